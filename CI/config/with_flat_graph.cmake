@@ -0,0 +1,4 @@
+# from minimal, test the kernel with the flat simulation graphs
+include(minimal)
+set_option(SICONOS_USE_FLAT_GRAPH ON)
+set_option(WITH_kernel_TESTING ON)
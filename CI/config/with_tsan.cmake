@@ -0,0 +1,3 @@
+# from default, test solvers with thread sanitizer
+include(default)
+set_option(USE_SANITIZER tsan)
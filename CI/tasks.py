@@ -67,6 +67,9 @@ minimal = SiconosCiTask(
     srcs=['.'],
     targets={'.': ['docker-build', 'docker-ctest']})
 
+minimal_with_flat_graph = minimal.copy()(
+    ci_config='with_flat_graph')
+
 minimal_with_python = SiconosCiTask(
     docker=True,
     ci_config='minimal_with_python',
@@ -287,6 +290,7 @@ known_tasks = {'siconos---vm0':
 
                'siconos---vm1':
                (minimal,
+                minimal_with_flat_graph,
                 minimal_with_python,
                 siconos_documentation,
                 siconos_dev_mode_strict,
@@ -76,6 +76,8 @@ if(USE_SANITIZER MATCHES "asan")
   APPEND_C_FLAGS("-fsanitize=leak -fsanitize=address -fsanitize=undefined -fno-omit-frame-pointer")
 elseif(USE_SANITIZER MATCHES "msan")
   APPEND_C_FLAGS("-fsanitize=memory -fsanitize-memory-track-origins -fno-omit-frame-pointer")
+elseif(USE_SANITIZER MATCHES "tsan")
+  APPEND_C_FLAGS("-fsanitize=thread -fno-omit-frame-pointer")
 elseif(USE_SANITIZER MATCHES "cfi")
   APPEND_C_FLAGS("-fsanitize=cfi -flto -fno-omit-frame-pointer -B ${CLANG_LD_HACK}")
 endif()
@@ -14,6 +14,7 @@ endif()
 # For SiconosConfig.h
 option(SICONOS_USE_BOOST_FOR_CXX11 "Prefer BOOST features over C++ standard features even if C++xy is enabled" ON)
 option(SICONOS_USE_MAP_FOR_HASH "Prefer std::map to std::unordered_map even if C++xy is enabled" ON)
+option(SICONOS_USE_FLAT_GRAPH "Store vertices and edges of the simulation graphs in contiguous arrays instead of boost::adjacency_list" OFF)
 
 include(cxxTools)
 
@@ -111,6 +112,8 @@ if(USE_SANITIZER MATCHES "asan")
   APPEND_CXX_FLAGS("-fsanitize=leak -fsanitize=address -fsanitize=undefined -fno-omit-frame-pointer")
 elseif(USE_SANITIZER MATCHES "msan")
   APPEND_CXX_FLAGS("-fsanitize=memory -fsanitize-memory-track-origins -fno-omit-frame-pointer")
+elseif(USE_SANITIZER MATCHES "tsan")
+  APPEND_CXX_FLAGS("-fsanitize=thread -fno-omit-frame-pointer")
 elseif(USE_SANITIZER MATCHES "cfi")
   APPEND_CXX_FLAGS("-fsanitize=cfi -flto -fno-omit-frame-pointer -B ${CLANG_LD_HACK}")
 endif()
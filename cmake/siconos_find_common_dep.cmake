@@ -90,6 +90,12 @@ if(WITH_MUMPS)
   compile_with(MUMPS REQUIRED SICONOS_COMPONENTS numerics)
 endif()
 
+# --- MPI ---
+if(WITH_MPI AND NOT HAVE_MPI)
+  compile_with(MPI REQUIRED SICONOS_COMPONENTS numerics)
+  set(HAVE_MPI TRUE)
+endif()
+
 # --- UMFPACK ---
 if(WITH_UMFPACK)
   compile_with(Umfpack REQUIRED SICONOS_COMPONENTS numerics)
@@ -152,6 +158,10 @@ IF(WITH_BULLET)
     IF(BULLET_USE_DOUBLE_PRECISION)
       APPEND_CXX_FLAGS("-DBT_USE_DOUBLE_PRECISION")
     ENDIF(BULLET_USE_DOUBLE_PRECISION)
+    # Bullet built with BULLET2_MULTITHREADING: parallel collision detection
+    IF(BULLET_USE_MULTITHREADING)
+      APPEND_CXX_FLAGS("-DBT_THREADSAFE=1")
+    ENDIF(BULLET_USE_MULTITHREADING)
 
     # If a custom bullet was set, provide it for user programs.
     IF(BULLET_INCLUDE_DIR)
@@ -172,6 +182,9 @@ IF(WITH_BULLET)
     IF(BULLET_USE_DOUBLE_PRECISION)
       SET(BULLET_PATHS "${BULLET_PATHS}\nset(BULLET_USE_DOUBLE_PRECISION \"${BULLET_USE_DOUBLE_PRECISION}\")")
     ENDIF()
+    IF(BULLET_USE_MULTITHREADING)
+      SET(BULLET_PATHS "${BULLET_PATHS}\nset(BULLET_USE_MULTITHREADING \"${BULLET_USE_MULTITHREADING}\")")
+    ENDIF()
   ENDIF(BULLET_FOUND)
 ENDIF(WITH_BULLET)
 
@@ -81,6 +81,7 @@
 #define SICONOS_CXXVERSION @CXXVERSION@
 #cmakedefine SICONOS_USE_BOOST_FOR_CXX11
 #cmakedefine SICONOS_USE_MAP_FOR_HASH
+#cmakedefine SICONOS_USE_FLAT_GRAPH
 #cmakedefine SICONOS_STD_SHARED_PTR
 #cmakedefine SICONOS_STD_ARRAY
 #cmakedefine SICONOS_STD_UNORDERED_MAP
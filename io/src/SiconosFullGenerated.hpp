@@ -72,7 +72,10 @@ SICONOS_IO_REGISTER(MatrixIntegrator,
   (_E)
   (_OSI)
   (_TD)
+  (_closedForm)
+  (_h)
   (_isConst)
+  (_k)
   (_mat)
   (_nsds)
   (_plugin)
@@ -86,6 +89,7 @@ SICONOS_IO_REGISTER_WITH_BASES(DynamicalSystemsGraph,(_DynamicalSystemsGraph),
   (Ld)
   (dummy)
   (e)
+  (fixed)
   (groupId)
   (jacgx)
   (name)
@@ -372,6 +376,7 @@ SICONOS_IO_REGISTER_WITH_BASES(NewtonEulerDS,(DynamicalSystem),
   (_mGyr)
   (_mInt)
   (_massMatrix)
+  (_massVersion)
   (_ndof)
   (_nullifyMGyr)
   (_p)
@@ -639,11 +644,16 @@ SICONOS_IO_REGISTER_WITH_BASES(MoreauJeanGOSI,(OneStepIntegrator),
   (_useGamma)
   (_useGammaForRelation))
 SICONOS_IO_REGISTER_WITH_BASES(MoreauJeanOSI,(OneStepIntegrator),
+  (_WTheta)
+  (_WTimeStep)
+  (_WVersion)
+  (_cacheW)
   (_explicitNewtonEulerDSOperators)
   (_gamma)
   (_theta)
   (_useGamma)
-  (_useGammaForRelation))
+  (_useGammaForRelation)
+  (_useNewtonEulerDSPool))
 SICONOS_IO_REGISTER_WITH_BASES(EulerMoreauOSI,(OneStepIntegrator),
   (_gamma)
   (_theta)
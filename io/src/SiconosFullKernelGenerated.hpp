@@ -63,6 +63,7 @@ SICONOS_IO_REGISTER_WITH_BASES(DynamicalSystemsGraph,(_DynamicalSystemsGraph),
   (Ld)
   (dummy)
   (e)
+  (fixed)
   (groupId)
   (jacgx)
   (name)
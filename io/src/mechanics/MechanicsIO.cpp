@@ -135,6 +135,46 @@ struct GetVelocity : public SiconosVisitor
   }
 };
 
+/* write time, id and the components of v in row, truncated or padded
+ * with zeros to cols values */
+static void fillRow(double* row, int cols, double time, double id,
+                    const SiconosVector& v)
+{
+  int n = std::max(0, std::min((int)v.size(), cols - 2));
+  if (cols > 0) row[0] = time;
+  if (cols > 1) row[1] = id;
+  for (int k = 0; k < n; ++k)
+    row[2+k] = v.getValue(k);
+  for (int k = n + 2; k < cols; ++k)
+    row[k] = 0.;
+}
+
+struct FillPosition : public SiconosVisitor
+{
+  double* row;
+  int cols;
+  double time;
+
+  template<typename T>
+  void operator()(const T& ds)
+  {
+    fillRow(row, cols, time, ds.number(), *ds.q());
+  }
+};
+
+struct FillVelocity : public SiconosVisitor
+{
+  double* row;
+  int cols;
+  double time;
+
+  template<typename T>
+  void operator()(const T& ds)
+  {
+    fillRow(row, cols, time, ds.number(), *ds.velocity());
+  }
+};
+
 struct ForMu : public Question<double>
 {
     ANSWER(NewtonImpactFrictionNSL, mu());
@@ -142,83 +182,80 @@ struct ForMu : public Question<double>
 };
 
 /* template partial specilization is not possible inside struct, so we
- * need an helper function */
+ * need an helper function. The 23 values mu, posa, posb, nc, cf, y(0),
+ * y(1), lambda(1), id are written in answer. */
 template<typename T>
-void contactPointProcess(SiconosVector& answer,
+bool contactPointProcess(double* answer,
                          const Interaction& inter,
                          const T& rel)
 {
 
-  answer.resize(23);
   const SiconosVector& posa = *rel.pc1();
   const SiconosVector& posb = *rel.pc2();
   const SiconosVector& nc = *rel.nc();
   const SimpleMatrix& jachqT = *rel.jachqT();
+  const SiconosVector& lambda = *inter.lambda(1);
   double id = inter.number();
   double mu = ask<ForMu>(*inter.nonSmoothLaw());
-  SiconosVector cf(jachqT.size(1));
-  prod(*inter.lambda(1), jachqT, cf, true);
-  answer.setValue(0, mu);
+  answer[0] = mu;
 
   DEBUG_PRINTF("posa(0)=%g\n", posa(0));
   DEBUG_PRINTF("posa(1)=%g\n", posa(1));
   DEBUG_PRINTF("posa(2)=%g\n", posa(2));
 
-
-  answer.setValue(1, posa(0));
-  answer.setValue(2, posa(1));
-  answer.setValue(3, posa(2));
-  answer.setValue(4, posb(0));
-  answer.setValue(5, posb(1));
-  answer.setValue(6, posb(2));
-  answer.setValue(7, nc(0));
-  answer.setValue(8, nc(1));
-  answer.setValue(9, nc(2));
-  answer.setValue(10, cf(0));
-  answer.setValue(11, cf(1));
-  answer.setValue(12, cf(2));
-  answer.setValue(13,inter.y(0)->getValue(0));
-  answer.setValue(14,inter.y(0)->getValue(1));
-  answer.setValue(15,inter.y(0)->getValue(2));
-  answer.setValue(16,inter.y(1)->getValue(0));
-  answer.setValue(17,inter.y(1)->getValue(1));
-  answer.setValue(18,inter.y(1)->getValue(2));
-  answer.setValue(19,inter.lambda(1)->getValue(0));
-  answer.setValue(20,inter.lambda(1)->getValue(1));
-  answer.setValue(21,inter.lambda(1)->getValue(2));
-  answer.setValue(22, id);
+  for (unsigned int k = 0; k < 3; ++k)
+  {
+    /* cf = trans(jachqT) lambda */
+    double cf = 0.;
+    for (unsigned int i = 0; i < jachqT.size(0); ++i)
+      cf += lambda.getValue(i) * jachqT.getValue(i, k);
+
+    answer[1+k] = posa.getValue(k);
+    answer[4+k] = posb.getValue(k);
+    answer[7+k] = nc.getValue(k);
+    answer[10+k] = cf;
+    answer[13+k] = inter.y(0)->getValue(k);
+    answer[16+k] = inter.y(1)->getValue(k);
+    answer[19+k] = lambda.getValue(k);
+  }
+  answer[22] = id;
+  return true;
 };
 
 template<>
-void contactPointProcess<PivotJointR>(SiconosVector& answer,
+bool contactPointProcess<PivotJointR>(double* answer,
                                       const Interaction& inter,
                                       const PivotJointR& rel)
 {
+  return false;
 };
 
 template<>
-void contactPointProcess<KneeJointR>(SiconosVector& answer,
+bool contactPointProcess<KneeJointR>(double* answer,
                                      const Interaction& inter,
                                      const KneeJointR& rel)
 {
+  return false;
 };
 
 template<>
-void contactPointProcess<PrismaticJointR>(SiconosVector& answer,
+bool contactPointProcess<PrismaticJointR>(double* answer,
                                           const Interaction& inter,
                                           const PrismaticJointR& rel)
 {
+  return false;
 };
 
 struct ContactPointVisitor : public SiconosVisitor
 {
   SP::Interaction inter;
-  SiconosVector answer;
+  double* answer;
+  bool found;
 
   template<typename T>
   void operator()(const T& rel)
   {
-    contactPointProcess<T>(answer, *inter, rel);
+    found = contactPointProcess<T>(answer, *inter, rel);
   }
 
 };
@@ -226,7 +263,8 @@ struct ContactPointVisitor : public SiconosVisitor
 struct ContactPointDomainVisitor : public SiconosVisitor
 {
   SP::Interaction inter;
-  SiconosVector answer;
+  double* answer;
+  bool found;
 
   template<typename T>
   void operator()(const T& rel)
@@ -238,15 +276,14 @@ struct ContactPointDomainVisitor : public SiconosVisitor
 template<>
 void ContactPointDomainVisitor::operator()(const BulletR& rel)
 {
-  answer.resize(2);
-
   /*
    * TODO: contact point domain coloring (e.g. based on broadphase).
    * currently, domain = (x>0):1?0
    */
-  answer.setValue(0, rel.pc1()->getValue(0) > 0);
+  answer[0] = rel.pc1()->getValue(0) > 0;
 
-  answer.setValue(1, inter->number());
+  answer[1] = inter->number();
+  found = true;
 }
 
 template<typename T, typename G>
@@ -306,82 +343,173 @@ SP::SimpleMatrix MechanicsIO::velocities(const NonSmoothDynamicalSystem& nsds) c
     (*nsds.topology()->dSG(0));
 }
 
-SP::SimpleMatrix MechanicsIO::contactPoints(const NonSmoothDynamicalSystem& nsds,
-                                            unsigned int index_set) const
+template<typename T, typename G>
+int MechanicsIO::fillAllVertices(const G& graph, double time,
+                                 double* buffer, int rows, int cols) const
 {
-  SP::SimpleMatrix result(new SimpleMatrix());
-  InteractionsGraph::VIterator vi, viend;
-  if (nsds.topology()->numberOfIndexSet() > 0)
+  int nrows = graph.vertices_number();
+  if (nrows > rows) return nrows;
+
+  T filler;
+  filler.cols = cols;
+  filler.time = time;
+  typename G::VIterator vi, viend;
+  int current_row;
+  for(current_row=0,std11::tie(vi,viend)=graph.vertices();
+      vi!=viend; ++vi, ++current_row)
   {
-    InteractionsGraph& graph =
-      *nsds.topology()->indexSet(index_set);
-    unsigned int current_row;
-    result->resize(graph.vertices_number(), 25);
-
-    SP::DynamicalSystem ds1;
-    SP::DynamicalSystem ds2;
-    for(current_row=0, std11::tie(vi,viend) = graph.vertices();
-        vi!=viend; ++vi)
-    {
-      DEBUG_PRINTF("process interaction : %p\n", &*graph.bundle(*vi));
-
-      typedef Visitor < Classes <
-                          NewtonEulerFrom1DLocalFrameR,
-                          NewtonEulerFrom3DLocalFrameR,
-                          PrismaticJointR,
-                          KneeJointR,
-                          PivotJointR>,
-                        ContactPointVisitor>::Make ContactPointInspector;
-      ContactPointInspector inspector;
-      inspector.inter = graph.bundle(*vi);
-      graph.bundle(*vi)->relation()->accept(inspector);
-      SiconosVector& data = inspector.answer;
-      if (data.size() == 23)
-      {
-        data.resize(23+2);
-        ds1 = graph.properties(*vi).source;
-        ds2 = graph.properties(*vi).target;
-        data.setValue(23,ds1->number());
-        data.setValue(24,ds2->number());
-        result->setRow(current_row++, data);
-      }
-    }
-    result->resize(current_row, 25);
+    filler.row = buffer + current_row * cols;
+    graph.bundle(*vi)->accept(filler);
+  }
+  return nrows;
+}
 
+int MechanicsIO::fillPositions(const NonSmoothDynamicalSystem& nsds,
+                               double time,
+                               double* buffer, int rows, int cols) const
+{
+  typedef
+    Visitor < Classes < LagrangianDS, NewtonEulerDS >,
+              FillPosition >::Make Filler;
 
+  return fillAllVertices<Filler>
+    (*nsds.topology()->dSG(0), time, buffer, rows, cols);
+}
 
-  }
-  return result;
+int MechanicsIO::fillVelocities(const NonSmoothDynamicalSystem& nsds,
+                                double time,
+                                double* buffer, int rows, int cols) const
+{
+  typedef
+    Visitor < Classes < LagrangianDS, NewtonEulerDS >,
+              FillVelocity >::Make Filler;
+
+  return fillAllVertices<Filler>
+    (*nsds.topology()->dSG(0), time, buffer, rows, cols);
 }
 
-SP::SimpleMatrix MechanicsIO::domains(const NonSmoothDynamicalSystem& nsds) const
+int MechanicsIO::fillContactPoints(const NonSmoothDynamicalSystem& nsds,
+                                   double time,
+                                   double* buffer, int rows, int cols,
+                                   unsigned int index_set) const
 {
-  SP::SimpleMatrix result(new SimpleMatrix());
+  if (nsds.topology()->numberOfIndexSet() == 0) return 0;
+
+  InteractionsGraph& graph = *nsds.topology()->indexSet(index_set);
+  int nrows = graph.vertices_number();
+  if (nrows > rows) return nrows;
+
+  typedef Visitor < Classes <
+                      NewtonEulerFrom1DLocalFrameR,
+                      NewtonEulerFrom3DLocalFrameR,
+                      PrismaticJointR,
+                      KneeJointR,
+                      PivotJointR>,
+                    ContactPointVisitor>::Make ContactPointInspector;
+  ContactPointInspector inspector;
+
+  /* time, contact point data, ds1 and ds2 numbers */
+  double data[26];
+  inspector.answer = data + 1;
+
   InteractionsGraph::VIterator vi, viend;
-  if (nsds.topology()->numberOfIndexSet() > 0)
+  int current_row;
+  for(current_row=0, std11::tie(vi,viend) = graph.vertices();
+      vi!=viend; ++vi)
   {
-    InteractionsGraph& graph =
-      *nsds.topology()->indexSet(1);
-    unsigned int current_row;
-    result->resize(graph.vertices_number(), 2);
-    for(current_row=0, std11::tie(vi,viend) = graph.vertices();
-        vi!=viend; ++vi, ++current_row)
+    DEBUG_PRINTF("process interaction : %p\n", &*graph.bundle(*vi));
+
+    inspector.inter = graph.bundle(*vi);
+    inspector.found = false;
+    graph.bundle(*vi)->relation()->accept(inspector);
+    if (inspector.found)
     {
-      DEBUG_PRINTF("process interaction : %p\n", &*graph.bundle(*vi));
-
-      typedef Visitor < Classes <
-                          NewtonEulerFrom1DLocalFrameR,
-                          NewtonEulerFrom3DLocalFrameR,
-                          PrismaticJointR,
-                          KneeJointR,
-                          PivotJointR>,
-                        ContactPointDomainVisitor>::Make DomainInspector;
-      DomainInspector inspector;
-      inspector.inter = graph.bundle(*vi);
-      graph.bundle(*vi)->relation()->accept(inspector);
-      const SiconosVector& data = inspector.answer;
-      if (data.size() == 2) result->setRow(current_row, data);
+      data[0] = time;
+      data[24] = graph.properties(*vi).source->number();
+      data[25] = graph.properties(*vi).target->number();
+      double* row = buffer + current_row * cols;
+      for (int k = 0; k < cols; ++k)
+        row[k] = k < 26 ? data[k] : 0.;
+      ++current_row;
     }
   }
+  return current_row;
+}
+
+int MechanicsIO::fillDomains(const NonSmoothDynamicalSystem& nsds,
+                             double time,
+                             double* buffer, int rows, int cols) const
+{
+  if (nsds.topology()->numberOfIndexSet() == 0) return 0;
+
+  InteractionsGraph& graph = *nsds.topology()->indexSet(1);
+  int nrows = graph.vertices_number();
+  if (nrows > rows) return nrows;
+
+  typedef Visitor < Classes <
+                      NewtonEulerFrom1DLocalFrameR,
+                      NewtonEulerFrom3DLocalFrameR,
+                      PrismaticJointR,
+                      KneeJointR,
+                      PivotJointR>,
+                    ContactPointDomainVisitor>::Make DomainInspector;
+  DomainInspector inspector;
+
+  /* time, domain, id */
+  double data[3];
+  inspector.answer = data + 1;
+
+  InteractionsGraph::VIterator vi, viend;
+  int current_row;
+  for(current_row=0, std11::tie(vi,viend) = graph.vertices();
+      vi!=viend; ++vi, ++current_row)
+  {
+    DEBUG_PRINTF("process interaction : %p\n", &*graph.bundle(*vi));
+
+    inspector.inter = graph.bundle(*vi);
+    inspector.found = false;
+    graph.bundle(*vi)->relation()->accept(inspector);
+    data[0] = time;
+    if (!inspector.found)
+      data[1] = data[2] = 0.;
+    double* row = buffer + current_row * cols;
+    for (int k = 0; k < cols; ++k)
+      row[k] = k < 3 ? data[k] : 0.;
+  }
+  return current_row;
+}
+
+/* the rows written by fill, without the time column, in a SimpleMatrix */
+static SP::SimpleMatrix rowsToMatrix(const std::vector<double>& buffer,
+                                     int rows, int cols)
+{
+  SP::SimpleMatrix result(new SimpleMatrix(rows, cols - 1));
+  for (int i = 0; i < rows; ++i)
+    for (int j = 1; j < cols; ++j)
+      result->setValue(i, j - 1, buffer[i * cols + j]);
   return result;
 }
+
+SP::SimpleMatrix MechanicsIO::contactPoints(const NonSmoothDynamicalSystem& nsds,
+                                            unsigned int index_set) const
+{
+  if (nsds.topology()->numberOfIndexSet() == 0)
+    return SP::SimpleMatrix(new SimpleMatrix());
+
+  int rows = nsds.topology()->indexSet(index_set)->vertices_number();
+  std::vector<double> buffer(rows * 26);
+  rows = fillContactPoints(nsds, 0., rows ? &buffer[0] : NULL, rows, 26,
+                           index_set);
+  return rowsToMatrix(buffer, rows, 26);
+}
+
+SP::SimpleMatrix MechanicsIO::domains(const NonSmoothDynamicalSystem& nsds) const
+{
+  if (nsds.topology()->numberOfIndexSet() == 0)
+    return SP::SimpleMatrix(new SimpleMatrix());
+
+  int rows = nsds.topology()->indexSet(1)->vertices_number();
+  std::vector<double> buffer(rows * 3);
+  rows = fillDomains(nsds, 0., rows ? &buffer[0] : NULL, rows, 3);
+  return rowsToMatrix(buffer, rows, 3);
+}
@@ -33,6 +33,10 @@ protected:
   template<typename T, typename G>
   SP::SiconosVector visitAllVerticesForDouble(const G& graph) const;
 
+  template<typename T, typename G>
+  int fillAllVertices(const G& graph, double time,
+                      double* buffer, int rows, int cols) const;
+
 public:
   /** default constructor
    */
@@ -68,6 +72,66 @@ public:
    * \return a matrix where the columns are domain, id
   */
   SP::SimpleMatrix domains(const NonSmoothDynamicalSystem& nsds) const;
+
+  /** \name Snapshots in preallocated buffers
+   * The following functions write one row per object in a row-major
+   * buffer of rows x cols doubles, with time as first column: the
+   * layout of the dynamic, velocities, cf and domain datasets of the
+   * hdf5 output. Rows are truncated or padded with zeros to cols
+   * values. Nothing is allocated, so that a buffer may be reused at
+   * each step. The returned value is the number of rows written, or,
+   * if it is greater than rows, the number of rows needed (an upper
+   * bound for contact points), in which case nothing is written.
+   */
+  ///@{
+
+  /** write time, id, x, y, z, qw, qx, qy, qz for each dynamical system
+   * \param nsds current nonsmooth dynamical system
+   * \param time the value of the first column
+   * \param buffer a row-major array of rows x cols doubles
+   * \param rows number of rows of buffer
+   * \param cols number of columns of buffer
+   * \return the number of rows of the snapshot
+   */
+  int fillPositions(const NonSmoothDynamicalSystem& nsds, double time,
+                    double* buffer, int rows, int cols) const;
+
+  /** write time, id, xdot, ydot, zdot, ox, oy, oz for each dynamical system
+   * \param nsds current nonsmooth dynamical system
+   * \param time the value of the first column
+   * \param buffer a row-major array of rows x cols doubles
+   * \param rows number of rows of buffer
+   * \param cols number of columns of buffer
+   * \return the number of rows of the snapshot
+   */
+  int fillVelocities(const NonSmoothDynamicalSystem& nsds, double time,
+                     double* buffer, int rows, int cols) const;
+
+  /** write time followed by the columns of contactPoints() for each
+   * contact point
+   * \param nsds current nonsmooth dynamical system
+   * \param time the value of the first column
+   * \param buffer a row-major array of rows x cols doubles
+   * \param rows number of rows of buffer
+   * \param cols number of columns of buffer
+   * \param index_set the index set number.
+   * \return the number of rows of the snapshot
+   */
+  int fillContactPoints(const NonSmoothDynamicalSystem& nsds, double time,
+                        double* buffer, int rows, int cols,
+                        unsigned int index_set=1) const;
+
+  /** write time, domain, id for each contact point
+   * \param nsds current nonsmooth dynamical system
+   * \param time the value of the first column
+   * \param buffer a row-major array of rows x cols doubles
+   * \param rows number of rows of buffer
+   * \param cols number of columns of buffer
+   * \return the number of rows of the snapshot
+   */
+  int fillDomains(const NonSmoothDynamicalSystem& nsds, double time,
+                  double* buffer, int rows, int cols) const;
+  ///@}
 };
 
 
@@ -21,6 +21,8 @@
 %include "SiconosRestart.hpp"
 
 #ifdef WITH_MECHANICS
+// snapshots are written in place in C-contiguous numpy arrays of floats
+%apply (double* INPLACE_ARRAY2, int DIM1, int DIM2) {(double* buffer, int rows, int cols)};
 %include <MechanicsIO.hpp>
 %{
 #include <MechanicsIO.hpp>
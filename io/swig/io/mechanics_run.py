@@ -723,6 +723,7 @@ class MechanicsHdf5Runner(siconos.io.mechanics_hdf5.MechanicsHdf5):
         self._gravity_scale = gravity_scale
         self._collision_margin = collision_margin
         self._output_frequency = 1
+        self._output_buffers = dict()
         self._keep = []
         self._scheduled_births = []
         self._scheduled_deaths = []
@@ -1543,49 +1544,45 @@ class MechanicsHdf5Runner(siconos.io.mechanics_hdf5.MechanicsHdf5):
                  rotation[3]]
             p += 1
 
+    def output(self, name, dataset, fill):
+        """
+        Append the rows written by fill(array) to dataset. fill returns
+        the number of rows written, or the number of rows it needs if
+        they do not fit, as MechanicsIO.fillPositions and friends do.
+        The array is kept for the next outputs of the same dataset.
+        """
+        buf = self._output_buffers.get(name)
+        if buf is None or buf.shape[1] != dataset.shape[1]:
+            buf = np.empty((64, dataset.shape[1]))
+        rows = fill(buf)
+        if rows > buf.shape[0]:
+            buf = np.empty((max(rows, 2 * buf.shape[0]), dataset.shape[1]))
+            rows = fill(buf)
+        self._output_buffers[name] = buf
+        if rows > 0:
+            current_line = dataset.shape[0]
+            dataset.resize(current_line + rows, 0)
+            dataset[current_line:, :] = buf[:rows, :]
+
     def output_dynamic_objects(self, initial=False):
         """
         Outputs translations and orientations of dynamic objects.
         """
 
-        current_line = self._dynamic_data.shape[0]
-
         time = self.current_time()
 
-        positions = self._io.positions(self._nsds)
-
-        if positions is not None:
-
-            self._dynamic_data.resize(current_line + positions.shape[0], 0)
-
-            times = np.empty((positions.shape[0], 1))
-            times.fill(time)
-
-            self._dynamic_data[current_line:, :] = np.concatenate((times,
-                                                                   positions),
-                                                                  axis=1)
+        self.output('dynamic', self._dynamic_data,
+                    lambda buf: self._io.fillPositions(self._nsds, time, buf))
 
     def output_velocities(self):
         """
         Output velocities of dynamic objects
         """
 
-        current_line = self._dynamic_data.shape[0]
-
         time = self.current_time()
 
-        velocities = self._io.velocities(self._nsds)
-
-        if velocities is not None:
-
-            self._velocities_data.resize(current_line + velocities.shape[0], 0)
-
-            times = np.empty((velocities.shape[0], 1))
-            times.fill(time)
-
-            self._velocities_data[current_line:, :] = np.concatenate((times,
-                                                                      velocities),
-                                                                     axis=1)
+        self.output('velocities', self._velocities_data,
+                    lambda buf: self._io.fillVelocities(self._nsds, time, buf))
 
     def output_contact_forces(self):
         """
@@ -1595,20 +1592,9 @@ class MechanicsHdf5Runner(siconos.io.mechanics_hdf5.MechanicsHdf5):
         if self._nsds.\
                 topology().indexSetsSize() > 1:
             time = self.current_time()
-            contact_points = self._io.contactPoints(self._nsds,
-                                                    self._contact_index_set)
-
-            if contact_points is not None:
-
-                current_line = self._cf_data.shape[0]
-                self._cf_data.resize(current_line + contact_points.shape[0], 0)
-                times = np.empty((contact_points.shape[0], 1))
-                times.fill(time)
-
-                self._cf_data[current_line:, :] = \
-                    np.concatenate((times,
-                                    contact_points),
-                                   axis=1)
+            self.output('cf', self._cf_data,
+                        lambda buf: self._io.fillContactPoints(
+                            self._nsds, time, buf, self._contact_index_set))
 
     def output_domains(self):
         """
@@ -1617,17 +1603,8 @@ class MechanicsHdf5Runner(siconos.io.mechanics_hdf5.MechanicsHdf5):
         if self._nsds.\
                 topology().indexSetsSize() > 1:
             time = self.current_time()
-            domains = self._io.domains(self._nsds)
-
-            if domains is not None:
-
-                current_line = self._domain_data.shape[0]
-                self._domain_data.resize(current_line + domains.shape[0], 0)
-                times = np.empty((domains.shape[0], 1))
-                times.fill(time)
-
-                self._domain_data[current_line:, :] = \
-                    np.concatenate((times, domains), axis=1)
+            self.output('domain', self._domain_data,
+                        lambda buf: self._io.fillDomains(self._nsds, time, buf))
 
     def output_solver_infos(self):
         """
@@ -1638,8 +1615,6 @@ class MechanicsHdf5Runner(siconos.io.mechanics_hdf5.MechanicsHdf5):
         so = self._simulation.oneStepNSProblem(0).\
             numericsSolverOptions()
 
-        current_line = self._solv_data.shape[0]
-        self._solv_data.resize(current_line + 1, 0)
         if so.solverId == Numerics.SICONOS_GENERIC_MECHANICAL_NSGS:
             iterations = so.iparam[3]
             precision = so.dparam[2]
@@ -1654,8 +1629,12 @@ class MechanicsHdf5Runner(siconos.io.mechanics_hdf5.MechanicsHdf5):
             precision = so.dparam[Numerics.SICONOS_DPARAM_RESIDU]
             local_precision = so.dparam[2]
 
-        self._solv_data[current_line, :] = [time, iterations, precision,
-                                            local_precision]
+        def fill(buf):
+            if buf.shape[0] > 0:
+                buf[0, :] = [time, iterations, precision, local_precision]
+            return 1
+
+        self.output('solv', self._solv_data, fill)
 
     def print_solver_infos(self):
         """
@@ -71,9 +71,9 @@ if(WITH_${COMPONENT}_TESTING)
   BEGIN_TEST(src/simulationTools/test)
 
   IF(HAS_FORTRAN)
-    NEW_TEST(testSimulationTools OSNSPTest.cpp ZOHTest.cpp)
+    NEW_TEST(testSimulationTools OSNSPTest.cpp ZOHTest.cpp LsodarOSITest.cpp MoreauJeanOSITest.cpp OSNSMatrixLayoutTest.cpp)
    ELSE()
-    NEW_TEST(testSimulationTools OSNSPTest.cpp)
+    NEW_TEST(testSimulationTools OSNSPTest.cpp MoreauJeanOSITest.cpp OSNSMatrixLayoutTest.cpp)
   ENDIF()
   
   END_TEST()
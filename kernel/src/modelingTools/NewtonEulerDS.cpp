@@ -477,6 +477,7 @@ void NewtonEulerDS::_init()
   _T.reset(new SimpleMatrix(_qDim, _ndof));
 
   _scalarMass = 1.;
+  _massVersion = 0;
   _I.reset(new SimpleMatrix(3, 3));
   _I->eye();
   updateMassMatrix();
@@ -517,7 +518,7 @@ void NewtonEulerDS::updateMassMatrix()
   startIndex[2] = 3;
   startIndex[3] = 3;
   setBlock(_I, _massMatrix, dimIndex, startIndex);
-
+  ++_massVersion;
 }
 
 void NewtonEulerDS::_zeroPlugin()
@@ -190,6 +190,9 @@ protected:
   /** used for concatenate _I and _scalarMass.I_3 */
   SP::SimpleMatrix _massMatrix;
 
+  /** number of updates of _massMatrix, see updateMassMatrix */
+  unsigned int _massVersion;
+
   /** inverse or factorization of the mass of the system */
   SP::SimpleMatrix _inverseMass;
 
@@ -607,6 +610,16 @@ public:
   /** to be called after scalar mass or inertia matrix have changed */
   void updateMassMatrix();
 
+  /** get the number of updates of the mass matrix. The quantities
+   *  computed from the mass matrix (its inverse, the iteration matrix of
+   *  an integrator...) are up to date as long as it does not change.
+   *  \return an unsigned int
+   */
+  inline unsigned int massVersion() const
+  {
+    return _massVersion;
+  };
+
   // -- Fext --
   /** get fExt
    *  \return pointer on a plugged vector
@@ -774,6 +787,18 @@ public:
     _nullifyMGyr = value;
   }
 
+  /** \return true if the jacobians of the forces with respect to q and
+   *  to the twist are null: no jacobian of the internal forces, no
+   *  jacobian of the external moment with respect to q, and a nullified
+   *  gyroscopic moment. The iteration matrix of MoreauJeanOSI is then
+   *  the mass matrix.
+   */
+  inline bool hasNullJacobiansOfForces() const
+  {
+    return !_jacobianWrenchq && !_jacobianFInttwist && !_jacobianMInttwist
+      && (_nullifyMGyr || !_jacobianMGyrtwist);
+  }
+
   virtual void normalizeq();
 
   /** Allocate memory for the lu factorization of the mass of the system.
@@ -29,6 +29,8 @@
 #include "SparseBlockMatrix.h" // From numerics, for SparseBlockStructuredMatrix
 #include "Tools.hpp"
 
+#include <algorithm>
+
 // #define DEBUG_STDOUT
 // #define DEBUG_MESSAGES 1
 #include "debug.h"
@@ -41,7 +43,8 @@ BlockCSRMatrix::BlockCSRMatrix():
   _diagsize0(new IndexInt()),
   _diagsize1(new IndexInt()),
   rowPos(new IndexInt()),
-  colPos(new IndexInt())
+  colPos(new IndexInt()),
+  _layoutChanged(true)
 {}
 
 // Constructor with dimensions
@@ -58,7 +61,8 @@ BlockCSRMatrix::BlockCSRMatrix(unsigned int nRow):
   _diagsize0(new IndexInt(_nr)),
   _diagsize1(new IndexInt(_nr)),
   rowPos(new IndexInt(_nr)),
-  colPos(new IndexInt(_nr))
+  colPos(new IndexInt(_nr)),
+  _layoutChanged(true)
 {}
 
 // Basic constructor
@@ -69,7 +73,8 @@ BlockCSRMatrix::BlockCSRMatrix(InteractionsGraph& indexSet):
   _diagsize0(new IndexInt(_nr)),
   _diagsize1(new IndexInt(_nr)),
   rowPos(new IndexInt(_nr)),
-  colPos(new IndexInt(_nr))
+  colPos(new IndexInt(_nr)),
+  _layoutChanged(true)
 {
   DEBUG_BEGIN("BlockCSRMatrix::BlockCSRMatrix(SP::InteractionsGraph indexSet)\n");
   fill(indexSet);
@@ -89,12 +94,11 @@ void BlockCSRMatrix::fill(InteractionsGraph& indexSet)
   // Number of blocks in a row = number of active constraints.
   _nr = indexSet.size();
 
-  // (re)allocate memory for ublas matrix
-  _blockCSR->resize(_nr, _nr, false);
-
   _diagsize0->resize(_nr);
   _diagsize1->resize(_nr);
 
+  _unsortedEntries.clear();
+
   // === Loop through "active" Interactions (ie present in
   // indexSets[level]) ===
 
@@ -115,8 +119,8 @@ void BlockCSRMatrix::fill(InteractionsGraph& indexSet)
     assert((*_diagsize0)[indexSet.index(*vi)] > 0);
     assert((*_diagsize1)[indexSet.index(*vi)] > 0);
 
-    (*_blockCSR)(indexSet.index(*vi), indexSet.index(*vi)) =
-      indexSet.properties(*vi).block->getArray();
+    _unsortedEntries.push_back(BlockEntry(indexSet.index(*vi), indexSet.index(*vi),
+                                  indexSet.properties(*vi).block->getArray()));
   }
 
   InteractionsGraph::EIterator ei, eiend;
@@ -125,7 +129,6 @@ void BlockCSRMatrix::fill(InteractionsGraph& indexSet)
   {
     InteractionsGraph::VDescriptor vd1 = indexSet.source(*ei);
     InteractionsGraph::VDescriptor vd2 = indexSet.target(*ei);
-    SP::Interaction inter1 = indexSet.bundle(vd1);
     SP::Interaction inter2 = indexSet.bundle(vd2);
 
     assert(indexSet.index(vd1) < _nr);
@@ -142,15 +145,115 @@ void BlockCSRMatrix::fill(InteractionsGraph& indexSet)
 
     assert(pos != col);
 
-    (*_blockCSR)(std::min(pos, col), std::max(pos, col)) =
-      indexSet.properties(*ei).upper_block->getArray();
+    _unsortedEntries.push_back(BlockEntry(std::min(pos, col), std::max(pos, col),
+                                  indexSet.properties(*ei).upper_block->getArray()));
 
-    (*_blockCSR)(std::max(pos, col), std::min(pos, col)) =
-      indexSet.properties(*ei).lower_block->getArray();
+    _unsortedEntries.push_back(BlockEntry(std::max(pos, col), std::min(pos, col),
+                                  indexSet.properties(*ei).lower_block->getArray()));
+  }
+
+  // Sort the blocks in row order: a counting sort on the rows, then
+  // each row (a few blocks) is sorted on the columns. Parallel edges
+  // give the same position twice: as with a direct assignment the
+  // last one is kept.
+  _rowStart.assign(_nr + 1, 0);
+  for (size_t k = 0; k < _unsortedEntries.size(); ++k)
+    ++_rowStart[_unsortedEntries[k].row + 1];
+  for (unsigned int r = 0; r < _nr; ++r)
+    _rowStart[r + 1] += _rowStart[r];
+
+  _entries.assign(_unsortedEntries.begin(), _unsortedEntries.end());
+  for (size_t k = 0; k < _unsortedEntries.size(); ++k)
+    _entries[_rowStart[_unsortedEntries[k].row]++] = _unsortedEntries[k];
+  // _rowStart[r] is now the end of row r
+  for (unsigned int r = _nr; r > 0; --r)
+    _rowStart[r] = _rowStart[r - 1];
+  _rowStart[0] = 0;
+
+  size_t nnz = 0;
+  for (unsigned int r = 0; r < _nr; ++r)
+  {
+    std::vector<BlockEntry>::iterator first = _entries.begin() + _rowStart[r];
+    std::vector<BlockEntry>::iterator last = _entries.begin() + _rowStart[r + 1];
+    std::stable_sort(first, last);
+    _rowStart[r] = nnz;
+    for (; first != last; ++first)
+    {
+      if (nnz > _rowStart[r] && _entries[nnz - 1].col == first->col)
+        _entries[nnz - 1].values = first->values;
+      else
+        _entries[nnz++] = *first;
+    }
+  }
+  _rowStart[_nr] = nnz;
+  _entries.erase(_entries.begin() + nnz, _entries.end());
+
+  unsigned int r0 = firstChangedRow();
+  _layoutChanged = (r0 < _nr || _blockCSR->size1() != _nr);
+
+  if (_layoutChanged)
+  {
+    DEBUG_PRINTF("BlockCSRMatrix::fill, new layout from row %u\n", r0);
+    // the blocks of the rows before r0 are at the same place, only
+    // the following ones are written again.
+    size_t keep = _rowStart[r0];
+    unsigned int r1 = r0;
+    if (_blockCSR->size1() != _nr)
+    {
+      // index1 is reallocated, index2 is kept if its capacity is
+      // not changed by ublas
+      size_t capacity = _blockCSR->index2_data().size();
+      _blockCSR->resize(_nr, _nr, false);
+      r1 = 0;
+      if (_blockCSR->index2_data().size() != capacity)
+        keep = 0;
+    }
+    if (_blockCSR->nnz_capacity() < nnz)
+      _blockCSR->reserve(nnz, true);
+
+    CompressedRowMat::index_array_type& index1 = _blockCSR->index1_data();
+    CompressedRowMat::index_array_type& index2 = _blockCSR->index2_data();
+    for (unsigned int r = r1; r <= _nr; ++r)
+      index1[r] = _rowStart[r];
+    for (size_t k = keep; k < nnz; ++k)
+      index2[k] = _entries[k].col;
+    _blockCSR->set_filled(_nr + 1, nnz);
+  }
+  else
+  {
+    DEBUG_PRINT("BlockCSRMatrix::fill, same layout, only values are updated\n");
+  }
+
+  // links to the blocks values
+  for (size_t k = 0; k < nnz; ++k)
+  {
+    _blockCSR->value_data()[k] = _entries[k].values;
   }
   DEBUG_EXPR(display(););
 }
 
+unsigned int BlockCSRMatrix::firstChangedRow() const
+{
+  // a structure not filled by a previous call is not reused
+  if (_blockCSR->filled1() != _blockCSR->size1() + 1)
+    return 0;
+
+  const CompressedRowMat::index_array_type& index1 = _blockCSR->index1_data();
+  const CompressedRowMat::index_array_type& index2 = _blockCSR->index2_data();
+  unsigned int nr = std::min<unsigned int>(_nr, _blockCSR->size1());
+  for (unsigned int r = 0; r < nr; ++r)
+  {
+    if (index1[r + 1] != _rowStart[r + 1])
+      return r;
+    for (size_t k = _rowStart[r]; k < _rowStart[r + 1]; ++k)
+    {
+      if (index2[k] != _entries[k].col)
+        return r;
+    }
+  }
+  return nr;
+}
+
 void BlockCSRMatrix::fillM(InteractionsGraph& indexSet)
 {
   /* on adjoint graph a dynamical system may be on several edges */
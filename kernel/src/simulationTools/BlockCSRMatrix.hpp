@@ -128,6 +128,42 @@ private:
   /** List of non null blocks positions (in col) */
   SP::IndexInt colPos;
 
+  /** a non null block: position (in blocks) and values */
+  struct BlockEntry
+  {
+    unsigned int row;
+    unsigned int col;
+    double* values;
+
+    BlockEntry(unsigned int r, unsigned int c, double* v):
+      row(r), col(c), values(v) {};
+
+    bool operator<(const BlockEntry& e) const
+    {
+      return (row < e.row) || (row == e.row && col < e.col);
+    };
+  };
+
+  /** non null blocks of the last fill, sorted by rows then columns.
+   * The memory is kept from one fill to the next. */
+  std::vector<BlockEntry> _entries;
+
+  /** non null blocks in the order of the graph, before sorting */
+  std::vector<BlockEntry> _unsortedEntries;
+
+  /** position in _entries of the first block of each row (_nr + 1 values) */
+  std::vector<size_t> _rowStart;
+
+  /** true if the last call to fill has changed the layout of _blockCSR */
+  bool _layoutChanged;
+
+  /** find the first row of _entries whose non null blocks are not at
+   * the positions already stored in _blockCSR
+   * \return the row number, min(_nr, number of stored rows) if the
+   * stored rows are all the same
+   */
+  unsigned int firstChangedRow() const;
+
   /** Private copy constructor => no copy nor pass by value */
   BlockCSRMatrix(const BlockCSRMatrix&);
 
@@ -205,11 +241,26 @@ public:
     else return colPos;
   };
 
-  /** fill the current class using an index set
+  /** fill the current class using an index set.
+   *
+   * The rows of the compressed structure before the first row whose
+   * non null blocks have moved (an inserted or removed interaction)
+   * are kept, only the following ones are written again. If no block
+   * has moved, the numerics SparseBlockStructuredMatrix which points
+   * to the structure stays valid and only the links to the blocks
+   * values are refreshed.
    *  \param indexSet set of the active constraints
    */
   void fill(InteractionsGraph& indexSet);
 
+  /** tell if the last call to fill has changed the sparse structure
+   * \return bool
+   */
+  inline bool hasLayoutChanged() const
+  {
+    return _layoutChanged;
+  };
+
 
   /** fill the matrix with the Mass matrix 
    * \warning only for NewtonEulerDS
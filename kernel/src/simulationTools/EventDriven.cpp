@@ -447,9 +447,9 @@ void EventDriven::computeJacobianfx(OneStepIntegrator& osi,
   lsodar.computeJacobianRhs(t, *_DSG0);
 
   // Save jacobianX values from dynamical system into current jacob
-  // (in-out parameter)
+  // (in-out parameter), full or banded according to the jacobian type
+  // of lsodar. The coupling between dynamical systems is neglected.
 
-  unsigned int i = 0;
   unsigned pos = 0;
   DynamicalSystemsGraph::VIterator dsi, dsend;
   SP::DynamicalSystemsGraph osiDSGraph = lsodar.dynamicalSystemsGraph();
@@ -459,21 +459,13 @@ void EventDriven::computeJacobianfx(OneStepIntegrator& osi,
 
     DynamicalSystem& ds = *(osiDSGraph->bundle(*dsi));
     Type::Siconos dsType = Type::value(ds);
-    if (dsType == Type::LagrangianDS || dsType == Type::LagrangianLinearTIDS)
-    {
-      LagrangianDS& lds = static_cast<LagrangianDS&>(ds);
-      BlockMatrix& jacotmp = static_cast<BlockMatrix&>(*lds.jacobianRhsx());
-      for (unsigned int j = 0; j < lds.n(); ++j)
-      {
-        for (unsigned int k = 0; k < lds.dimension(); ++k)
-          jacob[i++] = jacotmp(k, j);
-      }
-    }
-    else if(dsType == Type::FirstOrderNonLinearDS || dsType == Type::FirstOrderLinearDS
+    if (dsType == Type::LagrangianDS || dsType == Type::LagrangianLinearTIDS
+        || dsType == Type::FirstOrderNonLinearDS || dsType == Type::FirstOrderLinearDS
         || dsType == Type::FirstOrderLinearTIDS)
     {
-      SimpleMatrix& jacotmp = static_cast<SimpleMatrix&>(*(ds.jacobianRhsx())); // Pointer link !
-      pos += jacotmp.copyData(&jacob[pos]);
+      const SiconosMatrix& jacotmp = *ds.jacobianRhsx(); // Pointer link !
+      lsodar.copyJacobianBlock(jacotmp, pos, jacob);
+      pos += jacotmp.size(0);
     }
     else
     {
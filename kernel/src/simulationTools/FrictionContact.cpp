@@ -21,15 +21,38 @@
 #include "NonSmoothDynamicalSystem.hpp"
 #include "NewtonImpactFrictionNSL.hpp"
 #include "OSNSMatrix.hpp"
+#include "OneStepIntegrator.hpp"
+#include "Relation.hpp"
+#include "LagrangianDS.hpp"
+#include "NewtonEulerDS.hpp"
+#include "BoundaryCondition.hpp"
 #include "NonSmoothDrivers.h" // from numerics, for fcX_driver
 #include <fc2d_Solvers.h>
 #include <fc3d_Solvers.h>
+#include <fc2d_compute_error.h>
+#include <fc3d_compute_error.h>
+#include <NumericsMatrix.h>
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <map>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// #define DEBUG_STDOUT
+// #define DEBUG_MESSAGES
+#include "debug.h"
 
 using namespace RELATION;
 
 
 FrictionContact::FrictionContact(int dimPb, int numericsSolverId):
-  LinearOSNS(numericsSolverId), _contactProblemDim(dimPb)
+  LinearOSNS(numericsSolverId), _contactProblemDim(dimPb),
+  _solveByIslands(false), _numberOfIslands(0), _numberOfSolvedIslands(0),
+  _matrixFree(false), _delassusOperator(NULL)
 {
   if (dimPb == 2 && numericsSolverId == SICONOS_FRICTION_3D_NSGS)
     _numerics_solver_id = SICONOS_FRICTION_2D_NSGS;
@@ -103,12 +126,243 @@ void FrictionContact::updateMu()
   }
 }
 
+/* The matrix of the matrix-free mode, M = sum over the dynamical systems
+ * of H_ds W_ds^{-1} H_ds^T, plus the extra blocks of the interactions:
+ * the products H^T x of the interactions are accumulated in the dynamical
+ * systems, solved with their factorized W, and multiplied back by H. */
+struct DelassusOperator
+{
+  struct DS
+  {
+    SP::SimpleMatrix W;
+    SP::SiconosVector v;
+  };
+  struct Contact
+  {
+    unsigned int pos;
+    SP::SiconosMatrix diagonalBlock;
+    SP::SiconosMatrix extraBlock;
+    std::vector<unsigned int> ds;
+    std::vector<SP::SiconosMatrix> leftBlocks;
+    SP::SiconosVector x;
+    SP::SiconosVector y;
+  };
+  std::vector<DS> dss;
+  std::vector<Contact> contacts;
+  std::map<unsigned int, unsigned int> contactAt;
+};
+
+static void delassusGemv(void* env, double alpha, const double* x, double beta, double* y)
+{
+  DelassusOperator& op = *static_cast<DelassusOperator*>(env);
+  for (unsigned int d = 0; d < op.dss.size(); ++d)
+    op.dss[d].v->zero();
+
+  for (unsigned int c = 0; c < op.contacts.size(); ++c)
+  {
+    DelassusOperator::Contact& contact = op.contacts[c];
+    for (unsigned int k = 0; k < contact.x->size(); ++k)
+      (*contact.x)(k) = x[contact.pos + k];
+    for (unsigned int j = 0; j < contact.ds.size(); ++j)
+      gemvtranspose(1.0, *contact.leftBlocks[j], *contact.x, 1.0, *op.dss[contact.ds[j]].v);
+  }
+
+  for (unsigned int d = 0; d < op.dss.size(); ++d)
+    op.dss[d].W->PLUForwardBackwardInPlace(*op.dss[d].v);
+
+  for (unsigned int c = 0; c < op.contacts.size(); ++c)
+  {
+    DelassusOperator::Contact& contact = op.contacts[c];
+    contact.y->zero();
+    for (unsigned int j = 0; j < contact.ds.size(); ++j)
+      gemv(1.0, *contact.leftBlocks[j], *op.dss[contact.ds[j]].v, 1.0, *contact.y);
+    if (contact.extraBlock)
+      gemv(1.0, *contact.extraBlock, *contact.x, 1.0, *contact.y);
+    for (unsigned int k = 0; k < contact.y->size(); ++k)
+    {
+      double& yk = y[contact.pos + k];
+      yk = (beta == 0.0) ? alpha * (*contact.y)(k) : beta * yk + alpha * (*contact.y)(k);
+    }
+  }
+}
+
+static void delassusDiagBlock(void* env, int start, int size, double* block)
+{
+  DelassusOperator& op = *static_cast<DelassusOperator*>(env);
+  assert(op.contactAt.count(start));
+  const DelassusOperator::Contact& contact = op.contacts[op.contactAt[start]];
+  assert(contact.diagonalBlock->size(0) == (unsigned int)size);
+  std::copy(contact.diagonalBlock->getArray(),
+            contact.diagonalBlock->getArray() + size * size, block);
+}
+
+static void delassusFree(void* env)
+{
+  delete static_cast<DelassusOperator*>(env);
+}
+
+void FrictionContact::initOSNSMatrix()
+{
+  // the positions of the interactions only
+  if (_matrixFree && !_M)
+    _M.reset(new OSNSMatrix());
+  else
+    LinearOSNS::initOSNSMatrix();
+}
+
+void FrictionContact::updateInteractionBlocks()
+{
+  if (!_matrixFree)
+  {
+    LinearOSNS::updateInteractionBlocks();
+    return;
+  }
+  DEBUG_BEGIN("FrictionContact::updateInteractionBlocks()\n");
+  SP::InteractionsGraph indexSet = simulation()->indexSet(indexSetLevel());
+  bool isLinear = simulation()->nonSmoothDynamicalSystem()->isLinear();
+  std::vector<InteractionsGraph::VDescriptor> diagonalBlocks;
+  InteractionsGraph::VIterator vi, viend;
+  for (std11::tie(vi, viend) = indexSet->vertices(); vi != viend; ++vi)
+  {
+    unsigned int nslawSize = indexSet->bundle(*vi)->nonSmoothLaw()->size();
+    if (!indexSet->properties(*vi).block)
+      indexSet->properties(*vi).block.reset(new SimpleMatrix(nslawSize, nslawSize));
+    if (!isLinear || !_hasBeenUpdated)
+      diagonalBlocks.push_back(*vi);
+  }
+  // no extra-diagonal blocks, they are applied by the operator
+  computeInteractionBlocks(*indexSet, diagonalBlocks,
+                           std::vector<std::vector<InteractionsGraph::EDescriptor> >());
+  DEBUG_END("FrictionContact::updateInteractionBlocks()\n");
+}
+
+/* the solvers using M only through its products */
+static bool isMatrixFreeSolver(int solverId)
+{
+  switch (solverId)
+  {
+  case SICONOS_FRICTION_3D_FPP:
+  case SICONOS_FRICTION_3D_EG:
+  case SICONOS_FRICTION_3D_VI_FPP:
+  case SICONOS_FRICTION_3D_VI_EG:
+  case SICONOS_FRICTION_3D_HP:
+  case SICONOS_FRICTION_3D_ADMM:
+    return true;
+  default:
+    return false;
+  }
+}
+
+void FrictionContact::updateOSNSMatrix(InteractionsGraph& indexSet)
+{
+  if (!_matrixFree)
+  {
+    LinearOSNS::updateOSNSMatrix(indexSet);
+    return;
+  }
+  if (!isMatrixFreeSolver(_numerics_solver_options->solverId))
+    RuntimeException::selfThrow("FrictionContact::updateOSNSMatrix, the matrix-free mode needs a solver using only the products with M (FPP, EG, VI_FPP, VI_EG, HP or ADMM)");
+  DEBUG_BEGIN("FrictionContact::updateOSNSMatrix(InteractionsGraph& indexSet)\n");
+  _sizeOutput = 0;
+  DynamicalSystemsGraph& DSG0 = *simulation()->nonSmoothDynamicalSystem()->dynamicalSystems();
+  DelassusOperator* op = new DelassusOperator();
+  std::map<SP::DynamicalSystem, unsigned int> dsIndex;
+
+  InteractionsGraph::VIterator vi, viend;
+  for (std11::tie(vi, viend) = indexSet.vertices(); vi != viend; ++vi)
+  {
+    SP::Interaction inter = indexSet.bundle(*vi);
+    unsigned int nslawSize = inter->nonSmoothLaw()->size();
+    indexSet.properties(*vi).absolute_position = _sizeOutput;
+    _sizeOutput += nslawSize;
+    RELATION::TYPES relationType = inter->relation()->getType();
+    if ((relationType != Lagrangian && relationType != NewtonEuler)
+        || inter->relation()->getSubType() == CompliantLinearTIR)
+    {
+      delete op;
+      RuntimeException::selfThrow("FrictionContact::updateOSNSMatrix, the matrix-free mode is not implemented for this type of relation");
+    }
+
+    op->contactAt[indexSet.properties(*vi).absolute_position] = op->contacts.size();
+    op->contacts.push_back(DelassusOperator::Contact());
+    DelassusOperator::Contact& contact = op->contacts.back();
+    contact.pos = indexSet.properties(*vi).absolute_position;
+    contact.diagonalBlock = indexSet.properties(*vi).block;
+    contact.x.reset(new SiconosVector(nslawSize));
+    contact.y.reset(new SiconosVector(nslawSize));
+    contact.extraBlock.reset(new SimpleMatrix(nslawSize, nslawSize));
+    inter->getExtraInteractionBlock(contact.extraBlock);
+    if (contact.extraBlock->normInf() == 0.0)
+      contact.extraBlock.reset();
+
+    SP::DynamicalSystem ds1 = indexSet.properties(*vi).source;
+    SP::DynamicalSystem ds2 = indexSet.properties(*vi).target;
+    unsigned int pos = indexSet.properties(*vi).source_pos;
+    bool endl = false;
+    for (SP::DynamicalSystem ds = ds1; !endl; ds = ds2)
+    {
+      endl = (ds == ds2);
+      OneStepIntegrator& osi = *DSG0.properties(DSG0.descriptor(ds)).osi;
+      OSI::TYPES osiType = osi.getType();
+      Type::Siconos dsType = Type::value(*ds);
+      if ((osiType != OSI::MOREAUJEANOSI && osiType != OSI::MOREAUDIRECTPROJECTIONOSI
+           && osiType != OSI::SCHATZMANPAOLIOSI) || dsType == Type::LagrangianLinearDiagonalDS)
+      {
+        delete op;
+        RuntimeException::selfThrow("FrictionContact::updateOSNSMatrix, the matrix-free mode is not implemented for this integrator or dynamical system");
+      }
+
+      if (!dsIndex.count(ds))
+      {
+        dsIndex[ds] = op->dss.size();
+        DelassusOperator::DS d;
+        d.W = getOSIMatrix(osi, ds);
+        if (!d.W->isPLUFactorized())
+          d.W->PLUFactorizationInPlace();
+        d.v.reset(new SiconosVector(ds->dimension()));
+        op->dss.push_back(d);
+      }
+
+      SP::SiconosMatrix leftBlock(new SimpleMatrix(nslawSize, ds->dimension()));
+      inter->getLeftInteractionBlockForDS(pos, leftBlock);
+      // the velocities with a boundary condition are not changed by
+      // the reactions, as in computeDiagonalInteractionBlock
+      SP::BoundaryCondition bc;
+      if (dsType == Type::LagrangianLinearTIDS || dsType == Type::LagrangianDS)
+        bc = std11::static_pointer_cast<LagrangianDS>(ds)->boundaryConditions();
+      else if (dsType == Type::NewtonEulerDS)
+        bc = std11::static_pointer_cast<NewtonEulerDS>(ds)->boundaryConditions();
+      if (bc)
+      {
+        SiconosVector zero(nslawSize);
+        for (std::vector<unsigned int>::iterator itindex = bc->velocityIndices()->begin();
+             itindex != bc->velocityIndices()->end(); ++itindex)
+          leftBlock->setCol(*itindex, zero);
+      }
+      contact.ds.push_back(dsIndex[ds]);
+      contact.leftBlocks.push_back(leftBlock);
+      pos = indexSet.properties(*vi).target_pos;
+    }
+  }
+
+  if (_delassusOperator)
+  {
+    NM_free(_delassusOperator);
+    free(_delassusOperator);
+  }
+  _delassusOperator = NM_create_operator(_sizeOutput, _sizeOutput, op,
+                                         &delassusGemv, &delassusDiagBlock, &delassusFree);
+  DEBUG_PRINTF("matrix-free operator of %u contacts and %u dynamical systems\n",
+               (unsigned int)op->contacts.size(), (unsigned int)op->dss.size());
+  DEBUG_END("FrictionContact::updateOSNSMatrix(InteractionsGraph& indexSet)\n");
+}
+
 SP::FrictionContactProblem FrictionContact::frictionContactProblem()
 {
   SP::FrictionContactProblem numerics_problem(new FrictionContactProblem());
   numerics_problem->dimension = _contactProblemDim;
   numerics_problem->numberOfContacts = _sizeOutput / _contactProblemDim;
-  numerics_problem->M = &*_M->numericsMatrix();
+  numerics_problem->M = _matrixFree ? _delassusOperator : &*_M->numericsMatrix();
   numerics_problem->q = &*_q->getArray();
   numerics_problem->mu = _mu->data();
   return numerics_problem;
@@ -119,7 +373,7 @@ FrictionContactProblem *FrictionContact::frictionContactProblemPtr()
   FrictionContactProblem *numerics_problem = &_numerics_problem;
   numerics_problem->dimension = _contactProblemDim;
   numerics_problem->numberOfContacts = _sizeOutput / _contactProblemDim;
-  numerics_problem->M = &*_M->numericsMatrix();
+  numerics_problem->M = _matrixFree ? _delassusOperator : &*_M->numericsMatrix();
   numerics_problem->q = &*_q->getArray();
   numerics_problem->mu = _mu->data();
   return numerics_problem;
@@ -138,6 +392,160 @@ int FrictionContact::solve(SP::FrictionContactProblem problem)
                                     &*_numerics_solver_options);
 }
 
+/* the copies of the options share the callback and the solver data of
+ * the original, which must neither be used by several threads nor be
+ * freed with the copies */
+static void unshareOptionsData(SolverOptions* options)
+{
+  options->callback = NULL;
+  options->solverData = NULL;
+  options->solverParameters = NULL;
+  for (int i = 0; i < options->numberOfInternalSolvers; ++i)
+    unshareOptionsData(&options->internalSolvers[i]);
+}
+
+/* islands ordered by decreasing size, for the load balance */
+struct IslandSizeGreater
+{
+  const std::vector<std::vector<unsigned int> >& _contacts;
+  IslandSizeGreater(const std::vector<std::vector<unsigned int> >& contacts): _contacts(contacts) {};
+  bool operator()(unsigned int i, unsigned int j) const
+  {
+    return _contacts[i].size() > _contacts[j].size();
+  }
+};
+
+int FrictionContact::solveIslands()
+{
+  DEBUG_BEGIN("FrictionContact::solveIslands()\n");
+  FrictionContactProblem* problem = frictionContactProblemPtr();
+  int storageType = problem->M->storageType;
+  SP::InteractionsGraph indexSet = simulation()->indexSet(indexSetLevel());
+  std::vector<unsigned int> island;
+  _numberOfIslands = simulation()->nonSmoothDynamicalSystem()->topology()
+                     ->computeIslands(*indexSet, island);
+  _numberOfSolvedIslands = _numberOfIslands;
+  if (_numberOfIslands <= 1 || (storageType != NM_DENSE && storageType != NM_SPARSE_BLOCK))
+  {
+    DEBUG_END("FrictionContact::solveIslands()\n");
+    return solve();
+  }
+
+  // contacts of each island, in increasing order
+  const int dim = _contactProblemDim;
+  unsigned int nbIslands = _numberOfIslands;
+  std::vector<std::vector<unsigned int> > contacts(nbIslands);
+  InteractionsGraph::VIterator ui, uiend;
+  for (std11::tie(ui, uiend) = indexSet->vertices(); ui != uiend; ++ui)
+    contacts[island[indexSet->index(*ui)]].push_back(indexSet->properties(*ui).absolute_position / dim);
+  std::vector<unsigned int> order(nbIslands);
+  for (unsigned int k = 0; k < nbIslands; ++k)
+  {
+    std::sort(contacts[k].begin(), contacts[k].end());
+    order[k] = k;
+  }
+  std::sort(order.begin(), order.end(), IslandSizeGreater(contacts));
+
+  std::vector<FrictionContactProblem*> islands(nbIslands);
+  std::vector<int> localIndex(problem->numberOfContacts, -1);
+  for (unsigned int k = 0; k < nbIslands; ++k)
+    islands[k] = frictionContactProblem_new_subproblem(problem, contacts[k].size(),
+                                                        &contacts[k][0], &localIndex[0]);
+
+  double* z = &*_z->getArray();
+  double* w = &*_w->getArray();
+  double tolerance = _numerics_solver_options->dparam[SICONOS_DPARAM_TOL];
+  std::vector<int> infos(nbIslands, 0);
+  std::vector<int> solved(nbIslands, 0);
+  std::vector<int> iterations(nbIslands, 0);
+  std::vector<double> residus(nbIslands, 0.0);
+
+  // the callback is not thread safe: the islands are then solved in turn
+  Callback* callback = _numerics_solver_options->callback;
+  int nbThreads = 1;
+#ifdef _OPENMP
+  if (!callback)
+    nbThreads = std::min(omp_get_max_threads(), (int)nbIslands);
+#endif
+  std::vector<SolverOptions> options(nbThreads);
+
+#pragma omp parallel num_threads(nbThreads)
+  {
+    int thread = 0;
+#ifdef _OPENMP
+    thread = omp_get_thread_num();
+#endif
+    SolverOptions& localOptions = options[thread];
+    memset(&localOptions, 0, sizeof(SolverOptions));
+    solver_options_copy(&*_numerics_solver_options, &localOptions);
+    unshareOptionsData(&localOptions);
+    localOptions.callback = callback;
+    std::vector<double> zi, wi;
+
+#pragma omp for schedule(dynamic, 1)
+    for (int o = 0; o < (int)nbIslands; ++o)
+    {
+      unsigned int k = order[o];
+      FrictionContactProblem* islandProblem = islands[k];
+      unsigned int n = dim * contacts[k].size();
+      zi.resize(n);
+      wi.resize(n);
+      for (unsigned int c = 0; c < contacts[k].size(); ++c)
+        std::copy(z + dim * contacts[k][c], z + dim * (contacts[k][c] + 1), &zi[dim * c]);
+
+      // the current reactions may already be a solution
+      double& error = residus[k];
+      if (dim == 3)
+      {
+        double norm_q = 0.0;
+        for (unsigned int i = 0; i < n; ++i)
+          norm_q += islandProblem->q[i] * islandProblem->q[i];
+        fc3d_compute_error(islandProblem, &zi[0], &wi[0], tolerance, &localOptions,
+                           std::sqrt(norm_q), &error);
+      }
+      else
+        fc2d_compute_error(islandProblem, &zi[0], &wi[0], tolerance, &error);
+
+      if (!(error < tolerance))
+      {
+        infos[k] = (*_frictionContact_driver)(islandProblem, &zi[0], &wi[0], &localOptions);
+        solved[k] = 1;
+        iterations[k] = localOptions.iparam[SICONOS_IPARAM_ITER_DONE];
+        residus[k] = localOptions.dparam[SICONOS_DPARAM_RESIDU];
+      }
+
+      for (unsigned int c = 0; c < contacts[k].size(); ++c)
+      {
+        std::copy(&zi[dim * c], &zi[dim * (c + 1)], z + dim * contacts[k][c]);
+        std::copy(&wi[dim * c], &wi[dim * (c + 1)], w + dim * contacts[k][c]);
+      }
+    }
+  }
+
+  // the worst island gives the results of the solver
+  int info = 0;
+  int iter = 0;
+  double residu = 0.0;
+  _numberOfSolvedIslands = 0;
+  for (unsigned int k = 0; k < nbIslands; ++k)
+  {
+    info = std::max(info, infos[k]);
+    iter = std::max(iter, iterations[k]);
+    residu = std::max(residu, residus[k]);
+    _numberOfSolvedIslands += solved[k];
+    frictionContactProblem_free_subproblem(islands[k]);
+  }
+  _numerics_solver_options->iparam[SICONOS_IPARAM_ITER_DONE] = iter;
+  _numerics_solver_options->dparam[SICONOS_DPARAM_RESIDU] = residu;
+  for (int t = 0; t < nbThreads; ++t)
+  {
+    options[t].callback = NULL;
+    solver_options_delete(&options[t]);
+  }
+  DEBUG_PRINTF("%u islands, %u solved, info = %i\n", nbIslands, _numberOfSolvedIslands, info);
+  DEBUG_END("FrictionContact::solveIslands()\n");
+  return info;
+}
 
 int FrictionContact::compute(double time)
 {
@@ -165,7 +573,10 @@ int FrictionContact::compute(double time)
   if (_sizeOutput != 0)
   {
     // Call Numerics Driver for FrictionContact
-    info = solve();
+    if (_solveByIslands)
+      info = solveIslands();
+    else
+      info = solve();
     postCompute();
   }
 
@@ -182,4 +593,9 @@ void FrictionContact::display() const
 FrictionContact::~FrictionContact()
 {
   solver_options_delete(&*_numerics_solver_options);
+  if (_delassusOperator)
+  {
+    NM_free(_delassusOperator);
+    free(_delassusOperator);
+  }
 }
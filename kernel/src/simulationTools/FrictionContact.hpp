@@ -84,6 +84,24 @@ protected:
 
   FrictionContactProblem _numerics_problem;
 
+  /** if true, the islands of the index set are solved as independent
+   * problems, see solveIslands */
+  bool _solveByIslands;
+
+  /** number of islands of the last call to solveIslands */
+  unsigned int _numberOfIslands;
+
+  /** number of islands of the last call to solveIslands that have been
+   * solved, the other ones being already converged */
+  unsigned int _numberOfSolvedIslands;
+
+  /** if true, the matrix M of the problem is not assembled, see
+   * setMatrixFree */
+  bool _matrixFree;
+
+  /** the operator computing the products with M in the matrix-free mode */
+  NumericsMatrix* _delassusOperator;
+
 public:
 
   /**
@@ -137,6 +155,58 @@ public:
    */
   void updateMu();
 
+  /** solve the islands of the index set (see Topology::computeIslands)
+   * as independent problems in compute
+   * \param val true to solve by islands
+   */
+  inline void setSolveByIslands(bool val)
+  {
+    _solveByIslands = val;
+  }
+
+  /** \return true if the islands are solved as independent problems */
+  inline bool solveByIslands() const
+  {
+    return _solveByIslands;
+  }
+
+  /** \return the number of islands of the last call to solveIslands */
+  inline unsigned int numberOfIslands() const
+  {
+    return _numberOfIslands;
+  }
+
+  /** \return the number of islands solved in the last call to
+   * solveIslands, the other ones being already converged */
+  inline unsigned int numberOfSolvedIslands() const
+  {
+    return _numberOfSolvedIslands;
+  }
+
+  /** do not assemble the matrix M = H W^{-1} H^T of the problem: the
+   * solver gets instead a matrix-free operator (see NM_create_operator)
+   * computing its products by blocks of the interactions, with the
+   * factorized iteration matrices W of the dynamical systems, and only
+   * the diagonal blocks of M are computed. The memory is then linear in
+   * the number of contacts instead of the number of pairs of contacts
+   * sharing a dynamical system.
+   * Only the solvers using the products with M can be used (FPP, EG,
+   * VI_FPP, VI_EG, HP and ADMM), with Lagrangian or NewtonEuler
+   * relations and MoreauJeanOSI-like integrators. This must be set
+   * before the initialization of the simulation.
+   * \param val true for the matrix-free mode
+   */
+  inline void setMatrixFree(bool val)
+  {
+    _matrixFree = val;
+  }
+
+  /** \return true if the matrix of the problem is not assembled */
+  inline bool matrixFree() const
+  {
+    return _matrixFree;
+  }
+
   /** set the driver-function used to solve the problem
       \param newFunction function of prototype Driver
   */
@@ -162,12 +232,37 @@ public:
    */
   FrictionContactProblem *frictionContactProblemPtr();
 
+  /** initialize the _M matrix, without storage in the matrix-free mode */
+  virtual void initOSNSMatrix();
+
+  /** compute the interaction blocks, only the diagonal ones in the
+   * matrix-free mode */
+  virtual void updateInteractionBlocks();
+
+  /** fill the matrix M, or build its operator in the matrix-free mode
+   * \param indexSet the index set of the problem
+   */
+  virtual void updateOSNSMatrix(InteractionsGraph& indexSet);
+
   /** solve a friction contact problem
    * \param problem the friction contact problem
    * \return info solver information result
    */
   int solve(SP::FrictionContactProblem problem = SP::FrictionContactProblem());
 
+  /** solve the friction contact problem island by island: the contacts
+   * of different islands are not coupled, so that the problem of each
+   * island is independent and better conditioned than the whole one. The
+   * islands are solved concurrently (OpenMP), with a copy of the solver
+   * options per thread. An island is not solved if the current
+   * reactions, i.e. the ones of the last step when they are kept,
+   * already satisfy the tolerance of the solver: this is the case of
+   * the islands at rest. The matrix must be dense or sparse block,
+   * otherwise the whole problem is solved.
+   * \return the largest solver information result of the islands
+   */
+  int solveIslands();
+
   /** Compute the unknown reaction and velocity and update the Interaction (y and lambda )
    *  \param time the current time
    *  \return int information about the solver convergence (0: ok, >0 problem, see Numerics documentation)
@@ -89,6 +89,15 @@ public:
    */
   virtual void computeDiagonalInteractionBlock(const InteractionsGraph::VDescriptor& vd);
 
+  /** the numerics problems are added while computing the diagonal blocks,
+   * in the order of the vertices
+   * \return false
+   */
+  virtual bool hasReentrantInteractionBlocks() const
+  {
+    return false;
+  }
+
   /** print the data to the screen */
   void display() const;
   
@@ -38,6 +38,11 @@ public:
    * the Newton loop. */
   virtual void updateInteractions(SP::Simulation simulation) {}
 
+  /** Called by Simulation once the Interactions added by
+   * updateInteractions have been initialized, e.g. to set their
+   * initial state. */
+  virtual void initializeInteractions(SP::Simulation simulation) {}
+
   /** Specify a non-smooth law to use for a given combination of
    *  interaction groups.
    * \param nslaw the new nonsmooth law
@@ -43,6 +43,8 @@
 
 #include "Tools.hpp"
 
+#include <set>
+
 using namespace RELATION;
 // #define DEBUG_NOCOLOR
 // #define DEBUG_STDOUT
@@ -139,6 +141,77 @@ void LinearOSNS::initialize(SP::Simulation sim)
 
 }
 
+/* Tell whether the block computations solve with the OSI matrix of a ds,
+ * mirroring the branches of computeDiagonalInteractionBlock and
+ * computeInteractionBlock. D1MinusLinearOSI and ZeroOrderHoldOSI return a
+ * fresh copy of their matrix on each call, there is nothing to share. */
+static bool solvesWithOSIMatrix(OSI::TYPES osiType, Type::Siconos dsType,
+                                RELATION::TYPES relationType)
+{
+  if (osiType == OSI::D1MINUSLINEAROSI || osiType == OSI::ZOHOSI)
+    return false;
+  if (relationType == FirstOrder)
+    return true;
+  if (relationType == Lagrangian || relationType == NewtonEuler)
+    return !(osiType == OSI::MOREAUJEANBILBAOOSI || dsType == Type::LagrangianLinearDiagonalDS);
+  return false;
+}
+
+void LinearOSNS::prepareInteractionBlocks(InteractionsGraph& indexSet)
+{
+  // PLUForwardBackwardInPlace factorizes the OSI matrix on its first call.
+  // Do it here once for all, the block computations then only read it.
+  DynamicalSystemsGraph& DSG0 = *simulation()->nonSmoothDynamicalSystem()->dynamicalSystems();
+  std::set<SP::DynamicalSystem> done;
+
+  InteractionsGraph::VIterator vi, viend;
+  for (std11::tie(vi, viend) = indexSet.vertices(); vi != viend; ++vi)
+  {
+    RELATION::TYPES relationType = indexSet.bundle(*vi)->relation()->getType();
+    SP::DynamicalSystem ds[2] = { indexSet.properties(*vi).source,
+                                  indexSet.properties(*vi).target };
+    for (unsigned int i = 0; i < 2; ++i)
+    {
+      if (done.count(ds[i])) continue;
+      OneStepIntegrator& osi = *DSG0.properties(DSG0.descriptor(ds[i])).osi;
+      if (solvesWithOSIMatrix(osi.getType(), Type::value(*ds[i]), relationType))
+      {
+        SP::SimpleMatrix W = getOSIMatrix(osi, ds[i]);
+        if (!W->isPLUFactorized())
+          W->PLUFactorizationInPlace();
+        done.insert(ds[i]);
+      }
+    }
+  }
+
+  // Edges carry the common ds of two interactions, and are only computed
+  // in the FirstOrder/FirstOrder and mechanical cases.
+  InteractionsGraph::EIterator ei, eiend;
+  for (std11::tie(ei, eiend) = indexSet.edges(); ei != eiend; ++ei)
+  {
+    SP::DynamicalSystem ds = indexSet.bundle(*ei);
+    if (done.count(ds)) continue;
+    RELATION::TYPES relationType1 = indexSet.bundle(indexSet.source(*ei))->relation()->getType();
+    RELATION::TYPES relationType2 = indexSet.bundle(indexSet.target(*ei))->relation()->getType();
+    RELATION::TYPES relationType;
+    if (relationType1 == FirstOrder && relationType2 == FirstOrder)
+      relationType = FirstOrder;
+    else if (relationType1 == Lagrangian || relationType2 == Lagrangian ||
+             relationType1 == NewtonEuler || relationType2 == NewtonEuler)
+      relationType = Lagrangian;
+    else
+      continue;
+    OneStepIntegrator& osi = *DSG0.properties(DSG0.descriptor(ds)).osi;
+    if (solvesWithOSIMatrix(osi.getType(), Type::value(*ds), relationType))
+    {
+      SP::SimpleMatrix W = getOSIMatrix(osi, ds);
+      if (!W->isPLUFactorized())
+        W->PLUFactorizationInPlace();
+      done.insert(ds);
+    }
+  }
+}
+
 void LinearOSNS::computeDiagonalInteractionBlock(const InteractionsGraph::VDescriptor& vd)
 {
   DEBUG_BEGIN("LinearOSNS::computeDiagonalInteractionBlock(const InteractionsGraph::VDescriptor& vd)\n");
@@ -704,6 +777,14 @@ void LinearOSNS::computeq(double time)
 
 
 
+void LinearOSNS::updateOSNSMatrix(InteractionsGraph& indexSet)
+{
+  //    _M->fill(indexSet);
+  _M->fillW(indexSet, !_hasBeenUpdated);
+  DEBUG_EXPR(_M->display(););
+  _sizeOutput = _M->size();
+}
+
 bool LinearOSNS::preCompute(double time)
 {
   DEBUG_BEGIN("bool LinearOSNS::preCompute(double time)\n");
@@ -744,12 +825,7 @@ bool LinearOSNS::preCompute(double time)
     // Computes new _interactionBlocks if required
     updateInteractionBlocks();
 
-    //    _M->fill(indexSet);
-    _M->fillW(indexSet, !_hasBeenUpdated);
-    DEBUG_EXPR(_M->display(););
-
-    //      updateOSNSMatrix();
-    _sizeOutput = _M->size();
+    updateOSNSMatrix(indexSet);
 
     // Checks z and _w sizes and reset if necessary
 
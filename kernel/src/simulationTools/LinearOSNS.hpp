@@ -221,6 +221,21 @@ public:
    */
   virtual void computeDiagonalInteractionBlock(const InteractionsGraph::VDescriptor& vd);
 
+  /** blocks of a LinearOSNS only depend on their own interactions and on
+   * read-only OSI matrices, they can be computed concurrently
+   * \return true
+   */
+  virtual bool hasReentrantInteractionBlocks() const
+  {
+    return true;
+  }
+
+  /** factorize the OSI matrices that are solved with when computing the
+   * blocks, so that the (possibly concurrent) block computations only read them
+   * \param indexSet the index set whose blocks are about to be computed
+   */
+  virtual void prepareInteractionBlocks(InteractionsGraph& indexSet);
+
   /** To compute a part of the "q" vector of the OSNS
       \param vertex, vertex (interaction) which corresponds to the considered block
       \param pos the position of the first element of yOut to be set
@@ -232,6 +247,12 @@ public:
    */
   virtual void computeq(double time);
 
+  /** fill the matrix M of the problem with the interaction blocks and
+   * update the size of the problem
+   * \param indexSet the index set of the problem
+   */
+  virtual void updateOSNSMatrix(InteractionsGraph& indexSet);
+
   /** build problem coefficients (if required)
       \param time the current time
       \return true if succeeded
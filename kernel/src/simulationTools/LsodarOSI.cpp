@@ -78,6 +78,9 @@ LsodarOSI::LsodarOSI():
   _itol=1;
   _intData.resize(9);
   for(int i = 0; i < 9; i++) _intData[i] = 0;
+  _intData[8] = 2; // jt, internally generated full jacobian
+  _jacobianMl = -1;
+  _jacobianMu = -1;
   _sizeMem = 2;
   _steps=1;
 
@@ -172,6 +175,117 @@ void LsodarOSI::updateData()
 
 }
 
+/* lower and upper half-bandwidths of the nonzero pattern of J */
+static void patternBandwidths(const SiconosMatrix& J, integer& ml, integer& mu)
+{
+  ml = 0;
+  mu = 0;
+  for(unsigned int j = 0; j < J.size(1); ++j)
+    for(unsigned int i = 0; i < J.size(0); ++i)
+      if(J.getValue(i, j) != 0.0)
+      {
+        ml = std::max(ml, (integer)i - (integer)j);
+        mu = std::max(mu, (integer)j - (integer)i);
+      }
+}
+
+bool LsodarOSI::_computeJacobianBandwidths(integer& ml, integer& mu)
+{
+  ml = 0;
+  mu = 0;
+  bool known = true;
+  DynamicalSystemsGraph::VIterator dsi, dsend;
+  for(std11::tie(dsi, dsend) = _dynamicalSystemsGraph->vertices(); dsi != dsend; ++dsi)
+  {
+    if(!checkOSI(dsi)) continue;
+    DynamicalSystem& ds = *_dynamicalSystemsGraph->bundle(*dsi);
+    Type::Siconos dsType = Type::value(ds);
+    // the jacobian of the linear time invariant systems is constant
+    if((dsType == Type::FirstOrderLinearTIDS || dsType == Type::LagrangianLinearTIDS)
+       && ds.jacobianRhsx())
+    {
+      integer dsMl, dsMu;
+      ds.computeJacobianRhsx(_simulation->startingTime());
+      patternBandwidths(*ds.jacobianRhsx(), dsMl, dsMu);
+      ml = std::max(ml, dsMl);
+      mu = std::max(mu, dsMu);
+    }
+    else
+      known = false;
+  }
+  if(_jacobianMl >= 0) ml = _jacobianMl;
+  if(_jacobianMu >= 0) mu = _jacobianMu;
+  if(_jacobianMl >= 0 && _jacobianMu >= 0) known = true;
+  DEBUG_PRINTF("LsodarOSI::_computeJacobianBandwidths ml = %i, mu = %i, known = %i\n", (int)ml, (int)mu, known);
+  return known;
+}
+
+void LsodarOSI::_updateWorkArrays()
+{
+  // 1 - Neq; x vector size.
+  _intData[0] = _xWork->size();
+  integer neq = _intData[0];
+  bool banded = (_intData[8] == 4 || _intData[8] == 5);
+  integer ml = 0, mu = 0;
+  if(banded && !_computeJacobianBandwidths(ml, mu))
+  {
+    // no band is known for these systems, use the full jacobian
+    // (user-supplied or internally generated as for jt = 4 or 5)
+    _intData[8] = (_intData[8] == 4) ? 1 : 2;
+    banded = false;
+  }
+  if(banded)
+  {
+    ml = std::min(ml, neq - 1);
+    mu = std::min(mu, neq - 1);
+    // 5 - lrw, size of rwork
+    _intData[6] = 22 + neq * std::max(16, (int)(2 * ml + mu) + 10) + 3 * _intData[1];
+  }
+  else
+  {
+    // 5 - lrw, size of rwork
+    _intData[6] = 22 + neq * std::max(16, (int)neq + 9) + 3 * _intData[1];
+  }
+  // 6 - liw, size of iwork
+  _intData[7] = 20 + neq;
+
+  // memory allocation for doublereal*, according to _intData values
+  updateData();
+
+  if(banded)
+  {
+    iwork[0] = ml;
+    iwork[1] = mu;
+  }
+}
+
+void LsodarOSI::copyJacobianBlock(const SiconosMatrix& J, unsigned int pos, doublereal* jacob) const
+{
+  int n = J.size(0);
+  if(_intData[8] == 4)
+  {
+    // df(i)/dx(j) is stored at (i-j+mu, j), with 2*ml+mu+1 rows
+    int ml = iwork[0], mu = iwork[1];
+    int nrowpd = 2 * ml + mu + 1;
+    for(int j = 0; j < n; ++j)
+    {
+      doublereal* column = jacob + (pos + j) * nrowpd + mu - j;
+      for(int i = std::max(0, j - mu); i <= std::min(n - 1, j + ml); ++i)
+        column[i] = J.getValue(i, j);
+    }
+  }
+  else
+  {
+    int neq = _intData[0];
+    for(int j = 0; j < n; ++j)
+    {
+      doublereal* column = jacob + (pos + j) * neq + pos;
+      for(int i = 0; i < n; ++i)
+        column[i] = J.getValue(i, j);
+    }
+  }
+}
+
 void LsodarOSI::fillXWork(integer* sizeOfX, doublereal* x)
 {
   assert((unsigned int)(*sizeOfX) == _xWork->size() && "LsodarOSI::fillXWork xWork and sizeOfX have different sizes");
@@ -276,16 +390,7 @@ void LsodarOSI::initializeWorkVectorsForDS( double t, SP::DynamicalSystem ds)
   ds->swapInMemory();
 
   // Update necessary data
-
-  // 1 - Neq; x vector size.
-  _intData[0] = _xWork->size();
-  // 5 - lrw, size of rwork
-  _intData[6] = 22 + _intData[0] * std::max(16, (int)_intData[0] + 9) + 3 * _intData[1];
-  // 6 - liw, size of iwork
-  _intData[7] = 20 + _intData[0];
-
-  // memory allocation for doublereal*, according to _intData values
-  updateData();
+  _updateWorkArrays();
 
   _xtmp.reset(new SiconosVector(_xWork->size()));
 
@@ -433,6 +538,10 @@ void LsodarOSI::initialize()
   _intData[3] = 1; // itask, an index specifying the task to be performed. 1: normal computation.
   _intData[5] = 0; // iopt: 0 if no optional input else 1.
 
+  // sizes of the work arrays, with ng and the bandwidths of the jacobian
+  if(_xWork)
+    _updateWorkArrays();
+
   // 4 - Istate
   _intData[4] = 1; // istate, an index used for input and output to specify the state of the calculation.
   // On input:
@@ -449,8 +558,7 @@ void LsodarOSI::initialize()
 
 
 
-  // 7 - JT, Jacobian type indicator
-  _intData[8] = 2;   // jt, Jacobian type indicator.
+  // 7 - JT, Jacobian type indicator (default 2, see setJT)
   //           1 means a user-supplied full (NEQ by NEQ) Jacobian.
   //           2 means an internally generated (difference quotient) full Jacobian (using NEQ extra calls to f per df/dx value).
   //           4 means a user-supplied banded Jacobian.
@@ -34,8 +34,12 @@
  * in externals/odepack/opkdmain.f to have a full description of these parameters.  \n
  * Most of them are read-only parameters (ie can not be set by user). \n
  *  Except: \n
- *  - jt: Jacobian type indicator (1 means a user-supplied full Jacobian, 2 means an internally generated full Jacobian). \n
- *    Default = 2.
+ *  - jt: Jacobian type indicator (1 means a user-supplied full Jacobian, 2 means an internally generated full Jacobian,
+ *    4 and 5 the banded equivalents). \n
+ *    Default = 2. The user-supplied jacobians are assembled from the jacobianRhsx of the dynamical systems,
+ *    coupling between dynamical systems being neglected. \n
+ *  - ml, mu: lower and upper half-bandwidths of the banded jacobians. By default, the bandwidths of the
+ *    jacobianRhsx of the linear time invariant systems and the full blocks of the other systems.
  *  - itol, rtol and atol \n
  *    ITOL   = an indicator for the type of error control. \n
  *    RTOL   = a relative error tolerance parameter, either a scalar or array of length NEQ. \n
@@ -73,6 +77,23 @@ private:
   SP::BlockVector _xWork;
 
   SP::SiconosVector _xtmp;
+
+  /** lower and upper half-bandwidths of the jacobian set by the user
+   * (negative: computed from the dynamical systems) */
+  integer _jacobianMl;
+  integer _jacobianMu;
+
+  /** compute the sizes of the work arrays and allocate them */
+  void _updateWorkArrays();
+
+  /** compute the half-bandwidths of the jacobian from the dynamical
+   * systems
+   * \param[out] ml the lower half-bandwidth
+   * \param[out] mu the upper half-bandwidth
+   * \return false if the band is not known, i.e. not set by
+   * setJacobianBandwidths and some systems are not linear time invariant
+   */
+  bool _computeJacobianBandwidths(integer& ml, integer& mu);
   /** nslaw effects
    */
   struct _NSLEffectOnFreeOutput;
@@ -189,6 +210,23 @@ public:
     _intData[8] = newJT;
   };
 
+  /** set the lower and upper half-bandwidths of the banded jacobians
+   *  (jt = 4 or 5). df(i)/dx(j) is neglected if i-j > ml or j-i > mu.
+   *  Must be called before the initialization of the simulation.
+   *  Without them, the band is computed for linear time invariant
+   *  systems only, and the full jacobian (jt = 1 or 2) is used for the
+   *  other ones.
+   *  \param ml the lower half-bandwidth, negative to compute it from the
+   *  dynamical systems
+   *  \param mu the upper half-bandwidth, negative to compute it from the
+   *  dynamical systems
+   */
+  inline void setJacobianBandwidths(integer ml, integer mu)
+  {
+    _jacobianMl = ml;
+    _jacobianMu = mu;
+  };
+
   /** set itol, rtol and atol (tolerance parameters for lsodar)
    *  \param newItol itol value
    *  \param newRtol rtol value
@@ -241,6 +279,15 @@ public:
    */
   void computeJacobianRhs(double t, DynamicalSystemsGraph& DSG0);
 
+  /** copy the jacobian of the rhs of a dynamical system into the
+   *  jacobian given to lsodar (user-supplied full or banded jacobian,
+   *  jt = 1 or 4). The entries out of the band are neglected.
+   *  \param J the jacobian of the rhs of the dynamical system
+   *  \param pos the position of the state of the dynamical system in x
+   *  \param jacob the jacobian given to lsodar
+   */
+  void copyJacobianBlock(const SiconosMatrix& J, unsigned int pos, doublereal* jacob) const;
+
   void f(integer* sizeOfX, doublereal* time, doublereal* x, doublereal* xdot);
 
   void g(integer* nEq, doublereal* time, doublereal* x, integer* ng, doublereal* gOut);
@@ -131,6 +131,15 @@ public:
    */
   virtual void computeDiagonalInteractionBlock(const InteractionsGraph::VDescriptor& vd);
 
+  /** the block structure of the problem is built while computing the
+   * diagonal blocks, in the order of the vertices
+   * \return false
+   */
+  virtual bool hasReentrantInteractionBlocks() const
+  {
+    return false;
+  }
+
   /** Pre compute 
    * \param time current time
    * \return bool
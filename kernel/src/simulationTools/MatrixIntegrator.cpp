@@ -25,6 +25,7 @@
 #include "TimeDiscretisation.hpp"
 #include "NonSmoothDynamicalSystem.hpp"
 #include "EventsManager.hpp"
+#include "AlgebraTools.hpp"
 
 //#define DEBUG_WHERE_MESSAGES
 
@@ -34,7 +35,8 @@
 
 #include <debug.h>
 
-MatrixIntegrator::MatrixIntegrator(const DynamicalSystem& ds, const NonSmoothDynamicalSystem& nsds, const  TimeDiscretisation & td, SP::SiconosMatrix E): _E(E)
+MatrixIntegrator::MatrixIntegrator(const DynamicalSystem& ds, const NonSmoothDynamicalSystem& nsds, const  TimeDiscretisation & td, SP::SiconosMatrix E):
+  _E(E), _closedForm(false), _h(0.), _k(0)
 {
   commonInit(ds, nsds, td);
   _mat.reset(new SimpleMatrix(*E));
@@ -42,7 +44,7 @@ MatrixIntegrator::MatrixIntegrator(const DynamicalSystem& ds, const NonSmoothDyn
 }
 
 MatrixIntegrator::MatrixIntegrator(const DynamicalSystem& ds, const NonSmoothDynamicalSystem& nsds, const TimeDiscretisation & td, SP::PluggedObject plugin, const unsigned int p):
-  _plugin(plugin)
+  _plugin(plugin), _closedForm(false), _h(0.), _k(0)
 {
   commonInit(ds, nsds, td);
   unsigned int n = ds.n();
@@ -52,7 +54,8 @@ MatrixIntegrator::MatrixIntegrator(const DynamicalSystem& ds, const NonSmoothDyn
   _isConst = false;
 }
 
-MatrixIntegrator::MatrixIntegrator(const DynamicalSystem& ds, const NonSmoothDynamicalSystem& nsds, const  TimeDiscretisation & td)
+MatrixIntegrator::MatrixIntegrator(const DynamicalSystem& ds, const NonSmoothDynamicalSystem& nsds, const  TimeDiscretisation & td):
+  _closedForm(false), _h(0.), _k(0)
 {
   unsigned int n = ds.n();
   _mat.reset(new SimpleMatrix(n, n, 0));
@@ -71,6 +74,7 @@ void MatrixIntegrator::commonInit(const DynamicalSystem& ds, const NonSmoothDyna
   {
      _DS.reset(new FirstOrderLinearTIDS(static_cast<const FirstOrderLinearTIDS&>(ds)));
      _isConst = _TD->hConst();
+     _closedForm = !_plugin;
   }
   else if (dsType == Type::FirstOrderLinearDS)
   {
@@ -82,10 +86,19 @@ void MatrixIntegrator::commonInit(const DynamicalSystem& ds, const NonSmoothDyna
        std11::static_pointer_cast<FirstOrderLinearDS>(_DS)->setPluginA(cfolds.getPluginA());
      }
      _isConst = (_TD->hConst()) && !(cfolds.getPluginA()->isPlugged()) ? true : false;
+     _closedForm = !_plugin && !(cfolds.getPluginA()->isPlugged());
   }
 
   _DS->setNumber(9999999);
   DEBUG_EXPR(_DS->display(););
+
+  // with A and E constant (and no mass matrix), _mat is given by a matrix
+  // exponential
+  if (std11::static_pointer_cast<FirstOrderLinearDS>(_DS)->M())
+    _closedForm = false;
+  if (_closedForm)
+    return;
+
   // integration stuff
   _nsds.reset(new NonSmoothDynamicalSystem());
   _nsds->sett0(nsds.t0());
@@ -102,9 +115,54 @@ void MatrixIntegrator::commonInit(const DynamicalSystem& ds, const NonSmoothDyna
 
 }
 
+void MatrixIntegrator::computeExponential(double h)
+{
+  unsigned int n = _DS->n();
+  SP::SiconosMatrix A = static_cast<FirstOrderLinearDS&>(*_DS).A();
+  if (!_E)
+  {
+    // _mat = exp(Ah)
+    SimpleMatrix Ah(n, n, 0);
+    if (A)
+      Ah = h * *A;
+    Siconos::algebra::tools::expm(Ah, *_mat);
+  }
+  else
+  {
+    // Van Loan: exp([A E; 0 0]h) = [exp(Ah) int_0^h exp(A tau)E dtau; 0 I]
+    unsigned int p = _E->size(1);
+    SimpleMatrix M(n + p, n + p, 0);
+    SimpleMatrix expM(n + p, n + p);
+    for (unsigned int i = 0; i < n; i++)
+    {
+      if (A)
+        for (unsigned int j = 0; j < n; j++)
+          M(i, j) = h * (*A)(i, j);
+      for (unsigned int j = 0; j < p; j++)
+        M(i, n + j) = h * (*_E)(i, j);
+    }
+    Siconos::algebra::tools::expm(M, expM);
+    for (unsigned int i = 0; i < n; i++)
+      for (unsigned int j = 0; j < p; j++)
+        (*_mat)(i, j) = expM(i, n + j);
+  }
+  _h = h;
+}
+
 void MatrixIntegrator::integrate()
 {
   DEBUG_BEGIN("MatrixIntegrator::integrate()\n");
+  if (_closedForm)
+  {
+    // as the integration of the ODE, each call covers the next time step
+    double h = _TD->currentTimeStep(_k++);
+    if (h != _h)
+      computeExponential(h);
+    DEBUG_EXPR(_mat->display(););
+    DEBUG_END("MatrixIntegrator::integrate()\n");
+    return;
+  }
+
   SiconosVector& x0 = *_DS->x0();
   SiconosVector& x = *_DS->x();
 
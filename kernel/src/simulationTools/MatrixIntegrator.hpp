@@ -53,6 +53,16 @@ protected:
   /** flag to indicate where the Matrix _mat is constant */
   bool _isConst;
 
+  /** flag to indicate whether _mat is computed with a matrix exponential
+   * (A and E constant) instead of integrating the ODE */
+  bool _closedForm;
+
+  /** time step of the last value of _mat computed with a matrix exponential */
+  double _h;
+
+  /** index of the next time step */
+  unsigned int _k;
+
   /** DynamicalSystem to integrate */
   SP::DynamicalSystem _DS;
 
@@ -71,8 +81,14 @@ protected:
   /** */
   void commonInit(const DynamicalSystem& ds, const NonSmoothDynamicalSystem& nsds, const TimeDiscretisation & td);
 
+  /** Computes _mat with the matrix exponential of A (and the block
+   * matrix of Van Loan for \f$\int exp(A\tau)E\mathrm{d}\tau\f$)
+   * \param h the time step
+   */
+  void computeExponential(double h);
+
   /** Default constructor */
-  MatrixIntegrator() {};
+  MatrixIntegrator(): _closedForm(false), _h(0.), _k(0) {};
 
 public:
 
@@ -100,7 +116,10 @@ public:
    */
   MatrixIntegrator(const DynamicalSystem& ds,const NonSmoothDynamicalSystem& nsds, const TimeDiscretisation &td);
 
-  /** Computes the next value of _mat */
+  /** Computes the next value of _mat, over the next time step. If A and E
+   * are constant, _mat is given by a matrix exponential, which is only
+   * computed again when the time step changes. Otherwise the ODE is
+   * integrated with LsodarOSI, column by column. */
   void integrate();
 
   /** Get the value of _mat, solution of the ODE
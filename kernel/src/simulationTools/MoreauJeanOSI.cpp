@@ -57,7 +57,8 @@ template <typename T> static std11::shared_ptr<T> ptr(const T& a) {
 
 // --- constructor from a set of data ---
 MoreauJeanOSI::MoreauJeanOSI(double theta, double gamma):
-  OneStepIntegrator(OSI::MOREAUJEANOSI), _useGammaForRelation(false),_explicitNewtonEulerDSOperators(false)
+  OneStepIntegrator(OSI::MOREAUJEANOSI), _useGammaForRelation(false),_explicitNewtonEulerDSOperators(false),
+  _useNewtonEulerDSPool(false), _cacheW(true), _WTimeStep(0.0), _WTheta(theta)
 {
   _levelMinForOutput= 0;
   _levelMaxForOutput =1;
@@ -299,27 +300,67 @@ void MoreauJeanOSI::initializeIterationMatrixW(double time, SP::DynamicalSystem
     else
     {
       _dynamicalSystemsGraph->properties(dsv).W.reset(new SimpleMatrix(sizeW, sizeW));
-      _dynamicalSystemsGraph->properties(dsv).W->eye();
     }
+    _computeConstantW(*ds, dsv);
+  }
+  else if(dsType == Type::LagrangianLinearDiagonalDS)
+  {
+    unsigned int ndof = ds->dimension();
+    _dynamicalSystemsGraph->properties(dsv).W.reset(new SimpleMatrix(ndof, ndof, Siconos::BANDED, 0, 0));
+    _computeConstantW(*ds, dsv);
+  }
 
-    SP::SiconosMatrix K = d->K();
-    SP::SiconosMatrix C = d->C();
-    SP::SiconosMatrix W = _dynamicalSystemsGraph->properties(dsv).W;
-    if(C)
-      scal(h * _theta, *C, *W, false); // W += h*_theta *C
-    if(K)
-      scal(h * h * _theta * _theta, *K, *W, false); // W = h*h*_theta*_theta*K
+  // === ===
+  else if(dsType == Type::NewtonEulerDS)
+  {
+    NewtonEulerDS& d = static_cast<NewtonEulerDS&> (*ds);
+    _dynamicalSystemsGraph->properties(dsv).W.reset(new SimpleMatrix(*d.mass()));
+
+    computeW(time, d, *_dynamicalSystemsGraph->properties(dsv).W);
 
     // WBoundaryConditions initialization
-    if(d->boundaryConditions())
-      _initializeIterationMatrixWBoundaryConditions(*d,dsv);
+    if(d.boundaryConditions())
+      _initializeIterationMatrixWBoundaryConditions(*ds,dsv);
+
+  }
+  else RuntimeException::selfThrow("MoreauJeanOSI::initializeIterationMatrixW - not yet implemented for Dynamical system of type : " + Type::name(*ds));
+
+  _WTimeStep = h;
+  _WTheta = _theta;
+
+  // Remark: W is not LU-factorized nor inversed here.
+  // Function PLUForwardBackward will do that if required.
+  DEBUG_END("MoreauJeanOSI::initializeIterationMatrixW\n");
+}
+
+void MoreauJeanOSI::_computeConstantW(DynamicalSystem& ds, const DynamicalSystemsGraph::VDescriptor& dsv)
+{
+  DEBUG_BEGIN("MoreauJeanOSI::_computeConstantW\n");
+  double h = _simulation->timeStep();
+  Type::Siconos dsType = Type::value(ds);
+  SiconosMatrix& W = *_dynamicalSystemsGraph->properties(dsv).W;
+  SP::BoundaryCondition bc;
+
+  if(dsType == Type::LagrangianLinearTIDS)
+  {
+    LagrangianLinearTIDS& d = static_cast<LagrangianLinearTIDS&> (ds);
+    if(d.mass())
+      W = *d.mass();
+    else
+      W.eye();
+
+    SP::SiconosMatrix K = d.K();
+    SP::SiconosMatrix C = d.C();
+    if(C)
+      scal(h * _theta, *C, W, false); // W += h*_theta *C
+    if(K)
+      scal(h * h * _theta * _theta, *K, W, false); // W = h*h*_theta*_theta*K
+    bc = d.boundaryConditions();
   }
   else if(dsType == Type::LagrangianLinearDiagonalDS)
   {
-    LagrangianLinearDiagonalDS& lldds = static_cast<LagrangianLinearDiagonalDS&> (*ds);
+    LagrangianLinearDiagonalDS& lldds = static_cast<LagrangianLinearDiagonalDS&> (ds);
     unsigned int ndof = lldds.dimension();
-    _dynamicalSystemsGraph->properties(dsv).W.reset(new SimpleMatrix(ndof, ndof, Siconos::BANDED, 0, 0));
-    SiconosMatrix& W = *_dynamicalSystemsGraph->properties(dsv).W;
 
     if(lldds.mass())
       W = *lldds.mass();
@@ -345,34 +386,37 @@ void MoreauJeanOSI::initializeIterationMatrixW(double time, SP::DynamicalSystem
         W(i, i) += h2theta2 * K(i);
       }
     }
-    // WBoundaryConditions initialization
-    if(lldds.boundaryConditions())
-      _initializeIterationMatrixWBoundaryConditions(lldds, dsv);
-
-    for(unsigned int i=0;i<ndof;++i)
-    {
-      W(i, i) = 1. / W(i, i);
-    }
+    bc = lldds.boundaryConditions();
   }
-
-  // === ===
   else if(dsType == Type::NewtonEulerDS)
   {
-    NewtonEulerDS& d = static_cast<NewtonEulerDS&> (*ds);
-    _dynamicalSystemsGraph->properties(dsv).W.reset(new SimpleMatrix(*d.mass()));
-
-    computeW(time, d, *_dynamicalSystemsGraph->properties(dsv).W);
-
-    // WBoundaryConditions initialization
-    if(d.boundaryConditions())
-      _initializeIterationMatrixWBoundaryConditions(*ds,dsv);
+    // without jacobians of the forces, W is the mass matrix
+    NewtonEulerDS& d = static_cast<NewtonEulerDS&> (ds);
+    W = *d.mass();
+    bc = d.boundaryConditions();
+    _computeNewtonEulerDSInverseMass(d, dsv);
+  }
+  else RuntimeException::selfThrow("MoreauJeanOSI::_computeConstantW - W depends on the state for Dynamical system of type : " + Type::name(ds));
 
+  // WBoundaryConditions initialization
+  if(bc)
+  {
+    SP::SimpleMatrix WBoundaryConditions = _dynamicalSystemsGraph->properties(dsv).WBoundaryConditions;
+    if(!WBoundaryConditions)
+      _initializeIterationMatrixWBoundaryConditions(ds, dsv);
+    else
+      _computeWBoundaryConditions(ds, *WBoundaryConditions, W);
   }
-  else RuntimeException::selfThrow("MoreauJeanOSI::initializeIterationMatrixW - not yet implemented for Dynamical system of type : " + Type::name(*ds));
 
-  // Remark: W is not LU-factorized nor inversed here.
-  // Function PLUForwardBackward will do that if required.
-  DEBUG_END("MoreauJeanOSI::initializeIterationMatrixW\n");
+  // W is diagonal and contains the inverse of the iteration matrix
+  if(dsType == Type::LagrangianLinearDiagonalDS)
+  {
+    for(unsigned int i=0;i<ds.dimension();++i)
+    {
+      W(i, i) = 1. / W(i, i);
+    }
+  }
+  DEBUG_END("MoreauJeanOSI::_computeConstantW\n");
 }
 
 
@@ -555,6 +599,95 @@ void MoreauJeanOSI::computeW(double t, DynamicalSystem& ds, SiconosMatrix& W)
   // Function PLUForwardBackward will do that if required.
 }
 
+/* 0 if the iteration matrix W of ds depends on the state, otherwise a
+ * positive number that changes with the data W is computed from */
+static unsigned int constantWVersion(DynamicalSystem& ds)
+{
+  Type::Siconos dsType = Type::value(ds);
+  if(dsType == Type::LagrangianLinearTIDS || dsType == Type::LagrangianLinearDiagonalDS)
+    return 1;
+  if(dsType == Type::NewtonEulerDS)
+  {
+    NewtonEulerDS& d = static_cast<NewtonEulerDS&> (ds);
+    if(d.hasNullJacobiansOfForces())
+      return d.massVersion() + 1;
+  }
+  return 0;
+}
+
+void MoreauJeanOSI::_updateW(double t, DynamicalSystem& ds, const DynamicalSystemsGraph::VDescriptor& dsv)
+{
+  DEBUG_BEGIN("MoreauJeanOSI::_updateW\n");
+  unsigned int number = ds.number();
+  if(_WVersion.size() <= number)
+    _WVersion.resize(number + 1, 0);
+
+  unsigned int version = constantWVersion(ds);
+  if(!_cacheW || version == 0)
+  {
+    // W may depend on the state: it is computed at each step
+    _WVersion[number] = 0;
+    computeW(t, ds, *_dynamicalSystemsGraph->properties(dsv).W);
+  }
+  else if(_WVersion[number] != version)
+  {
+    // W does not depend on the state: it is computed, and factorized
+    // when needed, only if its data have changed or if it has been
+    // invalidated
+    DEBUG_PRINT("MoreauJeanOSI::_updateW, new constant W\n");
+    _computeConstantW(ds, dsv);
+    _WVersion[number] = version;
+  }
+  DEBUG_END("MoreauJeanOSI::_updateW\n");
+}
+
+void MoreauJeanOSI::_computeNewtonEulerDSInverseMass(NewtonEulerDS& d, const DynamicalSystemsGraph::VDescriptor& dsv)
+{
+  SP::SiconosVector& inverseMass = (*_dynamicalSystemsGraph->properties(dsv).workVectors)[MoreauJeanOSI::INVERSE_MASS];
+  inverseMass.reset();
+  if(!_useNewtonEulerDSPool || d.boundaryConditions())
+    return;
+
+  // inverse of the inertia by its adjugate
+  const SiconosMatrix& I = *d.inertia();
+  double a[9], adj[9];
+  for(unsigned int r = 0; r < 3; ++r)
+    for(unsigned int c = 0; c < 3; ++c)
+      a[3 * r + c] = I.getValue(r, c);
+  adj[0] = a[4] * a[8] - a[5] * a[7];
+  adj[1] = a[2] * a[7] - a[1] * a[8];
+  adj[2] = a[1] * a[5] - a[2] * a[4];
+  adj[3] = a[5] * a[6] - a[3] * a[8];
+  adj[4] = a[0] * a[8] - a[2] * a[6];
+  adj[5] = a[2] * a[3] - a[0] * a[5];
+  adj[6] = a[3] * a[7] - a[4] * a[6];
+  adj[7] = a[1] * a[6] - a[0] * a[7];
+  adj[8] = a[0] * a[4] - a[1] * a[3];
+  double det = a[0] * adj[0] + a[1] * adj[3] + a[2] * adj[6];
+  if(det == 0.0 || !std::isfinite(det) || d.scalarMass() == 0.0)
+    return;
+
+  inverseMass.reset(new SiconosVector(10));
+  double* invM = inverseMass->getArray();
+  invM[0] = 1.0 / d.scalarMass();
+  for(unsigned int l = 0; l < 9; ++l)
+    invM[1 + l] = adj[l] / det;
+}
+
+void MoreauJeanOSI::invalidateW()
+{
+  _WVersion.clear();
+}
+
+void MoreauJeanOSI::invalidateW(SP::DynamicalSystem ds)
+{
+  const DynamicalSystemsGraph::VDescriptor& dsv = _dynamicalSystemsGraph->descriptor(ds);
+  if(!checkOSI(dsv))
+    RuntimeException::selfThrow("MoreauJeanOSI::invalidateW(ds) - ds does not belong to the OSI.");
+  if(ds->number() < _WVersion.size())
+    _WVersion[ds->number()] = 0;
+}
+
 void MoreauJeanOSI::computeInitialNewtonState()
 {
   DEBUG_BEGIN("MoreauJeanOSI::computeInitialNewtonState()\n");
@@ -1161,7 +1294,7 @@ void MoreauJeanOSI::computeFreeState()
       DEBUG_EXPR(vfree.display());
       // -- Update W --
       // Note: during computeW, mass and jacobians of forces will be computed/
-      computeW(t, d, W);
+      _updateW(t, d, *dsi);
       DEBUG_EXPR(W.display(););
       // -- vfree =  v - W^{-1} ResiduFree --
       // At this point vfree = residuFree
@@ -1265,13 +1398,23 @@ void MoreauJeanOSI::computeFreeState()
       SiconosVector& residuFree = *ds_work_vectors[MoreauJeanOSI::RESIDU_FREE];
       SiconosVector& vfree = *ds_work_vectors[MoreauJeanOSI::VFREE];
 
-
-      vfree = residuFree;
-
       // -- Update W --
       // Note: during computeW, mass and jacobians of forces will be computed/
       SimpleMatrix& W = *_dynamicalSystemsGraph->properties(*dsi).W;
-      computeW(t, d, W);
+      _updateW(t, d, *dsi);
+
+      // W is the mass matrix: vfree is computed with the other bodies of the pool
+      if(_useNewtonEulerDSPool && _WVersion[d.number()] && ds_work_vectors[MoreauJeanOSI::INVERSE_MASS])
+      {
+        _newtonEulerDSPool.push_back(residuFree.getArray());
+        _newtonEulerDSPool.push_back(d.twist()->getArray());
+        _newtonEulerDSPool.push_back(vfree.getArray());
+        _newtonEulerDSPool.push_back(ds_work_vectors[MoreauJeanOSI::INVERSE_MASS]->getArray());
+        continue;
+      }
+
+      vfree = residuFree;
+
       const SiconosVector& v = *d.twist(); // v = v_k,i+1
 
       // -- vfree =  v - W^{-1} ResiduFree --
@@ -1295,18 +1438,53 @@ void MoreauJeanOSI::computeFreeState()
       RuntimeException::selfThrow("MoreauJeanOSI::computeFreeState - not yet implemented for Dynamical system of type: " +  Type::name(ds));
 
   }
+
+  if(!_newtonEulerDSPool.empty())
+  {
+    // -- vfree =  v - M^{-1} ResiduFree for the bodies of the pool --
+    const int n = _newtonEulerDSPool.size() / 4;
+    double * const * pool = &_newtonEulerDSPool[0];
+    // the bodies are independent
+#pragma omp parallel for if(n > 1024)
+    for(int i = 0; i < n; ++i)
+    {
+      const double* r = pool[4 * i];
+      const double* v = pool[4 * i + 1];
+      double* vfree = pool[4 * i + 2];
+      const double invm = pool[4 * i + 3][0];
+      const double* invI = pool[4 * i + 3] + 1;
+      vfree[0] = v[0] - invm * r[0];
+      vfree[1] = v[1] - invm * r[1];
+      vfree[2] = v[2] - invm * r[2];
+      vfree[3] = v[3] - (invI[0] * r[3] + invI[1] * r[4] + invI[2] * r[5]);
+      vfree[4] = v[4] - (invI[3] * r[3] + invI[4] * r[4] + invI[5] * r[5]);
+      vfree[5] = v[5] - (invI[6] * r[3] + invI[7] * r[4] + invI[8] * r[5]);
+    }
+    _newtonEulerDSPool.clear();
+  }
   DEBUG_END("MoreauJeanOSI::computeFreeState()\n");
 }
 
 void MoreauJeanOSI::prepareNewtonIteration(double time)
 {
   DEBUG_BEGIN(" MoreauJeanOSI::prepareNewtonIteration(double time)\n");
+  // the time step, difference of two times, varies by rounding errors
+  // from one step to the other: only a relative change larger than
+  // these errors invalidates the cached W
+  double h = _simulation->timeStep();
+  if(fabs(h - _WTimeStep) > 1e-8 * h || _theta != _WTheta)
+  {
+    invalidateW();
+    _WTimeStep = h;
+    _WTheta = _theta;
+  }
+
   DynamicalSystemsGraph::VIterator dsi, dsend;
   for(std11::tie(dsi, dsend) = _dynamicalSystemsGraph->vertices(); dsi != dsend; ++dsi)
   {
     if(!checkOSI(dsi)) continue;
     DynamicalSystem& ds = *_dynamicalSystemsGraph->bundle(*dsi);
-    computeW(time, ds, *_dynamicalSystemsGraph->properties(*dsi).W);
+    _updateW(time, ds, *dsi);
   }
 
   if(!_explicitNewtonEulerDSOperators)
@@ -136,6 +136,33 @@ protected:
    */
   bool _explicitNewtonEulerDSOperators;
 
+  /** a boolean to compute the free velocities of the NewtonEulerDS
+   * whose W is the mass matrix by batches, as a pool
+   */
+  bool _useNewtonEulerDSPool;
+
+  /** for the ds whose W does not depend on the state, indexed by the
+   * number of the ds: the version of the data W is computed from (1,
+   * or 1 + NewtonEulerDS::massVersion) when the cached W was computed,
+   * 0 if W is not cached
+   */
+  std::vector<unsigned int> _WVersion;
+
+  /** pointers to the arrays of the residu free, the twist, the free
+   * velocity and the inverse of the mass of the NewtonEulerDS of the
+   * pool during computeFreeState (4 per ds)
+   */
+  std::vector<double*> _newtonEulerDSPool;
+
+  /** a boolean to keep the iteration matrices W that do not depend on
+   * the state, and their factorization
+   */
+  bool _cacheW;
+
+  /** the time step and theta used for the cached W */
+  double _WTimeStep;
+  double _WTheta;
+
   /** nslaw effects
    */
   struct _NSLEffectOnFreeOutput;
@@ -143,7 +170,9 @@ protected:
 
 public:
 
-  enum MoreauJeanOSI_ds_workVector_id{RESIDU_FREE, VFREE, BUFFER, QTMP, WORK_LENGTH};
+  /** INVERSE_MASS: inverse of the scalar mass and inverse of the
+   *  inertia (row major) of a NewtonEulerDS of the pool */
+  enum MoreauJeanOSI_ds_workVector_id{RESIDU_FREE, VFREE, BUFFER, QTMP, INVERSE_MASS, WORK_LENGTH};
 
   enum MoreauJeanOSI_interaction_workVector_id{OSNSP_RHS,WORK_INTERACTION_LENGTH};
 
@@ -280,6 +309,61 @@ public:
     _explicitNewtonEulerDSOperators = newExplicitNewtonEulerDSOperators;
   };
 
+  /** get boolean _useNewtonEulerDSPool
+   *  \return a Boolean
+   */
+  inline bool useNewtonEulerDSPool()
+  {
+    return _useNewtonEulerDSPool;
+  };
+
+  /** set the boolean to indicate that the free velocities of the
+   *  NewtonEulerDS whose cached W is the mass matrix (see setCacheW),
+   *  without boundary conditions, are computed by batches from the
+   *  inverses of their scalar mass and inertia (default false).
+   *  \param newUseNewtonEulerDSPool a Boolean
+   */
+  inline void setUseNewtonEulerDSPool(bool newUseNewtonEulerDSPool)
+  {
+    _useNewtonEulerDSPool = newUseNewtonEulerDSPool;
+    invalidateW();
+  };
+
+  /** get boolean _cacheW
+   *  \return a Boolean
+   */
+  inline bool cacheW()
+  {
+    return _cacheW;
+  };
+
+  /** set the boolean to indicate that the iteration matrices W are
+   *  cached (default true). The W that do not depend on the state, of
+   *  LagrangianLinearTIDS, LagrangianLinearDiagonalDS and NewtonEulerDS
+   *  without jacobians of the forces (see
+   *  NewtonEulerDS::hasNullJacobiansOfForces), and their PLU
+   *  factorization are kept until the time step or theta change, until
+   *  the mass matrix of the NewtonEulerDS changes, or until a call to
+   *  invalidateW. The W of the other systems are computed at each step.
+   *  \param newCacheW a Boolean
+   */
+  inline void setCacheW(bool newCacheW)
+  {
+    _cacheW = newCacheW;
+    invalidateW();
+  };
+
+  /** force the computation of all the iteration matrices W at the
+   *  next step, for instance after a change of the mass, stiffness or
+   *  damping of a linear system */
+  void invalidateW();
+
+  /** force the computation of the iteration matrix W of a dynamical
+   *  system at the next step
+   *  \param ds the DynamicalSystem
+   */
+  void invalidateW(SP::DynamicalSystem ds);
+
   // --- OTHER FUNCTIONS ---
 
   /** initialization of the MoreauJeanOSI integrator; for linear time
@@ -327,6 +411,33 @@ public:
    */
   void computeW(double time , DynamicalSystem& ds, SiconosMatrix& W);
 
+  /** update the iteration matrix W of a dynamical system at time t,
+   *  with computeW, or only if its data have changed or if it has been
+   *  invalidated if W is cached.
+   *  \param time (double)
+   *  \param ds a DynamicalSystem
+   *  \param dsv a descriptor of the ds on the graph
+   */
+  void _updateW(double time, DynamicalSystem& ds, const DynamicalSystemsGraph::VDescriptor& dsv);
+
+  /** compute the W matrix of the systems for which it does not depend
+   *  on time or on the state (LagrangianLinearTIDS,
+   *  LagrangianLinearDiagonalDS, NewtonEulerDS without jacobians of the
+   *  forces), boundary conditions included.
+   *  \param ds a DynamicalSystem
+   *  \param dsv a descriptor of the ds on the graph
+   */
+  void _computeConstantW(DynamicalSystem& ds, const DynamicalSystemsGraph::VDescriptor& dsv);
+
+  /** compute the inverse of the mass of a NewtonEulerDS whose W is the
+   *  mass matrix in its INVERSE_MASS work vector, or reset it if the ds
+   *  is not in the pool: no pool, boundary conditions, or a singular
+   *  mass.
+   *  \param ds a NewtonEulerDS
+   *  \param dsv a descriptor of the ds on the graph
+   */
+  void _computeNewtonEulerDSInverseMass(NewtonEulerDS& ds, const DynamicalSystemsGraph::VDescriptor& dsv);
+
   /** compute WBoundaryConditionsMap[ds] MoreauJeanOSI matrix at time t
    *  \param ds a pointer to DynamicalSystem
    *  \param WBoundaryConditions write the result in WBoundaryConditions
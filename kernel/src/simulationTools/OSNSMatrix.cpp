@@ -271,6 +271,9 @@ void OSNSMatrix::fillW(InteractionsGraph& indexSet, bool update)
     {
       DEBUG_PRINT("fill existing _M2\n");
       _M2->fill(indexSet);
+      // the numerics structure points to the ublas arrays
+      if (!update && _M2->hasLayoutChanged())
+        convert();
     }
   }
 
@@ -339,8 +342,10 @@ void OSNSMatrix::fillM(DynamicalSystemsGraph & DSG, bool update)
 
       // We choose a triplet matrix format for inserting values.
       // This simplifies the memory manipulation.
+      // The symbolic analysis of the factors of M is kept for the
+      // next solve, when the sparsity pattern does not change.
       NumericsMatrix& M_NM = *numericsMatrix();
-      NM_clearSparse(&M_NM);
+      NM_clearSparseStorageKeepSymbolic(&M_NM);
       M_NM.storageType = NM_SPARSE;
       M_NM.size0 = sizeM;
       M_NM.size1 = sizeM;
@@ -85,7 +85,9 @@
  *  - Sparse Block Storage (_storageType = 1): corresponds to
  *  SparseBlockStructuredMatrix structure of Numerics. Only non-null
  *  interactionBlocks are saved in the matrix M and there is no copy of
- *  sub-interactionBlocks, only links thanks to pointers.
+ *  sub-interactionBlocks, only links thanks to pointers. The sparse
+ *  structure is only rebuilt when the positions of the non-null
+ *  interactionBlocks have changed since the previous fill.
  *
  *  - Sparse matrix (_storageType = 2): at the time of writting, only csc (compressed-sparse column).
  *    Could also be triplet (coo or coordinate) or csr (compressed-sparse row).
@@ -221,6 +223,14 @@ public:
     return _M1;
   };
 
+  /** get the matrix used for sparse block storage
+   * \return SP::BlockCSRMatrix
+   */
+  inline SP::BlockCSRMatrix sparseBlockMatrix()
+  {
+    return _M2;
+  };
+
   /** fill the current class using an index set
    * \param indexSet the index set of the active constraints
    * \param update if true update the size of the Matrix (default true)
@@ -37,6 +37,10 @@
 #include "debug.h"
 #include "numerics_verbose.h" // numerics to set verbose mode ...
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 
 OneStepNSProblem::OneStepNSProblem():
   _indexSetLevel(0), _inputOutputLevel(0), _maxSize(0), _hasBeenUpdated(false)
@@ -65,6 +69,21 @@ bool OneStepNSProblem::hasInteractions() const
   return _simulation->nonSmoothDynamicalSystem()->topology()->indexSet(_indexSetLevel)->size() > 0 ;
 }
 
+/* Append ed to the group of edges sharing the storage identified by key. */
+static void addToInteractionBlockGroup(std::vector<std::vector<InteractionsGraph::EDescriptor> >& groups,
+                                       std::map<size_t, size_t>& groupOf,
+                                       size_t key, const InteractionsGraph::EDescriptor& ed)
+{
+  std::map<size_t, size_t>::iterator it = groupOf.find(key);
+  if (it == groupOf.end())
+  {
+    groupOf[key] = groups.size();
+    groups.push_back(std::vector<InteractionsGraph::EDescriptor>(1, ed));
+  }
+  else
+    groups[it->second].push_back(ed);
+}
+
 void OneStepNSProblem::updateInteractionBlocks()
 {
   DEBUG_PRINT("OneStepNSProblem::updateInteractionBlocks() starts\n");
@@ -93,6 +112,14 @@ void OneStepNSProblem::updateInteractionBlocks()
   SP::InteractionsGraph indexSet = simulation()->indexSet(indexSetLevel());
 
   bool isLinear = simulation()->nonSmoothDynamicalSystem()->isLinear();
+  bool computeBlocks = !isLinear || !_hasBeenUpdated;
+
+  // Blocks are allocated and zeroed while walking the graph, and the
+  // descriptors of the blocks to compute are collected. The computation
+  // itself is done afterwards by computeInteractionBlocks.
+  std::vector<InteractionsGraph::VDescriptor> diagonalBlocks;
+  std::vector<std::vector<InteractionsGraph::EDescriptor> > edgeBlocks;
+  std::map<size_t, size_t> groupOf;
 
   // we put diagonal information on vertices
   // self loops with bgl are a *nightmare* at the moment
@@ -111,9 +138,9 @@ void OneStepNSProblem::updateInteractionBlocks()
         indexSet->properties(*vi).block.reset(new SimpleMatrix(nslawSize, nslawSize));
       }
 
-      if (!isLinear || !_hasBeenUpdated)
+      if (computeBlocks)
       {
-        computeDiagonalInteractionBlock(*vi);
+        diagonalBlocks.push_back(*vi);
       }
     }
 
@@ -172,38 +199,10 @@ void OneStepNSProblem::updateInteractionBlocks()
         initialized[indexSet->index(ed1)] = true;
         currentInteractionBlock->zero();
       }
-      if (!isLinear || !_hasBeenUpdated)
+      if (computeBlocks)
       {
-        {
-          computeInteractionBlock(*ei);
-        }
-
-        // allocation for transposed block
-        // should be avoided
-
-        if (itar > isrc) // upper block has been computed
-        {
-          if (!indexSet->properties(ed1).lower_block)
-          {
-            indexSet->properties(ed1).lower_block.
-            reset(new SimpleMatrix(indexSet->properties(ed1).upper_block->size(1),
-                                   indexSet->properties(ed1).upper_block->size(0)));
-          }
-          indexSet->properties(ed1).lower_block->trans(*indexSet->properties(ed1).upper_block);
-          indexSet->properties(ed2).lower_block = indexSet->properties(ed1).lower_block;
-        }
-        else
-        {
-          assert(itar < isrc);    // lower block has been computed
-          if (!indexSet->properties(ed1).upper_block)
-          {
-            indexSet->properties(ed1).upper_block.
-            reset(new SimpleMatrix(indexSet->properties(ed1).lower_block->size(1),
-                                   indexSet->properties(ed1).lower_block->size(0)));
-          }
-          indexSet->properties(ed1).upper_block->trans(*indexSet->properties(ed1).lower_block);
-          indexSet->properties(ed2).upper_block = indexSet->properties(ed1).upper_block;
-        }
+        /* ed1 and ed2 share their blocks: they are computed by the same task */
+        addToInteractionBlockGroup(edgeBlocks, groupOf, indexSet->index(ed1), *ei);
       }
     }
   }
@@ -223,9 +222,9 @@ void OneStepNSProblem::updateInteractionBlocks()
         indexSet->properties(*vi).block.reset(new SimpleMatrix(nslawSize, nslawSize));
       }
 
-      if (!isLinear || !_hasBeenUpdated)
+      if (computeBlocks)
       {
-        computeDiagonalInteractionBlock(*vi);
+        diagonalBlocks.push_back(*vi);
       }
 
       /* on a undirected graph, out_edges gives all incident edges */
@@ -314,10 +313,11 @@ void OneStepNSProblem::updateInteractionBlocks()
           currentInteractionBlock->zero();
         }
 
-        if (!isLinear || !_hasBeenUpdated)
+        if (computeBlocks && isrc != itar)
         {
-          if (isrc != itar)
-            computeInteractionBlock(*oei);
+          /* ed1 and ed2 accumulate into the same block of this row */
+          addToInteractionBlockGroup(edgeBlocks, groupOf,
+                                     2 * indexSet->index(ed1) + (itar > isrc), *oei);
         }
 
       }
@@ -325,6 +325,11 @@ void OneStepNSProblem::updateInteractionBlocks()
   }
 
 
+  if (computeBlocks)
+  {
+    computeInteractionBlocks(*indexSet, diagonalBlocks, edgeBlocks);
+  }
+
   DEBUG_EXPR(displayBlocks(indexSet););
 
   DEBUG_PRINT("OneStepNSProblem::updateInteractionBlocks() ends\n");
@@ -332,6 +337,135 @@ void OneStepNSProblem::updateInteractionBlocks()
 
 }
 
+void OneStepNSProblem::computeInteractionBlockGroup(InteractionsGraph& indexSet,
+                                                    const std::vector<InteractionsGraph::EDescriptor>& group)
+{
+  for (std::vector<InteractionsGraph::EDescriptor>::const_iterator it = group.begin();
+       it != group.end(); ++it)
+  {
+    computeInteractionBlock(*it);
+
+    if (!indexSet.properties().symmetric)
+      continue;
+
+    // allocation for transposed block
+    // should be avoided
+    InteractionsGraph::EDescriptor ed1, ed2;
+    std11::tie(ed1, ed2) = indexSet.edges(indexSet.source(*it), indexSet.target(*it));
+    unsigned int isrc = indexSet.index(indexSet.source(*it));
+    unsigned int itar = indexSet.index(indexSet.target(*it));
+
+    if (itar > isrc) // upper block has been computed
+    {
+      if (!indexSet.properties(ed1).lower_block)
+      {
+        indexSet.properties(ed1).lower_block.
+        reset(new SimpleMatrix(indexSet.properties(ed1).upper_block->size(1),
+                               indexSet.properties(ed1).upper_block->size(0)));
+      }
+      indexSet.properties(ed1).lower_block->trans(*indexSet.properties(ed1).upper_block);
+      indexSet.properties(ed2).lower_block = indexSet.properties(ed1).lower_block;
+    }
+    else
+    {
+      assert(itar < isrc);    // lower block has been computed
+      if (!indexSet.properties(ed1).upper_block)
+      {
+        indexSet.properties(ed1).upper_block.
+        reset(new SimpleMatrix(indexSet.properties(ed1).lower_block->size(1),
+                               indexSet.properties(ed1).lower_block->size(0)));
+      }
+      indexSet.properties(ed1).upper_block->trans(*indexSet.properties(ed1).lower_block);
+      indexSet.properties(ed2).upper_block = indexSet.properties(ed1).upper_block;
+    }
+  }
+}
+
+#ifdef _OPENMP
+/* keep the first report of the exceptions raised in a parallel region */
+static void keepFirstReport(std::string& report, const std::string& message)
+{
+#pragma omp critical (OneStepNSProblem_blocks_report)
+  if (report.empty()) report = message;
+}
+#endif
+
+void OneStepNSProblem::computeInteractionBlocks(InteractionsGraph& indexSet,
+                                                const std::vector<InteractionsGraph::VDescriptor>& diagonalBlocks,
+                                                const std::vector<std::vector<InteractionsGraph::EDescriptor> >& edgeBlocks)
+{
+  DEBUG_BEGIN("OneStepNSProblem::computeInteractionBlocks(...)\n");
+  prepareInteractionBlocks(indexSet);
+
+  int nDiagonal = (int) diagonalBlocks.size();
+  int nGroups = (int) edgeBlocks.size();
+
+#ifdef _OPENMP
+  if (hasReentrantInteractionBlocks() && omp_get_max_threads() > 1)
+  {
+    DEBUG_PRINTF("parallel computation of %i diagonal blocks and %i groups of extra-diagonal blocks\n",
+                 nDiagonal, nGroups);
+    // exceptions must not escape the parallel region: the first report
+    // is kept and thrown again once all threads are done.
+    std::string report;
+#pragma omp parallel
+    {
+#pragma omp for schedule(dynamic, 16) nowait
+      for (int i = 0; i < nDiagonal; ++i)
+      {
+        try
+        {
+          computeDiagonalInteractionBlock(diagonalBlocks[i]);
+        }
+        catch (SiconosException& e)
+        {
+          keepFirstReport(report, e.report());
+        }
+        catch (std::exception& e)
+        {
+          keepFirstReport(report, e.what());
+        }
+        catch (...)
+        {
+          keepFirstReport(report, "unknown exception");
+        }
+      }
+#pragma omp for schedule(dynamic, 16)
+      for (int i = 0; i < nGroups; ++i)
+      {
+        try
+        {
+          computeInteractionBlockGroup(indexSet, edgeBlocks[i]);
+        }
+        catch (SiconosException& e)
+        {
+          keepFirstReport(report, e.report());
+        }
+        catch (std::exception& e)
+        {
+          keepFirstReport(report, e.what());
+        }
+        catch (...)
+        {
+          keepFirstReport(report, "unknown exception");
+        }
+      }
+    }
+    if (!report.empty())
+      RuntimeException::selfThrow(report);
+    DEBUG_END("OneStepNSProblem::computeInteractionBlocks(...)\n");
+    return;
+  }
+#endif
+
+  for (int i = 0; i < nDiagonal; ++i)
+    computeDiagonalInteractionBlock(diagonalBlocks[i]);
+  for (int i = 0; i < nGroups; ++i)
+    computeInteractionBlockGroup(indexSet, edgeBlocks[i]);
+
+  DEBUG_END("OneStepNSProblem::computeInteractionBlocks(...)\n");
+}
+
 void OneStepNSProblem::displayBlocks(SP::InteractionsGraph indexSet)
 {
 
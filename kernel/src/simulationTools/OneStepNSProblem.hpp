@@ -245,6 +245,41 @@ public:
    */
   virtual void computeDiagonalInteractionBlock(const InteractionsGraph::VDescriptor& vd) = 0;
 
+  /** tell whether computeDiagonalInteractionBlock and computeInteractionBlock
+   * may be called concurrently on distinct vertices and edges. When true and
+   * Siconos is built with OpenMP, the blocks are computed in parallel.
+   * \return false by default
+   */
+  virtual bool hasReentrantInteractionBlocks() const
+  {
+    return false;
+  }
+
+  /** update, once and sequentially, any state shared by the computation of
+   * the interaction blocks (for instance lazily factorized matrices)
+   * \param indexSet the index set whose blocks are about to be computed
+   */
+  virtual void prepareInteractionBlocks(InteractionsGraph& indexSet) {}
+
+  /** compute the diagonal and extra-diagonal blocks collected by
+   * updateInteractionBlocks
+   * \param indexSet the concerned index set
+   * \param diagonalBlocks the vertices whose diagonal block is computed
+   * \param edgeBlocks the edges to compute, grouped by shared storage: the
+   * edges of a group are handled in sequence by the same thread
+   */
+  void computeInteractionBlocks(InteractionsGraph& indexSet,
+                                const std::vector<InteractionsGraph::VDescriptor>& diagonalBlocks,
+                                const std::vector<std::vector<InteractionsGraph::EDescriptor> >& edgeBlocks);
+
+  /** compute a group of extra-diagonal blocks sharing their storage, and
+   * their transposed blocks if the index set is symmetric
+   * \param indexSet the concerned index set
+   * \param group the edges of the group
+   */
+  void computeInteractionBlockGroup(InteractionsGraph& indexSet,
+                                    const std::vector<InteractionsGraph::EDescriptor>& group);
+
   /**
    * \return bool _hasBeenUpdated
    */
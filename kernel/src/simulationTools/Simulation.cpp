@@ -298,6 +298,11 @@ void Simulation::initializeNSDSChangelog()
   }
   _nsdsChangeLogPosition = _nsds->changeLogPosition();
 
+  // let the InteractionManager complete the initialization of the
+  // Interactions it has created
+  if (interactionInitialized && _interman)
+    _interman->initializeInteractions(shared_from_this());
+
   // (re)initialize OneStepNSProblem(s) if necessary
   if (interactionInitialized || !_isInitialized)
   {
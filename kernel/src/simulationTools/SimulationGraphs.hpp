@@ -152,6 +152,7 @@ struct DynamicalSystemsGraph : public _DynamicalSystemsGraph
                            ((VertexSP, SiconosVector, tmpXdot)) // For Controlled System (nonlinear w.r.t u); tmpXdot = g(x, u)
                            ((VertexSP, SimpleMatrix, jacgx)) // For Controlled System (nonlinear w.r.t u); jacgx = nabla_x g(x, u)
                            ((Vertex, std::string, name)) // a name for a dynamical system
+                           ((Vertex, bool, fixed)) // see Topology::setFixed
                            ((Vertex, unsigned int, groupId))); // For group manipulations (example assign
                                                                // a material id for contact law
                                                                // determination
@@ -178,6 +179,7 @@ struct DynamicalSystemsGraph : public _DynamicalSystemsGraph
     tmpXdot._store->erase(vd);
     jacgx._store->erase(vd);
     name._store->erase(vd);
+    fixed._store->erase(vd);
     groupId._store->erase(vd);
   }
 };
@@ -274,7 +274,7 @@ void TimeStepping::updateIndexSet(unsigned int i)
         {
           //SP::OneStepIntegrator Osi = indexSet0->properties(*ui0).osi;
 	  // We assume that the integrator of the ds1 drive the update of the index set
-	  SP::DynamicalSystem ds1 = indexSet1->properties(*ui0).source;
+	  SP::DynamicalSystem ds1 = indexSet0->properties(*ui0).source;
 	  OneStepIntegrator& osi = *DSG0.properties(DSG0.descriptor(ds1)).osi;
 
           activate = osi.addInteractionInIndexSet(inter0, i);
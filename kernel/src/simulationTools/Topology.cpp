@@ -257,6 +257,21 @@ std::string Topology::name(SP::DynamicalSystem ds)
     return "";
 }
 
+void Topology::setFixed(SP::DynamicalSystem ds, bool val)
+{
+  DynamicalSystemsGraph::VDescriptor dsgv = _DSG[0]->descriptor(ds);
+  _DSG[0]->fixed.insert(dsgv, val);
+}
+
+bool Topology::isFixed(SP::DynamicalSystem ds) const
+{
+  DynamicalSystemsGraph& DSG0 = *_DSG[0];
+  if (!DSG0.is_vertex(ds))
+    return false;
+  DynamicalSystemsGraph::VDescriptor dsgv = DSG0.descriptor(ds);
+  return DSG0.fixed.hasKey(dsgv) && DSG0.fixed.at(dsgv);
+}
+
 void Topology::setName(SP::Interaction inter, const std::string& name)
 {
   InteractionsGraph::VDescriptor igv = _IG[0]->descriptor(inter);
@@ -467,6 +482,57 @@ unsigned int Topology::numberOfInvolvedDS(unsigned int inumber)
   return return_value;
 }
 
+unsigned int Topology::computeIslands(InteractionsGraph& indexSet,
+                                      std::vector<unsigned int>& island) const
+{
+  DEBUG_BEGIN("Topology::computeIslands(...)\n");
+  const unsigned int none = std::numeric_limits<unsigned int>::max();
+  indexSet.update_vertices_indices();
+  island.assign(indexSet.size(), none);
+
+  /* the test of the fixed dynamical systems is done once per system */
+  std::map<SP::DynamicalSystem, bool> fixed;
+
+  unsigned int nbIslands = 0;
+  std::vector<InteractionsGraph::VDescriptor> stack;
+  InteractionsGraph::VIterator vi, viend;
+  for (std11::tie(vi, viend) = indexSet.vertices(); vi != viend; ++vi)
+  {
+    if (island[indexSet.index(*vi)] != none)
+      continue;
+
+    /* depth first traversal of a new island */
+    island[indexSet.index(*vi)] = nbIslands;
+    stack.push_back(*vi);
+    while (!stack.empty())
+    {
+      InteractionsGraph::VDescriptor vd = stack.back();
+      stack.pop_back();
+      InteractionsGraph::OEIterator oei, oeiend;
+      for (std11::tie(oei, oeiend) = indexSet.out_edges(vd); oei != oeiend; ++oei)
+      {
+        InteractionsGraph::VDescriptor vd2 = indexSet.target(*oei);
+        if (vd2 == vd)
+          vd2 = indexSet.source(*oei);
+        if (island[indexSet.index(vd2)] != none)
+          continue;
+        SP::DynamicalSystem ds = indexSet.bundle(*oei);
+        std::map<SP::DynamicalSystem, bool>::iterator it = fixed.find(ds);
+        if (it == fixed.end())
+          it = fixed.insert(std::make_pair(ds, isFixed(ds))).first;
+        if (it->second)
+          continue;
+        island[indexSet.index(vd2)] = nbIslands;
+        stack.push_back(vd2);
+      }
+    }
+    ++nbIslands;
+  }
+  DEBUG_PRINTF("%u interactions, %u islands\n", (unsigned int)indexSet.size(), nbIslands);
+  DEBUG_END("Topology::computeIslands(...)\n");
+  return nbIslands;
+}
+
 SP::Interaction Topology::getInteraction(unsigned int requiredNumber) const
 {
   InteractionsGraph::VIterator vi, vdend;
@@ -485,7 +551,7 @@ SP::Interaction Topology::getInteraction(unsigned int requiredNumber) const
 
 SP::Interaction Topology::getInteraction(std::string name) const
 {
-  DynamicalSystemsGraph::VIterator vi, vdend;
+  InteractionsGraph::VIterator vi, vdend;
   for (std11::tie(vi, vdend) = _IG[0]->vertices(); vi != vdend; ++vi)
   {
     if (name == _IG[0]->name.at(*vi))
@@ -176,6 +176,20 @@ public:
    */
   std::string name(SP::Interaction inter);
 
+  /** declare a DynamicalSystem as fixed, or not. The motion of a fixed
+   * DynamicalSystem (the ground, a prescribed body ...) must not depend on
+   * the reactions of its interactions: these interactions are not linked
+   * through it in the islands, see computeIslands.
+   * \param ds the DynamicalSystem
+   * \param val true if the DynamicalSystem is fixed
+   */
+  void setFixed(SP::DynamicalSystem ds, bool val = true);
+
+  /** \param ds a DynamicalSystem
+   * \return true if the DynamicalSystem has been declared fixed
+   */
+  bool isFixed(SP::DynamicalSystem ds) const;
+
   /** set the OSI for this DynamicalSystem
    * \param ds the DynamicalSystem
    * \param OSI the integrator to use for this DS
@@ -393,6 +407,18 @@ public:
    */
   unsigned int numberOfInvolvedDS(unsigned int inumber);
 
+  /** compute the islands of an index set, i.e. its connected components
+   * when two interactions are linked by the DynamicalSystems they share,
+   * except the fixed ones. The interactions of different islands are not
+   * coupled in the one step nonsmooth problems.
+   * \param indexSet the index set, whose vertex indices are updated
+   * \param island the island of each interaction (output), indexed by
+   * indexSet.index(vd)
+   * \return the number of islands
+   */
+  unsigned int computeIslands(InteractionsGraph& indexSet,
+                              std::vector<unsigned int>& island) const;
+
 
 };
 
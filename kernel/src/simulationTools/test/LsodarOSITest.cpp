@@ -0,0 +1,108 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#include "LsodarOSITest.hpp"
+
+// test suite registration
+CPPUNIT_TEST_SUITE_REGISTRATION(LsodarOSITest);
+
+
+void LsodarOSITest::setUp()
+{
+  // stiff tridiagonal A: ml = mu = 1. LSODAR only uses the jacobian
+  // once it has switched to BDF on a stiff problem.
+  _A.reset(new SimpleMatrix(_n, _n));
+  for (unsigned int i = 0; i < _n; i++)
+  {
+    (*_A)(i, i) = -1. - 500. * i;
+    if (i > 0)
+      (*_A)(i, i - 1) = 1.;
+    if (i < _n - 1)
+      (*_A)(i, i + 1) = 0.5;
+  }
+  _x0.reset(new SiconosVector(_n));
+  for (unsigned int i = 0; i < _n; i++)
+    (*_x0)(i) = 1. + i;
+}
+
+void LsodarOSITest::tearDown()
+{}
+
+// state of ds at _T
+SP::SiconosVector LsodarOSITest::integrate(SP::FirstOrderLinearDS ds, SP::LsodarOSI osi)
+{
+  SP::NonSmoothDynamicalSystem nsds(new NonSmoothDynamicalSystem(0., _T));
+  nsds->insertDynamicalSystem(ds);
+  SP::TimeDiscretisation td(new TimeDiscretisation(0., _h));
+  SP::EventDriven sim(new EventDriven(nsds, td));
+  sim->insertNonSmoothProblem(SP::OneStepNSProblem(new LCP()), SICONOS_OSNSP_ED_IMPACT);
+  sim->insertNonSmoothProblem(SP::OneStepNSProblem(new LCP()), SICONOS_OSNSP_ED_SMOOTH_ACC);
+  osi->setTol(1, 1e-10, 1e-12);
+  sim->associate(osi, ds);
+  sim->initialize();
+  while (sim->hasNextEvent())
+  {
+    sim->advanceToEvent();
+    sim->processEvents();
+  }
+  return SP::SiconosVector(new SiconosVector(*ds->x()));
+}
+
+void LsodarOSITest::testBandedJacobian()
+{
+  std::cout << "====  LsodarOSI Test : banded jacobian ====" <<std::endl;
+  SP::FirstOrderLinearTIDS dsFull(new FirstOrderLinearTIDS(SP::SiconosVector(new SiconosVector(*_x0)), _A));
+  SP::LsodarOSI full(new LsodarOSI());
+  SP::SiconosVector xFull = integrate(dsFull, full);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testBandedJacobian : full jt", full->intData(8), (integer)2);
+
+  SP::FirstOrderLinearTIDS dsBand(new FirstOrderLinearTIDS(SP::SiconosVector(new SiconosVector(*_x0)), _A));
+  SP::LsodarOSI band(new LsodarOSI());
+  band->setJT(4);
+  SP::SiconosVector xBand = integrate(dsBand, band);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testBandedJacobian : banded jt", band->intData(8), (integer)4);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testBandedJacobian : ml", band->getIwork()[0], (integer)1);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testBandedJacobian : mu", band->getIwork()[1], (integer)1);
+  // the stiff (BDF) method, which uses the jacobian, is in use
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testBandedJacobian : BDF", band->getIwork()[18], (integer)2);
+
+  double diff = (*xFull - *xBand).normInf();
+  std::cout << "error between the full and the banded jacobians: " << diff << std::endl;
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testBandedJacobian : same solution", diff < _tol, true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testBandedJacobian : the state has moved", (*xFull - *_x0).normInf() > 0.1, true);
+  std::cout << "--> banded jacobian test ended with success." <<std::endl;
+}
+
+void LsodarOSITest::testBandedJacobianFallback()
+{
+  std::cout << "====  LsodarOSI Test : banded jacobian of a time varying system ====" <<std::endl;
+  // the band of a FirstOrderLinearDS is not known: the full jacobian is used
+  SP::FirstOrderLinearDS ds(new FirstOrderLinearDS(SP::SiconosVector(new SiconosVector(*_x0)), _A));
+  SP::LsodarOSI osi(new LsodarOSI());
+  osi->setJT(4);
+  integrate(ds, osi);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testBandedJacobianFallback : full jt", osi->intData(8), (integer)1);
+
+  // unless it is given
+  SP::FirstOrderLinearDS ds2(new FirstOrderLinearDS(SP::SiconosVector(new SiconosVector(*_x0)), _A));
+  SP::LsodarOSI osi2(new LsodarOSI());
+  osi2->setJT(4);
+  osi2->setJacobianBandwidths(1, 1);
+  integrate(ds2, osi2);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testBandedJacobianFallback : banded jt", osi2->intData(8), (integer)4);
+  std::cout << "--> banded jacobian fallback test ended with success." <<std::endl;
+}
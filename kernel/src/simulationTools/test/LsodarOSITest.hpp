@@ -0,0 +1,68 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#ifndef __LsodarOSITest__
+#define __LsodarOSITest__
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "FirstOrderLinearTIDS.hpp"
+#include "LsodarOSI.hpp"
+#include "EventDriven.hpp"
+#include "LCP.hpp"
+#include "TimeDiscretisation.hpp"
+#include "NonSmoothDynamicalSystem.hpp"
+
+class LsodarOSITest : public CppUnit::TestFixture
+{
+
+private:
+  /** serialization hooks
+  */
+  ACCEPT_SERIALIZATION(LsodarOSITest);
+
+
+  // Name of the tests suite
+  CPPUNIT_TEST_SUITE(LsodarOSITest);
+
+  // tests to be done ...
+
+  CPPUNIT_TEST(testBandedJacobian);
+  CPPUNIT_TEST(testBandedJacobianFallback);
+
+  CPPUNIT_TEST_SUITE_END();
+
+  SP::SiconosVector integrate(SP::FirstOrderLinearDS ds, SP::LsodarOSI osi);
+  void testBandedJacobian();
+  void testBandedJacobianFallback();
+  // Members
+
+  unsigned int _n;
+  double _h;
+  double _T;
+  double _tol;
+  SP::SiconosMatrix _A;
+  SP::SiconosVector _x0;
+
+public:
+
+  LsodarOSITest(): _n(8), _h(0.1), _T(1.), _tol(1e-7) {}
+  void setUp();
+  void tearDown();
+
+};
+
+#endif
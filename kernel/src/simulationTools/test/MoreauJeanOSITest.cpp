@@ -0,0 +1,197 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#include "MoreauJeanOSITest.hpp"
+
+// test suite registration
+CPPUNIT_TEST_SUITE_REGISTRATION(MoreauJeanOSITest);
+
+
+void MoreauJeanOSITest::setUp()
+{
+  _M.reset(new SimpleMatrix(_n, _n));
+  _M->eye();
+  (*_M)(1, 1) = 2.;
+  _K.reset(new SimpleMatrix(_n, _n));
+  (*_K)(0, 0) = 100.;
+  (*_K)(0, 1) = (*_K)(1, 0) = -50.;
+  (*_K)(1, 1) = 200.;
+}
+
+void MoreauJeanOSITest::init()
+{
+  SP::SiconosVector q0(new SiconosVector(_n, 0));
+  SP::SiconosVector v0(new SiconosVector(_n, 0));
+  (*q0)(0) = 1.;
+  SP::SiconosMatrix C(new SimpleMatrix(_n, _n, 0));
+  _DS.reset(new LagrangianLinearTIDS(q0, v0, _M, _K, C));
+  // h = 0.1 for 3 steps, then h = 0.15
+  TkVector tk;
+  for (unsigned int k = 0; k < 4; k++)
+    tk.push_back(0.1 * k);
+  for (unsigned int k = 1; k < 4; k++)
+    tk.push_back(0.3 + 0.15 * k);
+  _nsds.reset(new NonSmoothDynamicalSystem(tk.front(), tk.back()));
+  _nsds->insertDynamicalSystem(_DS);
+  SP::TimeDiscretisation td(new TimeDiscretisation(tk));
+  _sim.reset(new TimeStepping(_nsds, td));
+  _sim->insertNonSmoothProblem(SP::OneStepNSProblem(new LCP()));
+  _OSI.reset(new MoreauJeanOSI(0.5));
+  _sim->associate(_OSI, _DS);
+  _sim->initialize();
+}
+
+void MoreauJeanOSITest::tearDown()
+{}
+
+void MoreauJeanOSITest::step()
+{
+  _sim->computeOneStep();
+  _sim->nextStep();
+}
+
+/* the LU factors of M + h^2 theta^2 K */
+SimpleMatrix MoreauJeanOSITest::factorizedW(double h, double theta)
+{
+  SimpleMatrix W(*_M);
+  W += h * h * theta * theta * *_K;
+  W.PLUFactorizationInPlace();
+  return W;
+}
+
+/* the difference between the values of the (factorized) W of the OSI
+ * and ref */
+double MoreauJeanOSITest::diffW(const SimpleMatrix& ref)
+{
+  SimpleMatrix& W = *_OSI->W(_DS);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("diffW : W is factorized ", W.isPLUFactorized(), true);
+  double diff = 0.;
+  for (unsigned int i = 0; i < _n; i++)
+    for (unsigned int j = 0; j < _n; j++)
+      diff = std::max(diff, fabs(W(i, j) - ref(i, j)));
+  return diff;
+}
+
+void MoreauJeanOSITest::testCacheW()
+{
+  std::cout << "===========================================" <<std::endl;
+  std::cout << " ===== MoreauJeanOSI tests start ... ===== " <<std::endl;
+  std::cout << "===========================================" <<std::endl;
+  std::cout << "------- Cache of the iteration matrix W -------" <<std::endl;
+  init();
+  step();
+  SimpleMatrix W1 = factorizedW(0.1, 0.5);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testCacheW : first W ", diffW(W1) < _tol, true);
+
+  // K is changed in place: W and its factors are kept
+  *_K *= 2.;
+  step();
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testCacheW : W reused ", diffW(W1) == 0., true);
+
+  // the new K is taken into account after invalidateW
+  _OSI->invalidateW();
+  step();
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testCacheW : W after invalidateW ", diffW(factorizedW(0.1, 0.5)) < _tol, true);
+
+  // change of the time step
+  step();
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testCacheW : W after a change of h ", diffW(factorizedW(0.15, 0.5)) < _tol, true);
+
+  // change of theta
+  _OSI->setTheta(0.7);
+  step();
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testCacheW : W after a change of theta ", diffW(factorizedW(0.15, 0.7)) < _tol, true);
+  std::cout << "------- Cache of W ok -------" <<std::endl;
+}
+
+/* a rigid body with a full inertia under a constant wrench, and its
+ * simulation */
+static SP::NewtonEulerDS freeBody(bool pool, SP::TimeStepping& sim, SP::MoreauJeanOSI& osi)
+{
+  SP::SiconosVector q0(new SiconosVector(7, 0));
+  SP::SiconosVector v0(new SiconosVector(6, 0));
+  (*q0)(3) = 1.;
+  (*v0)(4) = 1.;
+  SP::SimpleMatrix I(new SimpleMatrix(3, 3));
+  I->eye();
+  (*I)(0, 1) = (*I)(1, 0) = 0.2;
+  (*I)(2, 2) = 3.;
+  SP::NewtonEulerDS ds(new NewtonEulerDS(q0, v0, 2., I));
+  ds->setNullifyMGyr(true);
+  SP::SiconosVector f(new SiconosVector(3, 1.));
+  SP::SiconosVector m(new SiconosVector(3, 0));
+  (*m)(0) = 1.;
+  (*m)(2) = -2.;
+  ds->setFExtPtr(f);
+  ds->setMExtPtr(m);
+
+  SP::NonSmoothDynamicalSystem nsds(new NonSmoothDynamicalSystem(0., 1.));
+  nsds->insertDynamicalSystem(ds);
+  sim.reset(new TimeStepping(nsds, SP::TimeDiscretisation(new TimeDiscretisation(0., 0.1))));
+  sim->insertNonSmoothProblem(SP::OneStepNSProblem(new LCP()));
+  osi.reset(new MoreauJeanOSI(0.5));
+  osi->setUseNewtonEulerDSPool(pool);
+  sim->associate(osi, ds);
+  sim->initialize();
+  return ds;
+}
+
+void MoreauJeanOSITest::testNewtonEulerDSPool()
+{
+  std::cout << "------- Pool of NewtonEulerDS -------" <<std::endl;
+  SP::TimeStepping sim, simPool;
+  SP::MoreauJeanOSI osi, osiPool;
+  SP::NewtonEulerDS ds = freeBody(false, sim, osi);
+  SP::NewtonEulerDS dsPool = freeBody(true, simPool, osiPool);
+  for (unsigned int k = 0; k < 6; k++)
+  {
+    // a change of the mass is taken into account in the pool
+    if (k == 3)
+    {
+      ds->setInertia(1., 2., 0.5);
+      dsPool->setInertia(1., 2., 0.5);
+      ds->setScalarMass(3.);
+      dsPool->setScalarMass(3.);
+    }
+    sim->computeOneStep();
+    sim->nextStep();
+    simPool->computeOneStep();
+    simPool->nextStep();
+    double diff = 0.;
+    for (unsigned int i = 0; i < 6; i++)
+      diff = std::max(diff, fabs((*ds->twist())(i) - (*dsPool->twist())(i)));
+    for (unsigned int i = 0; i < 7; i++)
+      diff = std::max(diff, fabs((*ds->q())(i) - (*dsPool->q())(i)));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("testNewtonEulerDSPool : same state ", diff < _tol, true);
+  }
+  // W is the mass matrix, not factorized in the pool, and cached with
+  // its factors otherwise
+  SimpleMatrix& W = *osiPool->W(dsPool);
+  SimpleMatrix& Wlu = *osi->W(ds);
+  SimpleMatrix Mlu(*ds->mass());
+  Mlu.PLUFactorizationInPlace();
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testNewtonEulerDSPool : W factorized ", Wlu.isPLUFactorized(), true);
+  double diff = 0.;
+  for (unsigned int i = 0; i < 6; i++)
+    for (unsigned int j = 0; j < 6; j++)
+    {
+      diff = std::max(diff, fabs(W(i, j) - (*dsPool->mass())(i, j)));
+      diff = std::max(diff, fabs(Wlu(i, j) - Mlu(i, j)));
+    }
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testNewtonEulerDSPool : W ", diff < _tol, true);
+  std::cout << "------- Pool of NewtonEulerDS ok -------" <<std::endl;
+}
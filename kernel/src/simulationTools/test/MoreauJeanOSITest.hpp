@@ -0,0 +1,74 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#ifndef __MoreauJeanOSITest__
+#define __MoreauJeanOSITest__
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "LagrangianLinearTIDS.hpp"
+#include "NewtonEulerDS.hpp"
+#include "MoreauJeanOSI.hpp"
+#include "TimeStepping.hpp"
+#include "LCP.hpp"
+#include "TimeDiscretisation.hpp"
+#include "NonSmoothDynamicalSystem.hpp"
+
+class MoreauJeanOSITest : public CppUnit::TestFixture
+{
+
+private:
+  /** serialization hooks
+  */
+  ACCEPT_SERIALIZATION(MoreauJeanOSITest);
+
+
+  // Name of the tests suite
+  CPPUNIT_TEST_SUITE(MoreauJeanOSITest);
+
+  // tests to be done ...
+
+  CPPUNIT_TEST(testCacheW);
+  CPPUNIT_TEST(testNewtonEulerDSPool);
+
+  CPPUNIT_TEST_SUITE_END();
+
+  void init();
+  void step();
+  double diffW(const SimpleMatrix& ref);
+  SimpleMatrix factorizedW(double h, double theta);
+  void testCacheW();
+  void testNewtonEulerDSPool();
+  // Members
+
+  unsigned int _n;
+  double _tol;
+  SP::SimpleMatrix _M;
+  SP::SimpleMatrix _K;
+  SP::LagrangianLinearTIDS _DS;
+  SP::NonSmoothDynamicalSystem _nsds;
+  SP::TimeStepping _sim;
+  SP::MoreauJeanOSI _OSI;
+
+public:
+
+  MoreauJeanOSITest(): _n(2), _tol(1e-12) {}
+  void setUp();
+  void tearDown();
+
+};
+
+#endif
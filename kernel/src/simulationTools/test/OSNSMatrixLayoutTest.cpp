@@ -0,0 +1,133 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#include "OSNSMatrixLayoutTest.hpp"
+#include "NumericsMatrix.h"
+#include "SparseBlockMatrix.h"
+
+// test suite registration
+CPPUNIT_TEST_SUITE_REGISTRATION(OSNSMatrixLayoutTest);
+
+
+void OSNSMatrixLayoutTest::setUp()
+{
+  _indexSet.reset(new InteractionsGraph());
+  _ds.clear();
+}
+
+void OSNSMatrixLayoutTest::tearDown()
+{}
+
+// a contact with a diagonal block value * Id
+SP::Interaction OSNSMatrixLayoutTest::addInteraction(double value)
+{
+  SP::SimpleMatrix H(new SimpleMatrix(_n, 3));
+  SP::Interaction inter(new Interaction(SP::NonSmoothLaw(new NewtonImpactFrictionNSL(0., 0., 0.5, _n)),
+                                        SP::Relation(new LagrangianLinearTIR(H))));
+  InteractionsGraph::VDescriptor vd = _indexSet->add_vertex(inter);
+  SP::SiconosMatrix block(new SimpleMatrix(_n, _n));
+  block->eye();
+  *block *= value;
+  _indexSet->properties(vd).block = block;
+  return inter;
+}
+
+// a dynamical system shared by two contacts, with the coupling blocks
+// value and -value
+void OSNSMatrixLayoutTest::link(SP::Interaction inter1, SP::Interaction inter2,
+                                double value)
+{
+  SP::DynamicalSystem ds(new LagrangianDS(SP::SiconosVector(new SiconosVector(3)),
+                                          SP::SiconosVector(new SiconosVector(3))));
+  _ds.push_back(ds);
+  InteractionsGraph::EDescriptor ed =
+    _indexSet->add_edge(_indexSet->descriptor(inter1),
+                        _indexSet->descriptor(inter2), ds);
+  SP::SiconosMatrix upper(new SimpleMatrix(_n, _n, value));
+  SP::SiconosMatrix lower(new SimpleMatrix(_n, _n, -value));
+  _indexSet->properties(ed).upper_block = upper;
+  _indexSet->properties(ed).lower_block = lower;
+}
+
+void OSNSMatrixLayoutTest::updateIndices()
+{
+  _indexSet->update_vertices_indices();
+  _indexSet->update_edges_indices();
+}
+
+// difference between M and a dense matrix built from scratch
+double OSNSMatrixLayoutTest::diffWithDense(OSNSMatrix& M)
+{
+  OSNSMatrix ref(*_indexSet, NM_DENSE);
+  NumericsMatrix* refM = &*ref.numericsMatrix();
+  NumericsMatrix* numM = &*M.numericsMatrix();
+  if (numM->size0 != refM->size0 || numM->size1 != refM->size1)
+    return 1.;
+  double diff = 0.;
+  for (int i = 0; i < refM->size0; ++i)
+    for (int j = 0; j < refM->size1; ++j)
+      diff = std::max(diff, fabs(NM_get_value(numM, i, j) - NM_get_value(refM, i, j)));
+  return diff;
+}
+
+void OSNSMatrixLayoutTest::testFillSparseBlock()
+{
+  std::cout << "==== OSNSMatrixLayout Test : fill a sparse block matrix ====" <<std::endl;
+  SP::Interaction inter1 = addInteraction(1.);
+  SP::Interaction inter2 = addInteraction(2.);
+  SP::Interaction inter3 = addInteraction(3.);
+  link(inter1, inter2, 0.5);
+  link(inter2, inter3, 0.25);
+  updateIndices();
+
+  OSNSMatrix M(*_indexSet, NM_SPARSE_BLOCK);
+  SP::BlockCSRMatrix M2 = M.sparseBlockMatrix();
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testFillSparseBlock : first fill", M2->hasLayoutChanged(), true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testFillSparseBlock : first fill values", diffWithDense(M) < _tol, true);
+
+  // same contacts, new values
+  *_indexSet->properties(_indexSet->descriptor(inter2)).block *= 4.;
+  M.fillW(*_indexSet, false);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testFillSparseBlock : same layout", M2->hasLayoutChanged(), false);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testFillSparseBlock : same layout values", diffWithDense(M) < _tol, true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testFillSparseBlock : same layout nnz", M2->getNbNonNullBlocks(), 7u);
+
+  // insert a contact coupled with the last one: the first rows are kept
+  SP::Interaction inter4 = addInteraction(4.);
+  link(inter3, inter4, 0.125);
+  updateIndices();
+  M.fillW(*_indexSet);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testFillSparseBlock : insertion", M2->hasLayoutChanged(), true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testFillSparseBlock : insertion values", diffWithDense(M) < _tol, true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testFillSparseBlock : insertion nnz", M2->getNbNonNullBlocks(), 10u);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testFillSparseBlock : insertion numerics nnz",
+                               M.numericsMatrix()->matrix1->nbblocks, 10u);
+
+  M.fillW(*_indexSet, false);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testFillSparseBlock : after insertion", M2->hasLayoutChanged(), false);
+
+  // remove the second contact
+  _indexSet->remove_vertex(inter2);
+  updateIndices();
+  M.fillW(*_indexSet);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testFillSparseBlock : removal", M2->hasLayoutChanged(), true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testFillSparseBlock : removal values", diffWithDense(M) < _tol, true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testFillSparseBlock : removal nnz", M2->getNbNonNullBlocks(), 5u);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testFillSparseBlock : removal numerics nnz",
+                               M.numericsMatrix()->matrix1->nbblocks, 5u);
+  std::cout << "--> fill a sparse block matrix test ended with success." <<std::endl;
+}
@@ -0,0 +1,68 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#ifndef __OSNSMatrixLayoutTest__
+#define __OSNSMatrixLayoutTest__
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "OSNSMatrix.hpp"
+#include "BlockCSRMatrix.hpp"
+#include "SimulationGraphs.hpp"
+#include "Interaction.hpp"
+#include "LagrangianDS.hpp"
+#include "LagrangianLinearTIR.hpp"
+#include "NewtonImpactFrictionNSL.hpp"
+
+class OSNSMatrixLayoutTest : public CppUnit::TestFixture
+{
+
+private:
+  /** serialization hooks
+  */
+  ACCEPT_SERIALIZATION(OSNSMatrixLayoutTest);
+
+
+  // Name of the tests suite
+  CPPUNIT_TEST_SUITE(OSNSMatrixLayoutTest);
+
+  // tests to be done ...
+
+  CPPUNIT_TEST(testFillSparseBlock);
+
+  CPPUNIT_TEST_SUITE_END();
+
+  SP::Interaction addInteraction(double value);
+  void link(SP::Interaction inter1, SP::Interaction inter2, double value);
+  void updateIndices();
+  double diffWithDense(OSNSMatrix& M);
+  void testFillSparseBlock();
+  // Members
+
+  unsigned int _n;
+  double _tol;
+  SP::InteractionsGraph _indexSet;
+  std::vector<SP::DynamicalSystem> _ds;
+
+public:
+
+  OSNSMatrixLayoutTest(): _n(2), _tol(1e-12) {}
+  void setUp();
+  void tearDown();
+
+};
+
+#endif
@@ -17,6 +17,14 @@
 */
 #include "OSNSPTest.hpp"
 #include "EventsManager.hpp"
+#include "LagrangianLinearTIDS.hpp"
+#include "LagrangianLinearTIR.hpp"
+#include "NewtonImpactFrictionNSL.hpp"
+#include "MoreauJeanOSI.hpp"
+#include "FrictionContact.hpp"
+#include "Topology.hpp"
+#include "NumericsMatrix.h"
+#include "RuntimeException.hpp"
 
 #define CPPUNIT_ASSERT_NOT_EQUAL(message, alpha, omega)      \
             if ((alpha) == (omega)) CPPUNIT_FAIL(message);
@@ -134,3 +142,197 @@ void OSNSPTest::testAVI()
   }
   CPPUNIT_ASSERT_EQUAL_MESSAGE("testAVI : ",  maxErr < _tol, true);
 }
+
+/* two piles of two balls, on the ground or on a table, with a
+ * frictional contact between the balls and under the lowest ones */
+static SP::TimeStepping islandsScene(bool withTable, bool fixedTable, int storage,
+                                     std::vector<SP::LagrangianLinearTIDS>& balls,
+                                     int solverId = SICONOS_FRICTION_3D_NSGS)
+{
+  double R = 0.1;
+  SP::NonSmoothDynamicalSystem nsds(new NonSmoothDynamicalSystem(0.0, 1.0));
+  SP::NonSmoothLaw nslaw(new NewtonImpactFrictionNSL(0.5, 0.0, 0.3, 3));
+  SP::LagrangianLinearTIDS table;
+  if (withTable)
+  {
+    SP::SiconosVector q0(new SiconosVector(3)), v0(new SiconosVector(3));
+    SP::SimpleMatrix M(new SimpleMatrix(3, 3));
+    M->eye();
+    *M *= 100.0;
+    table.reset(new LagrangianLinearTIDS(q0, v0, M));
+    nsds->insertDynamicalSystem(table);
+  }
+  balls.clear();
+  for (unsigned int p = 0; p < 2; ++p)
+    for (unsigned int l = 0; l < 2; ++l)
+    {
+      SP::SiconosVector q0(new SiconosVector(3)), v0(new SiconosVector(3));
+      (*q0)(0) = 10.0 * p;
+      (*q0)(2) = R + 2.0 * R * l;
+      (*v0)(0) = 0.5 - l;
+      (*v0)(1) = 0.2 * p;
+      (*v0)(2) = -1.0 - l;
+      SP::SimpleMatrix M(new SimpleMatrix(3, 3));
+      M->eye();
+      *M *= 1.0 + l + p;
+      SP::LagrangianLinearTIDS ball(new LagrangianLinearTIDS(q0, v0, M));
+      SP::SiconosVector weight(new SiconosVector(3));
+      (*weight)(2) = -9.81 * (1.0 + l + p);
+      ball->setFExtPtr(weight);
+      nsds->insertDynamicalSystem(ball);
+      balls.push_back(ball);
+
+      // y = (normal gap, tangential displacements)
+      SP::SiconosVector b(new SiconosVector(3));
+      (*b)(0) = (l == 0) ? -R : -2.0 * R;
+      if (l == 0 && !withTable)
+      {
+        SP::SimpleMatrix H(new SimpleMatrix(3, 3));
+        (*H)(0, 2) = 1.0;
+        (*H)(1, 0) = 1.0;
+        (*H)(2, 1) = 1.0;
+        SP::Interaction inter(new Interaction(nslaw, SP::Relation(new LagrangianLinearTIR(H, b))));
+        nsds->link(inter, ball);
+      }
+      else
+      {
+        SP::LagrangianLinearTIDS below = (l == 0) ? table : balls[balls.size() - 2];
+        SP::SimpleMatrix H(new SimpleMatrix(3, 6));
+        (*H)(0, 2) = -1.0;
+        (*H)(1, 0) = -1.0;
+        (*H)(2, 1) = -1.0;
+        (*H)(0, 5) = 1.0;
+        (*H)(1, 3) = 1.0;
+        (*H)(2, 4) = 1.0;
+        SP::Interaction inter(new Interaction(nslaw, SP::Relation(new LagrangianLinearTIR(H, b))));
+        nsds->link(inter, below, ball);
+      }
+    }
+  if (fixedTable)
+    nsds->topology()->setFixed(table);
+
+  SP::TimeDiscretisation td(new TimeDiscretisation(0.0, 0.005));
+  SP::OneStepIntegrator osi(new MoreauJeanOSI(0.5));
+  SP::FrictionContact osnspb(new FrictionContact(3, solverId));
+  osnspb->setMStorageType(storage);
+  osnspb->numericsSolverOptions()->dparam[SICONOS_DPARAM_TOL] = 1e-14;
+  osnspb->numericsSolverOptions()->iparam[SICONOS_IPARAM_MAX_ITER] = 10000;
+  return SP::TimeStepping(new TimeStepping(nsds, td, osi, osnspb));
+}
+
+/* count the iterations reported to a numerics callback */
+static void countIterations(void *env, int size, double *reaction,
+                            double *velocity, double error, void *extra_data)
+{
+  ++*(int*)env;
+}
+
+void OSNSPTest::testFrictionContactIslands()
+{
+  std::cout << "------- FrictionContact solved by islands -------" <<std::endl;
+  int storages[2] = { NM_DENSE, NM_SPARSE_BLOCK };
+  for (unsigned int s = 0; s < 2; ++s)
+  {
+    std::vector<SP::LagrangianLinearTIDS> balls, ballsIslands;
+    SP::TimeStepping sim = islandsScene(false, false, storages[s], balls);
+    SP::TimeStepping simIslands = islandsScene(false, false, storages[s], ballsIslands);
+    SP::FrictionContact osnspb = std11::static_pointer_cast<FrictionContact>
+                                 (sim->oneStepNSProblem(SICONOS_OSNSP_TS_VELOCITY));
+    SP::FrictionContact osnspbIslands = std11::static_pointer_cast<FrictionContact>
+                                        (simIslands->oneStepNSProblem(SICONOS_OSNSP_TS_VELOCITY));
+    osnspbIslands->setSolveByIslands(true);
+    sim->computeOneStep();
+    simIslands->computeOneStep();
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("testFrictionContactIslands : islands", 2u, osnspbIslands->numberOfIslands());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("testFrictionContactIslands : solved islands", 2u, osnspbIslands->numberOfSolvedIslands());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("testFrictionContactIslands : z", osnspb->z()->size(), osnspbIslands->z()->size());
+    CPPUNIT_ASSERT_MESSAGE("testFrictionContactIslands : z", (*osnspb->z() - *osnspbIslands->z()).normInf() < 1e-10);
+    for (unsigned int i = 0; i < balls.size(); ++i)
+      CPPUNIT_ASSERT_MESSAGE("testFrictionContactIslands : velocity",
+                             (*balls[i]->velocity() - *ballsIslands[i]->velocity()).normInf() < 1e-10);
+
+    // the reactions are already a solution of both islands
+    osnspbIslands->compute(simIslands->nextTime());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("testFrictionContactIslands : converged islands", 0u, osnspbIslands->numberOfSolvedIslands());
+  }
+
+  // with a callback, the islands are solved in turn
+  {
+    std::vector<SP::LagrangianLinearTIDS> balls;
+    SP::TimeStepping sim = islandsScene(false, false, NM_SPARSE_BLOCK, balls);
+    SP::FrictionContact osnspb = std11::static_pointer_cast<FrictionContact>
+                                 (sim->oneStepNSProblem(SICONOS_OSNSP_TS_VELOCITY));
+    osnspb->setSolveByIslands(true);
+    int iterations = 0;
+    Callback* callback = (Callback*) malloc(sizeof(Callback));
+    callback->env = &iterations;
+    callback->collectStatsIteration = &countIterations;
+    osnspb->numericsSolverOptions()->callback = callback;
+    sim->computeOneStep();
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("testFrictionContactIslands : callback islands", 2u, osnspb->numberOfSolvedIslands());
+    CPPUNIT_ASSERT_MESSAGE("testFrictionContactIslands : callback", iterations > 0);
+  }
+
+  // a table shared by the piles joins them, unless it is fixed
+  for (unsigned int fixed = 0; fixed < 2; ++fixed)
+  {
+    std::vector<SP::LagrangianLinearTIDS> balls;
+    SP::TimeStepping sim = islandsScene(true, fixed, NM_SPARSE_BLOCK, balls);
+    sim->computeOneStep();
+    std::vector<unsigned int> island;
+    unsigned int nbIslands = sim->nonSmoothDynamicalSystem()->topology()->computeIslands(*sim->indexSet(1), island);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("testFrictionContactIslands : table", fixed ? 2u : 1u, nbIslands);
+  }
+  std::cout << "------- FrictionContact solved by islands ok -------" <<std::endl;
+}
+
+void OSNSPTest::testFrictionContactMatrixFree()
+{
+  std::cout << "------- FrictionContact with a matrix-free operator -------" <<std::endl;
+  int solvers[2] = { SICONOS_FRICTION_3D_EG, SICONOS_FRICTION_3D_ADMM };
+  for (unsigned int s = 0; s < 2; ++s)
+  {
+    // the table couples the contacts of the piles
+    std::vector<SP::LagrangianLinearTIDS> balls, ballsMatrixFree;
+    SP::TimeStepping sim = islandsScene(true, false, NM_SPARSE_BLOCK, balls, solvers[s]);
+    SP::TimeStepping simMatrixFree = islandsScene(true, false, NM_SPARSE_BLOCK, ballsMatrixFree, solvers[s]);
+    SP::FrictionContact osnspb = std11::static_pointer_cast<FrictionContact>
+                                 (sim->oneStepNSProblem(SICONOS_OSNSP_TS_VELOCITY));
+    SP::FrictionContact osnspbMatrixFree = std11::static_pointer_cast<FrictionContact>
+                                           (simMatrixFree->oneStepNSProblem(SICONOS_OSNSP_TS_VELOCITY));
+    osnspb->numericsSolverOptions()->dparam[SICONOS_DPARAM_TOL] = 1e-12;
+    osnspbMatrixFree->numericsSolverOptions()->dparam[SICONOS_DPARAM_TOL] = 1e-12;
+    osnspbMatrixFree->setMatrixFree(true);
+
+    for (unsigned int k = 0; k < 3; ++k)
+    {
+      sim->computeOneStep();
+      simMatrixFree->computeOneStep();
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("testFrictionContactMatrixFree : z", osnspb->z()->size(), osnspbMatrixFree->z()->size());
+      CPPUNIT_ASSERT_MESSAGE("testFrictionContactMatrixFree : z", (*osnspb->z() - *osnspbMatrixFree->z()).normInf() < 1e-8);
+      for (unsigned int i = 0; i < balls.size(); ++i)
+        CPPUNIT_ASSERT_MESSAGE("testFrictionContactMatrixFree : velocity",
+                               (*balls[i]->velocity() - *ballsMatrixFree[i]->velocity()).normInf() < 1e-8);
+      if (k == 0)
+      {
+        // the contacts are coupled, but no extra-diagonal block has been computed
+        SP::InteractionsGraph indexSet = simMatrixFree->indexSet(1);
+        CPPUNIT_ASSERT_MESSAGE("testFrictionContactMatrixFree : coupled contacts", indexSet->edges_number() > 0);
+        InteractionsGraph::EIterator ei, eiend;
+        for (std11::tie(ei, eiend) = indexSet->edges(); ei != eiend; ++ei)
+          CPPUNIT_ASSERT_MESSAGE("testFrictionContactMatrixFree : extra-diagonal blocks",
+                                 !indexSet->properties(*ei).upper_block && !indexSet->properties(*ei).lower_block);
+      }
+      sim->nextStep();
+      simMatrixFree->nextStep();
+    }
+  }
+
+  // the default solver (NSGS) needs the assembled matrix
+  std::vector<SP::LagrangianLinearTIDS> balls;
+  SP::TimeStepping sim = islandsScene(true, false, NM_SPARSE_BLOCK, balls);
+  std11::static_pointer_cast<FrictionContact>(sim->oneStepNSProblem(SICONOS_OSNSP_TS_VELOCITY))->setMatrixFree(true);
+  CPPUNIT_ASSERT_THROW_MESSAGE("testFrictionContactMatrixFree : solver", sim->computeOneStep(), RuntimeException);
+  std::cout << "------- FrictionContact with a matrix-free operator ok -------" <<std::endl;
+}
@@ -49,11 +49,15 @@ private:
 #ifdef HAS_EXTREME_POINT_ALGO
   CPPUNIT_TEST(testAVI);
 #endif
+  CPPUNIT_TEST(testFrictionContactIslands);
+  CPPUNIT_TEST(testFrictionContactMatrixFree);
 
   CPPUNIT_TEST_SUITE_END();
 
   void init();
   void testAVI();
+  void testFrictionContactIslands();
+  void testFrictionContactMatrixFree();
 
   unsigned int _n;
   double _h;
@@ -91,6 +91,48 @@ void ZOHTest::testMatrixExp1()
   std::cout <<std::endl <<std::endl;
 }
 
+void ZOHTest::testMatrixExp2()
+{
+  std::cout << "===========================================" <<std::endl;
+  std::cout << " ===== ZOH tests start ... ===== " <<std::endl;
+  std::cout << "===========================================" <<std::endl;
+  std::cout << "------- Compute matrix exponential with a variable time step -------" <<std::endl;
+  _A->zero();
+  (*_A)(0, 1) = 1;
+  (*_A)(1, 0) = -1;
+  TkVector tk;
+  tk.push_back(_t0);
+  tk.push_back(_t0 + 0.1);
+  tk.push_back(_t0 + 0.3);
+  tk.push_back(_t0 + 0.35);
+  tk.push_back(_t0 + 0.6);
+  _DS.reset(new FirstOrderLinearTIDS(_x0, _A, _b));
+  _TD.reset(new TimeDiscretisation(tk));
+  _model.reset(new NonSmoothDynamicalSystem(_t0, tk.back()));
+  _sim.reset(new TimeStepping(_model, _TD, 0));
+  _ZOH.reset(new ZeroOrderHoldOSI());
+  _model->insertDynamicalSystem(_DS);
+  _sim->associate(_ZOH, _DS);
+  _sim->initialize();
+  SimpleMatrix tmpM(_n, _n);
+  double diff = 0.;
+  for (unsigned int k = 0; k < tk.size() - 1; k++)
+  {
+    _sim->computeOneStep();
+    double h = tk[k + 1] - tk[k];
+    tmpM(0, 0) = cos(h);
+    tmpM(0, 1) = sin(h);
+    tmpM(1, 0) = -sin(h);
+    tmpM(1, 1) = cos(h);
+    diff = std::max(diff, (tmpM - _ZOH->Ad(_DS)).normInf());
+    if (k < tk.size() - 2)
+      _sim->nextStep();
+  }
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testMatrixExp2 : ", diff < _tol, true);
+  std::cout << "------- Third computation ok, error = " << diff << " -------" <<std::endl;
+  std::cout <<std::endl <<std::endl;
+}
+
 void ZOHTest::testMatrixIntegration1()
 {
   std::cout << "===========================================" <<std::endl;
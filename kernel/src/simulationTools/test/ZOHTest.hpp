@@ -46,6 +46,7 @@ private:
 
   CPPUNIT_TEST(testMatrixExp0);
   CPPUNIT_TEST(testMatrixExp1);
+  CPPUNIT_TEST(testMatrixExp2);
   CPPUNIT_TEST(testMatrixIntegration1);
   CPPUNIT_TEST(testMatrixIntegration2);
   CPPUNIT_TEST(testMatrixIntegration3);
@@ -57,6 +58,7 @@ private:
   void init();
   void testMatrixExp0();
   void testMatrixExp1();
+  void testMatrixExp2();
   void testMatrixIntegration1();
   void testMatrixIntegration2();
   void testMatrixIntegration3();
@@ -34,6 +34,15 @@ namespace Siconos {
         A.resetLU();
         Exp.resetLU();
         assert(Exp.num() == 1 || A.num() == 1);
+        // expm_pad does not handle a null matrix, exp(0) = I
+        if(A.normInf() == 0.)
+        {
+          if(computeAndAdd)
+            *Exp.dense() += ublas::identity_matrix<double>(A.size(0));
+          else
+            Exp.eye();
+          return;
+        }
         if(computeAndAdd)
           *Exp.dense() += expm_pad(*A.dense());
         else
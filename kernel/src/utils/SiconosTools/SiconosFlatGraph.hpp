@@ -0,0 +1,1405 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/*! \file SiconosFlatGraph.hpp
+  Contiguous storage backend of SiconosGraph.
+
+  This file is included by SiconosGraph.hpp when siconos is configured
+  with SICONOS_USE_FLAT_GRAPH=ON. It must not be included directly.
+
+  Vertices and edges (with their bundles and properties) are stored in
+  two std::vector, so that a walk over the vertices or the edges of an
+  index set is a linear scan of memory. Descriptors are stable handles
+  resolved through an indirection table:
+
+  - a removal only marks the record as dead, iterators on the other
+    records remain valid, exactly as with boost::listS ;
+  - dead records are squeezed out by update_vertices_indices() and
+    update_edges_indices(), which also set index() to the position of
+    the record in memory. As for the boost backend, these two functions
+    must not be called while iterating over the graph.
+
+  The public interface and the traversal order (insertion order) are
+  the same as with the boost::adjacency_list backend.
+*/
+
+#ifndef SICONOS_FLAT_GRAPH_HPP
+#define SICONOS_FLAT_GRAPH_HPP
+
+#ifndef SICONOS_GRAPH_HPP
+#error "SiconosFlatGraph.hpp must be included through SiconosGraph.hpp"
+#endif
+
+#include <vector>
+#include <algorithm>
+#include <iostream>
+
+#include <boost/core/explicit_operator_bool.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/mpl/if.hpp>
+#include <boost/serialization/nvp.hpp>
+
+/** vertex descriptor of the contiguous backend : a stable handle */
+struct SiconosFlatVDescriptor
+{
+  size_t handle;
+
+  SiconosFlatVDescriptor() : handle(std::numeric_limits<size_t>::max()) {};
+
+  explicit SiconosFlatVDescriptor(size_t h) : handle(h) {};
+
+  /** false for a default constructed descriptor, as a null pointer
+   *  with boost::listS */
+  BOOST_EXPLICIT_OPERATOR_BOOL()
+
+  bool operator!() const
+  {
+    return handle == std::numeric_limits<size_t>::max();
+  };
+
+  bool operator==(const SiconosFlatVDescriptor& vd) const
+  {
+    return handle == vd.handle;
+  };
+
+  bool operator!=(const SiconosFlatVDescriptor& vd) const
+  {
+    return handle != vd.handle;
+  };
+
+  bool operator<(const SiconosFlatVDescriptor& vd) const
+  {
+    return handle < vd.handle;
+  };
+
+  template<class Archive>
+  void serialize(Archive& ar, const unsigned int version)
+  {
+    ar & boost::serialization::make_nvp("handle", handle);
+  };
+};
+
+inline std::ostream& operator<<(std::ostream& os,
+                                const SiconosFlatVDescriptor& vd)
+{
+  return os << vd.handle;
+}
+
+/** edge descriptor of the contiguous backend. As for an undirected
+ * boost graph, source and target depend on the way the edge has been
+ * reached (source() is the vertex of out_edges()), the comparisons
+ * only use the edge handle.
+ */
+struct SiconosFlatEDescriptor
+{
+  SiconosFlatVDescriptor s;
+  SiconosFlatVDescriptor t;
+  size_t handle;
+
+  SiconosFlatEDescriptor() : handle(std::numeric_limits<size_t>::max()) {};
+
+  SiconosFlatEDescriptor(const SiconosFlatVDescriptor& source,
+                         const SiconosFlatVDescriptor& target,
+                         size_t h) : s(source), t(target), handle(h) {};
+
+  bool operator==(const SiconosFlatEDescriptor& ed) const
+  {
+    return handle == ed.handle;
+  };
+
+  bool operator!=(const SiconosFlatEDescriptor& ed) const
+  {
+    return handle != ed.handle;
+  };
+
+  bool operator<(const SiconosFlatEDescriptor& ed) const
+  {
+    return handle < ed.handle;
+  };
+
+  template<class Archive>
+  void serialize(Archive& ar, const unsigned int version)
+  {
+    ar & boost::serialization::make_nvp("s", s);
+    ar & boost::serialization::make_nvp("t", t);
+    ar & boost::serialization::make_nvp("handle", handle);
+  };
+};
+
+inline std::ostream& operator<<(std::ostream& os,
+                                const SiconosFlatEDescriptor& ed)
+{
+  return os << "(" << ed.s << "," << ed.t << ")";
+}
+
+/** the storage of the contiguous backend.
+ * vslot[h] (resp. eslot[h]) is the position of the vertex (resp. edge)
+ * of handle h in vertices (resp. edges), or npos if h is free.
+ */
+template < class V, class E, class VProperties,
+         class EProperties, class GProperties >
+struct SiconosFlatGraphStorage
+{
+  static size_t npos()
+  {
+    return std::numeric_limits<size_t>::max();
+  };
+
+  /** an entry of an incidence list */
+  struct out_edge_t
+  {
+    size_t target;
+    size_t edge;
+
+    out_edge_t() : target(npos()), edge(npos()) {};
+    out_edge_t(size_t t, size_t e) : target(t), edge(e) {};
+
+    template<class Archive>
+    void serialize(Archive& ar, const unsigned int version)
+    {
+      ar & boost::serialization::make_nvp("target", target);
+      ar & boost::serialization::make_nvp("edge", edge);
+    };
+  };
+
+  struct vertex_record
+  {
+    size_t handle;
+    bool alive;
+    V bundle;
+    boost::default_color_type color;
+    size_t index;
+    VProperties properties;
+    std::vector<out_edge_t> out;
+
+    vertex_record() : handle(npos()), alive(false),
+                      color(boost::white_color), index(npos()) {};
+
+    template<class Archive>
+    void serialize(Archive& ar, const unsigned int version)
+    {
+      ar & boost::serialization::make_nvp("handle", handle);
+      ar & boost::serialization::make_nvp("alive", alive);
+      ar & boost::serialization::make_nvp("bundle", bundle);
+      ar & boost::serialization::make_nvp("color", color);
+      ar & boost::serialization::make_nvp("index", index);
+      ar & boost::serialization::make_nvp("properties", properties);
+      ar & boost::serialization::make_nvp("out", out);
+    };
+  };
+
+  struct edge_record
+  {
+    size_t handle;
+    bool alive;
+    size_t source;
+    size_t target;
+    E bundle;
+    boost::default_color_type color;
+    size_t index;
+    EProperties properties;
+
+    edge_record() : handle(npos()), alive(false), source(npos()),
+                    target(npos()), color(boost::white_color),
+                    index(npos()) {};
+
+    template<class Archive>
+    void serialize(Archive& ar, const unsigned int version)
+    {
+      ar & boost::serialization::make_nvp("handle", handle);
+      ar & boost::serialization::make_nvp("alive", alive);
+      ar & boost::serialization::make_nvp("source", source);
+      ar & boost::serialization::make_nvp("target", target);
+      ar & boost::serialization::make_nvp("bundle", bundle);
+      ar & boost::serialization::make_nvp("color", color);
+      ar & boost::serialization::make_nvp("index", index);
+      ar & boost::serialization::make_nvp("properties", properties);
+    };
+  };
+
+  std::vector<vertex_record> vertices;
+  std::vector<edge_record> edges;
+  std::vector<size_t> vslot;
+  std::vector<size_t> eslot;
+  std::vector<size_t> vfree;
+  std::vector<size_t> efree;
+  size_t num_vertices;
+  size_t num_edges;
+  GProperties graph_properties;
+
+  SiconosFlatGraphStorage() : num_vertices(0), num_edges(0) {};
+
+  vertex_record& vertex(size_t h)
+  {
+    assert(h < vslot.size() && vslot[h] != npos());
+    return vertices[vslot[h]];
+  };
+
+  const vertex_record& vertex(size_t h) const
+  {
+    assert(h < vslot.size() && vslot[h] != npos());
+    return vertices[vslot[h]];
+  };
+
+  edge_record& edge(size_t h)
+  {
+    assert(h < eslot.size() && eslot[h] != npos());
+    return edges[eslot[h]];
+  };
+
+  const edge_record& edge(size_t h) const
+  {
+    assert(h < eslot.size() && eslot[h] != npos());
+    return edges[eslot[h]];
+  };
+
+  bool edge_alive(size_t h) const
+  {
+    return h < eslot.size() && eslot[h] != npos();
+  };
+
+  static size_t new_handle(std::vector<size_t>& slot,
+                           std::vector<size_t>& free_handles,
+                           size_t pos)
+  {
+    size_t h;
+    if (free_handles.empty())
+    {
+      h = slot.size();
+      slot.push_back(pos);
+    }
+    else
+    {
+      h = free_handles.back();
+      free_handles.pop_back();
+      slot[h] = pos;
+    }
+    return h;
+  };
+
+  size_t add_vertex()
+  {
+    size_t h = new_handle(vslot, vfree, vertices.size());
+    vertices.push_back(vertex_record());
+    vertices.back().handle = h;
+    vertices.back().alive = true;
+    ++num_vertices;
+    return h;
+  };
+
+  /* as with boost::undirectedS, a self loop appears twice in the
+     incidence list of its vertex */
+  size_t add_edge(size_t u, size_t v)
+  {
+    size_t h = new_handle(eslot, efree, edges.size());
+    edges.push_back(edge_record());
+    edge_record& er = edges.back();
+    er.handle = h;
+    er.alive = true;
+    er.source = u;
+    er.target = v;
+    vertex(u).out.push_back(out_edge_t(v, h));
+    vertex(v).out.push_back(out_edge_t(u, h));
+    ++num_edges;
+    return h;
+  };
+
+  struct has_edge
+  {
+    size_t _h;
+    has_edge(size_t h) : _h(h) {};
+    bool operator()(const out_edge_t& oe) const
+    {
+      return oe.edge == _h;
+    };
+  };
+
+  void remove_edge(size_t h)
+  {
+    edge_record& er = edge(h);
+    std::vector<out_edge_t>& outu = vertex(er.source).out;
+    outu.erase(std::remove_if(outu.begin(), outu.end(), has_edge(h)),
+               outu.end());
+    if (er.target != er.source)
+    {
+      std::vector<out_edge_t>& outv = vertex(er.target).out;
+      outv.erase(std::remove_if(outv.begin(), outv.end(), has_edge(h)),
+                 outv.end());
+    }
+    er.alive = false;
+    er.bundle = E();
+    er.properties = EProperties();
+    eslot[h] = npos();
+    efree.push_back(h);
+    --num_edges;
+  };
+
+  void clear_vertex(size_t h)
+  {
+    // copy: remove_edge modifies the incidence list
+    std::vector<out_edge_t> out = vertex(h).out;
+    for (size_t i = 0; i < out.size(); ++i)
+    {
+      if (edge_alive(out[i].edge))
+        remove_edge(out[i].edge);
+    }
+  };
+
+  void remove_vertex(size_t h)
+  {
+    vertex_record& vr = vertex(h);
+    assert(vr.out.empty());
+    vr.alive = false;
+    vr.bundle = V();
+    vr.properties = VProperties();
+    std::vector<out_edge_t>().swap(vr.out);
+    vslot[h] = npos();
+    vfree.push_back(h);
+    --num_vertices;
+  };
+
+  /* dead records removal, the relative order of live records is kept */
+  template<class Record>
+  static void compact(std::vector<Record>& records, std::vector<size_t>& slot)
+  {
+    size_t j = 0;
+    for (size_t i = 0; i < records.size(); ++i)
+    {
+      if (records[i].alive)
+      {
+        if (i != j)
+        {
+          std::swap(records[j], records[i]);
+        }
+        slot[records[j].handle] = j;
+        ++j;
+      }
+    }
+    records.erase(records.begin() + j, records.end());
+  };
+
+  void compact_vertices()
+  {
+    compact(vertices, vslot);
+  };
+
+  void compact_edges()
+  {
+    compact(edges, eslot);
+  };
+
+  void clear()
+  {
+    vertices.clear();
+    edges.clear();
+    vslot.clear();
+    eslot.clear();
+    vfree.clear();
+    efree.clear();
+    num_vertices = 0;
+    num_edges = 0;
+  };
+
+  template<class Archive>
+  void serialize(Archive& ar, const unsigned int version)
+  {
+    ar & boost::serialization::make_nvp("vertices", vertices);
+    ar & boost::serialization::make_nvp("edges", edges);
+    ar & boost::serialization::make_nvp("vslot", vslot);
+    ar & boost::serialization::make_nvp("eslot", eslot);
+    ar & boost::serialization::make_nvp("vfree", vfree);
+    ar & boost::serialization::make_nvp("efree", efree);
+    ar & boost::serialization::make_nvp("num_vertices", num_vertices);
+    ar & boost::serialization::make_nvp("num_edges", num_edges);
+    ar & boost::serialization::make_nvp("graph_properties", graph_properties);
+  };
+};
+
+/** iterator over the live vertices of the contiguous storage */
+template<class Storage>
+class SiconosFlatVIterator :
+  public boost::iterator_facade < SiconosFlatVIterator<Storage>,
+  SiconosFlatVDescriptor, boost::forward_traversal_tag,
+  SiconosFlatVDescriptor& >
+{
+public:
+  typedef SiconosFlatVDescriptor value_t;
+
+  SiconosFlatVIterator() : _s(0), _pos(Storage::npos()) {};
+
+  SiconosFlatVIterator(const Storage* s, size_t pos) : _s(s), _pos(pos)
+  {
+    skip();
+  };
+
+private:
+  friend class boost::iterator_core_access;
+
+  const Storage* _s;
+  size_t _pos;
+  // the descriptors are not stored as such, a reference on a copy is given
+  mutable value_t _current;
+
+  void skip()
+  {
+    while (_pos < _s->vertices.size() && !_s->vertices[_pos].alive) ++_pos;
+    if (_pos >= _s->vertices.size()) _pos = Storage::npos();
+  };
+
+  void increment()
+  {
+    ++_pos;
+    skip();
+  };
+
+  bool equal(const SiconosFlatVIterator& other) const
+  {
+    return _pos == other._pos;
+  };
+
+  SiconosFlatVDescriptor& dereference() const
+  {
+    _current = SiconosFlatVDescriptor(_s->vertices[_pos].handle);
+    return _current;
+  };
+};
+
+/** iterator over the live edges of the contiguous storage */
+template<class Storage>
+class SiconosFlatEIterator :
+  public boost::iterator_facade < SiconosFlatEIterator<Storage>,
+  SiconosFlatEDescriptor, boost::forward_traversal_tag,
+  SiconosFlatEDescriptor& >
+{
+public:
+  typedef SiconosFlatEDescriptor value_t;
+
+  SiconosFlatEIterator() : _s(0), _pos(Storage::npos()) {};
+
+  SiconosFlatEIterator(const Storage* s, size_t pos) : _s(s), _pos(pos)
+  {
+    skip();
+  };
+
+private:
+  friend class boost::iterator_core_access;
+
+  const Storage* _s;
+  size_t _pos;
+  mutable value_t _current;
+
+  void skip()
+  {
+    while (_pos < _s->edges.size() && !_s->edges[_pos].alive) ++_pos;
+    if (_pos >= _s->edges.size()) _pos = Storage::npos();
+  };
+
+  void increment()
+  {
+    ++_pos;
+    skip();
+  };
+
+  bool equal(const SiconosFlatEIterator& other) const
+  {
+    return _pos == other._pos;
+  };
+
+  SiconosFlatEDescriptor& dereference() const
+  {
+    const typename Storage::edge_record& er = _s->edges[_pos];
+    _current = SiconosFlatEDescriptor(SiconosFlatVDescriptor(er.source),
+                                      SiconosFlatVDescriptor(er.target),
+                                      er.handle);
+    return _current;
+  };
+};
+
+/** iterator over the incidence list of a vertex. With Adjacent=false
+ * it gives the out edges, with Adjacent=true the adjacent vertices.
+ */
+template<class Storage, bool Adjacent>
+class SiconosFlatOutIterator :
+  public boost::iterator_facade < SiconosFlatOutIterator<Storage, Adjacent>,
+  typename boost::mpl::if_c<Adjacent, SiconosFlatVDescriptor,
+                            SiconosFlatEDescriptor>::type,
+  boost::forward_traversal_tag,
+  typename boost::mpl::if_c<Adjacent, SiconosFlatVDescriptor,
+                            SiconosFlatEDescriptor>::type& >
+{
+public:
+  typedef typename boost::mpl::if_c<Adjacent, SiconosFlatVDescriptor,
+                                    SiconosFlatEDescriptor>::type value_t;
+
+  SiconosFlatOutIterator() : _s(0), _vd(), _pos(Storage::npos()) {};
+
+  SiconosFlatOutIterator(const Storage* s, const SiconosFlatVDescriptor& vd,
+                         size_t pos) : _s(s), _vd(vd), _pos(pos)
+  {
+    if (_pos >= _s->vertex(_vd.handle).out.size()) _pos = Storage::npos();
+  };
+
+private:
+  friend class boost::iterator_core_access;
+
+  const Storage* _s;
+  SiconosFlatVDescriptor _vd;
+  size_t _pos;
+  mutable value_t _current;
+
+  void increment()
+  {
+    ++_pos;
+    if (_pos >= _s->vertex(_vd.handle).out.size()) _pos = Storage::npos();
+  };
+
+  bool equal(const SiconosFlatOutIterator& other) const
+  {
+    return _pos == other._pos && (_pos == Storage::npos() || _vd == other._vd);
+  };
+
+  value_t& dereference() const
+  {
+    _current = make(_s->vertex(_vd.handle).out[_pos], (value_t*)0);
+    return _current;
+  };
+
+  SiconosFlatVDescriptor make(const typename Storage::out_edge_t& oe,
+                              SiconosFlatVDescriptor*) const
+  {
+    return SiconosFlatVDescriptor(oe.target);
+  };
+
+  SiconosFlatEDescriptor make(const typename Storage::out_edge_t& oe,
+                              SiconosFlatEDescriptor*) const
+  {
+    return SiconosFlatEDescriptor(_vd, SiconosFlatVDescriptor(oe.target),
+                                  oe.edge);
+  };
+};
+
+/** index property map, for Siconos::Properties */
+template<class G, class Descriptor>
+struct SiconosFlatIndexMap
+{
+  typedef Descriptor key_type;
+  typedef size_t value_type;
+  typedef size_t& reference;
+  typedef boost::lvalue_property_map_tag category;
+
+  G* _g;
+
+  SiconosFlatIndexMap(G* g = 0) : _g(g) {};
+
+  reference operator[](const key_type& k) const
+  {
+    return _g->index(k);
+  };
+};
+
+
+template < class V, class E, class VProperties,
+         class EProperties, class GProperties >
+class SiconosGraph
+{
+public:
+
+  typedef SiconosFlatGraphStorage < V, E, VProperties,
+          EProperties, GProperties > graph_t;
+
+  typedef SiconosFlatVDescriptor VDescriptor;
+
+  typedef SiconosFlatEDescriptor EDescriptor;
+
+  typedef V vertex_t;
+
+  typedef E edge_t;
+
+  typedef SiconosFlatVIterator<graph_t> VIterator;
+
+  typedef SiconosFlatEIterator<graph_t> EIterator;
+
+  typedef SiconosFlatOutIterator<graph_t, false> OEIterator;
+
+  typedef SiconosFlatOutIterator<graph_t, true> AVIterator;
+
+  typedef SiconosFlatIndexMap<SiconosGraph, EDescriptor> EIndexAccess;
+
+  typedef SiconosFlatIndexMap<SiconosGraph, VDescriptor> VIndexAccess;
+
+#if defined(SICONOS_STD_UNORDERED_MAP) && !defined(SICONOS_USE_MAP_FOR_HASH)
+  typedef typename std::unordered_map<V, VDescriptor> VMap;
+#else
+  typedef typename std::map<V, VDescriptor> VMap;
+#endif
+
+
+  int _stamp;
+  VMap vertex_descriptor;
+
+protected:
+  /** serialization hooks
+  */
+  typedef void serializable;
+  template<typename Archive>
+  friend void siconos_io(Archive&, SiconosGraph < V, E, VProperties, EProperties,
+                         GProperties > &,
+                         const unsigned int);
+  friend class boost::serialization::access;
+
+  graph_t g;
+
+private:
+
+  SiconosGraph(const SiconosGraph&);
+
+public:
+
+  /** default constructor
+   */
+  SiconosGraph() : _stamp(0)
+  {
+  };
+
+  ~SiconosGraph()
+  {
+    g.clear();
+  };
+
+  const graph_t& storage() const
+  {
+    return g;
+  }
+
+
+  std::pair<EDescriptor, bool>
+  edge(VDescriptor u, VDescriptor v) const
+  {
+    const std::vector<typename graph_t::out_edge_t>& out = g.vertex(u.handle).out;
+    for (size_t i = 0; i < out.size(); ++i)
+    {
+      if (out[i].target == v.handle)
+      {
+        return std::pair<EDescriptor, bool>(EDescriptor(u, v, out[i].edge), true);
+      }
+    }
+    return std::pair<EDescriptor, bool>(EDescriptor(), false);
+  }
+
+  bool edge_exists(const VDescriptor& vd1, const VDescriptor& vd2) const
+  {
+    bool ret = false;
+    EDescriptor tmped;
+    std11::tie(tmped, ret) = edge(vd1, vd2);
+
+#ifndef NDEBUG
+    bool check_ret = false;
+    AVIterator avi, aviend;
+    for (std11::tie(avi, aviend) = adjacent_vertices(vd1);
+         avi != aviend; ++avi)
+    {
+      if (*avi == vd2)
+      {
+        check_ret = true;
+        break;
+      }
+      assert(is_vertex(bundle(*avi)));
+      assert(bundle(descriptor(bundle(*avi))) == bundle(*avi));
+    }
+    assert(ret == check_ret);
+#endif
+
+    return ret;
+  }
+
+  /* parallel edges : only needed for AdjointGraph where only 2 edges
+     may be in common which correspond to the source and target in
+     primal graph
+   */
+  std::pair<EDescriptor, EDescriptor>
+  edges(VDescriptor u, VDescriptor v) const
+  {
+    OEIterator oei, oeiend;
+    bool ifirst = false;
+    bool isecond = false;
+    EDescriptor first, second;
+    for (std11::tie(oei, oeiend) = out_edges(u); oei != oeiend; ++oei)
+    {
+      if (target(*oei) == v)
+      {
+        if (!ifirst)
+        {
+          ifirst = true;
+          first = *oei;
+        }
+        else
+        {
+          isecond = true;
+          second = *oei;
+          break;
+        }
+      }
+    }
+
+    if (ifirst && isecond)
+    {
+      if (index(first) < index(second))
+      {
+        return std::pair<EDescriptor, EDescriptor>(first, second);
+      }
+      else
+      {
+        return std::pair<EDescriptor, EDescriptor>(second, first);
+      }
+    }
+    else if (ifirst)
+    {
+      return std::pair<EDescriptor, EDescriptor>(first, first);
+    }
+    else
+    {
+      throw(1);
+    }
+
+  }
+
+  bool is_edge(const VDescriptor& vd1, const VDescriptor& vd2,
+               const E& e_bundle) const
+  {
+    bool found = false;
+    OEIterator oei, oeiend;
+    for (std11::tie(oei, oeiend) = out_edges(vd1);
+         oei != oeiend; ++oei)
+    {
+      if (target(*oei) == vd2 && bundle(*oei) == e_bundle)
+      {
+        found = true;
+        break;
+      }
+    }
+    return found;
+  }
+
+  bool adjacent_vertex_exists(const VDescriptor& vd) const
+  {
+    bool ret = false;
+    VIterator vi, viend;
+    for (std11::tie(vi, viend) = vertices(); vi != viend; ++vi)
+    {
+      assert(is_vertex(bundle(*vi)));
+      assert(bundle(descriptor(bundle(*vi))) == bundle(*vi));
+
+      ret = edge_exists(vd, *vi);
+      if (ret) break;
+    }
+    return ret;
+  }
+
+
+  size_t size() const
+  {
+    return g.num_vertices;
+  };
+
+  size_t vertices_number() const
+  {
+    return g.num_vertices;
+  };
+
+  size_t edges_number() const
+  {
+    return g.num_edges;
+  };
+
+  inline V& bundle(const VDescriptor& vd)
+  {
+    return g.vertex(vd.handle).bundle;
+  };
+
+  inline const V& bundle(const VDescriptor& vd) const
+  {
+    return g.vertex(vd.handle).bundle;
+  };
+
+  inline E& bundle(const EDescriptor& ed)
+  {
+    return g.edge(ed.handle).bundle;
+  };
+
+  inline const E& bundle(const EDescriptor& ed) const
+  {
+    return g.edge(ed.handle).bundle;
+  };
+
+  inline boost::default_color_type& color(const VDescriptor& vd)
+  {
+    return g.vertex(vd.handle).color;
+  };
+
+  inline const boost::default_color_type& color(const VDescriptor& vd) const
+  {
+    return g.vertex(vd.handle).color;
+  };
+
+  inline boost::default_color_type& color(const EDescriptor& ed)
+  {
+    return g.edge(ed.handle).color;
+  };
+
+  inline const boost::default_color_type& color(const EDescriptor& ed) const
+  {
+    return g.edge(ed.handle).color;
+  };
+
+  inline GProperties& properties()
+  {
+    return g.graph_properties;
+  };
+
+  inline size_t& index(const VDescriptor& vd)
+  {
+    return g.vertex(vd.handle).index;
+  };
+
+  inline const size_t& index(const VDescriptor& vd) const
+  {
+    return g.vertex(vd.handle).index;
+  };
+
+  inline size_t& index(const EDescriptor& ed)
+  {
+    return g.edge(ed.handle).index;
+  };
+
+  inline const size_t& index(const EDescriptor& ed) const
+  {
+    return g.edge(ed.handle).index;
+  };
+
+  inline VProperties& properties(const VDescriptor& vd)
+  {
+    return g.vertex(vd.handle).properties;
+  };
+
+  inline EProperties& properties(const EDescriptor& ed)
+  {
+    return g.edge(ed.handle).properties;
+  };
+
+  inline bool is_vertex(const V& vertex) const
+  {
+    return (vertex_descriptor.find(vertex) != vertex_descriptor.end());
+  }
+
+  inline const VDescriptor& descriptor(const V& vertex) const
+  {
+    assert(size() == vertex_descriptor.size());
+    assert(vertex_descriptor.find(vertex) != vertex_descriptor.end());
+    return (*vertex_descriptor.find(vertex)).second;
+  }
+
+  inline std::pair<VIterator, VIterator> vertices() const
+  {
+    return std::pair<VIterator, VIterator>(VIterator(&g, 0),
+                                           VIterator(&g, graph_t::npos()));
+  };
+
+  inline VIterator begin() const
+  {
+    return VIterator(&g, 0);
+  }
+
+  inline VIterator end() const
+  {
+    return VIterator(&g, graph_t::npos());
+  }
+
+  inline std::pair<AVIterator, AVIterator> adjacent_vertices(const VDescriptor& vd) const
+  {
+    return std::pair<AVIterator, AVIterator>(AVIterator(&g, vd, 0),
+                                             AVIterator(&g, vd, graph_t::npos()));
+  };
+
+  inline std::pair<EIterator, EIterator> edges() const
+  {
+    return std::pair<EIterator, EIterator>(EIterator(&g, 0),
+                                           EIterator(&g, graph_t::npos()));
+  };
+
+  inline std::pair<OEIterator, OEIterator> out_edges(const VDescriptor& vd) const
+  {
+    return std::pair<OEIterator, OEIterator>(OEIterator(&g, vd, 0),
+                                             OEIterator(&g, vd, graph_t::npos()));
+  };
+
+  inline VDescriptor target(const EDescriptor& ed) const
+  {
+    return ed.t;
+  };
+
+  inline VDescriptor source(const EDescriptor& ed) const
+  {
+    return ed.s;
+  };
+
+
+  VDescriptor add_vertex(const V& vertex_bundle)
+  {
+    assert(vertex_descriptor.size() == size()) ;
+
+    typename VMap::iterator current_vertex_iterator =
+      vertex_descriptor.find(vertex_bundle);
+
+    if (current_vertex_iterator == vertex_descriptor.end())
+    {
+      VDescriptor new_vertex_descriptor(g.add_vertex());
+
+      assert(size() == vertex_descriptor.size() + 1);
+
+      vertex_descriptor[vertex_bundle] = new_vertex_descriptor;
+      assert(size() == vertex_descriptor.size());
+
+      bundle(new_vertex_descriptor) = vertex_bundle;
+
+      assert(descriptor(vertex_bundle) == new_vertex_descriptor);
+      assert(bundle(descriptor(vertex_bundle)) == vertex_bundle);
+
+      index(new_vertex_descriptor) = std::numeric_limits<size_t>::max() ;
+      return new_vertex_descriptor;
+    }
+    else
+    {
+      assert(descriptor(vertex_bundle) == current_vertex_iterator->second);
+      assert(bundle(descriptor(vertex_bundle)) == vertex_bundle);
+      return current_vertex_iterator->second;
+    }
+  }
+
+  template<class G> void copy_vertex(const V& vertex_bundle, G& og)
+  {
+
+    // is G similar ?
+    BOOST_STATIC_ASSERT((boost::is_same
+                         <typename G::vertex_t, vertex_t>::value));
+    BOOST_STATIC_ASSERT((boost::is_same
+                         <typename G::edge_t, edge_t>::value));
+
+    assert(og.is_vertex(vertex_bundle));
+
+    VDescriptor descr = add_vertex(vertex_bundle);
+    properties(descr) = og.properties(og.descriptor(vertex_bundle));
+
+    assert(bundle(descr) == vertex_bundle);
+
+    // edges copy as in boost::subgraph
+    typename G::OEIterator ogoei, ogoeiend;
+    for (std11::tie(ogoei, ogoeiend) =
+           og.out_edges(og.descriptor(vertex_bundle));
+         ogoei != ogoeiend; ++ogoei)
+    {
+      typename G::VDescriptor ognext_descr = og.target(*ogoei);
+
+      assert(og.is_vertex(og.bundle(ognext_descr)));
+
+      // target in graph ?
+      if (is_vertex(og.bundle(ognext_descr)))
+      {
+        assert(bundle(descriptor(og.bundle(ognext_descr)))
+               == og.bundle(ognext_descr));
+
+        EDescriptor edescr =
+          add_edge(descr, descriptor(og.bundle(ognext_descr)),
+                   og.bundle(*ogoei));
+
+        properties(edescr) = og.properties(*ogoei);
+
+        assert(bundle(edescr) == og.bundle(*ogoei));
+      }
+    }
+  }
+
+  void remove_vertex(const V& vertex_bundle)
+  {
+    assert(is_vertex(vertex_bundle));
+    assert(vertex_descriptor.size() == size());
+    assert(bundle(descriptor(vertex_bundle)) == vertex_bundle);
+
+
+    VDescriptor vd = descriptor(vertex_bundle);
+    /*   debug */
+#ifndef NDEBUG
+    assert(adjacent_vertices_ok());
+#endif
+    g.clear_vertex(vd.handle);
+    /*   debug */
+#ifndef NDEBUG
+    assert(adjacent_vertices_ok());
+    assert(!adjacent_vertex_exists(vd));
+#endif
+    g.remove_vertex(vd.handle);
+
+    assert(vertex_descriptor.size() == (size() + 1));
+
+    vertex_descriptor.erase(vertex_bundle);
+
+    /*  debug */
+#ifndef NDEBUG
+    assert(adjacent_vertices_ok());
+    assert(vertex_descriptor.size() == size());
+    assert(!is_vertex(vertex_bundle));
+    assert(state_assert());
+#endif
+  }
+
+
+  EDescriptor add_edge(const VDescriptor& vd1,
+                       const VDescriptor& vd2,
+                       const E& e_bundle)
+  {
+    assert(is_vertex(bundle(vd1)));
+    assert(is_vertex(bundle(vd2)));
+
+    assert(descriptor(bundle(vd1)) == vd1);
+    assert(descriptor(bundle(vd2)) == vd2);
+
+    assert(!is_edge(vd1, vd2, e_bundle));
+
+    EDescriptor new_edge(vd1, vd2, g.add_edge(vd1.handle, vd2.handle));
+
+    index(new_edge) = std::numeric_limits<size_t>::max();
+
+    bundle(new_edge) = e_bundle;
+
+    assert(is_edge(vd1, vd2, e_bundle));
+
+    return new_edge;
+  }
+
+  template<class AdjointG>
+  std::pair<EDescriptor, typename AdjointG::VDescriptor>
+  add_edge(const VDescriptor& vd1,
+           const VDescriptor& vd2,
+           const E& e_bundle,
+           AdjointG& ag)
+  {
+
+    // adjoint static assertions
+    BOOST_STATIC_ASSERT((boost::is_same
+                         <typename AdjointG::vertex_t, edge_t>::value));
+    BOOST_STATIC_ASSERT((boost::is_same
+                         <typename AdjointG::edge_t, vertex_t>::value));
+
+
+    EDescriptor new_ed = add_edge(vd1, vd2, e_bundle);
+
+    typename AdjointG::VDescriptor new_ve = ag.add_vertex(e_bundle);
+
+    assert(bundle(new_ed) == ag.bundle(new_ve));
+    assert(ag.size() == edges_number());
+
+    // better to build a range [vd1,vd2] or [vd1]...
+    bool endl = false;
+    for (VDescriptor vdx = vd1; !endl; vdx = vd2)
+    {
+      assert(vdx == vd1 || vdx == vd2);
+
+      if (vdx == vd2) endl = true;
+
+#if defined(SICONOS_STD_UNORDERED_MAP) && !defined(SICONOS_USE_MAP_FOR_HASH)
+      std::unordered_map<E, EDescriptor> Edone;
+#else
+      std::map<E, EDescriptor> Edone;
+#endif
+
+
+      OEIterator ied, iedend;
+      for (std11::tie(ied, iedend) = out_edges(vdx);
+           ied != iedend; ++ied)
+      {
+        if (Edone.find(bundle(*ied)) == Edone.end())
+        {
+          Edone[bundle(*ied)] = *ied;
+
+          assert(source(*ied) == vdx);
+
+          if (*ied != new_ed)
+            // so this is another edge
+          {
+            assert(bundle(*ied) != e_bundle);
+
+            assert(ag.bundle(ag.descriptor(bundle(*ied))) == bundle(*ied));
+
+            assert(ag.is_vertex(bundle(*ied)));
+
+            assert(new_ve != ag.descriptor(bundle(*ied)));
+
+            assert(!ag.is_edge(new_ve, ag.descriptor(bundle(*ied)),
+                               bundle(vdx)));
+
+            typename AdjointG::EDescriptor aed =
+              ag.add_edge(new_ve, ag.descriptor(bundle(*ied)),
+                          bundle(vdx));
+
+            assert(ag.bundle(aed) == bundle(vdx));
+          }
+        }
+
+      }
+    }
+    assert(ag.size() == edges_number());
+    return std::pair<EDescriptor, typename AdjointG::VDescriptor>(new_ed,
+           new_ve);
+  }
+
+  void remove_edge(const EDescriptor& ed)
+  {
+    assert(adjacent_vertex_exists(target(ed)));
+    assert(adjacent_vertex_exists(source(ed)));
+
+    g.remove_edge(ed.handle);
+    /* debug */
+#ifndef NDEBUG
+    assert(state_assert());
+#endif
+  }
+
+  template<class AdjointG>
+  void remove_edge(const EDescriptor& ed, AdjointG& ag)
+  {
+
+    // adjoint static assertions
+    BOOST_STATIC_ASSERT((boost::is_same
+                         <typename AdjointG::vertex_t, edge_t>::value));
+    BOOST_STATIC_ASSERT((boost::is_same
+                         <typename AdjointG::edge_t, vertex_t>::value));
+
+
+    assert(ag.size() == edges_number());
+
+    assert(bundle(ed) == ag.bundle(ag.descriptor(bundle(ed))));
+
+    remove_vertex(ag.bundle(ag.descriptor(bundle(ed))));
+    remove_edge(ed);
+
+    assert(ag.size() == edges_number());
+    /* debug */
+#ifndef NDEBUG
+    assert(state_assert());
+#endif
+  }
+
+  /** Remove all the out-edges of vertex u for which the predicate p
+   * returns true.
+   */
+  template<class Predicate>
+  void remove_out_edge_if(const VDescriptor& vd,
+                          const Predicate& pred)
+  {
+    // the predicate is taken by value, as in boost
+    Predicate p(pred);
+
+    // copy: the incidence list is modified by the removals
+    std::vector<typename graph_t::out_edge_t> out = g.vertex(vd.handle).out;
+    for (size_t i = 0; i < out.size(); ++i)
+    {
+      // a self loop is seen twice
+      if (g.edge_alive(out[i].edge) &&
+          p(EDescriptor(vd, VDescriptor(out[i].target), out[i].edge)))
+      {
+        g.remove_edge(out[i].edge);
+      }
+    }
+    /*  debug */
+#ifndef NDEBUG
+    assert(state_assert());
+#endif
+  }
+
+
+  /** Remove all the in-edges of vertex u for which the predicate p
+   * returns true. The graph is undirected: this is
+   * remove_out_edge_if.
+   */
+  template<class Predicate>
+  void remove_in_edge_if(const VDescriptor& vd,
+                         const Predicate& pred)
+  {
+    remove_out_edge_if(vd, pred);
+  }
+
+  /** Remove all the edges of the graph for which the predicate p
+   * returns true.
+   */
+  template<class Predicate>
+  void remove_edge_if(const VDescriptor& vd,
+                      const Predicate& pred)
+  {
+    Predicate p(pred);
+
+    // removed edges are only marked as dead, positions do not move
+    for (size_t i = 0; i < g.edges.size(); ++i)
+    {
+      if (g.edges[i].alive)
+      {
+        const typename graph_t::edge_record& er = g.edges[i];
+        EDescriptor ed(VDescriptor(er.source), VDescriptor(er.target),
+                       er.handle);
+        if (p(ed))
+        {
+          g.remove_edge(ed.handle);
+        }
+      }
+    }
+    /*  debug */
+#ifndef NDEBUG
+    assert(state_assert());
+#endif
+  }
+
+
+  int stamp() const
+  {
+    return _stamp;
+  }
+
+  /** squeeze out the removed vertices and number the vertices by
+   * their position in memory */
+  void update_vertices_indices()
+  {
+    g.compact_vertices();
+    for (size_t i = 0; i < g.vertices.size(); ++i)
+    {
+      g.vertices[i].index = i;
+    }
+    _stamp++;
+  };
+
+  /** squeeze out the removed edges and number the edges by
+   * their position in memory */
+  void update_edges_indices()
+  {
+    g.compact_edges();
+    for (size_t i = 0; i < g.edges.size(); ++i)
+    {
+      g.edges[i].index = i;
+    }
+    _stamp++;
+  };
+
+  void clear()
+  {
+    g.clear();
+    vertex_descriptor.clear();
+  };
+
+  VMap vertex_descriptor_map() const
+  {
+    return vertex_descriptor;
+  };
+
+  void display() const
+  {
+    std::cout << "vertices number :" << vertices_number() << std::endl;
+
+    std::cout << "edges number :" << edges_number() << std::endl;
+    VIterator vi, viend;
+    for (std11::tie(vi, viend) = vertices();
+         vi != viend; ++vi)
+    {
+      std::cout << "vertex :"
+                << *vi
+                << ", bundle :"
+                << bundle(*vi)
+                << ", index : "
+                << index(*vi)
+                << ", color : "
+                << color(*vi);
+      OEIterator oei, oeiend;
+      for (std11::tie(oei, oeiend) = out_edges(*vi);
+           oei != oeiend; ++oei)
+      {
+        std::cout << "---"
+                  << bundle(*oei)
+                  << "-->"
+                  << "bundle : "
+                  << bundle(target(*oei))
+                  << ", index : "
+                  << index(target(*oei))
+                  << ", color : "
+                  << color(target(*oei));
+      }
+      std::cout << std::endl;
+    }
+  }
+
+  /* debug */
+#ifndef SWIG
+#ifndef NDEBUG
+  bool state_assert() const
+  {
+    VIterator vi, viend;
+    for (std11::tie(vi, viend) = vertices(); vi != viend; ++vi)
+    {
+      assert(is_vertex(bundle(*vi)));
+      assert(bundle(descriptor(bundle(*vi))) == bundle(*vi));
+
+      OEIterator ei, eiend;
+      for (std11::tie(ei, eiend) = out_edges(*vi);
+           ei != eiend; ++ei)
+      {
+        assert(is_vertex(bundle(target(*ei))));
+        assert(source(*ei) == *vi);
+      }
+      AVIterator avi, aviend;
+      for (std11::tie(avi, aviend) = adjacent_vertices(*vi);
+           avi != aviend; ++avi)
+      {
+        assert(is_vertex(bundle(*avi)));
+        assert(bundle(descriptor(bundle(*avi))) == bundle(*avi));
+      }
+    }
+    return true;
+
+  }
+
+  bool adjacent_vertices_ok() const
+  {
+
+    VIterator vi, viend;
+    for (std11::tie(vi, viend) = vertices(); vi != viend; ++vi)
+    {
+      assert(is_vertex(bundle(*vi)));
+      assert(bundle(descriptor(bundle(*vi))) == bundle(*vi));
+
+      AVIterator avi, aviend;
+      for (std11::tie(avi, aviend) = adjacent_vertices(*vi);
+           avi != aviend; ++avi)
+      {
+        assert(is_vertex(bundle(*avi)));
+        assert(bundle(descriptor(bundle(*avi))) == bundle(*avi));
+      }
+    }
+    return true;
+  }
+#endif
+#endif
+
+
+};
+
+#endif
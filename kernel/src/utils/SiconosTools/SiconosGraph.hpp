@@ -21,6 +21,11 @@
 
   Note: this need documentation
 
+  The default storage is a boost::adjacency_list with listS
+  containers. If siconos is configured with SICONOS_USE_FLAT_GRAPH=ON,
+  the same class is built on contiguous arrays, see
+  SiconosFlatGraph.hpp.
+
 */
 
 #ifndef SICONOS_GRAPH_HPP
@@ -98,6 +103,9 @@ BOOST_INSTALL_PROPERTY(vertex, siconos_bundle);
 BOOST_INSTALL_PROPERTY(edge, siconos_bundle);
 }
 
+#ifdef SICONOS_USE_FLAT_GRAPH
+#include "SiconosFlatGraph.hpp"
+#else
 
 
 template < class V, class E, class VProperties,
@@ -994,6 +1002,6 @@ public:
 };
 
 
-#endif
-
+#endif /* SICONOS_USE_FLAT_GRAPH */
 
+#endif
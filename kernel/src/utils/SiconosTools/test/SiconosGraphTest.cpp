@@ -370,3 +370,69 @@ void SiconosGraphTest::t8()
   CPPUNIT_ASSERT(g.bundle(vd6) == "three");
 
 }
+
+// descriptors and traversal order after removals and indices update
+void SiconosGraphTest::t9()
+{
+  typedef SiconosGraph < std::string, int,
+          boost::no_property, boost::no_property, boost::no_property > G;
+  typedef SiconosGraph < int, std::string,
+          boost::no_property, boost::no_property, boost::no_property > AG;
+
+  G g;
+  AG ag;
+
+  G::VDescriptor vd1, vd2, vd3, vd4;
+
+  vd1 = g.add_vertex("one");
+  vd2 = g.add_vertex("two");
+  vd3 = g.add_vertex("three");
+  vd4 = g.add_vertex("four");
+
+  g.add_edge(vd1, vd2, 1, ag);
+  g.add_edge(vd2, vd3, 2, ag);
+  g.add_edge(vd3, vd4, 3, ag);
+
+  // removal while iterating, the next iterator must remain valid
+  G::VIterator vi, viend, vnext;
+  std11::tie(vi, viend) = g.vertices();
+  for (vnext = vi; vi != viend; vi = vnext)
+  {
+    ++vnext;
+    if (g.bundle(*vi) == "two")
+    {
+      g.remove_out_edge_if(*vi, num_inf<G, AG>(3, g, ag));
+      g.remove_vertex("two");
+    }
+  }
+
+  CPPUNIT_ASSERT(g.size() == 3);
+  CPPUNIT_ASSERT(g.edges_number() == 1);
+  CPPUNIT_ASSERT(ag.size() == 1);
+
+  g.update_vertices_indices();
+  g.update_edges_indices();
+
+  CPPUNIT_ASSERT(g.bundle(vd1) == "one");
+  CPPUNIT_ASSERT(g.bundle(vd3) == "three");
+  CPPUNIT_ASSERT(g.bundle(vd4) == "four");
+  CPPUNIT_ASSERT(g.descriptor("three") == vd3);
+  CPPUNIT_ASSERT(g.edge_exists(vd3, vd4));
+  CPPUNIT_ASSERT(!g.edge_exists(vd1, vd3));
+
+  // insertion order is kept and indices are dense
+  std::string order;
+  size_t i = 0;
+  for (std11::tie(vi, viend) = g.vertices(); vi != viend; ++vi, ++i)
+  {
+    CPPUNIT_ASSERT(g.index(*vi) == i);
+    order += g.bundle(*vi);
+  }
+  CPPUNIT_ASSERT(order == "onethreefour");
+
+  G::VDescriptor vd5 = g.add_vertex("five");
+  g.add_edge(vd5, vd1, 5, ag);
+  CPPUNIT_ASSERT(g.bundle(vd5) == "five");
+  CPPUNIT_ASSERT(g.edge_exists(vd1, vd5));
+  CPPUNIT_ASSERT(ag.size() == g.edges_number());
+}
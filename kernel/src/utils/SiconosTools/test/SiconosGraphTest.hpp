@@ -48,6 +48,7 @@ private:
 
   CPPUNIT_TEST(t7);
   CPPUNIT_TEST(t8);
+  CPPUNIT_TEST(t9);
 
   CPPUNIT_TEST_SUITE_END();
 
@@ -60,6 +61,7 @@ private:
   void t6();
   void t7();
   void t8();
+  void t9();
 
 public:
   void setUp();
@@ -92,6 +92,8 @@ static void copyBtVector3(const btVector3 &from, SiconosVector& to)
 BulletR::BulletR()
   : ContactR()
 {
+  partId[0] = partId[1] = -1;
+  featureIndex[0] = featureIndex[1] = -1;
 }
 
 void BulletR::updateContactPointsFromManifoldPoint(const btPersistentManifold& manifold,
@@ -158,5 +160,10 @@ void BulletR::updateContactPointsFromManifoldPoint(const btPersistentManifold& m
   else
     copyBtVector3(point.m_normalWorldOnB, vn);
 
+  partId[0] = flip ? point.m_partId1 : point.m_partId0;
+  partId[1] = flip ? point.m_partId0 : point.m_partId1;
+  featureIndex[0] = flip ? point.m_index1 : point.m_index0;
+  featureIndex[1] = flip ? point.m_index0 : point.m_index1;
+
   ContactR::updateContactPoints(va, vb, vn*(flip?-1:1));
 }
@@ -38,6 +38,11 @@ public:
   SP::btCollisionObject btObject[2];
   SP::btCollisionShape btShape[2];
 
+  /* Features of the shapes in contact (part and triangle index for
+   * meshes and height maps, -1 otherwise), in the order of ds[]. */
+  int partId[2];
+  int featureIndex[2];
+
   virtual
   void updateContactPointsFromManifoldPoint(const btPersistentManifold& manifold,
                                             const btManifoldPoint& point,
@@ -52,6 +52,9 @@ DEFINE_SPTR(UpdateShapeVisitor)
 
 #include <map>
 #include <limits>
+#include <boost/unordered_set.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/functional/hash.hpp>
 #include <boost/format.hpp>
 #include <boost/make_shared.hpp>
 #include <CxxStd.hpp>
@@ -98,6 +101,14 @@ DEFINE_SPTR(UpdateShapeVisitor)
 #include <LinearMath/btQuaternion.h>
 #include <LinearMath/btVector3.h>
 
+// The parallel narrowphase needs Bullet >= 2.87 built with
+// BULLET2_MULTITHREADING (which defines BT_THREADSAFE)
+#if defined(BT_THREADSAFE) && (BT_BULLET_VERSION >= 287)
+#define SICONOS_BULLET_MULTITHREADING 1
+#include <LinearMath/btThreads.h>
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
+#endif
+
 #if defined(__clang__)
 #pragma clang diagnostic pop
 #elif !(__INTEL_COMPILER || __APPLE__ )
@@ -182,6 +193,8 @@ SiconosBulletOptions::SiconosBulletOptions()
   , minimumPointsPerturbationThreshold(3)
   , enableSatConvex(false)
   , enablePolyhedralContactClipping(false)
+  , numberOfThreads(1)
+  , warmStartContacts(false)
 {
 }
 
@@ -258,6 +271,75 @@ namespace SP {
   typedef std11::shared_ptr<StaticContactorSetRecord> StaticContactorSetRecord;
 };
 
+/** Identity of a contact between two bodies: the bodies, their shapes
+ * and the features of the shapes in contact.  Several contact points
+ * may share it, they are told apart by their position on the first
+ * body. */
+struct ContactCacheKey
+{
+  const BodyDS* ds[2];
+  const SiconosShape* shape[2];
+  int partId[2];
+  int featureIndex[2];
+
+  ContactCacheKey(const BulletR& rel)
+  {
+    for (int i = 0; i < 2; i++)
+    {
+      ds[i] = rel.ds[i].get();
+      shape[i] = rel.shape[i].get();
+      partId[i] = rel.partId[i];
+      featureIndex[i] = rel.featureIndex[i];
+    }
+  }
+
+  bool operator==(const ContactCacheKey& other) const
+  {
+    for (int i = 0; i < 2; i++)
+      if (ds[i] != other.ds[i] || shape[i] != other.shape[i]
+          || partId[i] != other.partId[i]
+          || featureIndex[i] != other.featureIndex[i])
+        return false;
+    return true;
+  }
+};
+
+static std::size_t hash_value(const ContactCacheKey& key)
+{
+  std::size_t seed = 0;
+  for (int i = 0; i < 2; i++)
+  {
+    boost::hash_combine(seed, key.ds[i]);
+    boost::hash_combine(seed, key.shape[i]);
+    boost::hash_combine(seed, key.partId[i]);
+    boost::hash_combine(seed, key.featureIndex[i]);
+  }
+  return seed;
+}
+
+/** Reactions of a destroyed contact point. */
+struct ContactCacheEntry
+{
+  /* position of the contact point on the first body, in its frame */
+  SiconosVector position;
+  /* last reactions, by input level */
+  VectorOfVectors lambda;
+  /* number of collision updates since the contact point was destroyed */
+  unsigned int age;
+};
+
+typedef boost::unordered_multimap<ContactCacheKey, ContactCacheEntry> ContactCache;
+
+/* The data stored in a Bullet contact point: its interaction, and the
+ * contact cache receiving its reactions when the point is destroyed, if
+ * warm start is enabled (see SiconosBulletOptions::warmStartContacts) */
+struct ContactPointData
+{
+  ContactPointData(SP::Interaction i, ContactCache* c) : inter(i), cache(c) {}
+  SP::Interaction inter;
+  ContactCache* cache;
+};
+
 class CollisionUpdater;
 
 class SiconosBulletCollisionManager_impl
@@ -268,6 +350,17 @@ protected:
   SP::btCollisionDispatcher _dispatcher;
   SP::btBroadphaseInterface _broadphase;
 
+#ifdef SICONOS_BULLET_MULTITHREADING
+  /* Task scheduler of the parallel narrowphase and its number of
+   * threads, null if the narrowphase is sequential. Bullet only uses
+   * one scheduler at a time, it is set before each collision
+   * detection. */
+  std11::shared_ptr<btITaskScheduler> _taskScheduler;
+  int _numberOfThreads;
+
+  void activateTaskScheduler();
+#endif
+
   /* Static contactor sets may be repeated with different positions,
    * thus each one is assocated with a list of base positions and
    * collision objects. */
@@ -347,9 +440,26 @@ protected:
 
   std::vector<SP::btCollisionObject> _queuedCollisionObjects;
 
+  /* Reactions of the destroyed contact points, and the new interactions
+   * to warm-start with them once initialized */
+  ContactCache _contactCache;
+  std::vector< std::pair<SP::Interaction, VectorOfVectors> > _warmStarts;
+
+  /** Find the destroyed contact point matching a new contact
+   * interaction, and queue its reactions for the initialization of the
+   * interaction.
+   * \return true if a match was found */
+  bool findWarmStart(SP::Interaction inter, const BulletR& rel);
+
 public:
   SiconosBulletCollisionManager_impl(SiconosBulletOptions &op) : _options(op) {}
-  ~SiconosBulletCollisionManager_impl() {}
+  ~SiconosBulletCollisionManager_impl()
+  {
+#ifdef SICONOS_BULLET_MULTITHREADING
+    if (_taskScheduler && btGetTaskScheduler() == &*_taskScheduler)
+      btSetTaskScheduler(btGetSequentialTaskScheduler());
+#endif
+  }
 
   friend class SiconosBulletCollisionManager;
   friend class CollisionUpdateVisitor;
@@ -389,6 +499,30 @@ bool SiconosBulletCollisionManager::removeStaticContactorSet(StaticContactorSetI
   return false;
 }
 
+#ifdef SICONOS_BULLET_MULTITHREADING
+/* Create a task scheduler for the parallel narrowphase, or return null
+ * if Bullet provides none. The OpenMP scheduler is a singleton owned by
+ * Bullet. */
+static std11::shared_ptr<btITaskScheduler> createTaskScheduler()
+{
+  std11::shared_ptr<btITaskScheduler> scheduler;
+  btITaskScheduler* ts = btCreateDefaultTaskScheduler();
+  if (ts)
+    scheduler.reset(ts);
+  else if ((ts = btGetOpenMPTaskScheduler()))
+    scheduler.reset(ts, nullDeleter());
+  return scheduler;
+}
+
+void SiconosBulletCollisionManager_impl::activateTaskScheduler()
+{
+  if (btGetTaskScheduler() != &*_taskScheduler)
+    btSetTaskScheduler(&*_taskScheduler);
+  if (_taskScheduler->getNumThreads() != _numberOfThreads)
+    _taskScheduler->setNumThreads(_numberOfThreads);
+}
+#endif
+
 void SiconosBulletCollisionManager::initialize_impl()
 {
   impl.reset(new SiconosBulletCollisionManager_impl(_options));
@@ -406,6 +540,19 @@ void SiconosBulletCollisionManager::initialize_impl()
       _options.minimumPointsPerturbationThreshold);
   }
 
+#ifdef SICONOS_BULLET_MULTITHREADING
+  if (_options.numberOfThreads != 1)
+    impl->_taskScheduler = createTaskScheduler();
+  if (impl->_taskScheduler)
+  {
+    int maxThreads = impl->_taskScheduler->getMaxNumThreads();
+    int n = _options.numberOfThreads > 0 ? (int)_options.numberOfThreads : maxThreads;
+    impl->_numberOfThreads = std::min(n, maxThreads);
+    impl->_dispatcher.reset(
+      new btCollisionDispatcherMt(&*impl->_collisionConfiguration));
+  }
+  else
+#endif
   impl->_dispatcher.reset(
     new btCollisionDispatcher(&*impl->_collisionConfiguration));
 
@@ -1364,15 +1511,49 @@ public:
 Simulation* SiconosBulletCollisionManager::gSimulation;
 bool SiconosBulletCollisionManager::bulletContactClear(void* userPersistentData)
 {
-  /* note: stored pointer to shared_ptr! */
-  SP::Interaction *p_inter = (SP::Interaction*)userPersistentData;
-  assert(p_inter!=NULL && "Contact point's stored (SP::Interaction*) is null!");
-  DEBUG_PRINTF("unlinking interaction %p\n", &**p_inter);
-  std11::static_pointer_cast<BulletR>((*p_inter)->relation())->preDelete();
-  gSimulation->unlink(*p_inter);
-  delete p_inter;
+  ContactPointData *data = (ContactPointData*)userPersistentData;
+  assert(data!=NULL && "Contact point's stored (ContactPointData*) is null!");
+  DEBUG_PRINTF("unlinking interaction %p\n", &*data->inter);
+  std11::static_pointer_cast<BulletR>(data->inter->relation())->preDelete();
+
+  // keep the last reactions of the contact for a new contact point at
+  // the same place
+  SP::BulletR rel(std11::dynamic_pointer_cast<BulletR>(data->inter->relation()));
+  if (data->cache && rel && rel->ds[0])
+  {
+    Interaction& inter = *data->inter;
+    ContactCacheEntry entry;
+    entry.position = *rel->relPc1();
+    entry.lambda.resize(inter.upperLevelForInput() + 1);
+    for (unsigned int i = inter.lowerLevelForInput();
+         i <= inter.upperLevelForInput(); i++)
+    {
+      entry.lambda[i].reset(new SiconosVector(*inter.lambdaOld(i)));
+    }
+    entry.age = 0;
+    data->cache->insert(std::make_pair(ContactCacheKey(*rel), entry));
+  }
+
+  gSimulation->unlink(data->inter);
+  delete data;
+  return false;
+}
+
+#ifdef SICONOS_BULLET_MULTITHREADING
+// During a parallel collision detection, contact points are destroyed by
+// the worker threads: the interactions are only recorded, and unlinked
+// afterwards by the calling thread.
+static std::vector<void*> gDestroyedContacts;
+static btSpinMutex gDestroyedContactsMutex;
+
+static bool bulletContactClearDeferred(void* userPersistentData)
+{
+  btMutexLock(&gDestroyedContactsMutex);
+  gDestroyedContacts.push_back(userPersistentData);
+  btMutexUnlock(&gDestroyedContactsMutex);
   return false;
 }
+#endif
 
 SP::BulletR SiconosBulletCollisionManager::makeBulletR(SP::BodyDS ds1,
                                                        SP::SiconosShape shape1,
@@ -1383,6 +1564,34 @@ SP::BulletR SiconosBulletCollisionManager::makeBulletR(SP::BodyDS ds1,
   return std11::make_shared<BulletR>();
 }
 
+bool SiconosBulletCollisionManager_impl::findWarmStart(SP::Interaction inter,
+                                                       const BulletR& rel)
+{
+  std::pair<ContactCache::iterator, ContactCache::iterator> range =
+    _contactCache.equal_range(ContactCacheKey(rel));
+
+  // the closest point within the distance at which Bullet would have
+  // considered the two points as the same
+  ContactCache::iterator found = _contactCache.end();
+  double distance = _options.contactBreakingThreshold / _options.worldScale;
+  for (ContactCache::iterator it = range.first; it != range.second; ++it)
+  {
+    double d = (it->second.position - *rel.relPc1()).norm2();
+    if (d < distance)
+    {
+      distance = d;
+      found = it;
+    }
+  }
+
+  if (found == _contactCache.end())
+    return false;
+
+  _warmStarts.push_back(std::make_pair(inter, found->second.lambda));
+  _contactCache.erase(found);
+  return true;
+}
+
 class CollisionUpdateVisitor : public SiconosVisitor
 {
 public:
@@ -1404,6 +1613,48 @@ public:
   }
 };
 
+/* The pairs of bodies between which no contact interaction is created,
+ * stored in both orders. */
+typedef boost::unordered_set< std::pair<const BodyDS*, const BodyDS*> > BodyPairSet;
+
+/* Collect the pairs of bodies already connected by another type of
+ * relation (e.g. EqualityCondition == they have a joint between them),
+ * unless the relation and both bodies allow self-collision: contact
+ * constraints between them lead to an ill-conditioned problem. */
+static void findJointPairs(SP::Simulation simulation, BodyPairSet& pairs)
+{
+  InteractionsGraph::VIterator ui, uiend;
+  SP::InteractionsGraph indexSet0 = simulation->nonSmoothDynamicalSystem()->topology()->indexSet0();
+  for (std11::tie(ui, uiend) = indexSet0->vertices(); ui != uiend; ++ui)
+  {
+    SP::Interaction inter( indexSet0->bundle(*ui) );
+
+    // Only match on non-BulletR interactions, i.e. non-contact relations
+    if (std11::dynamic_pointer_cast<BulletR>(inter->relation()))
+      continue;
+
+    SP::BodyDS ds1( std11::dynamic_pointer_cast<BodyDS>(
+                      indexSet0->properties(*ui).source) );
+    SP::BodyDS ds2( std11::dynamic_pointer_cast<BodyDS>(
+                      indexSet0->properties(*ui).target) );
+    if (!ds1 || !ds2)
+      continue;
+
+    SP::NewtonEulerJointR jr (
+      std11::dynamic_pointer_cast<NewtonEulerJointR>(inter->relation()) );
+
+    /* If it is a joint, check the joint self-collide property.  If any
+     * non-contact relation is found, both bodies must allow
+     * self-collide */
+    if ((jr && !jr->allowSelfCollide())
+        || !ds1->allowSelfCollide() || !ds2->allowSelfCollide())
+    {
+      pairs.insert(std::make_pair(&*ds1, &*ds2));
+      pairs.insert(std::make_pair(&*ds2, &*ds1));
+    }
+  }
+}
+
 void SiconosBulletCollisionManager::updateInteractions(SP::Simulation simulation)
 {
   // -2. update collision objects from all BodyDS dynamical systems
@@ -1434,16 +1685,50 @@ void SiconosBulletCollisionManager::updateInteractions(SP::Simulation simulation
   gSimulation = &*simulation;
   gContactDestroyedCallback = this->bulletContactClear;
 
+  // Forget the contact points destroyed before the previous update, and
+  // the warm starts that have not been used.
+  impl->_warmStarts.clear();
+  if (_options.warmStartContacts)
+  {
+    ContactCache::iterator itc = impl->_contactCache.begin();
+    while (itc != impl->_contactCache.end())
+    {
+      if (++ itc->second.age > 1)
+        itc = impl->_contactCache.erase(itc);
+      else
+        ++ itc;
+    }
+  }
+  else
+    impl->_contactCache.clear();
+
   // Important parameter controlling contact point making and breaking
   gContactBreakingThreshold = _options.contactBreakingThreshold;
 
   // 1. perform bullet collision detection
+#ifdef SICONOS_BULLET_MULTITHREADING
+  if (impl->_taskScheduler)
+  {
+    impl->activateTaskScheduler();
+    gContactDestroyedCallback = bulletContactClearDeferred;
+    impl->_collisionWorld->performDiscreteCollisionDetection();
+    gContactDestroyedCallback = this->bulletContactClear;
+
+    std::vector<void*>::iterator itd;
+    for (itd = gDestroyedContacts.begin(); itd != gDestroyedContacts.end(); ++itd)
+      bulletContactClear(*itd);
+    gDestroyedContacts.clear();
+  }
+  else
+#endif
   impl->_collisionWorld->performDiscreteCollisionDetection();
 
   // 2. deleted contact points have been removed from the graph during the
   //    bullet collision detection callbacks
 
   // 3. for each contact point, if there is no interaction, create one
+  BodyPairSet jointPairs;
+  bool jointPairsFound = false;
   IterateContactPoints t(impl->_collisionWorld);
   IterateContactPoints::iterator it, itend=t.end();
   DEBUG_PRINT("iterating contact points:\n");
@@ -1478,49 +1763,24 @@ void SiconosBulletCollisionManager::updateInteractions(SP::Simulation simulation
     // to an ill-conditioned problem.
     if (pairA->ds && pairB->ds)
     {
-      InteractionsGraph::VIterator ui, uiend;
-      SP::InteractionsGraph indexSet0 = simulation->nonSmoothDynamicalSystem()->topology()->indexSet0();
-      bool match = false;
-      for (std11::tie(ui, uiend) = indexSet0->vertices(); ui != uiend; ++ui)
+      if (!jointPairsFound)
       {
-        SP::Interaction inter( indexSet0->bundle(*ui) );
-        SP::BodyDS ds1( std11::dynamic_pointer_cast<BodyDS>(
-                          indexSet0->properties(*ui).source) );
-        SP::BodyDS ds2( std11::dynamic_pointer_cast<BodyDS>(
-                          indexSet0->properties(*ui).target) );
-        if (ds1 && ds2 && (((&*ds1==&*pairA->ds) && (&*ds2==&*pairB->ds))
-                           || ((&*ds1==&*pairB->ds) && (&*ds2==&*pairA->ds))))
-        {
-          // Only match on non-BulletR interactions, i.e. non-contact relations
-          SP::BulletR br ( std11::dynamic_pointer_cast<BulletR>(inter->relation()) );
-          if (!br) {
-            SP::NewtonEulerJointR jr (
-              std11::dynamic_pointer_cast<NewtonEulerJointR>(inter->relation()) );
-
-            /* If it is a joint, check the joint self-collide property */
-            if (jr && !jr->allowSelfCollide())
-              match = true;
-
-            /* If any non-contact relation is found, both bodies must
-             * allow self-collide */
-            if (!pairA->ds->allowSelfCollide() || !pairB->ds->allowSelfCollide())
-              match = true;
-          }
-          if (match) break;
-        }
+        findJointPairs(simulation, jointPairs);
+        jointPairsFound = true;
       }
-      if (match)
+      if (jointPairs.find(std::make_pair(&*pairA->ds, &*pairB->ds))
+          != jointPairs.end())
         continue;
     }
 
     if (it->point->m_userPersistentData)
     {
       /* interaction already exists */
-      SP::Interaction *p_inter =
-        (SP::Interaction*)it->point->m_userPersistentData;
+      ContactPointData *data =
+        (ContactPointData*)it->point->m_userPersistentData;
 
       /* update the relation */
-      SP::BulletR rel(std11::static_pointer_cast<BulletR>((*p_inter)->relation()));
+      SP::BulletR rel(std11::static_pointer_cast<BulletR>(data->inter->relation()));
       rel->updateContactPointsFromManifoldPoint(*it->manifold, *it->point,
                                                 flip, _options.worldScale,
                                                 pairA->ds,
@@ -1578,6 +1838,9 @@ void SiconosBulletCollisionManager::updateInteractions(SP::Simulation simulation
 
         inter = std11::make_shared<Interaction>(nslaw, rel);
         _stats.new_interactions_created ++;
+
+        if (_options.warmStartContacts && impl->findWarmStart(inter, *rel))
+          _stats.warm_started_interactions ++;
       }
       else
       {
@@ -1594,8 +1857,9 @@ void SiconosBulletCollisionManager::updateInteractions(SP::Simulation simulation
       {
         /* store interaction in the contact point data, it will be freed by the
          * Bullet callback gContactDestroyedCallback */
-        /* note: storing pointer to shared_ptr! */
-        it->point->m_userPersistentData = (void*)(new SP::Interaction(inter));
+        it->point->m_userPersistentData = (void*)(
+          new ContactPointData(inter, _options.warmStartContacts
+                                      ? &impl->_contactCache : NULL));
 
         /* link bodies by the new interaction */
         simulation->link(inter, pairA->ds, pairB->ds);
@@ -1604,6 +1868,25 @@ void SiconosBulletCollisionManager::updateInteractions(SP::Simulation simulation
   }
 }
 
+void SiconosBulletCollisionManager::initializeInteractions(SP::Simulation simulation)
+{
+  // The OneStepNSProblem starts from lambdaOld, which is reset when the
+  // interaction is initialized: the warm start is set afterwards.
+  std::vector< std::pair<SP::Interaction, VectorOfVectors> >::iterator it;
+  for (it = impl->_warmStarts.begin(); it != impl->_warmStarts.end(); ++it)
+  {
+    Interaction& inter = *it->first;
+    const VectorOfVectors& lambda = it->second;
+    for (unsigned int i = inter.lowerLevelForInput();
+         i <= inter.upperLevelForInput() && i < lambda.size(); i++)
+    {
+      if (lambda[i] && lambda[i]->size() == inter.lambdaOld(i)->size())
+        *inter.lambdaOld(i) = *lambda[i];
+    }
+  }
+  impl->_warmStarts.clear();
+}
+
 void SiconosBulletCollisionManager::clearOverlappingPairCache()
 {
   if (!impl->_collisionWorld) return;
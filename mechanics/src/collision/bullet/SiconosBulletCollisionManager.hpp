@@ -48,6 +48,16 @@ struct SiconosBulletOptions
   unsigned int minimumPointsPerturbationThreshold;
   bool enableSatConvex;
   bool enablePolyhedralContactClipping;
+
+  /** number of threads of the narrowphase collision detection, 0 for all
+   * the available cores. Bullet must be built with BULLET2_MULTITHREADING,
+   * otherwise the detection is sequential. */
+  unsigned int numberOfThreads;
+
+  /** keep the reactions of the contact points destroyed by Bullet, and
+   * use them as the initial reactions of the new contact points created
+   * at the same place, on the same features, during the next time step. */
+  bool warmStartContacts;
 };
 
 struct SiconosBulletStatistics
@@ -56,10 +66,12 @@ struct SiconosBulletStatistics
     : new_interactions_created(0)
     , existing_interactions_processed(0)
     , interaction_warnings(0)
+    , warm_started_interactions(0)
     {}
   int new_interactions_created;
   int existing_interactions_processed;
   int interaction_warnings;
+  int warm_started_interactions;
 };
 
 class SiconosBulletCollisionManager : public SiconosCollisionManager
@@ -98,6 +110,8 @@ public:
 
   void updateInteractions(SP::Simulation simulation);
 
+  void initializeInteractions(SP::Simulation simulation);
+
   std::vector<SP::SiconosCollisionQueryResult>
   lineIntersectionQuery(const SiconosVector& start, const SiconosVector& end,
                         bool closestOnly=false, bool sorted=true);
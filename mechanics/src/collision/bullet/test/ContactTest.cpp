@@ -7,11 +7,13 @@
 #include "SiconosShape.hpp"
 #include "SiconosCollisionManager.hpp"
 #include "SiconosBulletCollisionManager.hpp"
+#include "BulletR.hpp"
 #include "BodyDS.hpp"
 
 #include "SiconosKernel.hpp"
 
 #include <string>
+#include <algorithm>
 #include <sys/time.h>
 #include <boost/make_shared.hpp>
 
@@ -518,3 +520,272 @@ void ContactTest::t4()
     CPPUNIT_ASSERT(1);
   }
 }
+
+struct PileResult
+{
+  // contact points found at each step, sorted by position
+  std::vector< std::vector< std::vector<double> > > contacts;
+  std::vector<double> final_positions;
+};
+
+// A grid of spheres falling on a plane at different times: each sphere
+// has its own contact, so the result does not depend on the order in
+// which the contacts are created.
+static
+PileResult pileTest(const SiconosBulletOptions &options)
+{
+  double t0 = 0, T = 1.0, h = 0.005;
+  int n = 4;
+
+  SP::NonSmoothDynamicalSystem nsds(new NonSmoothDynamicalSystem(t0, T));
+  std::vector<SP::BodyDS> bodies;
+  for (int i=0; i < n*n; i++)
+  {
+    SP::SiconosVector q(new SiconosVector(7));
+    SP::SiconosVector v(new SiconosVector(6));
+    q->zero();
+    v->zero();
+    (*q)(0) = 0.5 * (i % n);
+    (*q)(1) = 0.5 * (i / n);
+    (*q)(2) = 0.15 + 0.05 * i;
+    (*q)(3) = 1.0;
+
+    SP::BodyDS body(new BodyDS(q, v, 1.0));
+    SP::SiconosContactorSet contactors(new SiconosContactorSet());
+    SP::SiconosSphere sphere(new SiconosSphere(0.1));
+    contactors->push_back(std11::make_shared<SiconosContactor>(sphere));
+    body->setContactors(contactors);
+
+    SP::SiconosVector FExt(new SiconosVector(3));
+    FExt->zero();
+    FExt->setValue(2, - 9.81);
+    body->setFExtPtr(FExt);
+
+    nsds->insertDynamicalSystem(body);
+    bodies.push_back(body);
+  }
+
+  SP::SiconosContactorSet static_contactors(std11::make_shared<SiconosContactorSet>());
+  static_contactors->push_back(
+    std11::make_shared<SiconosContactor>(std11::make_shared<SiconosPlane>()));
+
+  SP::TimeDiscretisation timedisc(new TimeDiscretisation(t0, h));
+  SP::FrictionContact osnspb(new FrictionContact(3));
+  osnspb->numericsSolverOptions()->iparam[0] = 1000;
+  osnspb->numericsSolverOptions()->dparam[0] = 1e-10;
+  osnspb->setMaxSize(16384);
+  osnspb->setMStorageType(1);
+  osnspb->setKeepLambdaAndYState(true);
+
+  SP::TimeStepping simulation(new TimeStepping(nsds, timedisc));
+  simulation->insertIntegrator(std11::make_shared<MoreauJeanOSI>(0.5));
+  simulation->insertNonSmoothProblem(osnspb);
+
+  SP::SiconosBulletCollisionManager collisionMan(
+    new SiconosBulletCollisionManager(options));
+  simulation->insertInteractionManager(collisionMan);
+  collisionMan->insertStaticContactorSet(static_contactors);
+  collisionMan->insertNonSmoothLaw(
+    std11::make_shared<NewtonImpactFrictionNSL>(0.5, 0., 0.3, 3), 0, 0);
+
+  PileResult r;
+  while (simulation->hasNextEvent())
+  {
+    simulation->computeOneStep();
+
+    std::vector< std::vector<double> > contacts;
+    InteractionsGraph::VIterator ui, uiend;
+    SP::InteractionsGraph indexSet0 =
+      simulation->nonSmoothDynamicalSystem()->topology()->indexSet0();
+    for (std11::tie(ui, uiend) = indexSet0->vertices(); ui != uiend; ++ui)
+    {
+      SP::BulletR rel(std11::static_pointer_cast<BulletR>(
+                        indexSet0->bundle(*ui)->relation()));
+      SiconosVector& pc = *rel->pc1();
+      std::vector<double> c(3);
+      c[0] = pc(0); c[1] = pc(1); c[2] = pc(2);
+      contacts.push_back(c);
+    }
+    std::sort(contacts.begin(), contacts.end());
+    r.contacts.push_back(contacts);
+
+    simulation->nextStep();
+  }
+
+  for (unsigned int i=0; i < bodies.size(); i++)
+    r.final_positions.push_back((*bodies[i]->q())(2));
+
+  return r;
+}
+
+void ContactTest::t5()
+{
+  printf("\n==== t5\n");
+
+  try
+  {
+    // The parallel narrowphase must find the same contacts as the
+    // sequential one, whatever the number of threads.
+    SiconosBulletOptions options;
+    options.numberOfThreads = 1;
+    PileResult ref = pileTest(options);
+
+    unsigned int ncontacts = 0;
+    for (unsigned int k=0; k < ref.contacts.size(); k++)
+      ncontacts += ref.contacts[k].size();
+    CPPUNIT_ASSERT(ncontacts > 0);
+
+    unsigned int threads[2] = { 2, 4 };
+    for (int t=0; t < 2; t++)
+    {
+      options.numberOfThreads = threads[t];
+      PileResult r = pileTest(options);
+
+      CPPUNIT_ASSERT_EQUAL(ref.contacts.size(), r.contacts.size());
+      for (unsigned int k=0; k < ref.contacts.size(); k++)
+      {
+        CPPUNIT_ASSERT_EQUAL(ref.contacts[k].size(), r.contacts[k].size());
+        for (unsigned int c=0; c < ref.contacts[k].size(); c++)
+          for (int i=0; i < 3; i++)
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(ref.contacts[k][c][i],
+                                         r.contacts[k][c][i], 1e-10);
+      }
+      for (unsigned int i=0; i < ref.final_positions.size(); i++)
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(ref.final_positions[i],
+                                     r.final_positions[i], 1e-10);
+    }
+  }
+  catch (SiconosException e)
+  {
+    std::cout << "SiconosException: " << e.report() << std::endl;
+    CPPUNIT_ASSERT(0);
+  }
+}
+
+// Records the reactions the contacts start from when they are created
+class WarmStartRecorder : public SiconosBulletCollisionManager
+{
+public:
+  WarmStartRecorder(const SiconosBulletOptions &options)
+    : SiconosBulletCollisionManager(options) {}
+
+  std::vector< std::pair<SP::Interaction, SiconosVector> > initialLambdas;
+
+  void initializeInteractions(SP::Simulation simulation)
+  {
+    SiconosBulletCollisionManager::initializeInteractions(simulation);
+
+    InteractionsGraph::VIterator ui, uiend;
+    SP::InteractionsGraph indexSet0 =
+      simulation->nonSmoothDynamicalSystem()->topology()->indexSet0();
+    for (std11::tie(ui, uiend) = indexSet0->vertices(); ui != uiend; ++ui)
+    {
+      SP::Interaction inter(indexSet0->bundle(*ui));
+      initialLambdas.push_back(std::make_pair(inter, *inter->lambdaOld(1)));
+    }
+  }
+};
+
+void ContactTest::t6()
+{
+  printf("\n==== t6\n");
+
+  try
+  {
+    // A sphere resting on a plane. The overlapping pairs are cleared at
+    // each step, so that Bullet destroys the contact point and creates
+    // a new one at the same place: its reactions must be restored.
+    double t0 = 0, T = 0.5, h = 0.005;
+
+    SP::SiconosVector q(new SiconosVector(7));
+    SP::SiconosVector v(new SiconosVector(6));
+    q->zero();
+    v->zero();
+    (*q)(2) = 0.5;
+    (*q)(3) = 1.0;
+
+    SP::BodyDS body(new BodyDS(q, v, 1.0));
+    SP::SiconosContactorSet contactors(new SiconosContactorSet());
+    contactors->push_back(
+      std11::make_shared<SiconosContactor>(std11::make_shared<SiconosSphere>(0.5)));
+    body->setContactors(contactors);
+
+    SP::SiconosVector FExt(new SiconosVector(3));
+    FExt->zero();
+    FExt->setValue(2, - 9.81);
+    body->setFExtPtr(FExt);
+
+    SP::NonSmoothDynamicalSystem nsds(new NonSmoothDynamicalSystem(t0, T));
+    nsds->insertDynamicalSystem(body);
+
+    SP::SiconosContactorSet static_contactors(std11::make_shared<SiconosContactorSet>());
+    static_contactors->push_back(
+      std11::make_shared<SiconosContactor>(std11::make_shared<SiconosPlane>()));
+
+    SP::TimeDiscretisation timedisc(new TimeDiscretisation(t0, h));
+    SP::FrictionContact osnspb(new FrictionContact(3));
+    osnspb->numericsSolverOptions()->iparam[0] = 1000;
+    osnspb->numericsSolverOptions()->dparam[0] = 1e-10;
+    osnspb->setMaxSize(16384);
+    osnspb->setMStorageType(1);
+    osnspb->setKeepLambdaAndYState(true);
+
+    SP::TimeStepping simulation(new TimeStepping(nsds, timedisc));
+    simulation->insertIntegrator(std11::make_shared<MoreauJeanOSI>(0.5));
+    simulation->insertNonSmoothProblem(osnspb);
+
+    SiconosBulletOptions options;
+    options.warmStartContacts = true;
+    options.clearOverlappingPairCache = true;
+    std11::shared_ptr<WarmStartRecorder> collisionMan(new WarmStartRecorder(options));
+    simulation->insertInteractionManager(collisionMan);
+    collisionMan->insertStaticContactorSet(static_contactors);
+    collisionMan->insertNonSmoothLaw(
+      std11::make_shared<NewtonImpactFrictionNSL>(0., 0., 0.3, 3), 0, 0);
+
+    SP::Interaction previous;
+    SiconosVector previousLambda(3);
+    int restored = 0;
+    while (simulation->hasNextEvent())
+    {
+      // the reactions kept when the contact point is destroyed
+      if (previous)
+        previousLambda = *previous->lambdaOld(1);
+
+      collisionMan->initialLambdas.clear();
+      simulation->computeOneStep();
+
+      const SiconosBulletStatistics &stats = collisionMan->statistics();
+      if (previous && previousLambda(0) > 0.)
+      {
+        CPPUNIT_ASSERT_EQUAL(1, stats.new_interactions_created);
+        CPPUNIT_ASSERT_EQUAL(1, stats.warm_started_interactions);
+        CPPUNIT_ASSERT_EQUAL((size_t)1, collisionMan->initialLambdas.size());
+        if (collisionMan->initialLambdas.size() == 1)
+        {
+          CPPUNIT_ASSERT(collisionMan->initialLambdas[0].first != previous);
+          for (int i=0; i < 3; i++)
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(previousLambda(i),
+                                         collisionMan->initialLambdas[0].second(i),
+                                         1e-14);
+        }
+        restored ++;
+      }
+
+      SP::InteractionsGraph indexSet0 =
+        simulation->nonSmoothDynamicalSystem()->topology()->indexSet0();
+      previous.reset();
+      if (indexSet0->size() == 1)
+        previous = indexSet0->bundle(*indexSet0->vertices().first);
+
+      simulation->nextStep();
+    }
+
+    CPPUNIT_ASSERT(restored > 0);
+  }
+  catch (SiconosException e)
+  {
+    std::cout << "SiconosException: " << e.report() << std::endl;
+    CPPUNIT_ASSERT(0);
+  }
+}
@@ -20,6 +20,7 @@ if(WITH_${COMPONENT}_TESTING)
     NEW_TEST(test_dgels test_dgels.c)
   endif()
   NEW_TEST(test_dpotrf test_dpotrf.c)
+  NEW_TEST(test_drivers_concurrent test_drivers_concurrent.c)
   #NEW_TEST(NumericsMatrixTest main_NumericsMatrix.c)
   NEW_TEST(NumericsMatrixTest0 NumericsMatrix_test0.c)
   NEW_TEST(NumericsMatrixTest1 NumericsMatrix_test1.c)
@@ -37,6 +38,9 @@ if(WITH_${COMPONENT}_TESTING)
   NEW_TEST(SBMTest7 SBM_test7.c)
   NEW_TEST(SparseMatrix0 SparseMatrix_test0.c)
   NEW_TEST(SparseMatrix_NM_gemm SparseMatrix_NM_gemm.c)
+  NEW_TEST(SparseMatrix_NM_gemv SparseMatrix_NM_gemv.c)
+  NEW_TEST(SparseMatrix_NM_gesv SparseMatrix_NM_gesv.c)
+  NEW_TEST(NM_gesv_cholesky NM_gesv_cholesky.c)
   IF(HAS_ONE_LP_SOLVER)
    NEW_TEST(Vertex_extraction vertex_problem.c)
   ENDIF(HAS_ONE_LP_SOLVER)
@@ -160,6 +164,7 @@ if(WITH_${COMPONENT}_TESTING)
   ENDIF(HAVE_GAMS_C_API)
 
   NEW_TEST(LCP_DefaultSolverOptionstest LinearComplementarity_DefaultSolverOptions_test.c)
+  NEW_TEST(LCP_enum_threads lcp_enum_threads_test.c)
 
   END_TEST(LCP/test)
 
@@ -208,6 +213,8 @@ if(WITH_${COMPONENT}_TESTING)
     NEW_TEST(MLCPtest main_mlcp.cpp)
   ENDIF(HAVE_SYSTIMES_H AND WITH_CXX)
   NEW_TEST(ReadWrite_MLCPtest MixedLinearComplementarity_ReadWrite_test.c)
+  NEW_TEST(MLCP_enum_threads mlcp_enum_threads_test.c)
+  NEW_TEST(MLCP_direct_cache mlcp_direct_cache_test.c)
   END_TEST()
 
   BEGIN_TEST(src/MCP/test)
@@ -255,6 +262,7 @@ if(WITH_${COMPONENT}_TESTING)
   SET(NSGS_NB_IT 10000)
   NEW_TEST(FC3D_DefaultSolverOptionstest fc3d_DefaultSolverOptions_test.c)
   NEW_TEST(FC3D_sparse_test fc3d_sparse_test.c)
+  NEW_TEST(FC3D_operator_test fc3d_operator_test.c)
 
   STRING(CONCAT FC3D_DATA_SET "Capsules-i100-1090.dat;Capsules-i100-889.dat;Capsules-i101-404.dat;Capsules-i103-990.dat;Capsules-i122-1617.dat;")
   STRING(CONCAT FC3D_DATA_SET "FC3D_Example1.dat;FC3D_Example1_SBM.dat;FrictionContact3D_1c.dat;FrictionContact3D_RR_1c.dat;" "${FC3D_DATA_SET}")
@@ -313,6 +321,9 @@ if(WITH_${COMPONENT}_TESTING)
       0 0 0
       IPARAM 1 1)
     NEW_FC_3D_TEST(${_DAT} SICONOS_FRICTION_3D_NSN_AC 1e-3 1000)
+    NEW_FC_3D_TEST(${_DAT} SICONOS_FRICTION_3D_NSN_AC 1e-3 1000
+      0 0 0
+      IPARAM SICONOS_FRICTION_3D_NSN_FORMULATION SICONOS_FRICTION_3D_NSN_FORMULATION_ALARTCURNIER_STD_BATCH)
     NEW_FC_3D_TEST(${_DAT} SICONOS_FRICTION_3D_NSN_AC_TEST 1e-3 1000)
     NEW_FC_3D_TEST(${_DAT} SICONOS_FRICTION_3D_NSN_FB 1e-3 1000)
     NEW_FC_3D_TEST(${_DAT} SICONOS_FRICTION_3D_NSN_NM 1e-3 1000)
@@ -375,6 +386,43 @@ if(WITH_${COMPONENT}_TESTING)
   #   SICONOS_FRICTION_3D_NCPGlockerFBNewton 0 0
   #   WILL_FAIL)
 
+  # --- Multithreaded NSGS (contact graph coloring) ---
+  NEW_FC_3D_TEST(FC3D_Example1_SBM.dat
+    SICONOS_FRICTION_3D_NSGS_OPENMP 1e-16 ${NSGS_NB_IT})
+
+  NEW_FC_3D_TEST(Confeti-ex13-Fc3D-SBM.dat
+    SICONOS_FRICTION_3D_NSGS_OPENMP 1e-5 10000)
+
+  NEW_FC_3D_TEST(Confeti-ex13-4contact-Fc3D-SBM.dat
+    SICONOS_FRICTION_3D_NSGS_OPENMP  1e-12 10000
+    SICONOS_FRICTION_3D_ONECONTACT_ProjectionOnConeWithLocalIteration 1e-6 100)
+
+  NEW_FC_3D_TEST(Capsules-i122-1617.dat
+    SICONOS_FRICTION_3D_NSGS_OPENMP 1e-5 10000
+    0 0 0
+    IPARAM SICONOS_FRICTION_3D_NSGS_OPENMP_NUMBER_OF_THREADS 2)
+
+  # --- Block Jacobi on subdomains (domain decomposition) ---
+  NEW_FC_3D_TEST(FC3D_Example1_SBM.dat
+    SICONOS_FRICTION_3D_BLOCK_JACOBI 1e-5 1000
+    0 0 0
+    IPARAM SICONOS_FRICTION_3D_BLOCK_JACOBI_NUMBER_OF_DOMAINS 3)
+
+  NEW_FC_3D_TEST(FC3D_Example1.dat
+    SICONOS_FRICTION_3D_BLOCK_JACOBI 1e-5 1000
+    0 0 0
+    IPARAM SICONOS_FRICTION_3D_BLOCK_JACOBI_NUMBER_OF_DOMAINS 3)
+
+  NEW_FC_3D_TEST(Confeti-ex13-Fc3D-SBM.dat
+    SICONOS_FRICTION_3D_BLOCK_JACOBI 1e-5 1000
+    0 0 0
+    IPARAM SICONOS_FRICTION_3D_BLOCK_JACOBI_NUMBER_OF_DOMAINS 4)
+
+  NEW_FC_3D_TEST(Capsules-i122-1617.dat
+    SICONOS_FRICTION_3D_BLOCK_JACOBI 1e-5 1000
+    0 0 0
+    IPARAM SICONOS_FRICTION_3D_BLOCK_JACOBI_NUMBER_OF_DOMAINS 4)
+
   NEW_FC_3D_TEST(FC3D_Example1_SBM.dat
     SICONOS_FRICTION_3D_NSGS  1e-16 1000
     SICONOS_FRICTION_3D_NCPGlockerFBFixedPoint 0.0 10
@@ -601,6 +649,29 @@ if(WITH_${COMPONENT}_TESTING)
     0 0 0
     IPARAM 2 1)
 
+  # ---- Acceleration of the projection solvers ----
+  NEW_FC_3D_TEST(BoxesStack1-i100000-32.hdf5.dat
+    SICONOS_FRICTION_3D_VI_FPP 1e-8 100000
+    0 0 0
+    IPARAM SICONOS_IPARAM_ACCELERATION SICONOS_ACCELERATION_ANDERSON)
+
+  NEW_FC_3D_TEST(Confeti-ex13-Fc3D-SBM.dat
+    SICONOS_FRICTION_3D_FPP 1e-8 100000
+    0 0 0
+    IPARAM SICONOS_IPARAM_ACCELERATION SICONOS_ACCELERATION_ANDERSON)
+
+  NEW_FC_3D_TEST(BoxesStack1-i100000-32.hdf5.dat
+    SICONOS_FRICTION_3D_EG 1e-8 10000
+    0 0 0
+    IPARAM SICONOS_IPARAM_ACCELERATION SICONOS_ACCELERATION_ANDERSON
+    DPARAM 3 1e-4)
+
+  NEW_FC_3D_TEST(BoxesStack1-i100000-32.hdf5.dat
+    SICONOS_FRICTION_3D_EG 1e-8 20000
+    0 0 0
+    IPARAM SICONOS_IPARAM_ACCELERATION SICONOS_ACCELERATION_NESTEROV
+    DPARAM 3 1e-4)
+
   # --- Test from rock pile simulations using "time of birth" feature --- 
   # failure in local solver with line search
   NEW_FC_3D_TEST(RockPile_tob1.dat SICONOS_FRICTION_3D_NSGS 1e-3 1000
@@ -884,6 +955,7 @@ if(WITH_${COMPONENT}_TESTING)
   ENDIF()
   # Alart Curnier functions
   NEW_TEST(AlartCurnierFunctions_test fc3d_AlartCurnierFunctions_test.c)
+  NEW_TEST(AlartCurnierBatch_test fc3d_AlartCurnierBatch_test.c)
 
   # 
   if(WITH_FCLIB)
@@ -16,6 +16,7 @@
  * limitations under the License.
 */
 #include <stdlib.h>
+#include <string.h>
 #include <assert.h>
 #include "FrictionContactProblem.h"
 #include "NumericsMatrix.h"
@@ -205,6 +206,112 @@ FrictionContactProblem* frictionContactProblem_new(int dim, int nc, NumericsMatr
   return fcp;
 }
 
+FrictionContactProblem* frictionContactProblem_new_subproblem(FrictionContactProblem* problem,
+                                                              unsigned int nc,
+                                                              const unsigned int* contacts,
+                                                              int* local_index)
+{
+  int dim = problem->dimension;
+  NumericsMatrix* M = problem->M;
+  FrictionContactProblem* subproblem = newFCP();
+
+  for (unsigned int k = 0; k < nc; ++k)
+    local_index[contacts[k]] = (int)k;
+
+  subproblem->dimension = dim;
+  subproblem->numberOfContacts = (int)nc;
+  subproblem->q = (double *) malloc(dim * nc * sizeof(double));
+  subproblem->mu = (double *) malloc(nc * sizeof(double));
+  for (unsigned int k = 0; k < nc; ++k)
+  {
+    memcpy(&subproblem->q[dim * k], &problem->q[dim * contacts[k]], dim * sizeof(double));
+    subproblem->mu[k] = problem->mu[contacts[k]];
+  }
+
+  if (M->storageType == NM_SPARSE_BLOCK)
+  {
+    SparseBlockStructuredMatrix* A = M->matrix1;
+    SparseBlockStructuredMatrix* B = SBM_new();
+    size_t nbblocks = 0;
+    for (unsigned int k = 0; k < nc; ++k)
+    {
+      unsigned int row = contacts[k];
+      for (size_t blockNum = A->index1_data[row]; blockNum < A->index1_data[row + 1]; ++blockNum)
+        if (local_index[A->index2_data[blockNum]] >= 0)
+          nbblocks++;
+    }
+    B->nbblocks = (unsigned int)nbblocks;
+    B->blocknumber0 = nc;
+    B->blocknumber1 = nc;
+    B->blocksize0 = (unsigned int *) malloc(nc * sizeof(unsigned int));
+    B->blocksize1 = B->blocksize0;
+    B->filled1 = nc + 1;
+    B->filled2 = nbblocks;
+    B->index1_data = (size_t *) malloc((nc + 1) * sizeof(size_t));
+    B->index2_data = (size_t *) malloc((nbblocks + 1) * sizeof(size_t));
+    B->block = (double **) malloc((nbblocks + 1) * sizeof(double *));
+    nbblocks = 0;
+    for (unsigned int k = 0; k < nc; ++k)
+    {
+      unsigned int row = contacts[k];
+      B->blocksize0[k] = dim * (k + 1);
+      B->index1_data[k] = nbblocks;
+      for (size_t blockNum = A->index1_data[row]; blockNum < A->index1_data[row + 1]; ++blockNum)
+      {
+        int j = local_index[A->index2_data[blockNum]];
+        if (j >= 0)
+        {
+          B->index2_data[nbblocks] = (size_t)j;
+          B->block[nbblocks] = A->block[blockNum];
+          nbblocks++;
+        }
+      }
+    }
+    B->index1_data[nc] = nbblocks;
+    subproblem->M = NM_create_from_data(NM_SPARSE_BLOCK, dim * nc, dim * nc, B);
+  }
+  else
+  {
+    assert(M->storageType == NM_DENSE);
+    int n = dim * (int)nc;
+    subproblem->M = NM_create(NM_DENSE, n, n);
+    double* dense = subproblem->M->matrix0;
+    for (unsigned int kj = 0; kj < nc; ++kj)
+      for (int dj = 0; dj < dim; ++dj)
+      {
+        int col = dim * (int)contacts[kj] + dj;
+        for (unsigned int ki = 0; ki < nc; ++ki)
+          for (int di = 0; di < dim; ++di)
+          {
+            int row = dim * (int)contacts[ki] + di;
+            dense[(dim * ki + di) + (size_t)n * (dim * kj + dj)] = M->matrix0[row + (size_t)M->size0 * col];
+          }
+      }
+  }
+
+  for (unsigned int k = 0; k < nc; ++k)
+    local_index[contacts[k]] = -1;
+
+  return subproblem;
+}
+
+void frictionContactProblem_free_subproblem(FrictionContactProblem* subproblem)
+{
+  NumericsMatrix* M = subproblem->M;
+  if (M->storageType == NM_SPARSE_BLOCK)
+  {
+    /* the blocks belong to the matrix of the whole problem */
+    SparseBlockStructuredMatrix* B = M->matrix1;
+    free(B->blocksize0);
+    free(B->index1_data);
+    free(B->index2_data);
+    free(B->block);
+    free(B);
+    M->matrix1 = NULL;
+  }
+  freeFrictionContactProblem(subproblem);
+}
+
 //#define SN_SBM_TO_DENSE
 
 
@@ -114,6 +114,30 @@ extern "C"
       NumericsMatrix* M, double* q, double* mu);
 
 
+  /** new FrictionContactProblem restricted to a subset of the contacts of
+   * a problem. It is independent of the other contacts only if they are not
+   * coupled with the contacts of the subset in M. q and mu are copied. M
+   * must be dense or a SBM, whose blocks are shared with the matrix of
+   * the problem.
+   * \param[in] problem the problem
+   * \param[in] nc the number of contacts of the subproblem
+   * \param[in] contacts the numbers of these contacts in problem, in
+   * increasing order
+   * \param[in,out] local_index work array of size
+   * problem->numberOfContacts, filled with -1 on input and on output
+   * \return the subproblem, to be freed with
+   * frictionContactProblem_free_subproblem
+   */
+  FrictionContactProblem* frictionContactProblem_new_subproblem(FrictionContactProblem* problem,
+                                                                unsigned int nc,
+                                                                const unsigned int* contacts,
+                                                                int* local_index);
+
+  /** free a subproblem built by frictionContactProblem_new_subproblem
+   * \param subproblem the subproblem
+   */
+  void frictionContactProblem_free_subproblem(FrictionContactProblem* subproblem);
+
   /* create an empty FrictionContactProblem
    * \return an empty fcp */
   FrictionContactProblem* newFCP(void);
@@ -61,6 +61,10 @@ enum FRICTION_SOLVER
   SICONOS_FRICTION_3D_PFP = 522,
   /** ADMM local formulation */
   SICONOS_FRICTION_3D_ADMM = 523,
+  /** Non-smooth Gauss Seidel, multithreaded by coloring of the contact graph, local formulation */
+  SICONOS_FRICTION_3D_NSGS_OPENMP = 524,
+  /** Block Jacobi iterations on subdomains solved with NSGS, possibly distributed on MPI processes, local formulation */
+  SICONOS_FRICTION_3D_BLOCK_JACOBI = 525,
 
   /* 3D Frictional Contact solvers for one contact (used mainly inside NSGS solvers) */
 
@@ -120,6 +124,8 @@ extern const char* const   SICONOS_FRICTION_2D_LEMKE_STR ;
 extern const char* const   SICONOS_FRICTION_2D_ENUM_STR ;
 extern const char* const   SICONOS_FRICTION_3D_NSGS_STR ;
 extern const char* const   SICONOS_FRICTION_3D_NSGSV_STR ;
+extern const char* const   SICONOS_FRICTION_3D_NSGS_OPENMP_STR ;
+extern const char* const   SICONOS_FRICTION_3D_BLOCK_JACOBI_STR ;
 extern const char* const   SICONOS_FRICTION_3D_PROX_STR;
 extern const char* const   SICONOS_FRICTION_3D_TFP_STR ;
 extern const char* const   SICONOS_FRICTION_3D_PFP_STR ;
@@ -208,6 +214,10 @@ enum SICONOS_FRICTION_3D_NSGS_IPARAM
   SICONOS_FRICTION_3D_NSGS_SHUFFLE_SEED=6,
   /** index in iparam to store the  */
   SICONOS_FRICTION_3D_NSGS_FILTER_LOCAL_SOLUTION =14,
+  /** index in iparam to store the number of threads used by the multithreaded NSGS (0 : OpenMP default) */
+  SICONOS_FRICTION_3D_NSGS_OPENMP_NUMBER_OF_THREADS =15,
+  /** index in iparam to store (out) the number of colors of the contact graph used by the multithreaded NSGS */
+  SICONOS_FRICTION_3D_NSGS_OPENMP_NUMBER_OF_COLORS =16,
 };
 enum SICONOS_FRICTION_3D_NSGS_DPARAM
 {
@@ -215,6 +225,19 @@ enum SICONOS_FRICTION_3D_NSGS_DPARAM
   SICONOS_FRICTION_3D_NSGS_RELAXATION_VALUE=8,
 };
 
+enum SICONOS_FRICTION_3D_BLOCK_JACOBI_IPARAM
+{
+  /** index in iparam to store the number of subdomains (0 : one per MPI process) */
+  SICONOS_FRICTION_3D_BLOCK_JACOBI_NUMBER_OF_DOMAINS =15,
+  /** index in iparam to store (out) the number of subdomains effectively used */
+  SICONOS_FRICTION_3D_BLOCK_JACOBI_NUMBER_OF_DOMAINS_DONE =16,
+};
+enum SICONOS_FRICTION_3D_BLOCK_JACOBI_DPARAM
+{
+  /** index in dparam to store the relaxation value of the reactions, in ]0,1] */
+  SICONOS_FRICTION_3D_BLOCK_JACOBI_RELAXATION_VALUE=8,
+};
+
 
 enum SICONOS_FRICTION_3D_NSGS_LOCALSOLVER_IPARAM
 {
@@ -304,6 +327,9 @@ enum SICONOS_FRICTION_3D_NSN_FORMULATION_ENUM
   SICONOS_FRICTION_3D_NSN_FORMULATION_ALARTCURNIER_GENERATED =2,
   SICONOS_FRICTION_3D_NSN_FORMULATION_JEANMOREAU_GENERATED =3,
   SICONOS_FRICTION_3D_NSN_FORMULATION_NULL = 4 ,
+  /** STD Alart-Curnier function evaluated for all the contacts at once
+      (structure-of-arrays, vectorizable kernel) */
+  SICONOS_FRICTION_3D_NSN_FORMULATION_ALARTCURNIER_STD_BATCH = 5,
 };
 
 
@@ -366,8 +392,9 @@ enum SICONOS_FRICTION_3D_ADMM_IPARAM_ENUM
   /** index in iparam to store the strategy for computing rho */
   SICONOS_FRICTION_3D_ADMM_IPARAM_RHO_STRATEGY = 9,
   /** index in iparam to store the acceleration paramter */
-  SICONOS_FRICTION_3D_ADMM_IPARAM_ACCELERATION= 10
-
+  SICONOS_FRICTION_3D_ADMM_IPARAM_ACCELERATION= 10,
+  /** index in iparam to store the symmetry assumption on the matrix of the problem */
+  SICONOS_FRICTION_3D_ADMM_IPARAM_SYMMETRY= 11
 };
 
 enum SICONOS_FRICTION_3D_ADMM_DPARAM_ENUM
@@ -389,6 +416,18 @@ enum SICONOS_FRICTION_3D_ADMM_ACCELERATION_ENUM
   SICONOS_FRICTION_3D_ADMM_ACCELERATION_AND_RESTART= 2
 };
 
+enum SICONOS_FRICTION_3D_ADMM_SYMMETRY_ENUM
+{
+  /** the symmetry of M is checked: Cholesky factorization if M is
+   * symmetric, LU factorization otherwise */
+  SICONOS_FRICTION_3D_ADMM_CHECK_SYMMETRY= 0,
+  /** M is assumed to be symmetric: Cholesky factorization, with a
+   * fallback to LU if it fails */
+  SICONOS_FRICTION_3D_ADMM_ASSUME_SYMMETRY= 1,
+  /** M may be unsymmetric: LU factorization */
+  SICONOS_FRICTION_3D_ADMM_ASSUME_NO_SYMMETRY= 2
+};
+
 enum SICONOS_FRICTION_3D_ADMM_STRATEGY_ENUM
 {
   /** A constant value given in dparam[SICONOS_FRICTION_3D_NSN_RHO] is used */
@@ -0,0 +1,455 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/* fc3d_benchmark: run a set of solvers on a collection of friction-contact
+ * 3D problems and write the timings to a JSON file.
+ *
+ * Usage: fc3d_benchmark [options] file_or_directory ...
+ *
+ *  -s SOLVER[:iIDX=VAL][:dIDX=VAL]...  add a solver, given by its name or
+ *                         its id (e.g. FC3D_NSGS, SICONOS_FRICTION_3D_NSGS_OPENMP:i15=4),
+ *                         with some iparam/dparam values. Default: NSGS,
+ *                         NSGS_OPENMP, ADMM, NSN_AC and VI_EG
+ *  -t TOL                 tolerance of all the solvers (default 1e-8)
+ *  -i MAXITER             maximum number of iterations (default: the solver default)
+ *  -r N                   number of runs of each solver on each problem (default 1)
+ *  -o FILE                JSON output file (default: standard output)
+ *  -v                     verbose mode of the solvers
+ *
+ * The problems are fclib files (.hdf5, if Siconos is built WITH_FCLIB) or
+ * numerics files (.dat). The files of a directory are taken in
+ * alphabetical order.
+ *
+ * For each problem and solver, the output records the solver status, the
+ * number of iterations, the error, the wall clock time (minimum and mean
+ * over the runs) and an estimate of the number of floating point operations,
+ * iterations x 2 nnz(M), i.e. one product with M per iteration. This is a
+ * lower bound for the solvers that factorize a matrix at each iteration. */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include "SiconosConfig.h"
+#include "NonSmoothDrivers.h"
+#include "SolverOptions.h"
+#include "Friction_cst.h"
+#include "fc3d_Solvers.h"
+#include "FrictionContactProblem.h"
+#include "NumericsMatrix.h"
+#include "numerics_verbose.h"
+/* solver ids, for SICONOS_REGISTER_SOLVERS */
+#include "mlcp_cst.h"
+#include "MCP_cst.h"
+#include "NCP_cst.h"
+#include "lcp_cst.h"
+#include "relay_cst.h"
+#include "AVI_cst.h"
+#include "VI_cst.h"
+#include "SOCLCP_cst.h"
+#include "ConvexQP_cst.h"
+#include "SiconosNumerics_Solvers.h"
+#if defined(WITH_FCLIB)
+#include "fclib_interface.h"
+#endif
+
+#define MAX_PARAMS 16
+
+typedef struct
+{
+  char *spec;
+  int solverId;
+  int nb_iparam;
+  int iparam_idx[MAX_PARAMS];
+  int iparam_val[MAX_PARAMS];
+  int nb_dparam;
+  int dparam_idx[MAX_PARAMS];
+  double dparam_val[MAX_PARAMS];
+} benchmark_solver;
+
+static const char* default_solvers[] =
+{
+  "SICONOS_FRICTION_3D_NSGS",
+  "SICONOS_FRICTION_3D_NSGS_OPENMP",
+  "SICONOS_FRICTION_3D_ADMM",
+  "SICONOS_FRICTION_3D_NSN_AC",
+  "SICONOS_FRICTION_3D_VI_EG"
+};
+
+/* solver id from its name (solver_options_name_to_id) or from the name of
+ * its constant */
+static int solver_id(char* name)
+{
+  int id = solver_options_name_to_id(name);
+  if (id)
+    return id;
+#undef SICONOS_SOLVER_MACRO
+#define SICONOS_SOLVER_MACRO(X) if (strcmp(#X, name) == 0) return X;
+  SICONOS_REGISTER_SOLVERS()
+  return 0;
+}
+
+static void usage(const char* name)
+{
+  fprintf(stderr,
+          "Usage: %s [-s SOLVER[:iIDX=VAL][:dIDX=VAL]...] [-t TOL] [-i MAXITER] [-r N] [-o FILE] [-v] file_or_directory ...\n",
+          name);
+}
+
+/* parse SOLVER[:iIDX=VAL][:dIDX=VAL]... */
+static int parse_solver(const char* spec, benchmark_solver* solver)
+{
+  char* s = strdup(spec);
+  char* saveptr = NULL;
+  char* token = strtok_r(s, ":", &saveptr);
+  memset(solver, 0, sizeof(benchmark_solver));
+  solver->spec = strdup(spec);
+  solver->solverId = token ? solver_id(token) : 0;
+  if (solver->solverId == 0)
+  {
+    fprintf(stderr, "fc3d_benchmark: unknown solver %s\n", token ? token : spec);
+    free(s);
+    return 1;
+  }
+  while ((token = strtok_r(NULL, ":", &saveptr)))
+  {
+    int idx;
+    char kind;
+    char value[64];
+    if (sscanf(token, "%c%d=%63s", &kind, &idx, value) != 3 || idx < 0)
+    {
+      fprintf(stderr, "fc3d_benchmark: bad parameter %s in %s\n", token, spec);
+      free(s);
+      return 1;
+    }
+    if (kind == 'i' && solver->nb_iparam < MAX_PARAMS)
+    {
+      solver->iparam_idx[solver->nb_iparam] = idx;
+      solver->iparam_val[solver->nb_iparam++] = atoi(value);
+    }
+    else if (kind == 'd' && solver->nb_dparam < MAX_PARAMS)
+    {
+      solver->dparam_idx[solver->nb_dparam] = idx;
+      solver->dparam_val[solver->nb_dparam++] = atof(value);
+    }
+    else
+    {
+      fprintf(stderr, "fc3d_benchmark: bad parameter %s in %s\n", token, spec);
+      free(s);
+      return 1;
+    }
+  }
+  free(s);
+  return 0;
+}
+
+static int has_suffix(const char* name, const char* suffix)
+{
+  size_t n = strlen(name);
+  size_t m = strlen(suffix);
+  return n >= m && strcmp(name + n - m, suffix) == 0;
+}
+
+static int is_problem_file(const char* name)
+{
+#if defined(WITH_FCLIB)
+  if (has_suffix(name, ".hdf5"))
+    return 1;
+#endif
+  return has_suffix(name, ".dat");
+}
+
+static int compare_names(const void* a, const void* b)
+{
+  return strcmp(*(char* const*)a, *(char* const*)b);
+}
+
+/* append the problem files of path (a file or a directory) to files */
+static void collect_files(const char* path, char*** files, int* nb_files, int* capacity)
+{
+  struct stat st;
+  if (stat(path, &st) != 0)
+  {
+    fprintf(stderr, "fc3d_benchmark: cannot access %s\n", path);
+    return;
+  }
+  int first = *nb_files;
+  if (S_ISDIR(st.st_mode))
+  {
+    DIR* dir = opendir(path);
+    struct dirent* entry;
+    while (dir && (entry = readdir(dir)))
+    {
+      if (!is_problem_file(entry->d_name))
+        continue;
+      if (*nb_files == *capacity)
+      {
+        *capacity = 2 * (*capacity) + 16;
+        *files = (char**) realloc(*files, *capacity * sizeof(char*));
+      }
+      char* name = (char*) malloc(strlen(path) + strlen(entry->d_name) + 2);
+      sprintf(name, "%s/%s", path, entry->d_name);
+      (*files)[(*nb_files)++] = name;
+    }
+    if (dir)
+      closedir(dir);
+    qsort(*files + first, *nb_files - first, sizeof(char*), compare_names);
+  }
+  else
+  {
+    if (*nb_files == *capacity)
+    {
+      *capacity = 2 * (*capacity) + 16;
+      *files = (char**) realloc(*files, *capacity * sizeof(char*));
+    }
+    (*files)[(*nb_files)++] = strdup(path);
+  }
+}
+
+static FrictionContactProblem* read_problem(const char* path)
+{
+#if defined(WITH_FCLIB)
+  if (has_suffix(path, ".hdf5"))
+    return frictionContact_fclib_read(path);
+#endif
+  FrictionContactProblem* problem = (FrictionContactProblem*) malloc(sizeof(FrictionContactProblem));
+  if (frictionContact_newFromFilename(problem, (char*)path))
+  {
+    free(problem);
+    return NULL;
+  }
+  return problem;
+}
+
+static double wall_time(void)
+{
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return (double)t.tv_sec + 1e-9 * (double)t.tv_nsec;
+}
+
+static void json_string(FILE* out, const char* s)
+{
+  fputc('"', out);
+  for (; *s; ++s)
+  {
+    if (*s == '"' || *s == '\\')
+      fprintf(out, "\\%c", *s);
+    else if ((unsigned char)*s < 0x20)
+      fprintf(out, "\\u%04x", (unsigned char)*s);
+    else
+      fputc(*s, out);
+  }
+  fputc('"', out);
+}
+
+int main(int argc, char** argv)
+{
+  benchmark_solver* solvers = NULL;
+  int nb_solvers = 0;
+  double tolerance = 1e-8;
+  int maxiter = 0;
+  int nb_runs = 1;
+  const char* output = NULL;
+  int verbose_mode = 0;
+
+  char** files = NULL;
+  int nb_files = 0;
+  int capacity = 0;
+
+  for (int k = 1; k < argc; ++k)
+  {
+    if (argv[k][0] == '-' && argv[k][1] != '\0' && argv[k][2] == '\0')
+    {
+      char opt = argv[k][1];
+      if (opt == 'v')
+      {
+        verbose_mode = 1;
+        continue;
+      }
+      if (k + 1 >= argc)
+      {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+      }
+      const char* value = argv[++k];
+      switch (opt)
+      {
+      case 's':
+        solvers = (benchmark_solver*) realloc(solvers, (nb_solvers + 1) * sizeof(benchmark_solver));
+        if (parse_solver(value, &solvers[nb_solvers]))
+          return EXIT_FAILURE;
+        nb_solvers++;
+        break;
+      case 't':
+        tolerance = atof(value);
+        break;
+      case 'i':
+        maxiter = atoi(value);
+        break;
+      case 'r':
+        nb_runs = atoi(value) > 0 ? atoi(value) : 1;
+        break;
+      case 'o':
+        output = value;
+        break;
+      default:
+        usage(argv[0]);
+        return EXIT_FAILURE;
+      }
+    }
+    else
+      collect_files(argv[k], &files, &nb_files, &capacity);
+  }
+
+  if (nb_files == 0)
+  {
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  if (nb_solvers == 0)
+  {
+    nb_solvers = sizeof(default_solvers) / sizeof(default_solvers[0]);
+    solvers = (benchmark_solver*) malloc(nb_solvers * sizeof(benchmark_solver));
+    for (int s = 0; s < nb_solvers; ++s)
+      if (parse_solver(default_solvers[s], &solvers[s]))
+        return EXIT_FAILURE;
+  }
+
+  numerics_set_verbose(verbose_mode);
+
+  FILE* out = output ? fopen(output, "w") : stdout;
+  if (!out)
+  {
+    fprintf(stderr, "fc3d_benchmark: cannot open %s\n", output);
+    return EXIT_FAILURE;
+  }
+
+  time_t now = time(NULL);
+  char date[32];
+  strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+
+  fprintf(out, "{\n  \"date\": \"%s\",\n  \"tolerance\": %g,\n  \"max_iter\": %d,\n  \"runs_per_solver\": %d,\n",
+          date, tolerance, maxiter, nb_runs);
+  fprintf(out, "  \"solvers\": [");
+  for (int s = 0; s < nb_solvers; ++s)
+  {
+    if (s)
+      fputs(", ", out);
+    json_string(out, solvers[s].spec);
+  }
+  fprintf(out, "],\n  \"results\": [");
+
+  int first_result = 1;
+  for (int f = 0; f < nb_files; ++f)
+  {
+    FrictionContactProblem* problem = read_problem(files[f]);
+    if (!problem)
+    {
+      fprintf(stderr, "fc3d_benchmark: cannot read %s\n", files[f]);
+      continue;
+    }
+    if (problem->dimension != 3)
+    {
+      fprintf(stderr, "fc3d_benchmark: %s is not a 3D problem, skipped\n", files[f]);
+      freeFrictionContactProblem(problem);
+      continue;
+    }
+
+    int n = 3 * problem->numberOfContacts;
+    size_t nnz = NM_nnz(problem->M);
+    double* reaction = (double*) malloc(n * sizeof(double));
+    double* velocity = (double*) malloc(n * sizeof(double));
+
+    for (int s = 0; s < nb_solvers; ++s)
+    {
+      benchmark_solver* solver = &solvers[s];
+      int info = -1;
+      int iter = 0;
+      double error = 0.;
+      double tmin = 0.;
+      double tsum = 0.;
+
+      for (int run = 0; run < nb_runs; ++run)
+      {
+        SolverOptions options;
+        fc3d_setDefaultSolverOptions(&options, solver->solverId);
+        options.dparam[SICONOS_DPARAM_TOL] = tolerance;
+        if (maxiter > 0)
+          options.iparam[SICONOS_IPARAM_MAX_ITER] = maxiter;
+        for (int k = 0; k < solver->nb_iparam; ++k)
+          if (solver->iparam_idx[k] < options.iSize)
+            options.iparam[solver->iparam_idx[k]] = solver->iparam_val[k];
+        for (int k = 0; k < solver->nb_dparam; ++k)
+          if (solver->dparam_idx[k] < options.dSize)
+            options.dparam[solver->dparam_idx[k]] = solver->dparam_val[k];
+
+        memset(reaction, 0, n * sizeof(double));
+        memset(velocity, 0, n * sizeof(double));
+
+        double t0 = wall_time();
+        info = fc3d_driver(problem, reaction, velocity, &options);
+        double t = wall_time() - t0;
+
+        iter = options.iparam[SICONOS_IPARAM_ITER_DONE];
+        error = options.dparam[SICONOS_DPARAM_RESIDU];
+        tsum += t;
+        if (run == 0 || t < tmin)
+          tmin = t;
+        solver_options_delete(&options);
+      }
+
+      fprintf(stderr, "%s %s: info = %d, iterations = %d, error = %e, time = %e s\n",
+              files[f], solver->spec, info, iter, error, tmin);
+
+      fputs(first_result ? "\n" : ",\n", out);
+      first_result = 0;
+      fprintf(out, "    {\"problem\": ");
+      json_string(out, files[f]);
+      fprintf(out, ", \"contacts\": %d, \"nnz\": %zu, \"solver\": ", problem->numberOfContacts, nnz);
+      json_string(out, solver->spec);
+      fprintf(out, ", \"solver_name\": ");
+      json_string(out, solver_options_id_to_name(solver->solverId));
+      fprintf(out, ", \"info\": %d, \"iterations\": %d, \"error\": %.6e, "
+              "\"time\": %.6e, \"time_mean\": %.6e, \"flops_estimate\": %.6e}",
+              info, iter, error, tmin, tsum / nb_runs, 2.0 * (double)nnz * iter);
+      fflush(out);
+    }
+
+    free(reaction);
+    free(velocity);
+    freeFrictionContactProblem(problem);
+  }
+  fprintf(out, "\n  ]\n}\n");
+
+  if (output)
+    fclose(out);
+  for (int f = 0; f < nb_files; ++f)
+    free(files[f]);
+  free(files);
+  for (int s = 0; s < nb_solvers; ++s)
+    free(solvers[s].spec);
+  free(solvers);
+  return EXIT_SUCCESS;
+}
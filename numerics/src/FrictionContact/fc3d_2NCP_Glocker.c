@@ -32,8 +32,10 @@
 #include <math.h>
 #include "SiconosBlas.h"
 #include "numerics_verbose.h"
+#include "tlsdef.h"
 
-/*Static variables */
+/*Static variables, thread local since the functions of the Newton solver
+  have no user data */
 
 /* The global problem of size n= 3*nc, nc being the number of contacts, is locally saved in MGlobal and qGlobal */
 /* mu corresponds to the vector of friction coefficients */
@@ -50,30 +52,30 @@
 /* static int isMAllocatedIn = 0; /\* True if a malloc is done for MLocal, else false *\/ */
 /* static double qLocal[3]; */
 
-static FrictionContactProblem* localFC3D = NULL;
-static FrictionContactProblem* globalFC3D = NULL;
+static tlsvar FrictionContactProblem* localFC3D = NULL;
+static tlsvar FrictionContactProblem* globalFC3D = NULL;
 
 
 
 
 /* Local "Glocker" variables */
 static const int Gsize = 5;
-static double reactionGlocker[5];
-static double MGlocker[25];
+static tlsvar double reactionGlocker[5];
+static tlsvar double MGlocker[25];
 /* static double qGlocker[5]; */
 /* static double gGlocker[5]; */
 
 /* Output */
-static double jacobianFGlocker[25];
-static double FGlocker[5];
+static tlsvar double jacobianFGlocker[25];
+static tlsvar double FGlocker[5];
 
-static double mu_i = 0.0;
+static tlsvar double mu_i = 0.0;
 
 /* static double e1[2],e2[2] ; */
-static double e3[2];
-static double IpInv[4];
-static double IpInvTranspose[4];
-static double Igloc[4];
+static tlsvar double e3[2];
+static tlsvar double IpInv[4];
+static tlsvar double IpInvTranspose[4];
+static tlsvar double Igloc[4];
 # define PI 3.14159265358979323846 /* pi */
 
 void computeE(unsigned int i, double* e)
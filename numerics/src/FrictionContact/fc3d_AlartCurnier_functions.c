@@ -785,6 +785,162 @@ void computeAlartCurnierSTD(double R[3], double velocity[3], double mu, double r
 }
 
 
+/* The loop bodies below are written without branches: the three cases of
+ * computeAlartCurnierSTD are evaluated and the results are selected with
+ * ternary operators, so that the compiler can vectorize them over the
+ * contacts. Every operation is done unconditionally, otherwise it could
+ * trap and prevent the if-conversion. With GCC on x86_64, AVX2 and
+ * AVX-512 versions are built and the best one is chosen at load time. */
+#if defined(_OPENMP) && _OPENMP >= 201307
+#define AC_BATCH_SIMD _Pragma("omp simd")
+#elif defined(__GNUC__) && !defined(__clang__)
+#define AC_BATCH_SIMD _Pragma("GCC ivdep")
+#else
+#define AC_BATCH_SIMD
+#endif
+
+#if defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 6) \
+  && defined(__x86_64__) && defined(__linux__)
+#define AC_BATCH_TARGETS __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define AC_BATCH_TARGETS
+#endif
+
+AC_BATCH_TARGETS
+void fc3d_AlartCurnierSTD_batch(unsigned int nc,
+                                const double* restrict reaction,
+                                const double* restrict velocity,
+                                const double* restrict mu,
+                                const double* restrict rho,
+                                double* restrict F,
+                                double* restrict A,
+                                double* restrict B)
+{
+  const double* restrict R0 = reaction;
+  const double* restrict R1 = reaction + nc;
+  const double* restrict R2 = reaction + 2 * nc;
+  const double* restrict u0 = velocity;
+  const double* restrict u1 = velocity + nc;
+  const double* restrict u2 = velocity + 2 * nc;
+  const double* restrict rhoN = rho;
+  const double* restrict rhoT = rho + nc;
+
+  double* restrict F0 = F;
+  double* restrict F1 = F + nc;
+  double* restrict F2 = F + 2 * nc;
+
+  if (!(A && B))
+  {
+    AC_BATCH_SIMD
+    for (unsigned int i = 0; i < nc; ++i)
+    {
+      double RVN = R0[i] - rhoN[i] * u0[i];
+      double RVT = R1[i] - rhoT[i] * u1[i];
+      double RVS = R2[i] - rhoT[i] * u2[i];
+      double RV = sqrt(RVT * RVT + RVS * RVS);
+
+      double MuRVN = mu[i] * RVN;
+      double Radius = (RVN > 0.0) ? MuRVN : 0.0;
+      int disk = RV <= Radius;
+      /* out of the disk, RV > Radius >= 0 */
+      double RV1 = 1.0 / (disk ? 1.0 : RV);
+
+      double F0in = rhoN[i] * u0[i];
+      double F1in = rhoT[i] * u1[i];
+      double F2in = rhoT[i] * u2[i];
+      double F1out = R1[i] - Radius * RVT * RV1;
+      double F2out = R2[i] - Radius * RVS * RV1;
+
+      F0[i] = (RVN > 0.0) ? F0in : R0[i];
+      F1[i] = disk ? F1in : F1out;
+      F2[i] = disk ? F2in : F2out;
+    }
+    return;
+  }
+
+  /* A and B are column-major 3x3 blocks, entry (r, c) of contact i is
+     stored at [(r + 3 * c) * nc + i] */
+  double* restrict A00 = A;           double* restrict B00 = B;
+  double* restrict A10 = A + nc;      double* restrict B10 = B + nc;
+  double* restrict A20 = A + 2 * nc;  double* restrict B20 = B + 2 * nc;
+  double* restrict A01 = A + 3 * nc;  double* restrict B01 = B + 3 * nc;
+  double* restrict A11 = A + 4 * nc;  double* restrict B11 = B + 4 * nc;
+  double* restrict A21 = A + 5 * nc;  double* restrict B21 = B + 5 * nc;
+  double* restrict A02 = A + 6 * nc;  double* restrict B02 = B + 6 * nc;
+  double* restrict A12 = A + 7 * nc;  double* restrict B12 = B + 7 * nc;
+  double* restrict A22 = A + 8 * nc;  double* restrict B22 = B + 8 * nc;
+
+  AC_BATCH_SIMD
+  for (unsigned int i = 0; i < nc; ++i)
+  {
+    double Mu = mu[i];
+    double RhoN = rhoN[i];
+    double RhoT = rhoT[i];
+    double RVN = R0[i] - RhoN * u0[i];
+    double RVT = R1[i] - RhoT * u1[i];
+    double RVS = R2[i] - RhoT * u2[i];
+    double RV = sqrt(RVT * RVT + RVS * RVS);
+
+    /* normal part in the cone */
+    double MuRVN = Mu * RVN;
+    double Radius = (RVN > 0.0) ? MuRVN : 0.0;
+    /* tangential part in the disk, or out of the disk with a positive
+       radius (slide). Out of the disk with a zero radius is the
+       remaining case */
+    double RV1 = 1.0 / ((RV <= Radius) ? 1.0 : RV);
+
+    double F0in = RhoN * u0[i];
+    double F1in = RhoT * u1[i];
+    double F2in = RhoT * u2[i];
+    double F1out = R1[i] - Radius * RVT * RV1;
+    double F2out = R2[i] - Radius * RVS * RV1;
+
+    F0[i] = (RVN > 0.0) ? F0in : R0[i];
+    F1[i] = (RV <= Radius) ? F1in : F1out;
+    F2[i] = (RV <= Radius) ? F2in : F2out;
+
+    double RV3 = RV1 * RV1 * RV1;
+    double GammaTT = RV1 - RVT * RVT * RV3;
+    double GammaTS = - RVT * RVS * RV3;
+    double GammaSS = RV1 - RVS * RVS * RV3;
+
+    /* the sliding values, zeroed when the radius is zero */
+    double RadiusS = (Radius > 0.0) ? Radius : 0.0;
+    double MuS = (Radius > 0.0) ? Mu : 0.0;
+    double A10s = MuS * RhoN * RVT * RV1;
+    double A20s = MuS * RhoN * RVS * RV1;
+    double A11s = GammaTT * RhoT * RadiusS;
+    double A12s = GammaTS * RhoT * RadiusS;
+    double A22s = GammaSS * RhoT * RadiusS;
+    double B10s = -MuS * RVT * RV1;
+    double B20s = -MuS * RVS * RV1;
+    double B11s = 1.0 - GammaTT * RadiusS;
+    double B12s = - GammaTS * RadiusS;
+    double B22s = 1.0 - GammaSS * RadiusS;
+
+    A00[i] = (RVN > 0.0) ? RhoN : 0.0;
+    B00[i] = (RVN > 0.0) ? 0.0 : 1.0;
+    A01[i] = 0.0;
+    A02[i] = 0.0;
+    B01[i] = 0.0;
+    B02[i] = 0.0;
+
+    A10[i] = (RV <= Radius) ? 0.0 : A10s;
+    A20[i] = (RV <= Radius) ? 0.0 : A20s;
+    A11[i] = (RV <= Radius) ? RhoT : A11s;
+    A12[i] = (RV <= Radius) ? 0.0 : A12s;
+    A21[i] = (RV <= Radius) ? 0.0 : A12s;
+    A22[i] = (RV <= Radius) ? RhoT : A22s;
+
+    B10[i] = (RV <= Radius) ? 0.0 : B10s;
+    B20[i] = (RV <= Radius) ? 0.0 : B20s;
+    B11[i] = (RV <= Radius) ? 0.0 : B11s;
+    B12[i] = (RV <= Radius) ? 0.0 : B12s;
+    B21[i] = (RV <= Radius) ? 0.0 : B12s;
+    B22[i] = (RV <= Radius) ? 0.0 : B22s;
+  }
+}
+
 /* Christensen & Pang version (Radius = mu* R[0])*/
 void computeAlartCurnierJeanMoreau(double R[3], double velocity[3], double mu, double rho[3], double F[3], double A[9], double B[9])
 {
@@ -72,6 +72,30 @@ extern "C"
                                double mu, double rho[3],
                                double result[3], double A[9], double B[9]);
 
+  /** Batched version of computeAlartCurnierSTD: evaluates the function and
+   * its gradients for nc contacts at once. All arrays are in
+   * structure-of-arrays layout, component k of contact i being stored at
+   * [k * nc + i]:
+   * \param nc the number of contacts
+   * \param reaction the reactions (3 * nc)
+   * \param velocity the velocities (3 * nc)
+   * \param mu the friction coefficients (nc)
+   * \param rho the normal then tangential rho (2 * nc)
+   * \param[out] F the function (3 * nc)
+   * \param[out] A the gradient w.r.t. the velocity (9 * nc, entry (r,c) of
+   * the 3x3 column-major block at k = r + 3 * c), may be NULL
+   * \param[out] B the gradient w.r.t. the reaction (9 * nc), may be NULL
+   * The arrays must not overlap (they are restrict in the definition).
+   */
+  void fc3d_AlartCurnierSTD_batch(unsigned int nc,
+                                  const double* reaction,
+                                  const double* velocity,
+                                  const double* mu,
+                                  const double* rho,
+                                  double* F,
+                                  double* A,
+                                  double* B);
+
   /* /\** Computes F function used in Newton process for Alart-Curnier formulation */
   /*     \param size of the local problem */
   /*     \param localreaction */
@@ -109,7 +109,7 @@ void fc3d_ConvexQP_ProjectedGradient_Cylinder(FrictionContactProblem* problem, d
   /* } */
 
   error = cqpsolver_options->dparam[1];
-  iter = cqpsolver_options->iparam[7];
+  iter = cqpsolver_options->iparam[SICONOS_IPARAM_ITER_DONE];
 
   options->dparam[SICONOS_DPARAM_RESIDU] = error;
   options->iparam[SICONOS_IPARAM_ITER_DONE] = iter;
@@ -18,6 +18,7 @@
 #include "projectionOnCone.h"
 #include "fc3d_Solvers.h"
 #include "fc3d_compute_error.h"
+#include "fixed_point_acceleration.h"
 #include "SiconosBlas.h"
 
 #include <stdio.h>
@@ -104,6 +105,9 @@ void fc3d_ExtraGradient(FrictionContactProblem* problem, double *reaction, doubl
     velocity_k = (double *)calloc(n,sizeof(double));
   }
 
+  FixedPointAcceleration* acc = fixed_point_acceleration_new(n, options, reaction,
+                                                             &fc3d_projectionOnCones, problem);
+
   if (!isVariable)
   {
     /*   double minusrho  = -1.0*rho; */
@@ -158,6 +162,9 @@ void fc3d_ExtraGradient(FrictionContactProblem* problem, double *reaction, doubl
       }
       if (error < tolerance) hasNotConverged = 0;
       *info = hasNotConverged;
+
+      if (acc && hasNotConverged && iter < itermax)
+        fixed_point_acceleration_update(acc, reaction, error);
     }
   }
 
@@ -304,6 +311,9 @@ void fc3d_ExtraGradient(FrictionContactProblem* problem, double *reaction, doubl
       }
       if (error < tolerance) hasNotConverged = 0;
       *info = hasNotConverged;
+
+      if (acc && hasNotConverged && iter < itermax)
+        fixed_point_acceleration_update(acc, reaction, error);
     }
   }
 
@@ -322,6 +332,7 @@ void fc3d_ExtraGradient(FrictionContactProblem* problem, double *reaction, doubl
     free(reaction_k);
     free(velocity_k);
   }
+  fixed_point_acceleration_free(acc);
 }
 
 
@@ -337,8 +348,8 @@ int fc3d_ExtraGradient_setDefaultSolverOptions(SolverOptions* options)
   options->numberOfInternalSolvers = 0;
   options->isSet = 1;
   options->filterOn = 1;
-  options->iSize = 8;
-  options->dSize = 8;
+  options->iSize = 14;
+  options->dSize = 14;
   options->iparam = (int *)calloc(options->iSize, sizeof(int));
   options->dparam = (double *)calloc(options->dSize, sizeof(double));
   options->dWork = NULL;
@@ -18,6 +18,7 @@
 #include "projectionOnCone.h"
 #include "fc3d_Solvers.h"
 #include "fc3d_compute_error.h"
+#include "fixed_point_acceleration.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -100,6 +101,9 @@ void fc3d_fixedPointProjection(FrictionContactProblem* problem, double *reaction
 
 
 
+  FixedPointAcceleration* acc = fixed_point_acceleration_new(n, options, reaction,
+                                                             &fc3d_projectionOnCones, problem);
+
   // Compute new rho if variable
   if (isVariable)
   {
@@ -225,6 +229,9 @@ void fc3d_fixedPointProjection(FrictionContactProblem* problem, double *reaction
 
     if (error < tolerance) hasNotConverged = 0;
     *info = hasNotConverged;
+
+    if (acc && hasNotConverged && iter < itermax)
+      fixed_point_acceleration_update(acc, reaction, error);
   }
 
   }
@@ -240,6 +247,7 @@ void fc3d_fixedPointProjection(FrictionContactProblem* problem, double *reaction
   free(reaction_k);
   free(velocity_k);
   free(reactiontmp);
+  fixed_point_acceleration_free(acc);
 
 }
 
@@ -256,8 +264,8 @@ int fc3d_fixedPointProjection_setDefaultSolverOptions(SolverOptions* options)
   options->numberOfInternalSolvers = 0;
   options->isSet = 1;
   options->filterOn = 1;
-  options->iSize = 8;
-  options->dSize = 8;
+  options->iSize = 14;
+  options->dSize = 14;
   options->iparam = (int *)calloc(options->iSize, sizeof(int));
   options->dparam = (double *)calloc(options->dSize, sizeof(double));
   options->dWork = NULL;
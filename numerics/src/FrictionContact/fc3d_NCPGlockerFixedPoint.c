@@ -24,15 +24,16 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include "numerics_verbose.h"
+#include "tlsdef.h"
 /* Pointer to function used to update the solver, to formalize the local problem for example. */
 typedef void (*UpdateSolverPtr)(int, double*);
 
-static UpdateSolverPtr updateSolver = NULL;
-static PostSolverPtr postSolver = NULL;
-static FreeSolverPtr freeSolver = NULL;
+static tlsvar UpdateSolverPtr updateSolver = NULL;
+static tlsvar PostSolverPtr postSolver = NULL;
+static tlsvar FreeSolverPtr freeSolver = NULL;
 
 /* size of a block */
-static int Fsize;
+static tlsvar int Fsize;
 
 /** writes \f$ F(z) \f$ using Glocker formulation
  */
@@ -123,6 +123,82 @@ extern "C"
   */
   int fc3d_nsgs_setDefaultSolverOptions(SolverOptions* options);
 
+  /** Multithreaded Non-Smooth Gauss Seidel solver for friction-contact 3D problem.
+
+      The contacts are colored such that two contacts coupled by a non null
+      block of M (i.e. contacts sharing a body) get different colors. The
+      contacts of a color are then uncoupled and their local problems are
+      solved in parallel (OpenMP), the colors being swept one after the other.
+      The result is a (multicolor) Gauss-Seidel iteration. Without OpenMP, or
+      if M is not stored as a SBM, the colors are swept serially.
+
+      The parameters are the ones of fc3d_nsgs(), except:
+
+      [in] iparam[SICONOS_FRICTION_3D_NSGS_SHUFFLE(5)] must be SICONOS_FRICTION_3D_NSGS_SHUFFLE_FALSE
+
+      [in] iparam[SICONOS_FRICTION_3D_NSGS_OPENMP_NUMBER_OF_THREADS(15)] : number of threads (0 for the OpenMP default)
+
+      [out] iparam[SICONOS_FRICTION_3D_NSGS_OPENMP_NUMBER_OF_COLORS(16)] : number of colors of the contact graph
+
+      The internal (local) solver must be one of the Newton (SICONOS_FRICTION_3D_ONECONTACT_NSN*)
+      or projection (SICONOS_FRICTION_3D_ONECONTACT_ProjectionOnCone*) one-contact solvers.
+
+      \param problem the friction-contact 3D problem to solve
+      \param velocity global vector (n), in-out parameter
+      \param reaction global vector (n), in-out parameters
+      \param info return 0 if the solution is found
+      \param options the solver options
+  */
+  void fc3d_nsgs_openmp(FrictionContactProblem* problem, double *reaction, double *velocity, int* info, SolverOptions* options);
+
+  /** set the default solver parameters and perform memory allocation for NSGS_OPENMP
+      \param options the pointer to the array of options to set
+  */
+  int fc3d_nsgs_openmp_setDefaultSolverOptions(SolverOptions* options);
+
+  /** Block Jacobi (domain decomposition) solver for friction-contact 3D problem.
+
+      The contacts are partitioned in subdomains, contacts coupled by a non
+      null block of M (i.e. sharing a body) being kept together as much as
+      possible (SBM_row_blocks_partition()). At each iteration, the problem
+      restricted to each subdomain, where the reactions of the other
+      subdomains are frozen at their previous value, is solved with fc3d_nsgs(),
+      then all the reactions are updated at once. The subdomains are thus
+      independent during an iteration.
+
+      When Siconos is built with MPI and MPI is initialized by the caller, the
+      subdomain d is solved by the process d % size of MPI_COMM_WORLD and the
+      reactions are exchanged at the end of each iteration. Every process
+      must be given the whole problem (e.g. read from the same fclib file);
+      they all return the same solution. Otherwise the subdomains are solved
+      in sequence.
+
+      [in] iparam[SICONOS_IPARAM_MAX_ITER(0)] : maximum number of block Jacobi iterations
+
+      [in] iparam[SICONOS_FRICTION_3D_BLOCK_JACOBI_NUMBER_OF_DOMAINS(15)] : number of subdomains (0 for one per MPI process)
+
+      [out] iparam[SICONOS_FRICTION_3D_BLOCK_JACOBI_NUMBER_OF_DOMAINS_DONE(16)] : number of subdomains used
+
+      [in] dparam[SICONOS_DPARAM_TOL(0)] : tolerance on fc3d_compute_error()
+
+      [in] dparam[SICONOS_FRICTION_3D_BLOCK_JACOBI_RELAXATION_VALUE(8)] : relaxation of the reactions in ]0,1]
+
+      The internal solver, used for the subdomains, must be SICONOS_FRICTION_3D_NSGS.
+      M must be stored as a dense matrix or as a SBM.
+
+      \param problem the friction-contact 3D problem to solve
+      \param velocity global vector (n), in-out parameter
+      \param reaction global vector (n), in-out parameters
+      \param info return 0 if the solution is found
+      \param options the solver options
+  */
+  void fc3d_block_jacobi(FrictionContactProblem* problem, double *reaction, double *velocity, int* info, SolverOptions* options);
+
+  /** set the default solver parameters and perform memory allocation for BLOCK_JACOBI
+      \param options the pointer to the array of options to set
+  */
+  int fc3d_block_jacobi_setDefaultSolverOptions(SolverOptions* options);
+
   void fc3d_admm(FrictionContactProblem*  problem, double*  reaction,
                  double*  velocity,
                  int*  info, SolverOptions*  options);
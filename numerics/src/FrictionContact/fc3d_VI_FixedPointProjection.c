@@ -106,7 +106,7 @@ void fc3d_VI_FixedPointProjection(FrictionContactProblem* problem, double *react
   /* } */
 
   error = visolver_options->dparam[1];
-  iter = visolver_options->iparam[7];
+  iter = visolver_options->iparam[SICONOS_IPARAM_ITER_DONE];
 
   options->dparam[SICONOS_DPARAM_RESIDU] = error;
   options->dparam[3] = visolver_options->dparam[SICONOS_VI_EG_DPARAM_RHO];
@@ -212,7 +212,7 @@ void fc3d_VI_FixedPointProjection_Cylinder(FrictionContactProblem* problem, doub
   /* } */
 
   error = visolver_options->dparam[1];
-  iter = visolver_options->iparam[7];
+  iter = visolver_options->iparam[SICONOS_IPARAM_ITER_DONE];
 
   options->dparam[SICONOS_DPARAM_RESIDU] = error;
   options->dparam[3] =  visolver_options->dparam[SICONOS_VI_EG_DPARAM_RHO];
@@ -22,6 +22,7 @@
 #include "projectionOnCone.h"
 #include "SiconosLapack.h"
 #include "SparseBlockMatrix.h"
+#include "op3x3.h"
 #include <stdio.h>
 #include <assert.h>
 #include <math.h>
@@ -51,6 +52,118 @@ Fc3d_ADDM_data;
 
 
 
+/* Solver of (M + rho I) x = b for a matrix-free M (NM_OPERATOR): conjugate
+ * gradient preconditioned by the 3x3 diagonal blocks of M + rho I, and
+ * warm-started with the solution of the previous ADMM iteration. */
+typedef struct
+{
+  double * blocks; /* diagonal blocks of M */
+  double * x;      /* previous solution */
+  double * r;
+  double * z;
+  double * p;
+  double * Mp;
+}
+Fc3d_ADDM_operator_data;
+
+static Fc3d_ADDM_operator_data * fc3d_admm_operator_data_new(NumericsMatrix* M, int nc)
+{
+  int m = 3 * nc;
+  Fc3d_ADDM_operator_data * cg = (Fc3d_ADDM_operator_data *)malloc(sizeof(Fc3d_ADDM_operator_data));
+  cg->blocks = (double*)malloc(9 * nc * sizeof(double));
+  cg->x = (double*)calloc(m, sizeof(double));
+  cg->r = (double*)malloc(m * sizeof(double));
+  cg->z = (double*)malloc(m * sizeof(double));
+  cg->p = (double*)malloc(m * sizeof(double));
+  cg->Mp = (double*)malloc(m * sizeof(double));
+  for(int contact = 0 ; contact < nc ; ++contact)
+  {
+    double * block = &cg->blocks[9 * contact];
+    NM_extract_diag_block3(M, contact, &block);
+  }
+  return cg;
+}
+
+static void fc3d_admm_operator_data_free(Fc3d_ADDM_operator_data * cg)
+{
+  free(cg->blocks);
+  free(cg->x);
+  free(cg->r);
+  free(cg->z);
+  free(cg->p);
+  free(cg->Mp);
+  free(cg);
+}
+
+/* an estimation of the 1-norm of M from its diagonal blocks */
+static double fc3d_admm_operator_norm_1(Fc3d_ADDM_operator_data * cg, int nc)
+{
+  double norm = 0.0;
+  for(int contact = 0 ; contact < nc ; ++contact)
+    for(int j = 0 ; j < 3 ; ++j)
+      norm = fmax(norm, cblas_dasum(3, &cg->blocks[9 * contact + 3 * j], 1));
+  return norm;
+}
+
+static void fc3d_admm_operator_precond(Fc3d_ADDM_operator_data * cg, int nc, double rho,
+                                       double * r, double * z)
+{
+  double a[9];
+  cblas_dcopy(3 * nc, r, 1, z, 1);
+  for(int contact = 0 ; contact < nc ; ++contact)
+  {
+    cblas_dcopy(9, &cg->blocks[9 * contact], 1, a, 1);
+    a[0] += rho;
+    a[4] += rho;
+    a[8] += rho;
+    /* no preconditioning on a singular block */
+    if(solve_3x3_gepp(a, &z[3 * contact]))
+      cblas_dcopy(3, &r[3 * contact], 1, &z[3 * contact], 1);
+  }
+}
+
+/* solve (M + rho I) x = b up to the relative tolerance tol, b is replaced
+ * by x. Return the number of iterations. */
+static int fc3d_admm_operator_solve(NumericsMatrix* M, Fc3d_ADDM_operator_data * cg, int nc,
+                                    double rho, double tol, double * b)
+{
+  int m = 3 * nc;
+  double norm_b = cblas_dnrm2(m, b, 1);
+  double * x = cg->x;
+
+  /* r = b - (M + rho I) x */
+  cblas_dcopy(m, b, 1, cg->r, 1);
+  NM_gemv(-1.0, M, x, 1.0, cg->r);
+  cblas_daxpy(m, -rho, x, 1, cg->r, 1);
+
+  fc3d_admm_operator_precond(cg, nc, rho, cg->r, cg->z);
+  cblas_dcopy(m, cg->z, 1, cg->p, 1);
+  double rz = cblas_ddot(m, cg->r, 1, cg->z, 1);
+
+  int iter = 0;
+  while(iter < m && cblas_dnrm2(m, cg->r, 1) > tol * norm_b)
+  {
+    ++iter;
+    /* Mp = (M + rho I) p */
+    cblas_dcopy(m, cg->p, 1, cg->Mp, 1);
+    NM_gemv(1.0, M, cg->p, rho, cg->Mp);
+    double alpha = rz / cblas_ddot(m, cg->p, 1, cg->Mp, 1);
+    cblas_daxpy(m, alpha, cg->p, 1, x, 1);
+    cblas_daxpy(m, -alpha, cg->Mp, 1, cg->r, 1);
+
+    fc3d_admm_operator_precond(cg, nc, rho, cg->r, cg->z);
+    double rz_new = cblas_ddot(m, cg->r, 1, cg->z, 1);
+    double beta = rz_new / rz;
+    rz = rz_new;
+    /* p = z + beta p */
+    cblas_dscal(m, beta, cg->p, 1);
+    cblas_daxpy(m, 1.0, cg->z, 1, cg->p, 1);
+  }
+  DEBUG_PRINTF("fc3d_admm_operator_solve: %i iterations\n", iter);
+  cblas_dcopy(m, x, 1, b, 1);
+  return iter;
+}
+
 void fc3d_admm_init(FrictionContactProblem* problem, SolverOptions* options)
 {
   int nc = problem->numberOfContacts;
@@ -135,15 +248,29 @@ void fc3d_admm(FrictionContactProblem* restrict problem, double* restrict reacti
 
   double norm_q = cblas_dnrm2(m , problem->q , 1);
 
-  if(!(NM_is_symmetric(M)))
+  /* a matrix-free M is only known through its products: M + rho I is
+   * then solved with a conjugate gradient, and M is assumed symmetric */
+  Fc3d_ADDM_operator_data * cg = NULL;
+  int is_symmetric = 1;
+  if(M->storageType == NM_OPERATOR)
   {
-    double d= NM_symmetry_discrepancy(M);
-    numerics_warning("fc3d_admm","---- FC3D - ADMM - M is not symmetric (%e)\n",d);
+    cg = fc3d_admm_operator_data_new(M, nc);
+    numerics_printf_verbose(1,"---- FC3D - ADMM - Problem information");
+    numerics_printf_verbose(1,"---- FC3D - ADMM - matrix-free M, norm of q = %g ", norm_q);
   }
+  else
+  {
+    is_symmetric = NM_is_symmetric(M);
+    if(!is_symmetric)
+    {
+      double d= NM_symmetry_discrepancy(M);
+      numerics_warning("fc3d_admm","---- FC3D - ADMM - M is not symmetric (%e)\n",d);
+    }
 
-  numerics_printf_verbose(1,"---- FC3D - ADMM - Problem information");
-  numerics_printf_verbose(1,"---- FC3D - ADMM - 1-norm of M = %g norm of q = %g ", NM_norm_1(problem->M), norm_q);
-  numerics_printf_verbose(1,"---- FC3D - ADMM - inf-norm of M = %g ", NM_norm_inf(problem->M));
+    numerics_printf_verbose(1,"---- FC3D - ADMM - Problem information");
+    numerics_printf_verbose(1,"---- FC3D - ADMM - 1-norm of M = %g norm of q = %g ", NM_norm_1(problem->M), norm_q);
+    numerics_printf_verbose(1,"---- FC3D - ADMM - inf-norm of M = %g ", NM_norm_inf(problem->M));
+  }
 
   int internal_allocation=0;
   if(!(Fc3d_ADDM_data *)options->solverData)
@@ -168,7 +295,7 @@ void fc3d_admm(FrictionContactProblem* restrict problem, double* restrict reacti
   else if (options->iparam[SICONOS_FRICTION_3D_ADMM_IPARAM_RHO_STRATEGY] ==
            SICONOS_FRICTION_3D_ADMM_RHO_STRATEGY_NORM_INF)
   {
-    double norm_1_M =   NM_norm_1(problem->M);
+    double norm_1_M = cg ? fc3d_admm_operator_norm_1(cg, nc) : NM_norm_1(problem->M);
     double norm_1_H =   1.0;
     if ((fabs(norm_1_H) > DBL_EPSILON) &&  (fabs(norm_1_M) > DBL_EPSILON))
       rho = norm_1_M/norm_1_H;
@@ -178,7 +305,7 @@ void fc3d_admm(FrictionContactProblem* restrict problem, double* restrict reacti
   else if(options->iparam[SICONOS_FRICTION_3D_ADMM_IPARAM_RHO_STRATEGY] ==
           SICONOS_FRICTION_3D_ADMM_RHO_STRATEGY_RESIDUAL_BALANCING)
   {
-    double norm_1_M =   NM_norm_1(problem->M);
+    double norm_1_M = cg ? fc3d_admm_operator_norm_1(cg, nc) : NM_norm_1(problem->M);
     double norm_1_H =   1.0;
     if ((fabs(norm_1_H) > DBL_EPSILON) &&  (fabs(norm_1_M) > DBL_EPSILON))
       rho = norm_1_M/norm_1_H;
@@ -194,7 +321,9 @@ void fc3d_admm(FrictionContactProblem* restrict problem, double* restrict reacti
 
   /* Compute M + rho I (storage in W)*/
   NumericsMatrix *W = NM_new();
-
+  int symmetry = options->iparam[SICONOS_FRICTION_3D_ADMM_IPARAM_SYMMETRY];
+  int symmetric_W = (symmetry == SICONOS_FRICTION_3D_ADMM_ASSUME_SYMMETRY
+                     || (symmetry == SICONOS_FRICTION_3D_ADMM_CHECK_SYMMETRY && is_symmetric));
 
   /* if (M->storageType == NM_SPARSE_BLOCK) */
   /* { */
@@ -248,12 +377,16 @@ void fc3d_admm(FrictionContactProblem* restrict problem, double* restrict reacti
     ++iter;
     DEBUG_PRINTF("\n\n\n############### iteration:%i\n", iter);
 
-    if (has_rho_changed)
+    if (has_rho_changed && !cg)
     {
       /* NM_free(W); */
       /* W= NM_new(); */
       NM_copy(M,W);
       NM_add_to_diag3(W, rho);
+      /* W is symmetric positive definite if M is symmetric: Cholesky
+       * factorization, with the symbolic analysis kept by NM_copy for a
+       * sparse W */
+      NM_set_symmetric(W, symmetric_W);
     }
 
     /********************/
@@ -286,7 +419,10 @@ void fc3d_admm(FrictionContactProblem* restrict problem, double* restrict reacti
     DEBUG_EXPR(NV_display(reaction,m));
 
     /* Linear system solver */
-    NM_gesv_expert(W,reaction, NM_KEEP_FACTORS);
+    if(cg)
+      fc3d_admm_operator_solve(M, cg, nc, rho, 1e-2 * tolerance, reaction);
+    else
+      NM_gesv_expert(W,reaction, NM_KEEP_FACTORS);
     DEBUG_PRINT("reaction:");
     DEBUG_EXPR(NV_display(reaction,m));
 
@@ -488,6 +624,10 @@ void fc3d_admm(FrictionContactProblem* restrict problem, double* restrict reacti
 
 
   /***** Free memory *****/
+  NM_free(W);
+  free(W);
+  if(cg)
+    fc3d_admm_operator_data_free(cg);
   if(internal_allocation)
   {
     fc3d_admm_free(problem,options);
@@ -518,6 +658,7 @@ int fc3d_admm_setDefaultSolverOptions(SolverOptions* options)
 
   options->iparam[SICONOS_IPARAM_MAX_ITER] = 20000;
   options->iparam[SICONOS_FRICTION_3D_ADMM_IPARAM_ACCELERATION] = SICONOS_FRICTION_3D_ADMM_ACCELERATION_AND_RESTART;
+  options->iparam[SICONOS_FRICTION_3D_ADMM_IPARAM_SYMMETRY] = SICONOS_FRICTION_3D_ADMM_CHECK_SYMMETRY;
 
   options->dparam[SICONOS_DPARAM_TOL] = 1e-6;
 
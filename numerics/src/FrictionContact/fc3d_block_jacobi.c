@@ -0,0 +1,310 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#include "fc3d_Solvers.h"
+#include "fc3d_compute_error.h"
+#include "SiconosBlas.h"
+#include "SparseBlockMatrix.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <assert.h>
+#include <string.h>
+/* #define DEBUG_STDOUT */
+/* #define DEBUG_MESSAGES */
+#include "debug.h"
+#include "numerics_verbose.h"
+
+#ifdef HAVE_MPI
+#include <mpi.h>
+#endif
+
+/* A subdomain: its contacts (increasing global numbers) and the
+ * friction-contact problem restricted to these contacts. For a SBM storage,
+ * the blocks of the local matrix are the ones of the global matrix. */
+typedef struct
+{
+  unsigned int nc;
+  unsigned int *contacts;
+  FrictionContactProblem* problem;
+  double *reaction;
+  double *velocity;
+} fc3d_block_jacobi_domain;
+
+static void fc3d_block_jacobi_domain_init(FrictionContactProblem* problem,
+                                          fc3d_block_jacobi_domain* domain,
+                                          int* local_index)
+{
+  domain->problem = frictionContactProblem_new_subproblem(problem, domain->nc,
+                                                          domain->contacts, local_index);
+  domain->reaction = (double *) malloc(3 * domain->nc * sizeof(double));
+  domain->velocity = (double *) malloc(3 * domain->nc * sizeof(double));
+}
+
+static void fc3d_block_jacobi_domain_free(fc3d_block_jacobi_domain* domain)
+{
+  frictionContactProblem_free_subproblem(domain->problem);
+  free(domain->reaction);
+  free(domain->velocity);
+  free(domain->contacts);
+}
+
+/* q of the problem of a domain: q + the coupling with the reactions of the
+ * other domains */
+static void fc3d_block_jacobi_domain_q(FrictionContactProblem* problem,
+                                       fc3d_block_jacobi_domain* domain,
+                                       unsigned int d, unsigned int* part,
+                                       double* reaction, double* Mr)
+{
+  unsigned int nc = domain->nc;
+  double* q = domain->problem->q;
+  NumericsMatrix* M = problem->M;
+
+  for (unsigned int k = 0; k < nc; ++k)
+    memcpy(&q[3 * k], &problem->q[3 * domain->contacts[k]], 3 * sizeof(double));
+
+  if (M->storageType == NM_SPARSE_BLOCK)
+  {
+    SparseBlockStructuredMatrix* A = M->matrix1;
+    for (unsigned int k = 0; k < nc; ++k)
+    {
+      unsigned int row = domain->contacts[k];
+      for (size_t blockNum = A->index1_data[row]; blockNum < A->index1_data[row + 1]; ++blockNum)
+      {
+        size_t j = A->index2_data[blockNum];
+        if (part[j] != d)
+        {
+          /* 3x3 block in column-major order */
+          double* b = A->block[blockNum];
+          double* r = &reaction[3 * j];
+          q[3 * k]     += b[0] * r[0] + b[3] * r[1] + b[6] * r[2];
+          q[3 * k + 1] += b[1] * r[0] + b[4] * r[1] + b[7] * r[2];
+          q[3 * k + 2] += b[2] * r[0] + b[5] * r[1] + b[8] * r[2];
+        }
+      }
+    }
+  }
+  else
+  {
+    /* Mr = M reaction is computed once for all domains: remove the
+     * contribution of the domain */
+    for (unsigned int k = 0; k < nc; ++k)
+    {
+      memcpy(&domain->reaction[3 * k], &reaction[3 * domain->contacts[k]], 3 * sizeof(double));
+      for (unsigned int i = 0; i < 3; ++i)
+        q[3 * k + i] += Mr[3 * domain->contacts[k] + i];
+    }
+    NM_gemv(-1.0, domain->problem->M, domain->reaction, 1.0, q);
+  }
+}
+
+void fc3d_block_jacobi(FrictionContactProblem* problem, double *reaction,
+                       double *velocity, int* info, SolverOptions* options)
+{
+  int* iparam = options->iparam;
+  double* dparam = options->dparam;
+
+  unsigned int nc = problem->numberOfContacts;
+  int n = 3 * (int)nc;
+  int itermax = iparam[SICONOS_IPARAM_MAX_ITER];
+  double tolerance = dparam[SICONOS_DPARAM_TOL];
+  double norm_q = cblas_dnrm2(n , problem->q , 1);
+  double omega = dparam[SICONOS_FRICTION_3D_BLOCK_JACOBI_RELAXATION_VALUE];
+
+  int iter = 0;
+  double error = 1.;
+  int hasNotConverged = 1;
+
+  if (*info == 0)
+    return;
+
+  if (options->numberOfInternalSolvers < 1)
+  {
+    numerics_error("fc3d_block_jacobi",
+                   "The block Jacobi method needs options for the solver of the subdomains, "
+                   "options[0].numberOfInternalSolvers should be >= 1");
+  }
+  assert(options->internalSolvers);
+  SolverOptions* domain_options = options->internalSolvers;
+  if (domain_options->solverId != SICONOS_FRICTION_3D_NSGS)
+  {
+    numerics_error("fc3d_block_jacobi", "solver %s is not supported for the subdomains.",
+                   solver_options_id_to_name(domain_options->solverId));
+  }
+  if (problem->M->storageType != NM_SPARSE_BLOCK && problem->M->storageType != NM_DENSE)
+  {
+    numerics_error("fc3d_block_jacobi", "the matrix M must be stored as a dense matrix or a SBM.");
+  }
+  if (omega <= 0.0 || omega > 1.0)
+  {
+    numerics_error("fc3d_block_jacobi", "the relaxation value must be in ]0,1].");
+  }
+
+  /*****  Processes *****/
+  int rank = 0;
+  int nbprocs = 1;
+#ifdef HAVE_MPI
+  int mpi_initialized = 0;
+  MPI_Initialized(&mpi_initialized);
+  if (mpi_initialized)
+  {
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &nbprocs);
+  }
+#endif
+
+  /*****  Partition of the contacts *****/
+  unsigned int nbdomains = (unsigned int) iparam[SICONOS_FRICTION_3D_BLOCK_JACOBI_NUMBER_OF_DOMAINS];
+  if (nbdomains == 0)
+    nbdomains = (unsigned int) nbprocs;
+  unsigned int *part = (unsigned int *) malloc(nc * sizeof(unsigned int));
+  if (problem->M->storageType == NM_SPARSE_BLOCK)
+  {
+    nbdomains = SBM_row_blocks_partition(problem->M->matrix1, nbdomains, part);
+  }
+  else
+  {
+    /* no coupling information: slices of consecutive contacts */
+    if (nbdomains > nc)
+      nbdomains = nc;
+    for (unsigned int i = 0; i < nc; ++i)
+      part[i] = (unsigned int)(((size_t)i * nbdomains) / nc);
+  }
+  iparam[SICONOS_FRICTION_3D_BLOCK_JACOBI_NUMBER_OF_DOMAINS_DONE] = (int)nbdomains;
+  numerics_printf_verbose(1, "fc3d_block_jacobi: %u contacts, %u domains, %d processes",
+                          nc, nbdomains, nbprocs);
+
+  /*****  Subdomain problems of this process (domain d is solved by process d % nbprocs) *****/
+  fc3d_block_jacobi_domain* domains =
+    (fc3d_block_jacobi_domain *) calloc(nbdomains, sizeof(fc3d_block_jacobi_domain));
+  for (unsigned int i = 0; i < nc; ++i)
+    domains[part[i]].nc++;
+  int* local_index = (int *) malloc(nc * sizeof(int));
+  for (unsigned int i = 0; i < nc; ++i)
+    local_index[i] = -1;
+  for (unsigned int d = 0; d < nbdomains; ++d)
+  {
+    domains[d].contacts = (unsigned int *) malloc(domains[d].nc * sizeof(unsigned int));
+    domains[d].nc = 0;
+  }
+  for (unsigned int i = 0; i < nc; ++i)
+    domains[part[i]].contacts[domains[part[i]].nc++] = i;
+  for (unsigned int d = rank; d < nbdomains; d += nbprocs)
+    fc3d_block_jacobi_domain_init(problem, &domains[d], local_index);
+
+  double* reaction_new = (double *) malloc(n * sizeof(double));
+  double* Mr = NULL;
+  if (problem->M->storageType == NM_DENSE)
+    Mr = (double *) malloc(n * sizeof(double));
+
+  /*****  Block Jacobi iterations *****/
+  while ((iter < itermax) && (hasNotConverged > 0))
+  {
+    ++iter;
+
+    if (Mr)
+      NM_gemv(1.0, problem->M, reaction, 0.0, Mr);
+
+    /* every process sums the reactions of the contacts of its domains */
+    memset(reaction_new, 0, n * sizeof(double));
+    for (unsigned int d = rank; d < nbdomains; d += nbprocs)
+    {
+      fc3d_block_jacobi_domain* domain = &domains[d];
+      fc3d_block_jacobi_domain_q(problem, domain, d, part, reaction, Mr);
+      for (unsigned int k = 0; k < domain->nc; ++k)
+        memcpy(&domain->reaction[3 * k], &reaction[3 * domain->contacts[k]], 3 * sizeof(double));
+
+      int domain_info = fc3d_checkTrivialCase(domain->problem, domain->velocity,
+                                              domain->reaction, domain_options);
+      if (domain_info != 0)
+        fc3d_nsgs(domain->problem, domain->reaction, domain->velocity, &domain_info, domain_options);
+      DEBUG_PRINTF("fc3d_block_jacobi: domain %u, %u contacts, info = %i\n",
+                   d, domain->nc, domain_info);
+
+      for (unsigned int k = 0; k < domain->nc; ++k)
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+          unsigned int pos = 3 * domain->contacts[k] + i;
+          reaction_new[pos] = (1.0 - omega) * reaction[pos] + omega * domain->reaction[3 * k + i];
+        }
+    }
+#ifdef HAVE_MPI
+    if (nbprocs > 1)
+      MPI_Allreduce(MPI_IN_PLACE, reaction_new, n, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+#endif
+    cblas_dcopy(n, reaction_new, 1, reaction, 1);
+
+    fc3d_compute_error(problem, reaction, velocity, tolerance, options, norm_q, &error);
+    hasNotConverged = !(error < tolerance);
+    numerics_printf_verbose(1, "---- FC3D - BLOCK JACOBI - Iteration %i Residual = %14.7e <= %7.3e",
+                            iter, error, tolerance);
+
+    if (options->callback)
+    {
+      options->callback->collectStatsIteration(options->callback->env, n,
+                                               reaction, velocity,
+                                               error, NULL);
+    }
+  }
+
+  *info = hasNotConverged;
+  dparam[SICONOS_DPARAM_RESIDU] = error;
+  iparam[SICONOS_IPARAM_ITER_DONE] = iter;
+
+  /** Free memory **/
+  for (unsigned int d = 0; d < nbdomains; ++d)
+  {
+    if (domains[d].problem)
+      fc3d_block_jacobi_domain_free(&domains[d]);
+    else
+      free(domains[d].contacts);
+  }
+  free(domains);
+  free(local_index);
+  free(part);
+  free(reaction_new);
+  if (Mr)
+    free(Mr);
+}
+
+int fc3d_block_jacobi_setDefaultSolverOptions(SolverOptions* options)
+{
+  numerics_printf_verbose(1,"fc3d_block_jacobi_setDefaultSolverOptions\n");
+
+  options->solverId = SICONOS_FRICTION_3D_BLOCK_JACOBI;
+  options->numberOfInternalSolvers = 1;
+  options->isSet = 1;
+  options->filterOn = 1;
+  options->iSize = 20;
+  options->dSize = 20;
+  options->iparam = (int *)calloc(options->iSize, sizeof(int));
+  options->dparam = (double *)calloc(options->dSize, sizeof(double));
+  options->dWork = NULL;
+  solver_options_nullify(options);
+
+  options->iparam[SICONOS_IPARAM_MAX_ITER] = 1000;
+  options->iparam[SICONOS_FRICTION_3D_BLOCK_JACOBI_NUMBER_OF_DOMAINS] = 0;
+  options->dparam[SICONOS_DPARAM_TOL] = 1e-4;
+  options->dparam[SICONOS_FRICTION_3D_BLOCK_JACOBI_RELAXATION_VALUE] = 0.5;
+
+  options->internalSolvers = (SolverOptions *)malloc(sizeof(SolverOptions));
+  fc3d_nsgs_setDefaultSolverOptions(options->internalSolvers);
+  options->internalSolvers->iparam[SICONOS_IPARAM_MAX_ITER] = 100;
+  options->internalSolvers->dparam[SICONOS_DPARAM_TOL] = 1e-6;
+
+  return 0;
+}
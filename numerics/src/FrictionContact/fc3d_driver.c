@@ -28,6 +28,8 @@
 
 const char* const   SICONOS_FRICTION_3D_NSGS_STR = "FC3D_NSGS";
 const char* const   SICONOS_FRICTION_3D_NSGSV_STR = "FC3D_NSGSV";
+const char* const   SICONOS_FRICTION_3D_NSGS_OPENMP_STR = "FC3D_NSGS_OPENMP";
+const char* const   SICONOS_FRICTION_3D_BLOCK_JACOBI_STR = "FC3D_BLOCK_JACOBI";
 const char* const   SICONOS_FRICTION_3D_TFP_STR = "FC3D_TFP";
 const char* const   SICONOS_FRICTION_3D_PFP_STR = "FC3D_PFP";
 const char* const   SICONOS_FRICTION_3D_NSN_AC_STR = "FC3D_NSN_AC";
@@ -108,6 +110,18 @@ int fc3d_driver(FrictionContactProblem* problem,
     fc3d_nsgs(problem, reaction , velocity , &info , options);
     break;
   }
+  case SICONOS_FRICTION_3D_NSGS_OPENMP:
+  {
+    numerics_printf(" ========================== Call NSGS_OPENMP solver for Friction-Contact 3D problem ==========================\n");
+    fc3d_nsgs_openmp(problem, reaction , velocity , &info , options);
+    break;
+  }
+  case SICONOS_FRICTION_3D_BLOCK_JACOBI:
+  {
+    numerics_printf(" ========================== Call BLOCK_JACOBI solver for Friction-Contact 3D problem ==========================\n");
+    fc3d_block_jacobi(problem, reaction , velocity , &info , options);
+    break;
+  }
   case SICONOS_FRICTION_3D_NSGSV:
   {
     numerics_printf(" ========================== Call NSGSV solver for Friction-Contact 3D problem ==========================\n");
@@ -109,6 +109,63 @@ void nonsmoothEqnAlartCurnierFun(void* arg,
 
 
 
+void nonsmoothEqnAlartCurnierFunBatch(void* arg,
+                                      unsigned int problemSize,
+                                      double* reaction,
+                                      double* velocity,
+                                      double* mu,
+                                      double* rho,
+                                      double* result,
+                                      double* A,
+                                      double* B)
+{
+  AlartCurnierBatchParams* acparams_p = (AlartCurnierBatchParams *) arg;
+  unsigned int nc = problemSize / 3;
+  assert(problemSize % 3 == 0);
+  assert(nc <= acparams_p->nc);
+
+  /* gather the contacts data in structure-of-arrays layout */
+  double* R = acparams_p->work;
+  double* U = R + 3 * nc;
+  double* Rho = U + 3 * nc;
+  double* F = Rho + 2 * nc;
+  double* Aw = F + 3 * nc;
+  double* Bw = Aw + 9 * nc;
+  int withAB = A && B;
+
+  for (unsigned int i = 0; i < nc; ++i)
+  {
+    for (unsigned int k = 0; k < 3; ++k)
+    {
+      R[k * nc + i] = reaction[3 * i + k];
+      U[k * nc + i] = velocity[3 * i + k];
+    }
+    Rho[i] = rho[3 * i];
+    Rho[nc + i] = rho[3 * i + 1];
+  }
+
+  fc3d_AlartCurnierSTD_batch(nc, R, U, mu, Rho, F,
+                             withAB ? Aw : NULL, withAB ? Bw : NULL);
+
+  /* and scatter the results back to the block layout */
+  for (unsigned int i = 0; i < nc; ++i)
+  {
+    if (result)
+    {
+      for (unsigned int k = 0; k < 3; ++k)
+        result[3 * i + k] = F[k * nc + i];
+    }
+    if (withAB)
+    {
+      for (unsigned int k = 0; k < 9; ++k)
+      {
+        A[9 * i + k] = Aw[k * nc + i];
+        B[9 * i + k] = Bw[k * nc + i];
+      }
+    }
+  }
+}
+
 void fc3d_nonsmooth_Newton_AlartCurnier(
   FrictionContactProblem* problem,
   double *reaction,
@@ -166,6 +223,20 @@ void fc3d_nonsmooth_Newton_AlartCurnier(
   equation.data = (void *) &acparams;
   equation.function = &nonsmoothEqnAlartCurnierFun;
 
+  AlartCurnierBatchParams acbatchparams;
+  acbatchparams.nc = 0;
+  acbatchparams.work = NULL;
+
+  if (options->iparam[SICONOS_FRICTION_3D_NSN_FORMULATION] ==
+      SICONOS_FRICTION_3D_NSN_FORMULATION_ALARTCURNIER_STD_BATCH)
+  {
+    /* reaction, velocity, F: 3, rho: 2, A, B: 9 doubles per contact */
+    acbatchparams.nc = problem->numberOfContacts;
+    acbatchparams.work = (double *) malloc(29 * acbatchparams.nc * sizeof(double));
+    equation.data = (void *) &acbatchparams;
+    equation.function = &nonsmoothEqnAlartCurnierFunBatch;
+  }
+
   if(options->iparam[SICONOS_FRICTION_3D_NSN_HYBRID_STRATEGY] ==  SICONOS_FRICTION_3D_NSN_HYBRID_STRATEGY_VI_EG_NSN)
   {
     SolverOptions * options_vi_eg =(SolverOptions *)malloc(sizeof(SolverOptions));
@@ -188,6 +259,8 @@ void fc3d_nonsmooth_Newton_AlartCurnier(
     numerics_error("fc3d_nonsmooth_Newton_AlartCurnier","Unknown nsn hybrid solver");
   }
 
+  free(acbatchparams.work);
+
 
 
   
@@ -76,6 +76,29 @@ extern "C"
                                    double* A,
                                    double* B);
 
+  /** Workspace of the batched Alart & Curnier function: the data of all
+   * the contacts is gathered there in structure-of-arrays layout.
+   */
+  typedef struct
+  {
+    unsigned int nc;
+    double* work;
+  } AlartCurnierBatchParams;
+
+  /** The Alart & Curnier function (STD formulation) for all the contacts,
+   * evaluated with fc3d_AlartCurnierSTD_batch. Same arguments as
+   * nonsmoothEqnAlartCurnierFun, arg being an AlartCurnierBatchParams.
+   */
+  void nonsmoothEqnAlartCurnierFunBatch(void* arg,
+                                        unsigned int problemSize,
+                                        double* reaction,
+                                        double* velocity,
+                                        double* mu,
+                                        double* rho,
+                                        double* result,
+                                        double* A,
+                                        double* B);
+
   /** Nonsmooth Newton solver based on the Alart--Curnier function for the
    * local (reduced) frictional contact problem in the dense form
    * \param problem the problem to solve in dense form
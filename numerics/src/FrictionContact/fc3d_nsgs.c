@@ -24,6 +24,7 @@
 #include "fc3d_local_problem_tools.h"
 #include "NCP_Solvers.h"
 #include "SiconosBlas.h"
+#include "SparseBlockMatrix.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
@@ -36,11 +37,13 @@
 #include "debug.h"
 #include "numerics_verbose.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 //#define FCLIB_OUTPUT
 
 #ifdef FCLIB_OUTPUT
-static int fccounter = -1;
 #include "fclib_interface.h"
 #endif
 
@@ -362,7 +365,6 @@ void acceptLocalReactionFiltered(FrictionContactProblem *localproblem,
 
     /* printf("step counter value = %i\n", localsolver_options->iparam[19]); */
     char fname[256];
-    fccounter ++;
     sprintf(fname, "./local_problem/localproblem_%i_%i.hdf5", contact, localsolver_options->iparam[19]);
 
     if (file_exists(fname))
@@ -825,3 +827,251 @@ int fc3d_nsgs_setDefaultSolverOptions(SolverOptions* options)
 
   return 0;
 }
+
+/* Sort the contacts by color. On return, the contacts of color c are
+ * contacts_by_color[color_start[c]] ... contacts_by_color[color_start[c+1]-1].
+ * Contacts are coupled if they share a non null block in M, that is if they
+ * share a body. Without block information (M not stored as a SBM), each
+ * contact gets its own color and the sweep is serial. */
+static
+unsigned int fc3d_nsgs_openmp_coloring(FrictionContactProblem *problem,
+                                       unsigned int *color_start,
+                                       unsigned int *contacts_by_color)
+{
+  unsigned int nc = problem->numberOfContacts;
+  unsigned int *color = (unsigned int *) malloc(nc * sizeof(unsigned int));
+  unsigned int nbcolors;
+
+  if (problem->M->storageType == NM_SPARSE_BLOCK)
+  {
+    nbcolors = SBM_row_blocks_coloring(problem->M->matrix1, color);
+  }
+  else
+  {
+    numerics_warning("fc3d_nsgs_openmp",
+                     "the contact graph can only be colored for a SBM storage, the sweep is serial.");
+    for (unsigned int i = 0; i < nc; ++i)
+      color[i] = i;
+    nbcolors = nc;
+  }
+
+  for (unsigned int c = 0; c <= nbcolors; ++c)
+    color_start[c] = 0;
+  for (unsigned int i = 0; i < nc; ++i)
+    color_start[color[i] + 1]++;
+  for (unsigned int c = 0; c < nbcolors; ++c)
+    color_start[c + 1] += color_start[c];
+
+  unsigned int *pos = (unsigned int *) malloc(nbcolors * sizeof(unsigned int));
+  memcpy(pos, color_start, nbcolors * sizeof(unsigned int));
+  for (unsigned int i = 0; i < nc; ++i)
+    contacts_by_color[pos[color[i]]++] = i;
+
+  free(pos);
+  free(color);
+  return nbcolors;
+}
+
+void fc3d_nsgs_openmp(FrictionContactProblem* problem, double *reaction,
+                      double *velocity, int* info, SolverOptions* options)
+{
+  int* iparam = options->iparam;
+  double* dparam = options->dparam;
+
+  unsigned int nc = problem->numberOfContacts;
+  int itermax = iparam[SICONOS_IPARAM_MAX_ITER];
+  double tolerance = dparam[SICONOS_DPARAM_TOL];
+  double norm_q = cblas_dnrm2(nc*3 , problem->q , 1);
+  double omega = dparam[SICONOS_FRICTION_3D_NSGS_RELAXATION_VALUE];
+
+  SolverOptions * localsolver_options = options->internalSolvers;
+  SolverPtr local_solver = NULL;
+  UpdatePtr update_localproblem = NULL;
+  FreeSolverNSGSPtr freeSolver = NULL;
+  ComputeErrorPtr computeError = NULL;
+
+  int iter = 0;
+  double error = 1.;
+  int hasNotConverged = 1;
+
+  if (*info == 0)
+    return;
+
+  if (options->numberOfInternalSolvers < 1)
+  {
+    numerics_error("fc3d_nsgs_openmp",
+                   "The NSGS method needs options for the internal solvers, "
+                   "options[0].numberOfInternalSolvers should be >= 1");
+  }
+  assert(options->internalSolvers);
+
+  /*****  Check solver options *****/
+  if (iparam[SICONOS_FRICTION_3D_NSGS_SHUFFLE] != SICONOS_FRICTION_3D_NSGS_SHUFFLE_FALSE)
+  {
+    numerics_error("fc3d_nsgs_openmp", "iparam[SICONOS_FRICTION_3D_NSGS_SHUFFLE] must be equal to "
+                   "SICONOS_FRICTION_3D_NSGS_SHUFFLE_FALSE (0), contacts are ordered by color");
+    return;
+  }
+  if (! (iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION] == SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_FULL
+         || iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION] == SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_LIGHT_WITH_FULL_FINAL
+         || iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION] == SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_LIGHT
+         || iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION] == SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_ADAPTIVE))
+  {
+    numerics_error("fc3d_nsgs_openmp", "iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION] must be equal to "
+                   "SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_FULL (0), "
+                   "SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_LIGHT_WITH_FULL_FINAL (1), "
+                   "SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_LIGHT (2) or "
+                   "SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_ADAPTIVE (3)");
+    return;
+  }
+
+  /* Only local solvers without static state modified during the solve
+   * can be called concurrently */
+  switch (localsolver_options->solverId)
+  {
+  case SICONOS_FRICTION_3D_ONECONTACT_NSN:
+  case SICONOS_FRICTION_3D_ONECONTACT_NSN_GP:
+  case SICONOS_FRICTION_3D_ONECONTACT_NSN_GP_HYBRID:
+  case SICONOS_FRICTION_3D_ONECONTACT_ProjectionOnCone:
+  case SICONOS_FRICTION_3D_ONECONTACT_ProjectionOnConeWithLocalIteration:
+  case SICONOS_FRICTION_3D_ONECONTACT_ProjectionOnConeWithDiagonalization:
+    break;
+  default:
+    numerics_error("fc3d_nsgs_openmp", "local solver %s is not supported in the multithreaded NSGS.",
+                   solver_options_id_to_name(localsolver_options->solverId));
+  }
+
+  /*****  Coloring of the contact graph *****/
+  unsigned int *color_start = (unsigned int *) malloc((nc + 1) * sizeof(unsigned int));
+  unsigned int *contacts_by_color = (unsigned int *) malloc(nc * sizeof(unsigned int));
+  unsigned int nbcolors = fc3d_nsgs_openmp_coloring(problem, color_start, contacts_by_color);
+  iparam[SICONOS_FRICTION_3D_NSGS_OPENMP_NUMBER_OF_COLORS] = (int)nbcolors;
+  numerics_printf_verbose(1, "fc3d_nsgs_openmp: %u contacts, %u colors", nc, nbcolors);
+
+  /*****  Initialize the local solver (shared data, e.g. rho per contact) *****/
+  FrictionContactProblem* localproblem = fc3d_local_problem_allocate(problem);
+  fc3d_nsgs_initialize_local_solver(&local_solver, &update_localproblem,
+                                    (FreeSolverNSGSPtr *)&freeSolver, &computeError,
+                                    problem, localproblem, options);
+
+  /*****  One local problem and one copy of iparam/dparam per thread *****/
+  int nthreads = 1;
+#ifdef _OPENMP
+  if (iparam[SICONOS_FRICTION_3D_NSGS_OPENMP_NUMBER_OF_THREADS] > 0)
+    nthreads = iparam[SICONOS_FRICTION_3D_NSGS_OPENMP_NUMBER_OF_THREADS];
+  else
+    nthreads = omp_get_max_threads();
+#endif
+  FrictionContactProblem** thread_localproblem =
+    (FrictionContactProblem**) malloc(nthreads * sizeof(FrictionContactProblem*));
+  SolverOptions* thread_options = (SolverOptions*) malloc(nthreads * sizeof(SolverOptions));
+  for (int t = 0; t < nthreads; ++t)
+  {
+    thread_localproblem[t] = fc3d_local_problem_allocate(problem);
+    /* dWork is shared: the local solvers only access the entries of their
+     * current contact */
+    thread_options[t] = *localsolver_options;
+    thread_options[t].iparam = (int *) malloc(localsolver_options->iSize * sizeof(int));
+    thread_options[t].dparam = (double *) malloc(localsolver_options->dSize * sizeof(double));
+  }
+
+  /*****  NSGS Iterations *****/
+  while ((iter < itermax) && (hasNotConverged > 0))
+  {
+    ++iter;
+    double light_error_sum = 0.0;
+    fc3d_set_internalsolver_tolerance(problem, options, &localsolver_options[0], error);
+    for (int t = 0; t < nthreads; ++t)
+    {
+      memcpy(thread_options[t].iparam, localsolver_options->iparam, localsolver_options->iSize * sizeof(int));
+      memcpy(thread_options[t].dparam, localsolver_options->dparam, localsolver_options->dSize * sizeof(double));
+    }
+
+    for (unsigned int c = 0; c < nbcolors; ++c)
+    {
+      int start = (int)color_start[c];
+      int end = (int)color_start[c + 1];
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic, 16) reduction(+:light_error_sum)
+      for (int k = start; k < end; ++k)
+      {
+        int tid = 0;
+#ifdef _OPENMP
+        tid = omp_get_thread_num();
+#endif
+        unsigned int contact = contacts_by_color[k];
+        double localreaction[3];
+        solveLocalReaction(update_localproblem, local_solver, contact,
+                           problem, thread_localproblem[tid], reaction, &thread_options[tid],
+                           localreaction);
+
+        if (iparam[SICONOS_FRICTION_3D_NSGS_RELAXATION] == SICONOS_FRICTION_3D_NSGS_RELAXATION_TRUE)
+          performRelaxation(localreaction, &reaction[contact*3], omega);
+
+        accumulateLightErrorSum(&light_error_sum, localreaction, &reaction[contact*3]);
+
+        if (iparam[SICONOS_FRICTION_3D_NSGS_FILTER_LOCAL_SOLUTION] == SICONOS_FRICTION_3D_NSGS_FILTER_LOCAL_SOLUTION_TRUE)
+          acceptLocalReactionFiltered(thread_localproblem[tid], &thread_options[tid],
+                                      contact, iter, reaction, localreaction);
+        else
+          acceptLocalReactionUnconditionally(contact, reaction, localreaction);
+      }
+    }
+
+    if (iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION] == SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_LIGHT)
+    {
+      error = calculateLightError(light_error_sum, nc, reaction);
+      hasNotConverged = determine_convergence(error, tolerance, iter, options);
+    }
+    else if (iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION] == SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_LIGHT_WITH_FULL_FINAL)
+    {
+      error = calculateLightError(light_error_sum, nc, reaction);
+      hasNotConverged = determine_convergence_with_full_final(problem,  options, computeError,
+                                                              reaction, velocity,
+                                                              &tolerance, norm_q, error,
+                                                              iter);
+    }
+    else
+    {
+      error = calculateFullErrorAdaptiveInterval(problem, computeError, options,
+                                                 iter, reaction, velocity,
+                                                 tolerance, norm_q);
+      hasNotConverged = determine_convergence(error, tolerance, iter, options);
+    }
+
+    statsIterationCallback(problem, options, reaction, velocity, error);
+  }
+
+  if (iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION] == SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_LIGHT_WITH_FULL_FINAL)
+  {
+    error = calculateFullErrorFinal(problem, options, computeError, reaction, velocity,
+                                    tolerance, norm_q);
+    hasNotConverged = determine_convergence(error,  dparam[SICONOS_DPARAM_TOL] , iter, options);
+  }
+
+  *info = hasNotConverged;
+  dparam[SICONOS_DPARAM_RESIDU] = error;
+  iparam[SICONOS_IPARAM_ITER_DONE] = iter;
+
+  /** Free memory **/
+  for (int t = 0; t < nthreads; ++t)
+  {
+    free(thread_options[t].iparam);
+    free(thread_options[t].dparam);
+    fc3d_local_problem_free(thread_localproblem[t], problem);
+  }
+  free(thread_options);
+  free(thread_localproblem);
+  (*freeSolver)(problem, localproblem, localsolver_options);
+  fc3d_local_problem_free(localproblem, problem);
+  free(color_start);
+  free(contacts_by_color);
+}
+
+int fc3d_nsgs_openmp_setDefaultSolverOptions(SolverOptions* options)
+{
+  numerics_printf_verbose(1,"fc3d_nsgs_openmp_setDefaultSolverOptions\n");
+  fc3d_nsgs_setDefaultSolverOptions(options);
+  options->solverId = SICONOS_FRICTION_3D_NSGS_OPENMP;
+  options->iparam[SICONOS_FRICTION_3D_NSGS_OPENMP_NUMBER_OF_THREADS] = 0;
+  return 0;
+}
@@ -38,53 +38,37 @@
 #include <string.h>
 #include <float.h>
 
-static computeNonsmoothFunction  Function = NULL;
-static NewtonFunctionPtr F = NULL;
-static NewtonFunctionPtr jacobianF = NULL;
-static UpdateSolverPtr updateSolver = NULL;
-static PostSolverPtr postSolver = NULL;
-static FreeSolverNSGSPtr freeSolver = NULL;
-
-/* size of a block */
-static int Fsize;
+/* The solvers keep no static state: the function of the formulation is
+ * chosen from the options at each call, so that local problems may be
+ * solved concurrently. */
+
+/* size of a block of the Glocker formulation */
+#define GLOCKER_FSIZE 5
+
+/* the nonsmooth function of the formulation chosen in the options */
+static computeNonsmoothFunction fc3d_AC_function(SolverOptions * options)
+{
+  switch (options->iparam[SICONOS_FRICTION_3D_NSN_FORMULATION])
+  {
+  case SICONOS_FRICTION_3D_NSN_FORMULATION_ALARTCURNIER_STD:
+    return &computeAlartCurnierSTD;
+  case SICONOS_FRICTION_3D_NSN_FORMULATION_JEANMOREAU_STD:
+    return &computeAlartCurnierJeanMoreau;
+  case SICONOS_FRICTION_3D_NSN_FORMULATION_ALARTCURNIER_GENERATED:
+    return &fc3d_AlartCurnierFunctionGenerated;
+  case SICONOS_FRICTION_3D_NSN_FORMULATION_JEANMOREAU_GENERATED:
+    return &fc3d_AlartCurnierJeanMoreauFunctionGenerated;
+  default:
+    return NULL;
+  }
+}
 static void fc3d_AC_initialize(FrictionContactProblem* problem,
                                FrictionContactProblem* localproblem,
                                SolverOptions * options)
 {
-  /** In initialize, these operators are "connected" to their corresponding static variables,
-   * that will be used to build local problem for each considered contact.
-   * Local problem is built during call to update (which depends on the storage type for M).
-   */
-
   DEBUG_PRINTF("fc3d_AC_initialize starts with options->iparam[10] = %i\n",
                options->iparam[SICONOS_FRICTION_3D_NSN_FORMULATION]);
 
-  if (options->iparam[SICONOS_FRICTION_3D_NSN_FORMULATION] ==
-      SICONOS_FRICTION_3D_NSN_FORMULATION_ALARTCURNIER_STD )
-  {
-    Function = &(computeAlartCurnierSTD);
-  }
-  else if (options->iparam[SICONOS_FRICTION_3D_NSN_FORMULATION] ==
-           SICONOS_FRICTION_3D_NSN_FORMULATION_JEANMOREAU_STD )
-  {
-    Function = &(computeAlartCurnierJeanMoreau);
-  }
-  else if (options->iparam[SICONOS_FRICTION_3D_NSN_FORMULATION] ==
-           SICONOS_FRICTION_3D_NSN_FORMULATION_ALARTCURNIER_GENERATED )
-  {
-    Function = &(fc3d_AlartCurnierFunctionGenerated);
-  }
-  else if (options->iparam[SICONOS_FRICTION_3D_NSN_FORMULATION] ==
-           SICONOS_FRICTION_3D_NSN_FORMULATION_JEANMOREAU_GENERATED )
-  {
-    Function = &fc3d_AlartCurnierJeanMoreauFunctionGenerated;;
-  }
-  else if (options->iparam[SICONOS_FRICTION_3D_NSN_FORMULATION] ==
-           SICONOS_FRICTION_3D_NSN_FORMULATION_NULL)
-  {
-    Function = NULL;
-  }
-
   /* Compute and store default value of rho value */
   int nc = problem->numberOfContacts;
 
@@ -194,11 +178,6 @@ static void fc3d_AC_free(FrictionContactProblem * problem, FrictionContactProble
 }
 
 
-static void fc3d_AC_post(int contact, double* reaction)
-{
-  /* This function is required in the interface but useless in Alart-Curnier case */
-}
-
 void fc3d_onecontact_nonsmooth_Newton_solvers_initialize(FrictionContactProblem* problem,
                                                          FrictionContactProblem* localproblem,
                                                          SolverOptions * localsolver_options)
@@ -207,37 +186,17 @@ void fc3d_onecontact_nonsmooth_Newton_solvers_initialize(FrictionContactProblem*
   /* Initialize solver (Connect F and its jacobian, set local size ...) according to the chosen formulation. */
 
   /* Alart-Curnier formulation */
-  if (localsolver_options->solverId == SICONOS_FRICTION_3D_ONECONTACT_NSN)
+  if (localsolver_options->solverId == SICONOS_FRICTION_3D_ONECONTACT_NSN ||
+      localsolver_options->solverId == SICONOS_FRICTION_3D_ONECONTACT_NSN_GP ||
+      localsolver_options->solverId == SICONOS_FRICTION_3D_ONECONTACT_NSN_GP_HYBRID)
   {
     fc3d_AC_initialize(problem, localproblem,localsolver_options);
-    postSolver = &fc3d_AC_post;
-    freeSolver = &fc3d_AC_free;
-  }
-  else if (localsolver_options->solverId == SICONOS_FRICTION_3D_ONECONTACT_NSN_GP)
-  {
-    fc3d_AC_initialize(problem, localproblem,localsolver_options);
-    postSolver = &fc3d_AC_post;
-    freeSolver = &fc3d_AC_free;
-
-  }
-  else if (localsolver_options->solverId == SICONOS_FRICTION_3D_ONECONTACT_NSN_GP_HYBRID)
-  {
-
-    fc3d_AC_initialize(problem, localproblem,localsolver_options);
-    postSolver = &fc3d_AC_post;
-    freeSolver = &fc3d_AC_free;
   }
   /* Glocker formulation - Fischer-Burmeister function used in Newton */
   else if (localsolver_options->solverId == SICONOS_FRICTION_3D_NCPGlockerFBNewton)
   {
-    Fsize = 5;
     NCPGlocker_initialize(problem, localproblem);
-    F = &F_GlockerFischerBurmeister;
-    jacobianF = &jacobianF_GlockerFischerBurmeister;
-    /*     updateSolver = &NCPGlocker_update; */
-    postSolver = &NCPGlocker_post;
-    freeSolver = (FreeSolverNSGSPtr)&NCPGlocker_free;
- }
+  }
   else
   {
     fprintf(stderr, "Numerics, fc3d_onecontact_nonsmooth_Newton_solvers failed. Unknown formulation type.\n");
@@ -291,7 +250,9 @@ int fc3d_onecontact_nonsmooth_Newton_solvers_solve(FrictionContactProblem* local
   }
   else
   {
-    info = nonSmoothDirectNewton(Fsize, local_reaction, &F, &jacobianF,  options->iparam,  options->dparam);
+    NewtonFunctionPtr F = &F_GlockerFischerBurmeister;
+    NewtonFunctionPtr jacobianF = &jacobianF_GlockerFischerBurmeister;
+    info = nonSmoothDirectNewton(GLOCKER_FSIZE, local_reaction, &F, &jacobianF,  options->iparam,  options->dparam);
   }
   if (info > 0)
   {
@@ -318,11 +279,10 @@ int fc3d_onecontact_nonsmooth_Newton_solvers_solve(FrictionContactProblem* local
 
 void fc3d_onecontact_nonsmooth_Newton_solvers_free(FrictionContactProblem * problem, FrictionContactProblem * localproblem, SolverOptions* localsolver_options)
 {
-  F = NULL;
-  jacobianF = NULL;
-  updateSolver = NULL;
-  postSolver = NULL;
-  (*freeSolver)(problem, localproblem, localsolver_options);
+  if (localsolver_options->solverId == SICONOS_FRICTION_3D_NCPGlockerFBNewton)
+    NCPGlocker_free();
+  else
+    fc3d_AC_free(problem, localproblem, localsolver_options);
 }
 
 
@@ -429,6 +389,7 @@ int fc3d_onecontact_nonsmooth_Newton_solvers_solve_direct(FrictionContactProblem
 
   int * iparam = options->iparam;
   double * dparam = options->dparam;
+  computeNonsmoothFunction Function = fc3d_AC_function(options);
 
   if (verbose > 1)
     printf("---------------    fc3d_onecontact_nonsmooth_Newton_solvers_solve_direct  -- start iteration for contact %i \n", iparam[SICONOS_FRICTION_3D_NSGS_LOCALSOLVER_CONTACTNUMBER]);
@@ -727,6 +688,7 @@ int fc3d_onecontact_nonsmooth_Newton_solvers_solve_damped(FrictionContactProblem
 
   int * iparam = options->iparam;
   double * dparam = options->dparam;
+  computeNonsmoothFunction Function = fc3d_AC_function(options);
 
   if (verbose > 1)
     printf("---------------    fc3d_onecontact_nonsmooth_Newton_solvers_solve_damped  -- start iteration for contact %i \n", iparam[SICONOS_FRICTION_3D_NSGS_LOCALSOLVER_CONTACTNUMBER]);
@@ -969,3 +969,14 @@ int fc3d_projectionOnCylinderWithLocalIteration_setDefaultSolverOptions(SolverOp
 
   return 0;
 }
+
+void fc3d_projectionOnCones(void* problem, double* reaction, double* projected_reaction)
+{
+  FrictionContactProblem* fc3d = (FrictionContactProblem*) problem;
+  int nc = fc3d->numberOfContacts;
+  cblas_dcopy(nc * 3, reaction, 1, projected_reaction, 1);
+  for (int contact = 0; contact < nc; ++contact)
+  {
+    projectionOnCone(&projected_reaction[contact * 3], fc3d->mu[contact]);
+  }
+}
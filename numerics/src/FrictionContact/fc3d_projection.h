@@ -171,6 +171,15 @@ extern "C"
   void fc3d_projection_with_regularization_free(FrictionContactProblem * problem, FrictionContactProblem * localproblem, SolverOptions* localsolver_options);
 
   int fc3d_projectionOnConeWithRegularization_setDefaultSolverOptions(SolverOptions* options);
+
+  /** projection of all the reactions on their friction cones, with the
+   * signature of the projections of the fixed-point accelerations
+   * \param problem the FrictionContactProblem
+   * \param reaction the reactions to project
+   * \param[out] projected_reaction the projected reactions
+   */
+  void fc3d_projectionOnCones(void* problem, double* reaction, double* projected_reaction);
+
 #if defined(__cplusplus) && !defined(BUILD_AS_CPP)
 }
 #endif
@@ -136,7 +136,8 @@ void gfc3d_ADMM(GlobalFrictionContactProblem* restrict problem, double* restrict
 
   numerics_printf_verbose(1,"---- GFC3D - ADMM - 1-norm of H = %g norm of b = %g ", NM_norm_1(problem->H), norm_b);
   numerics_printf_verbose(1,"---- GFC3D - ADMM - inf-norm of H = %g ", NM_norm_inf(problem->H));
-  numerics_printf_verbose(1,"---- GFC3D - ADMM -  M is symmetric = %i ", NM_is_symmetric(problem->M));
+  int is_symmetric = NM_is_symmetric(problem->M);
+  numerics_printf_verbose(1,"---- GFC3D - ADMM -  M is symmetric = %i ", is_symmetric);
 
 
   int internal_allocation=0;
@@ -189,6 +190,10 @@ void gfc3d_ADMM(GlobalFrictionContactProblem* restrict problem, double* restrict
   NM_copy(M, W);
   Htrans = NM_transpose(H);
   NM_gemm(rho, H, Htrans, 1.0, W);
+  /* W is symmetric positive definite if M is symmetric: Cholesky factorization */
+  int symmetry = options->iparam[SICONOS_FRICTION_3D_ADMM_IPARAM_SYMMETRY];
+  NM_set_symmetric(W, symmetry == SICONOS_FRICTION_3D_ADMM_ASSUME_SYMMETRY
+                   || (symmetry == SICONOS_FRICTION_3D_ADMM_CHECK_SYMMETRY && is_symmetric));
 
   double eta = dparam[SICONOS_FRICTION_3D_ADMM_RESTART_ETA];
 
@@ -413,6 +418,7 @@ int gfc3d_ADMM_setDefaultSolverOptions(SolverOptions* options)
 
   options->iparam[SICONOS_IPARAM_MAX_ITER] = 20000;
   options->iparam[SICONOS_FRICTION_3D_ADMM_IPARAM_ACCELERATION] = SICONOS_FRICTION_3D_ADMM_ACCELERATION_AND_RESTART;
+  options->iparam[SICONOS_FRICTION_3D_ADMM_IPARAM_SYMMETRY] = SICONOS_FRICTION_3D_ADMM_CHECK_SYMMETRY;
 
   options->dparam[SICONOS_DPARAM_TOL] = 1e-6;
 
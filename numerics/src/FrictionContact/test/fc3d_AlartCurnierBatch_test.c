@@ -0,0 +1,171 @@
+#undef NDEBUG
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "op3x3.h"
+#include "fc3d_AlartCurnier_functions.h"
+
+/* Check fc3d_AlartCurnierSTD_batch against computeAlartCurnierSTD, on the
+   inputs of AlartCurnierFunctions_test and on random contacts covering the
+   sticking, sliding and take-off cases. */
+
+#define NRANDOM 4096
+
+static double uniform(double a, double b)
+{
+  return a + (b - a) * ((double) rand() / RAND_MAX);
+}
+
+static int check(unsigned int nc, double* reactions, double* velocities,
+                 double* mus, double* rhos)
+{
+  int info = 0;
+
+  double* R = (double *) malloc(3 * nc * sizeof(double));
+  double* U = (double *) malloc(3 * nc * sizeof(double));
+  double* Rho = (double *) malloc(2 * nc * sizeof(double));
+  double* F = (double *) malloc(3 * nc * sizeof(double));
+  double* A = (double *) malloc(9 * nc * sizeof(double));
+  double* B = (double *) malloc(9 * nc * sizeof(double));
+  double* Fonly = (double *) malloc(3 * nc * sizeof(double));
+
+  for (unsigned int i = 0; i < nc; ++i)
+  {
+    for (unsigned int k = 0; k < 3; ++k)
+    {
+      R[k * nc + i] = reactions[3 * i + k];
+      U[k * nc + i] = velocities[3 * i + k];
+    }
+    Rho[i] = rhos[3 * i];
+    Rho[nc + i] = rhos[3 * i + 1];
+  }
+
+  fc3d_AlartCurnierSTD_batch(nc, R, U, mus, Rho, F, A, B);
+  fc3d_AlartCurnierSTD_batch(nc, R, U, mus, Rho, Fonly, NULL, NULL);
+
+  double F1[3], A1[9], B1[9];
+  for (unsigned int i = 0; i < nc; ++i)
+  {
+    computeAlartCurnierSTD(&reactions[3 * i], &velocities[3 * i], mus[i],
+                           &rhos[3 * i], F1, A1, B1);
+
+#define EPS 1e-12
+    for (unsigned int k = 0; k < 3; ++k)
+    {
+      info |= !(fabs(F1[k] - F[k * nc + i]) <= EPS * (1. + fabs(F1[k])));
+      info |= !(fabs(F1[k] - Fonly[k * nc + i]) <= EPS * (1. + fabs(F1[k])));
+    }
+    for (unsigned int k = 0; k < 9; ++k)
+    {
+      info |= !(fabs(A1[k] - A[k * nc + i]) <= EPS * (1. + fabs(A1[k])));
+      info |= !(fabs(B1[k] - B[k * nc + i]) <= EPS * (1. + fabs(B1[k])));
+    }
+    if (info)
+    {
+      printf("contact %u: batched and scalar evaluations differ\n", i);
+      break;
+    }
+  }
+
+  free(R);
+  free(U);
+  free(Rho);
+  free(F);
+  free(A);
+  free(B);
+  free(Fonly);
+  return info;
+}
+
+int main()
+{
+  int info = 0;
+  int r = -1;
+
+  FILE* file = fopen("./data/ACinputs.dat", "r");
+  unsigned int dim = 0;
+  double* reactions;
+  double* velocities;
+  double *mus;
+  double *rhos;
+
+  r = fscanf(file, "%d\n", &dim);
+  assert(r > 0);
+  if (r <= 0) return(r);
+
+  reactions = (double *) malloc(3 * dim * sizeof(double));
+  velocities = (double *) malloc(3 * dim * sizeof(double));
+  mus = (double *) malloc(dim * sizeof(double));
+  rhos = (double *) malloc(3 * dim * sizeof(double));
+
+  for (unsigned int i = 0; i < dim * 3 ; ++i)
+  {
+    r = fscanf(file, "%lf\n", &reactions[i]);
+    assert(r > 0);
+  };
+
+  for (unsigned int i = 0; i < dim * 3 ; ++i)
+  {
+    r = fscanf(file, "%lf\n", &velocities[i]);
+    assert(r > 0);
+  };
+
+  for (unsigned int k = 0; k < dim ; ++k)
+  {
+    r = fscanf(file, "%lf\n", &mus[k]);
+    assert(r > 0);
+  };
+
+  for (unsigned int i = 0; i < dim * 3 ; ++i)
+  {
+    r = fscanf(file, "%lf\n", &rhos[i]);
+    assert(r > 0);
+  };
+  fclose(file);
+
+  info |= check(dim, reactions, velocities, mus, rhos);
+  printf("ACinputs.dat: %s\n", info ? "failed" : "ok");
+
+  free(reactions);
+  free(velocities);
+  free(mus);
+  free(rhos);
+
+  reactions = (double *) malloc(3 * NRANDOM * sizeof(double));
+  velocities = (double *) malloc(3 * NRANDOM * sizeof(double));
+  mus = (double *) malloc(NRANDOM * sizeof(double));
+  rhos = (double *) malloc(3 * NRANDOM * sizeof(double));
+
+  srand(1);
+  for (unsigned int i = 0; i < NRANDOM; ++i)
+  {
+    for (unsigned int k = 0; k < 3; ++k)
+    {
+      reactions[3 * i + k] = uniform(-1., 1.);
+      velocities[3 * i + k] = uniform(-1., 1.);
+    }
+    /* some contacts exactly at rest */
+    if (i % 7 == 0)
+    {
+      velocities[3 * i + 1] = 0.;
+      velocities[3 * i + 2] = 0.;
+      reactions[3 * i + 1] = 0.;
+      reactions[3 * i + 2] = 0.;
+    }
+    mus[i] = uniform(0., 1.);
+    rhos[3 * i] = uniform(0.1, 10.);
+    rhos[3 * i + 1] = rhos[3 * i + 2] = uniform(0.1, 10.);
+  }
+
+  info |= check(NRANDOM, reactions, velocities, mus, rhos);
+  printf("random contacts: %s\n", info ? "failed" : "ok");
+
+  free(reactions);
+  free(velocities);
+  free(mus);
+  free(rhos);
+
+  return info;
+}
@@ -0,0 +1,135 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/* The solvers of FrictionContactProblem working with the products of M
+ * only must give the same results with M as with a matrix-free operator
+ * (NM_OPERATOR) computing the same products. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+
+#include "NonSmoothDrivers.h"
+#include "SolverOptions.h"
+#include "FrictionContactProblem.h"
+#include "Friction_cst.h"
+#include "fc3d_Solvers.h"
+#include "NumericsMatrix.h"
+#include "numerics_verbose.h"
+
+#define GET_ITER(X) X.iparam[1] ? X.iparam[1] : X.iparam[7]
+
+static void operator_gemv(void* env, double alpha, const double* x, double beta, double* y)
+{
+  NM_gemv(alpha, (NumericsMatrix*) env, x, beta, y);
+}
+
+static void operator_diag_block(void* env, int start, int size, double* block)
+{
+  NM_extract_diag_block((NumericsMatrix*) env, start / size, start, size, &block);
+}
+
+static void operator_free(void* env)
+{
+  NM_free((NumericsMatrix*) env);
+  free(env);
+}
+
+static int solve(int solver_id, FrictionContactProblem* problem, int* iter)
+{
+  int n = problem->numberOfContacts * problem->dimension;
+  double *reaction = (double*)calloc(n, sizeof(double));
+  double *velocity = (double*)calloc(n, sizeof(double));
+  SolverOptions SO;
+  fc3d_setDefaultSolverOptions(&SO, solver_id);
+  SO.dparam[0] = 1e-8;
+  int info = fc3d_driver(problem, reaction, velocity, &SO);
+  *iter = GET_ITER(SO);
+  solver_options_delete(&SO);
+  free(reaction);
+  free(velocity);
+  return info;
+}
+
+static int test(int solver_id, char* filename)
+{
+  FILE *finput = fopen(filename, "r");
+  if (!finput)
+  {
+    int _errno = errno;
+    fprintf(stderr, "%s :: unable to open file %s\n", __func__, filename);
+    return _errno;
+  }
+  FrictionContactProblem* problem = (FrictionContactProblem*)malloc(sizeof(FrictionContactProblem));
+  frictionContact_newFromFile(problem, finput);
+  fclose(finput);
+
+  /* a dense M, whose diagonal blocks are copied by NM_extract_diag_block */
+  NumericsMatrix* M = NM_create(NM_DENSE, problem->M->size0, problem->M->size1);
+  NM_to_dense(problem->M, M);
+  NM_free(problem->M);
+  free(problem->M);
+  problem->M = M;
+
+  int iter, iter_operator;
+  int info = solve(solver_id, problem, &iter);
+
+  /* the same problem with a matrix-free M, owning the explicit matrix */
+  problem->M = NM_create_operator(M->size0, M->size1, M, &operator_gemv,
+                                  &operator_diag_block, &operator_free);
+  int info_operator = solve(solver_id, problem, &iter_operator);
+
+  freeFrictionContactProblem(problem);
+
+  printf("Solver %s on problem %s: info = %d with %d iterations, matrix-free: info = %d with %d iterations\n",
+         solver_options_id_to_name(solver_id), filename, info, iter, info_operator, iter_operator);
+
+  if (info_operator)
+    return 1;
+  /* the same products give the same iterates, the linear systems of ADMM
+   * are solved by a conjugate gradient */
+  if (solver_id != SICONOS_FRICTION_3D_ADMM && (info != info_operator || iter != iter_operator))
+    return 1;
+  return 0;
+}
+
+int main(void)
+{
+  int total_info = 0;
+
+  int solvers_to_test[] = {SICONOS_FRICTION_3D_FPP,
+                           SICONOS_FRICTION_3D_EG,
+                           SICONOS_FRICTION_3D_VI_FPP,
+                           SICONOS_FRICTION_3D_VI_EG,
+                           SICONOS_FRICTION_3D_ADMM};
+
+  char* filetests[] = {"data/FC3D_Example1_SBM.dat",
+                       "data/NESpheres_10_1.dat",
+                       "data/NESpheres_30_1.dat",
+                       "data/Rover4144.dat"};
+
+  for (size_t s = 0; s < sizeof(solvers_to_test)/sizeof(int); ++s)
+  {
+    for (size_t i = 0; i < sizeof(filetests)/sizeof(char*); ++i)
+    {
+      total_info += test(solvers_to_test[s], filetests[i]);
+    }
+  }
+
+  return total_info;
+}
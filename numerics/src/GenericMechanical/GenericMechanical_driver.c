@@ -213,10 +213,6 @@ int GenericMechanical_compute_error(GenericMechanicalProblem* pGMP, double *reac
   else
     return 0;
 }
-#ifdef GENERICMECHANICAL_DEBUG_CMP
-static int SScmp = 0;
-static int SScmpTotal = 0;
-#endif
 //#define GMP_WRITE_PRB
 //static double sCoefLS=1.0;
 void genericMechanicalProblem_GS(GenericMechanicalProblem* pGMP, double * reaction, double * velocity, int * info,
@@ -228,9 +224,6 @@ void genericMechanicalProblem_GS(GenericMechanicalProblem* pGMP, double * reacti
   fclose(toto1);
 #endif
 
-#ifdef GENERICMECHANICAL_DEBUG_CMP
-  SScmp++;
-#endif
   listNumericsProblem * curProblem = 0;
   int storageType = pGMP->M->storageType;
   NumericsMatrix* numMat = pGMP->M;
@@ -266,9 +259,6 @@ void genericMechanicalProblem_GS(GenericMechanicalProblem* pGMP, double * reacti
   pBuffVelocity = pPrevReaction + pGMP->size;
   while (it < iterMax && tolViolate)
   {
-#ifdef GENERICMECHANICAL_DEBUG_CMP
-    SScmpTotal++;
-#endif
     memcpy(pPrevReaction, reaction, pGMP->size * sizeof(double));
     currentRowNumber = 0;
     curProblem =  pGMP->firstListElem;
@@ -460,7 +450,7 @@ void genericMechanicalProblem_GS(GenericMechanicalProblem* pGMP, double * reacti
   {
     ;
 #ifdef GENERICMECHANICAL_DEBUG_CMP
-    printf("---GenericalMechanical_drivers, CV %d at it=%d, itTotal=%d.\n", SScmp, it, SScmpTotal);
+    printf("---GenericalMechanical_drivers, CV at it=%d.\n", it);
 #endif
   }
 
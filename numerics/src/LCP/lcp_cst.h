@@ -59,6 +59,22 @@ enum LCP_PIVOT
   SICONOS_LCP_PIVOT_PATHSEARCH = 4
 };
 
+enum SICONOS_LCP_ENUM_IPARAM
+{
+  /** index in iparam to store (in) the search of all the solutions (1) or of the first one (0) */
+  SICONOS_LCP_IPARAM_ENUM_MULTIPLE_SOLUTIONS = 0,
+  /** index in iparam to store (out) the key of the pattern of the solution */
+  SICONOS_LCP_IPARAM_ENUM_KEY = 1,
+  /** index in iparam to store (out) the number of solutions found */
+  SICONOS_LCP_IPARAM_ENUM_NUMBER_OF_SOLUTIONS = 2,
+  /** index in iparam to store (in) the key of the first pattern tried */
+  SICONOS_LCP_IPARAM_ENUM_SEED = 3,
+  /** index in iparam to store (in) the use of DGELS (1) or DGESV (0) */
+  SICONOS_LCP_IPARAM_ENUM_USE_DGELS = 4,
+  /** index in iparam to store (in) the number of threads enumerating the patterns (0 : OpenMP default) */
+  SICONOS_LCP_IPARAM_ENUM_NUMBER_OF_THREADS = 5
+};
+
 extern const char* const   SICONOS_LCP_LEMKE_STR;
 extern const char* const   SICONOS_LCP_NSGS_SBM_STR;
 extern const char* const   SICONOS_LCP_PGS_STR;
@@ -31,44 +31,26 @@
 #include "SiconosLapack.h"
 #include "lcp_enum.h"
 #include "numerics_verbose.h"
+#include "mlcp_enum_tool.h"
 
-static unsigned long  int sCurrentEnum = 0;
-static unsigned long  int sCmpEnum = 0;
-static unsigned long  int sNbCase = 0;
-static double sProgress = 0;
-static int* sWZ = 0;
-static double * sM = 0;
-static double * sMref = 0;
-static double * sQ = 0;
-static double * sQref = 0;
-static double * sColNul = 0;
-static int sSize = 0;
-static int LWORK = 0;
-
-
-static void affectWZ();
-static void lcp_buildM(int * zw, double * M, double * Mref, int size);
-static void lcp_fillSolution(double*  z, double * w, int size, int* zw, double * Q);
-static void lcp_initEnum();
-static int lcp_nextEnum();
-static void lcp_buildQ();
-
-/*case defined with sCurrentEnum
- *if sWZ[i]==0
- *  w[i] null
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* number of patterns given at once to a thread */
+#define LCP_ENUM_CHUNK 16
+
+/* The enumeration has no static state: the working memory of the first
+ * thread is options->dWork and options->iWork, the other threads
+ * allocate their own. */
+
+/* the matrix of the linear system of the pattern zw:
+ *if zw[i]==0
+ *  w[i] null, the column i is the one of Mref
  *else
- *  z[i] null
+ *  z[i] null, the column i is the one of -I
  */
-void affectWZ()
-{
-  unsigned long  int aux = sCurrentEnum;
-  for (int i = 0; i < sSize; i++)
-  {
-    sWZ[i] = aux & 1;
-    aux = aux >> 1;
-  }
-}
-void lcp_buildM(int * zw, double * M, double * Mref, int size)
+static void lcp_buildM(int * zw, double * M, double * Mref, int size)
 {
   int col;
   double * Aux;
@@ -83,16 +65,14 @@ void lcp_buildM(int * zw, double * M, double * Mref, int size)
     }
     else
     {
-      /*for(i=0;i<size;i++) Aux[i]=0;*/
-      memcpy(Aux, sColNul, sSize * sizeof(double));
+      memset(Aux, 0, size * sizeof(double));
       Aux[col] = -1;
-      /*M[(n+col)*npm+col+n]=-1;*/
     }
     Aux = Aux + size;
     AuxRef = AuxRef + size;
   }
 }
-void   lcp_fillSolution(double*  z, double * w, int size, int* zw, double * Q)
+static void lcp_fillSolution(double*  z, double * w, int size, int* zw, double * Q)
 {
   int lin;
 
@@ -110,58 +90,70 @@ void   lcp_fillSolution(double*  z, double * w, int size, int* zw, double * Q)
     }
   }
 }
-void lcp_initEnum()
-{
-  int cmp;
-  sCmpEnum = 0;
-  sNbCase = 1;
-  for (cmp = 0; cmp < sSize; cmp++)
-    sNbCase = sNbCase << 1;
-  sProgress = 0;
-}
-int lcp_nextEnum()
+
+/* solve the linear system of the pattern of key.
+ * M (size*size), Q (size), zw (size) and ipiv (size) are the working
+ * memory of the thread.
+ * return 1 if the solution Q is in the cone, 0 otherwise */
+static int lcp_enum_solve_pattern(unsigned long long int key, int size, double * Mref, double * Qref,
+                                  double * M, double * Q, int * zw, lapack_int * ipiv,
+                                  int useDGELS, double tol)
 {
-  if (sCmpEnum == sNbCase)
+  lapack_int LAinfo = 0;
+  if (verbose)
+    printf("try enum :%llu\n", key);
+  enum_pattern(key, size, zw);
+  lcp_buildM(zw, M, Mref, size);
+  memcpy(Q, Qref, size * sizeof(double));
+  if (useDGELS)
+  {
+    DGELS(LA_NOTRANS, size, size, 1, M, size, Q, size, &LAinfo);
+    if (verbose)
+    {
+      printf("Solution of dgels (info=%i)\n", LAinfo);
+      NM_dense_display(Q, size, 1, 0);
+    }
+  }
+  else
+  {
+    DGESV(size, 1, M, size, ipiv, Q, size, &LAinfo);
+  }
+  if (LAinfo)
     return 0;
-  if (sCurrentEnum >= sNbCase)
+
+  if (useDGELS)
   {
-    sCurrentEnum = 0;
+    for (int ii = 0; ii < size; ii++)
+    {
+      if (isnan(Q[ii]) || isinf(Q[ii]))
+      {
+        if (verbose)
+          printf("DGELS FAILED\n");
+        return 0;
+      }
+    }
   }
+
   if (verbose)
-    printf("try enum :%d\n", (int)sCurrentEnum);
-  affectWZ();
-  sCurrentEnum++;
-  sCmpEnum++;
-  if (verbose && sCmpEnum > (unsigned long int)sProgress * sNbCase)
   {
-    sProgress += 0.001;
-    printf("lcp_enum progress %f %d \n", sProgress, (int) sCurrentEnum);
+    printf("lcp_enum LU factorization succeeded:\n");
   }
 
+  for (int lin = 0 ; lin < size; lin++)
+  {
+    if (Q[lin] < - tol)
+      return 0; /*out of the cone!*/
+  }
   return 1;
 }
 
-void lcp_buildQ()
-{
-  memcpy(sQ, sQref, (sSize)*sizeof(double));
-}
 int lcp_enum_getNbIWork(LinearComplementarityProblem* problem, SolverOptions* options)
 {
   return 2 * (problem->size);
 }
 int lcp_enum_getNbDWork(LinearComplementarityProblem* problem, SolverOptions* options)
 {
-  int aux = 3 * (problem->size) + (problem->size) * (problem->size);
-  if (options->iparam[4])
-  {
-    LWORK = -1;
-    //int info = 0;
-    double dgelsSize = 0;
-    //DGELS(problem->M->size0, problem->size , 1, 0, problem->M->size0, 0, problem->M->size0, &dgelsSize, LWORK, &info);
-    aux += (int) dgelsSize;
-    LWORK = (int) dgelsSize;
-  }
-  return aux;
+  return 3 * (problem->size) + (problem->size) * (problem->size);
 }
 void lcp_enum_init(LinearComplementarityProblem* problem, SolverOptions* options, int withMemAlloc)
 {
@@ -186,132 +178,111 @@ void lcp_enum_reset(LinearComplementarityProblem* problem, SolverOptions* option
 void lcp_enum(LinearComplementarityProblem* problem, double *z, double *w, int *info , SolverOptions* options)
 {
   *info = 1;
-  double tol ;
   if (options->dWork == NULL)
   {
     lcp_enum_init(problem, options, 1);
   }
-  double * workingFloat = options->dWork;
-  int * workingInt = options->iWork;
-  int lin;
-  sSize = (problem->size);
-  int NRHS = 1;
-  lapack_int * ipiv;
-  int check;
-  lapack_int LAinfo = 0;
-  int useDGELS = options->iparam[4];
-
-  /*OUTPUT param*/
-  sCurrentEnum = options->iparam[3];
-  tol = options->dparam[0];
-  int multipleSolutions = options->iparam[0];
-  int numberofSolutions = 0;
-
-
-
-
-  sMref = problem->M->matrix0;
-  if (!sMref)
+  int size = problem->size;
+  int * iparam = options->iparam;
+  double tol = options->dparam[SICONOS_DPARAM_TOL];
+  int multipleSolutions = iparam[SICONOS_LCP_IPARAM_ENUM_MULTIPLE_SOLUTIONS];
+  int useDGELS = iparam[SICONOS_LCP_IPARAM_ENUM_USE_DGELS];
+
+  double * Mref = problem->M->matrix0;
+  if (!Mref)
   {
-    printf("lcp_enum failed, problem->M->matrix0 is null");
-
+    numerics_error("lcp_enum", "problem->M->matrix0 is null");
   }
 
   if (verbose)
-    printf("lcp_enum begin, size %d tol %e\n", sSize, tol);
-
-  sM = workingFloat;
-  sQ = sM + sSize * sSize;
-  sColNul = sQ + sSize;
-  sQref = sColNul + sSize;
-  for (lin = 0; lin < sSize; lin++)
+    printf("lcp_enum begin, size %d tol %e\n", size, tol);
+
+  /* all the solutions are searched in the order of the keys by one thread */
+  int nthreads = 1;
+  if (!multipleSolutions && options->iSize > SICONOS_LCP_IPARAM_ENUM_NUMBER_OF_THREADS)
+    nthreads = enum_number_of_threads(iparam[SICONOS_LCP_IPARAM_ENUM_NUMBER_OF_THREADS]);
+
+  /* working memory of the first thread: M, Q, (unused), Qref */
+  double * Qref = options->dWork + size * size + 2 * size;
+  for (int lin = 0; lin < size; lin++)
+    Qref[lin] =  - problem->q[lin];
+
+  /* the patterns are tried from the one of the seed key, and the solution
+   * is the first one found in this order, whatever the number of threads */
+  unsigned long long int nbCase = enum_nb_patterns(size);
+  unsigned long long int seed = (unsigned long long int) iparam[SICONOS_LCP_IPARAM_ENUM_SEED];
+  if (seed >= nbCase)
+    seed = 0;
+  long long int nbTries = (long long int) nbCase;
+  /* rank of the first solution found */
+  unsigned long long int found = nbCase;
+  int numberOfSolutions = 0;
+
+#pragma omp parallel num_threads(nthreads) if(nthreads > 1)
   {
-    sQref[lin] =  - problem->q[lin];
-    sColNul[lin] = 0;
-  }
-  sWZ = workingInt;
-  ipiv = sWZ + sSize;
-  *info = 0;
-  lcp_initEnum();
-  while (lcp_nextEnum())
-  {
-    lcp_buildM(sWZ, sM, sMref, sSize);
-    lcp_buildQ();
-    /*     if (verbose) */
-    /*       printCurrentSystem(); */
-    if (useDGELS)
+    int tid = 0;
+#ifdef _OPENMP
+    tid = omp_get_thread_num();
+#endif
+    double * M = options->dWork;
+    int * zw = options->iWork;
+    if (tid > 0)
     {
-      /* if (verbose) */
-      /*   { */
-      /*     printf("call dgels on ||AX-B||\n"); */
-      /*     printf("A\n"); */
-      /*     NM_dense_display(sM,sSize,sSize,0); */
-      /*     printf("B\n"); */
-      /*     NM_dense_display(sQ,sSize,1,0); */
-      /*   } */
-
-      DGELS(LA_NOTRANS,sSize, sSize, NRHS, sM, sSize, sQ, sSize,&LAinfo);
-      if (verbose)
-      {
-        printf("Solution of dgels (info=%i)\n", LAinfo);
-        NM_dense_display(sQ, sSize, 1, 0);
-      }
+      M = (double *) malloc((size * size + size) * sizeof(double));
+      zw = (int *) malloc(2 * size * sizeof(int));
     }
-    else
-    {
-      DGESV(sSize, NRHS, sM, sSize, ipiv, sQ, sSize, &LAinfo);
-    }
-    if (!LAinfo)
-    {
-      if (useDGELS)
-      {
-        int cc = 0;
-        int ii;
-        printf("DGELS LAInfo=%i\n", LAinfo);
-        for (ii = 0; ii < sSize; ii++)
-        {
-          if (isnan(sQ[ii]) || isinf(sQ[ii]))
-          {
-            printf("DGELS FAILED\n");
-            cc = 1;
-            break;
-          }
-        }
-        if (cc)
-          continue;
-      }
+    double * Q = M + size * size;
+    lapack_int * ipiv = zw + size;
 
-      if (verbose)
-      {
-        printf("lcp_enum LU factorization succeeded:\n");
-      }
+#pragma omp for schedule(dynamic, LCP_ENUM_CHUNK)
+    for (long long int r = 0; r < nbTries; r++)
+    {
+      unsigned long long int first;
+#pragma omp atomic read
+      first = found;
+      if ((unsigned long long int) r > first)
+        continue; /* a solution has already been found before this pattern */
+
+      unsigned long long int key = (seed + r) % nbCase;
+      if (!lcp_enum_solve_pattern(key, size, Mref, Qref, M, Q, zw, ipiv, useDGELS, tol))
+        continue;
 
-      check = 1;
-      for (lin = 0 ; lin < sSize; lin++)
+      if (multipleSolutions)
       {
-        if (sQ[lin] < - tol)
-        {
-          check = 0;
-          break;/*out of the cone!*/
-        }
+        /* only one thread here */
+        numberOfSolutions++;
+        printf("lcp_enum find %i solution with key = %llu!\n", numberOfSolutions, key);
+        lcp_fillSolution(z, w, size, zw, Q);
+        iparam[SICONOS_LCP_IPARAM_ENUM_KEY] = (int) key;
       }
-      if (!check)
-        continue;
       else
       {
-        numberofSolutions++;
-        if (verbose || multipleSolutions)
+#pragma omp critical(lcp_enum_solution)
+        if ((unsigned long long int) r < found)
         {
-          printf("lcp_enum find %i solution with sCurrentEnum = %ld!\n", numberofSolutions, sCurrentEnum - 1);
+          if (verbose)
+            printf("lcp_enum find a solution with key = %llu!\n", key);
+          lcp_fillSolution(z, w, size, zw, Q);
+          iparam[SICONOS_LCP_IPARAM_ENUM_KEY] = (int) key;
+          numberOfSolutions = 1;
+#pragma omp atomic write
+          found = r;
         }
-
-
-        lcp_fillSolution(z, w, sSize, sWZ, sQ);
-        options->iparam[1] = (int) sCurrentEnum - 1;
-        options->iparam[2] = numberofSolutions;
-        if (!multipleSolutions)  return;
       }
     }
+
+    if (tid > 0)
+    {
+      free(M);
+      free(zw);
+    }
+  }
+
+  iparam[SICONOS_LCP_IPARAM_ENUM_NUMBER_OF_SOLUTIONS] = numberOfSolutions;
+  if (numberOfSolutions)
+  {
+    *info = 0;
+    return;
   }
   *info = 1;
   if (verbose)
@@ -332,15 +303,16 @@ int linearComplementarity_enum_setDefaultSolverOptions(LinearComplementarityProb
   options->numberOfInternalSolvers = 0;
   options->isSet = 1;
   options->filterOn = 1;
-  options->iSize = 5;
+  options->iSize = 6;
   options->dSize = 5;
   options->iparam = (int *)malloc(options->iSize * sizeof(int));
   options->dparam = (double *)malloc(options->dSize * sizeof(double));
-  for (i = 0; i < 5; i++)
-  {
+  for (i = 0; i < options->iSize; i++)
     options->iparam[i] = 0;
+  for (i = 0; i < options->dSize; i++)
     options->dparam[i] = 0.0;
-  }
+  /* sequential enumeration by default */
+  options->iparam[SICONOS_LCP_IPARAM_ENUM_NUMBER_OF_THREADS] = 1;
   if (problem)
   {
     options->dWork = (double*) malloc(lcp_enum_getNbDWork(problem, options) * sizeof(double));
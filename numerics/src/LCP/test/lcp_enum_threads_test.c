@@ -0,0 +1,129 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/* lcp_enum with several threads must find the same solution as the
+ * sequential enumeration, and several lcp_enum must run concurrently. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "NumericsMatrix.h"
+#include "LinearComplementarityProblem.h"
+#include "LCP_Solvers.h"
+#include "lcp_cst.h"
+#include "SolverOptions.h"
+
+#define NB_PROBLEMS 5
+
+static const char * const filenames[NB_PROBLEMS] =
+{
+  "./data/lcp_CPS_1.dat",
+  "./data/lcp_deudeu.dat",
+  "./data/lcp_exp_murty.dat",
+  "./data/lcp_ortiz.dat",
+  "./data/lcp_Pang_isolated_sol.dat"
+};
+
+static int solve(LinearComplementarityProblem* problem, int nthreads, double* z, double* w, int* key)
+{
+  SolverOptions options;
+  int info = linearComplementarity_setDefaultSolverOptions(problem, &options, SICONOS_LCP_ENUM);
+  options.iparam[SICONOS_LCP_IPARAM_ENUM_NUMBER_OF_THREADS] = nthreads;
+  lcp_enum(problem, z, w, &info, &options);
+  *key = options.iparam[SICONOS_LCP_IPARAM_ENUM_KEY];
+  solver_options_delete(&options);
+  return info;
+}
+
+int main(void)
+{
+  int info = 0;
+  LinearComplementarityProblem problems[NB_PROBLEMS];
+  double * z[NB_PROBLEMS];
+  double * w[NB_PROBLEMS];
+  int key[NB_PROBLEMS];
+  int solved[NB_PROBLEMS];
+
+  for (int i = 0; i < NB_PROBLEMS; ++i)
+  {
+    FILE * finput = fopen(filenames[i], "r");
+    if (!finput)
+    {
+      printf("Error! Could not read %s\n", filenames[i]);
+      return 1;
+    }
+    linearComplementarity_newFromFile(&problems[i], finput);
+    fclose(finput);
+    int n = problems[i].size;
+    z[i] = (double *) calloc(n, sizeof(double));
+    w[i] = (double *) calloc(n, sizeof(double));
+    solved[i] = solve(&problems[i], 1, z[i], w[i], &key[i]);
+    printf("%s: info = %i, key = %i\n", filenames[i], solved[i], key[i]);
+  }
+
+  /* the same solution with several threads */
+  for (int i = 0; i < NB_PROBLEMS; ++i)
+  {
+    int n = problems[i].size;
+    double * zt = (double *) calloc(n, sizeof(double));
+    double * wt = (double *) calloc(n, sizeof(double));
+    int keyt;
+    int infot = solve(&problems[i], 4, zt, wt, &keyt);
+    if (infot != solved[i] || (!infot && (keyt != key[i]
+                                          || memcmp(zt, z[i], n * sizeof(double))
+                                          || memcmp(wt, w[i], n * sizeof(double)))))
+    {
+      printf("%s: 4 threads, info = %i, key = %i, not the sequential solution\n", filenames[i], infot, keyt);
+      info = 1;
+    }
+    free(zt);
+    free(wt);
+  }
+
+  /* concurrent calls */
+  int failed = 0;
+#pragma omp parallel for reduction(+:failed)
+  for (int i = 0; i < NB_PROBLEMS; ++i)
+  {
+    int n = problems[i].size;
+    double * zt = (double *) calloc(n, sizeof(double));
+    double * wt = (double *) calloc(n, sizeof(double));
+    int keyt;
+    int infot = solve(&problems[i], 1, zt, wt, &keyt);
+    if (infot != solved[i] || (!infot && (keyt != key[i]
+                                          || memcmp(zt, z[i], n * sizeof(double)))))
+      failed++;
+    free(zt);
+    free(wt);
+  }
+  if (failed)
+  {
+    printf("concurrent calls of lcp_enum: %i wrong solutions\n", failed);
+    info = 1;
+  }
+
+  for (int i = 0; i < NB_PROBLEMS; ++i)
+  {
+    free(z[i]);
+    free(w[i]);
+    NM_free(problems[i].M);
+    free(problems[i].M);
+    free(problems[i].q);
+  }
+  return info;
+}
@@ -26,14 +26,16 @@
 #include "FischerBurmeister.h"
 #include "MCP_Solvers.h"
 #include "MCP_FischerBurmeister.h"
+#include "tlsdef.h"
 
 #pragma GCC diagnostic ignored "-Wmissing-prototypes"
 
 /* Static object which contains the MCP problem description.
 Ugly but required to deal with function pointer connection
-in  FischerFunc_MCP and its jacobian.
+in  FischerFunc_MCP and its jacobian. Thread local, so that
+problems may be solved concurrently by different threads.
 */
-static MixedComplementarityProblem * localProblem = NULL;
+static tlsvar MixedComplementarityProblem * localProblem = NULL;
 
 
 void mcp_FischerBurmeister_init(MixedComplementarityProblem * problem, SolverOptions* options)
@@ -24,19 +24,20 @@
 #include "SiconosCompat.h"
 #include "NonSmoothDrivers.h"
 #include "numerics_verbose.h"
+#include "mlcp_cst.h"
 
 
 void  mixedLinearComplementarity_default_setDefaultSolverOptions(MixedLinearComplementarityProblem* problem, SolverOptions* pOptions)
 {
   pOptions->isSet = 0;
-  pOptions->iSize = 10;
+  pOptions->iSize = 14;
   pOptions->iparam = 0;
   pOptions->dSize = 10;
   pOptions->dparam = 0;
   pOptions->filterOn = 0;
   pOptions->dWork = 0;
   pOptions->iWork = 0;
-  pOptions->iparam = (int*)malloc(10 * sizeof(int));
+  pOptions->iparam = (int*)calloc(14, sizeof(int));
   pOptions->dparam = (double*)malloc(10 * sizeof(double));
   pOptions->numberOfInternalSolvers = 0;
   solver_options_nullify(pOptions);
@@ -47,8 +48,12 @@ void  mixedLinearComplementarity_default_setDefaultSolverOptions(MixedLinearComp
   pOptions->iparam[0] = 1000;
   /*enum case : do not use dgels*/
   pOptions->iparam[4] = 0;
-  pOptions->iparam[5] = 3; /*Number of registered configurations*/
-  pOptions->iparam[8] = 0; /*Prb nedd a update*/
+  /*enum case : first pattern tried, sequential enumeration*/
+  pOptions->iparam[SICONOS_MLCP_IPARAM_ENUM_KEY] = 0;
+  pOptions->iparam[SICONOS_MLCP_IPARAM_ENUM_SEED] = 0;
+  pOptions->iparam[SICONOS_MLCP_IPARAM_ENUM_NUMBER_OF_THREADS] = 1;
+  pOptions->iparam[SICONOS_MLCP_IPARAM_DIRECT_NUMBER_OF_CONFIGURATIONS] = 3; /*Number of registered configurations*/
+  pOptions->iparam[SICONOS_MLCP_IPARAM_DIRECT_PROBLEM_CHANGED] = 0; /*Prb nedd a update*/
   pOptions->dparam[5] = 1e-12; /*tol used by direct solver to check complementarity*/
   pOptions->dparam[6] = 1e-12; /*tol for direct solver to determinate if a value is positive*/
 
@@ -25,36 +25,39 @@
 #include "SiconosLapack.h"
 #include "mlcp_enum_tool.h"
 #include "numerics_verbose.h"
+#include "tlsdef.h"
 
 
 
-static  int sN ;
-static  int sN2 ;
+/* the functions phi and jacobianPhi have no user data: the state of the
+ * solver is thread local */
+static tlsvar  int sN ;
+static tlsvar  int sN2 ;
 
-static  double * sphi_z ;
-static  double * sdir_descent ;
-static  double * sphi_zaux ;
-static  double *sjacobianPhi_z ;
-static  double *sjacobianPhi_zaux ;
-static  double *sgrad_psi_z ;
-static  double *sgrad_psi_zaux ;
-static  double *sPrevDirDescent;
-static  double *szaux ;
-static  double *szzaux ;
-static  double *sz2 ;
-static  lapack_int* sipiv ;
-static  int* sW2V;
+static tlsvar  double * sphi_z ;
+static tlsvar  double * sdir_descent ;
+static tlsvar  double * sphi_zaux ;
+static tlsvar  double *sjacobianPhi_z ;
+static tlsvar  double *sjacobianPhi_zaux ;
+static tlsvar  double *sgrad_psi_z ;
+static tlsvar  double *sgrad_psi_zaux ;
+static tlsvar  double *sPrevDirDescent;
+static tlsvar  double *szaux ;
+static tlsvar  double *szzaux ;
+static tlsvar  double *sz2 ;
+static tlsvar  lapack_int* sipiv ;
+static tlsvar  int* sW2V;
 
-static int scmp = 0;
+static tlsvar int scmp = 0;
 
-static int sPlotMerit = 1;
-static char fileName[64];
+static tlsvar int sPlotMerit = 1;
+static tlsvar char fileName[64];
 /* static char fileId[16]; */
 
-static double* sZsol = 0;
+static tlsvar double* sZsol = 0;
 
-static NewtonFunctionPtr* sFphi;
-static NewtonFunctionPtr* sFjacobianPhi;
+static tlsvar NewtonFunctionPtr* sFphi;
+static tlsvar NewtonFunctionPtr* sFjacobianPhi;
 
 
 static void plotMerit(double *z, double psi_k, double descentCondition);
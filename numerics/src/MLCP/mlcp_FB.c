@@ -27,12 +27,15 @@
 #include "NonSmoothNewtonNeighbour.h"
 #include "FischerBurmeister.h"
 #include "numerics_verbose.h"
+#include "tlsdef.h"
 
-static int sN = 0;
-static int sM = 0;
-static MixedLinearComplementarityProblem* sProblem;
-static double* sFz = 0;
-static double sMaxError = 0;
+/* F and its jacobian have no user data: the problem is thread local, set
+ * at each call of mlcp_FB */
+static tlsvar int sN = 0;
+static tlsvar int sM = 0;
+static tlsvar MixedLinearComplementarityProblem* sProblem;
+static tlsvar double* sFz = 0;
+static tlsvar double sMaxError = 0;
 
 static void computeFz(double* z);
 static void F_MCPFischerBurmeister(int size, double* z, double* FBz, int a);
@@ -87,12 +90,8 @@ void jacobianF_MCPFischerBurmeister(int size, double* z, double* jacobianFMatrix
 
 
 
-void mlcp_FB_init(MixedLinearComplementarityProblem* problem, SolverOptions* options)
+static void mlcp_FB_set_problem(MixedLinearComplementarityProblem* problem, SolverOptions* options)
 {
-
-  /*
-     Initialize solver (Connect F and its jacobian, set local size ...) according to the chosen formulation.
-  */
   sProblem = problem;
   sN = problem->n;
   sM = problem->m;
@@ -104,10 +103,18 @@ void mlcp_FB_init(MixedLinearComplementarityProblem* problem, SolverOptions* opt
     printf("internal error.");
     exit(1);
   }
+}
 
+void mlcp_FB_init(MixedLinearComplementarityProblem* problem, SolverOptions* options)
+{
+
+  /*
+     Initialize solver (Connect F and its jacobian, set local size ...) according to the chosen formulation.
+  */
+  mlcp_FB_set_problem(problem, options);
 }
 
-void mlcp_FB_reset()
+void mlcp_FB_reset(MixedLinearComplementarityProblem* problem, SolverOptions* options)
 {
   NSNN_reset();
   /*free(sFz) ;*/
@@ -127,6 +134,8 @@ void mlcp_FB(MixedLinearComplementarityProblem* problem, double *z, double *w, i
   double * zz = (double *)malloc((sN+sM)*sizeof(double));
   memcpy(zz,z,(sN+sM)*sizeof(double));*/
 
+  /* the problem may be solved by another thread than the one of mlcp_FB_init */
+  mlcp_FB_set_problem(problem, options);
 
   *info = nonSmoothNewtonNeigh(sN + sM, z, &F, &jacobianF, options->iparam, options->dparam);
   if (*info > 0)
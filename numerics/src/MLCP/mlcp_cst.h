@@ -20,6 +20,36 @@ enum MLCP_SOLVER
   SICONOS_MLCP_PGS_SBM = 114
 };
 
+enum SICONOS_MLCP_ENUM_IPARAM
+{
+  /** index in iparam to store (out) the key of the pattern of the solution found by mlcp_enum */
+  SICONOS_MLCP_IPARAM_ENUM_KEY = 1,
+  /** index in iparam to store (in) the key of the first pattern tried by mlcp_enum */
+  SICONOS_MLCP_IPARAM_ENUM_SEED = 3,
+  /** index in iparam to store (in) the use of DGELS (1) or DGESV (0) */
+  SICONOS_MLCP_IPARAM_ENUM_USE_DGELS = 4,
+  /** index in iparam to store (in) the number of threads enumerating the patterns (0 : OpenMP default) */
+  SICONOS_MLCP_IPARAM_ENUM_NUMBER_OF_THREADS = 6
+};
+
+enum SICONOS_MLCP_DIRECT_IPARAM
+{
+  /** index in iparam to store (in) the maximal number of configurations kept by mlcp_direct */
+  SICONOS_MLCP_IPARAM_DIRECT_NUMBER_OF_CONFIGURATIONS = 5,
+  /** index in iparam to store (out) the number of calls of mlcp_direct without solution */
+  SICONOS_MLCP_IPARAM_DIRECT_NUMBER_OF_FAILURES = 7,
+  /** index in iparam to store (in) the change of the matrix of the problem since the previous call */
+  SICONOS_MLCP_IPARAM_DIRECT_PROBLEM_CHANGED = 8,
+  /** index in iparam to store (out) the number of calls of mlcp_direct solved by a configuration of the cache */
+  SICONOS_MLCP_IPARAM_DIRECT_NUMBER_OF_HITS = 10,
+  /** index in iparam to store (out) the number of triangular solves with the factors of the cache */
+  SICONOS_MLCP_IPARAM_DIRECT_NUMBER_OF_SOLVES = 11,
+  /** index in iparam to store (out) the number of LU factorizations of configurations */
+  SICONOS_MLCP_IPARAM_DIRECT_NUMBER_OF_FACTORIZATIONS = 12,
+  /** index in iparam to store (out) the number of configurations removed from the full cache */
+  SICONOS_MLCP_IPARAM_DIRECT_NUMBER_OF_EVICTIONS = 13
+};
+
 extern const char* const   SICONOS_NONAME_STR;
 extern const char* const   SICONOS_MLCP_PGS_STR;
 extern const char* const   SICONOS_MLCP_RPGS_STR;
@@ -31,6 +31,13 @@ dim(v)=nn
 * 1) The complementarity constraints hold --> Success.
 * 2) The complementarity constraints don't hold --> Failed.
 *
+* The configurations are kept in a cache of at most iparam[5] entries, which
+* stores the LU factors of their linear systems. They are tried from the most
+* recently used one, and the least recently used one is replaced when a new
+* configuration is added to a full cache. A hash table on the complementarity
+* pattern finds the configurations already in the cache, which are not
+* factorized again.
+*
 **************************************************************************/
 
 #include <stdio.h>
@@ -41,67 +48,136 @@ dim(v)=nn
 #include <math.h>
 #include "mlcp_direct.h"
 #include "mlcp_tool.h"
+#include "mlcp_cst.h"
 #include "SiconosLapack.h"
 #include "NumericsMatrix.h"
 #include "numerics_verbose.h"
 
-#define DIRECT_SOLVER_USE_DGETRI
-double * sVBuf;
-
 struct dataComplementarityConf
 {
   int * zw; /*zw[i] == 0 means w null and z >=0*/
-  double * M;
+  double * M; /* LU factors of the linear system of the configuration */
+  lapack_int* IPV;
+  unsigned long long int hash; /* hash of zw */
+  int factorized; /* M holds the factors for the current problem */
+  int Usable; /* the linear system is not singular */
+  /* list of the configurations, from the most recently used one */
   struct dataComplementarityConf * next;
   struct dataComplementarityConf * prev;
-  int Usable;
-  int used;
-  lapack_int* IPV;
+  /* configurations with the same hash bucket */
+  struct dataComplementarityConf * hashNext;
 };
 
-static double * spCurDouble = 0;
-static int * spCurInt = 0;
-static double * sQ = 0;
-static int sNumberOfCC = 0;
-static int sMaxNumberOfCC = 0;
-static struct dataComplementarityConf * spFirstCC = 0;
-static struct dataComplementarityConf * spCurCC = 0;
-static double sTolneg = 0;
-static double sTolpos = 0;
-static int sN;
-static int sM;
-static int sNbLines;
-static int sNpM;
-static int* spIntBuf;
-static int sProblemChanged = 0;
-
-static double * mydMalloc(int n);
-static int * myiMalloc(int n);
-static int internalPrecompute(MixedLinearComplementarityProblem* problem);
-static int internalAddConfig(MixedLinearComplementarityProblem* problem, int * zw, int init);
-static int solveWithCurConfig(MixedLinearComplementarityProblem* problem);
-//static int nbConfig(struct dataComplementarityConf * pC);
+/* state of the direct solver, kept in options->solverData between
+ * mlcp_direct_init and mlcp_direct_reset */
+struct mlcp_direct_data
+{
+  double * curDouble;
+  int * curInt;
+  double * Q;
+  double * VBuf;
+  int numberOfCC;
+  int maxNumberOfCC;
+  struct dataComplementarityConf * CC;
+  struct dataComplementarityConf * firstCC;
+  struct dataComplementarityConf * lastCC;
+  struct dataComplementarityConf ** hashTable;
+  unsigned int hashTableSize;
+  double tolneg;
+  double tolpos;
+  int n;
+  int m;
+  int nbLines;
+  int npm;
+  int* intBuf;
+  /* statistics since mlcp_direct_init */
+  int nbHits;
+  int nbSolves;
+  int nbFactorizations;
+  int nbEvictions;
+};
 
-double * mydMalloc(int n)
+static double * mydMalloc(struct mlcp_direct_data * d, int n)
 {
-  double * aux = spCurDouble;
-  spCurDouble = spCurDouble + n;
+  double * aux = d->curDouble;
+  d->curDouble = d->curDouble + n;
   return aux;
 }
-int * myiMalloc(int n)
+static int * myiMalloc(struct mlcp_direct_data * d, int n)
 {
-  int * aux = spCurInt;
-  spCurInt = spCurInt + n;
+  int * aux = d->curInt;
+  d->curInt = d->curInt + n;
   return aux;
 }
 // XXX this is going to fail
-static lapack_int * myiMalloc2(int n)
+static lapack_int * myiMalloc2(struct mlcp_direct_data * d, int n)
 {
-  lapack_int * aux = (lapack_int*)spCurInt;
-  spCurInt = (int*)&aux[n];
+  lapack_int * aux = (lapack_int*)d->curInt;
+  d->curInt = (int*)&aux[n];
   return aux;
 }
 
+/* FNV-1a hash of a complementarity pattern */
+static unsigned long long int configurationHash(struct mlcp_direct_data * d, int * zw)
+{
+  unsigned long long int hash = 14695981039346656037ULL;
+  for (int i = 0; i < d->m; i++)
+  {
+    hash ^= (unsigned long long int)(zw[i] != 0);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+static struct dataComplementarityConf ** hashBucket(struct mlcp_direct_data * d, unsigned long long int hash)
+{
+  return &d->hashTable[hash & (d->hashTableSize - 1)];
+}
+static struct dataComplementarityConf * findConfig(struct mlcp_direct_data * d, int * zw, unsigned long long int hash)
+{
+  struct dataComplementarityConf * pC = *hashBucket(d, hash);
+  while (pC && (pC->hash != hash || memcmp(pC->zw, zw, d->m * sizeof(int))))
+    pC = pC->hashNext;
+  return pC;
+}
+static void removeFromHashTable(struct mlcp_direct_data * d, struct dataComplementarityConf * pC)
+{
+  struct dataComplementarityConf ** ppC = hashBucket(d, pC->hash);
+  while (*ppC != pC)
+    ppC = &(*ppC)->hashNext;
+  *ppC = pC->hashNext;
+}
+static void unlinkConfig(struct mlcp_direct_data * d, struct dataComplementarityConf * pC)
+{
+  if (pC->prev)
+    pC->prev->next = pC->next;
+  else
+    d->firstCC = pC->next;
+  if (pC->next)
+    pC->next->prev = pC->prev;
+  else
+    d->lastCC = pC->prev;
+}
+static void pushFrontConfig(struct mlcp_direct_data * d, struct dataComplementarityConf * pC)
+{
+  pC->prev = 0;
+  pC->next = d->firstCC;
+  if (d->firstCC)
+    d->firstCC->prev = pC;
+  d->firstCC = pC;
+  if (!d->lastCC)
+    d->lastCC = pC;
+}
+static void copyStatistics(struct mlcp_direct_data * d, SolverOptions* options)
+{
+  if (options->iSize > SICONOS_MLCP_IPARAM_DIRECT_NUMBER_OF_EVICTIONS)
+  {
+    options->iparam[SICONOS_MLCP_IPARAM_DIRECT_NUMBER_OF_HITS] = d->nbHits;
+    options->iparam[SICONOS_MLCP_IPARAM_DIRECT_NUMBER_OF_SOLVES] = d->nbSolves;
+    options->iparam[SICONOS_MLCP_IPARAM_DIRECT_NUMBER_OF_FACTORIZATIONS] = d->nbFactorizations;
+    options->iparam[SICONOS_MLCP_IPARAM_DIRECT_NUMBER_OF_EVICTIONS] = d->nbEvictions;
+  }
+}
+
 int mlcp_direct_getNbIWork(MixedLinearComplementarityProblem* problem, SolverOptions* options)
 {
   return (problem->n + problem->m) * (options->iparam[5] + 1) + options->iparam[5] * problem->m;
@@ -124,205 +200,174 @@ int mlcp_direct_getNbDWork(MixedLinearComplementarityProblem* problem, SolverOpt
 
 void mlcp_direct_init(MixedLinearComplementarityProblem* problem, SolverOptions* options)
 {
-  spCurDouble = options->dWork;
-  spCurInt = options->iWork;
-  sMaxNumberOfCC = options->iparam[5];
-  sTolneg = options->dparam[5];
-  sTolpos = options->dparam[6];
-  options->iparam[7] = 0;
-  sProblemChanged = options->iparam[8];
-  sN = problem->n;
-  sM = problem->m;
-  sNbLines = problem->n + problem->m;
-  if (problem->M->size0 != sNbLines)
+  if (options->solverData)
+    mlcp_direct_reset(problem, options);
+  struct mlcp_direct_data * d = (struct mlcp_direct_data *) calloc(1, sizeof(struct mlcp_direct_data));
+  options->solverData = d;
+  d->curDouble = options->dWork;
+  d->curInt = options->iWork;
+  d->maxNumberOfCC = options->iparam[SICONOS_MLCP_IPARAM_DIRECT_NUMBER_OF_CONFIGURATIONS];
+  d->tolneg = options->dparam[5];
+  d->tolpos = options->dparam[6];
+  options->iparam[SICONOS_MLCP_IPARAM_DIRECT_NUMBER_OF_FAILURES] = 0;
+  d->n = problem->n;
+  d->m = problem->m;
+  d->nbLines = problem->n + problem->m;
+  if (problem->M->size0 != d->nbLines)
   {
     printf("mlcp_direct_init : M rectangular, not yet managed\n");
     exit(1);
   }
 
   if (verbose)
-    printf("n= %d  m= %d /n sTolneg= %lf sTolpos= %lf \n", sN, sM, sTolneg, sTolpos);
+    printf("n= %d  m= %d /n tolneg= %lf tolpos= %lf \n", d->n, d->m, d->tolneg, d->tolpos);
+
+  d->npm = d->n + d->m;
+  d->Q = mydMalloc(d, d->npm);
+  d->VBuf = mydMalloc(d, d->npm);
+  d->intBuf = myiMalloc(d, d->npm);
 
-  sNpM = sN + sM;
-  spCurCC = 0;
-  spFirstCC = 0;
-  sNumberOfCC = 0;
-  sQ = mydMalloc(sNpM);
-  sVBuf = mydMalloc(sNpM);
-  spIntBuf = myiMalloc(sNpM);
+  if (d->maxNumberOfCC < 0)
+    d->maxNumberOfCC = 0;
+  d->CC = (struct dataComplementarityConf *) malloc((d->maxNumberOfCC + 1) * sizeof(struct dataComplementarityConf));
+  d->hashTableSize = 1;
+  while (d->hashTableSize < 2 * (unsigned int)d->maxNumberOfCC)
+    d->hashTableSize <<= 1;
+  d->hashTable = (struct dataComplementarityConf **) calloc(d->hashTableSize, sizeof(struct dataComplementarityConf *));
+  copyStatistics(d, options);
 }
-void mlcp_direct_reset()
+void mlcp_direct_reset(MixedLinearComplementarityProblem* problem, SolverOptions* options)
 {
-  struct dataComplementarityConf * aux;
-  while (spFirstCC)
-  {
-    aux = spFirstCC;
-    spFirstCC = spFirstCC->next;
-    free(aux);
-  }
+  struct mlcp_direct_data * d = (struct mlcp_direct_data *) options->solverData;
+  if (!d)
+    return;
+  free(d->CC);
+  free(d->hashTable);
+  free(d);
+  options->solverData = NULL;
 }
-int internalPrecompute(MixedLinearComplementarityProblem* problem)
+/* LU factorization of the linear system of the configuration */
+static int internalPrecompute(struct mlcp_direct_data * d, MixedLinearComplementarityProblem* problem, struct dataComplementarityConf * pC)
 {
   lapack_int INFO = 0;
-  mlcp_buildM(spFirstCC->zw, spFirstCC->M, problem->M->matrix0, sN, sM, sNbLines);
+  int npm = d->npm;
+  mlcp_buildM(pC->zw, pC->M, problem->M->matrix0, d->n, d->m, d->nbLines);
   if (verbose)
   {
     printf("mlcp_direct, precomputed M :\n");
-    NM_dense_display(spFirstCC->M, sNpM, sNpM, 0);
+    NM_dense_display(pC->M, npm, npm, 0);
   }
-  if (!(spFirstCC->Usable))
-    return 0;
-  DGETRF(sNpM, sNpM, spFirstCC->M, sNpM, spFirstCC->IPV, &INFO);
-  if (INFO)
-  {
-    spFirstCC->Usable = 0;
-    printf("mlcp_direct, internalPrecompute  error, LU impossible\n");
-    return 0;
-  }
-#ifdef DIRECT_SOLVER_USE_DGETRI
-  DGETRI(sNpM, spFirstCC->M, sNpM, spFirstCC->IPV, &INFO);
+  pC->factorized = 1;
+  d->nbFactorizations++;
+  DGETRF(npm, npm, pC->M, npm, pC->IPV, &INFO);
+  pC->Usable = !INFO;
   if (INFO)
   {
-    spFirstCC->Usable = 1;
-    printf("mlcp_direct error, internalPrecompute  DGETRI impossible\n");
+    if (verbose)
+      printf("mlcp_direct, internalPrecompute  error, LU impossible\n");
     return 0;
   }
-#endif
   return 1;
 }
-/*memory management about floatWorkingMem and intWorkingMem*/
-int internalAddConfig(MixedLinearComplementarityProblem* problem, int * zw, int init)
+void mlcp_direct_addConfig(MixedLinearComplementarityProblem* problem, SolverOptions* options, int * zw)
 {
   int i;
+  struct mlcp_direct_data * d = (struct mlcp_direct_data *) options->solverData;
   if (verbose)
   {
-    printf("mlcp_direct internalAddConfig\n");
+    printf("mlcp_direct addConfig\n");
     printf("---------\n");
     for (i = 0; i < problem->m; i++)
       printf("zw[%d]=%d\t", i, zw[i]);
     printf("\n");
   }
-  if (init)
-  {
-    spFirstCC->zw = myiMalloc(sM);
-    spFirstCC->IPV = myiMalloc2(sNpM);
-    spFirstCC->M = mydMalloc(sNpM * sNpM);
-  }
-  for (i = 0; i < sM; i++)
+  if (!d->maxNumberOfCC)
+    return;
+
+  unsigned long long int hash = configurationHash(d, zw);
+  struct dataComplementarityConf * pC = findConfig(d, zw, hash);
+  if (pC) /* already known, becomes the most recently used */
   {
-    spFirstCC->zw[i] = zw[i];
+    unlinkConfig(d, pC);
+    pushFrontConfig(d, pC);
+    if (!pC->factorized)
+      internalPrecompute(d, problem, pC);
+    copyStatistics(d, options);
+    return;
   }
-  return internalPrecompute(problem);
-}
-/*memory management about dataComplementarityConf*/
-void mlcp_direct_addConfig(MixedLinearComplementarityProblem* problem, int * zw)
-{
-  if (sNumberOfCC < sMaxNumberOfCC) /*Add a configuration*/
+
+  if (d->numberOfCC < d->maxNumberOfCC) /*Add a configuration*/
   {
-    sNumberOfCC++;
-    if (spFirstCC == 0) /*first add*/
-    {
-      spFirstCC = (struct dataComplementarityConf *) malloc(sizeof(struct dataComplementarityConf));
-      spFirstCC->Usable = 1;
-      spCurCC = spFirstCC;
-      spFirstCC->prev = 0;
-      spFirstCC->next = 0;
-    }
-    else
-    {
-      spFirstCC->prev = (struct dataComplementarityConf *) malloc(sizeof(struct dataComplementarityConf));
-      spFirstCC->prev->Usable = 1;
-      spFirstCC->prev->next = spFirstCC;
-      spFirstCC = spFirstCC->prev;
-      spFirstCC->prev = 0;
-    }
-    internalAddConfig(problem, zw, 1);
+    pC = &d->CC[d->numberOfCC++];
+    pC->zw = myiMalloc(d, d->m);
+    pC->IPV = myiMalloc2(d, d->npm);
+    pC->M = mydMalloc(d, d->npm * d->npm);
   }
-  else /*Replace an old one*/
+  else /*Replace the least recently used one*/
   {
-    struct dataComplementarityConf * aux = spFirstCC;
-    while (aux->next) aux = aux->next;
-    if (aux->prev)
-    {
-      aux->prev->next = 0;
-      spFirstCC->prev = aux;
-      aux->prev = 0;
-      aux->next = spFirstCC;
-      spFirstCC = aux;
-      spFirstCC->Usable = 1;
-    }
-    internalAddConfig(problem, zw, 0);
+    pC = d->lastCC;
+    unlinkConfig(d, pC);
+    removeFromHashTable(d, pC);
+    d->nbEvictions++;
   }
+  for (i = 0; i < d->m; i++)
+    pC->zw[i] = zw[i];
+  pC->hash = hash;
+  pC->hashNext = *hashBucket(d, hash);
+  *hashBucket(d, hash) = pC;
+  pushFrontConfig(d, pC);
+  internalPrecompute(d, problem, pC);
+  copyStatistics(d, options);
 }
-void mlcp_direct_addConfigFromWSolution(MixedLinearComplementarityProblem* problem, double * wSol)
+void mlcp_direct_addConfigFromWSolution(MixedLinearComplementarityProblem* problem, SolverOptions* options, double * wSol)
 {
   int i;
+  struct mlcp_direct_data * d = (struct mlcp_direct_data *) options->solverData;
 
-  for (i = 0; i < sM; i++)
+  for (i = 0; i < d->m; i++)
   {
-    if (wSol[i] > sTolpos)
-      spIntBuf[i] = 1;
+    if (wSol[i] > d->tolpos)
+      d->intBuf[i] = 1;
     else
-      spIntBuf[i] = 0;
+      d->intBuf[i] = 0;
   }
-  mlcp_direct_addConfig(problem, spIntBuf);
+  mlcp_direct_addConfig(problem, options, d->intBuf);
 }
 
 
 
-int solveWithCurConfig(MixedLinearComplementarityProblem* problem)
+/* solve the linear system of the configuration with its LU factors,
+ * the solution is in VBuf. Return 1 if it is in the cone. */
+static int solveWithConfig(struct mlcp_direct_data * d, MixedLinearComplementarityProblem* problem, struct dataComplementarityConf * pC)
 {
   int lin;
   lapack_int INFO = 0;
-  double ALPHA = 1;
-  double BETA = 0;
-  int INCX = 1;
-  int INCY = 1;
-  double * solTest = 0;
-  /*  printf("cur config ");
-  for (int i=0;i<sM;i++)
-    if (spCurCC->zw[i])
-      printf("1");
-    else
-      printf("0");
-      printf("\n");*/
-  if (sProblemChanged)
-    internalPrecompute(problem);
-  if (!spCurCC->Usable)
+  if (!pC->factorized)
+    internalPrecompute(d, problem, pC);
+  if (!pC->Usable)
   {
     if (verbose)
-      printf("solveWithCurConfig not usable\n");
+      printf("solveWithConfig not usable\n");
     return 0;
   }
-#ifdef DIRECT_SOLVER_USE_DGETRI
-  cblas_dgemv(CblasColMajor,CblasNoTrans, sNpM, sNpM, ALPHA, spCurCC->M, sNpM, sQ, INCX, BETA, sVBuf, INCY);
-  solTest = sVBuf;
-#else
-  for (lin = 0; lin < sNpM; lin++)
-    sQ[lin] =  - problem->q[lin];
-  DGETRS(LA_NOTRANS, sNpM, one, spCurCC->M, sNpM, spCurCC->IPV, sQ, sNpM, &INFO);
-  solTest = sQ;
-#endif
+  memcpy(d->VBuf, d->Q, d->npm * sizeof(double));
+  DGETRS(LA_NOTRANS, d->npm, 1, pC->M, d->npm, pC->IPV, d->VBuf, d->npm, &INFO);
+  d->nbSolves++;
   if (INFO)
   {
     if (verbose)
-      printf("solveWithCurConfig DGETRS failed\n");
+      printf("solveWithConfig DGETRS failed\n");
     return 0;
   }
-  else
+  for (lin = 0 ; lin < d->m; lin++)
   {
-    for (lin = 0 ; lin < sM; lin++)
+    if (d->VBuf[d->n + lin] < - d->tolneg)
     {
-      if (solTest[sN + lin] < - sTolneg)
-      {
-        if (verbose)
-          printf("solveWithCurConfig Sol not in the positive cone because %lf\n", solTest[sN + lin]);
-        return 0;
-      }
+      if (verbose)
+        printf("solveWithConfig Sol not in the positive cone because %lf\n", d->VBuf[d->n + lin]);
+      return 0;
     }
   }
-  /*  if (verbose)
-      printf("solveWithCurConfig Success\n");*/
   return 1;
 }
 /*
@@ -330,84 +375,67 @@ int solveWithCurConfig(MixedLinearComplementarityProblem* problem)
  *
  *options:
  * iparam[5] : (in)  n0 number of possible configuration.
+ * iparam[7] : (out) number of calls without solution since mlcp_direct_init.
+ * iparam[8] : (in) the matrix of the problem has been changed since the previous call.
+ * iparam[10..13] : (out) if iSize > 13, numbers of hits, of solves, of factorizations
+ *                  and of evictions of the cache since mlcp_direct_init.
  * dparam[5] : (in) a positive value, tolerane about the sign.
+ * dparam[6] : (in) tolerance to build a configuration from w.
  * dWork : working float zone size : n + m + n0*(n+m)*(n+m)  . MUST BE ALLOCATED BY THE USER.
  * iWork : working int zone size : (n + m)*(n0+1) + nO*m. MUST BE ALLOCATED BY THE USER.
+ * solverData : (in/out) the state of the solver, set by mlcp_direct_init.
  * double *z : size n+m
  * double *w : size n+m
  * info : output. info == 0 if success
  */
-/*int nbConfig(struct dataComplementarityConf * pC)
-{
-  struct dataComplementarityConf * paux = pC;
-  int nb = 0;
-  while (paux)
-  {
-    nb++;
-    paux = paux->next;
-  }
-  printf("number of conf :%d\n", nb);
-  return nb;
-
-}
-*/
-
 void mlcp_direct(MixedLinearComplementarityProblem* problem, double *z, double *w, int *info, SolverOptions* options)
 {
   int find = 0;
   int lin = 0;
-  if (!spFirstCC)
+  struct dataComplementarityConf * pC;
+  struct mlcp_direct_data * d = (struct mlcp_direct_data *) options->solverData;
+  if (!d)
   {
-    (*info) = 1;
+    *info = 1;
+    printf("MLCP_DIRECT error, call a non initialised method!\n");
+    return;
   }
-  else
+
+  if (options->iparam[SICONOS_MLCP_IPARAM_DIRECT_PROBLEM_CHANGED])
+  {
+    /* the factors are computed again when the configurations are tried */
+    for (pC = d->firstCC; pC; pC = pC->next)
+      pC->factorized = 0;
+  }
+
+  for (lin = 0; lin < d->npm; lin++)
+    d->Q[lin] =  - problem->q[lin];
+
+  for (pC = d->firstCC; pC; pC = pC->next)
   {
-    spCurCC = spFirstCC;
-#ifdef DIRECT_SOLVER_USE_DGETRI
-    for (lin = 0; lin < sNpM; lin++)
-      sQ[lin] =  - problem->q[lin];
-#endif
-    do
+    find = solveWithConfig(d, problem, pC);
+    if (find)
     {
-      find = solveWithCurConfig(problem);
-      if (find)
+      mlcp_fillSolution(z, z + d->n, w, w + d->n, d->n, d->m, d->nbLines, pC->zw, d->VBuf);
+      /*Current becomes first for the next step.*/
+      if (pC != d->firstCC)
       {
-#ifdef DIRECT_SOLVER_USE_DGETRI
-        mlcp_fillSolution(z, z + sN, w, w + sN, sN, sM, sNbLines, spCurCC->zw, sVBuf);
-#else
-        mlcp_fillSolution(z, z + sN, w, w + sN, sN, sM, sNbLines, spCurCC->zw, sQ);
-#endif
-        /*Current becomes first for the next step.*/
-        if (spCurCC != spFirstCC)
-        {
-          /*    nbConfig(spFirstCC);
-          nbConfig(spCurCC);
-          printf("bidouille pour devenir 1\n");*/
-          spCurCC->prev->next = spCurCC->next;
-          if (spCurCC->next)
-            spCurCC->next->prev = spCurCC->prev;
-          spFirstCC->prev = spCurCC;
-          spCurCC->next = spFirstCC;
-          spFirstCC = spCurCC;
-          spFirstCC->prev = 0;
-          /*    nbConfig(spFirstCC);*/
-        }
-      }
-      else
-      {
-        spCurCC = spCurCC->next;
+        unlinkConfig(d, pC);
+        pushFrontConfig(d, pC);
       }
+      break;
     }
-    while (spCurCC && !find);
+  }
 
-    if (find)
-    {
-      *info = 0;
-    }
-    else
-    {
-      options->iparam[7]++;
-      *info = 1;
-    }
+  if (find)
+  {
+    d->nbHits++;
+    *info = 0;
+  }
+  else
+  {
+    options->iparam[SICONOS_MLCP_IPARAM_DIRECT_NUMBER_OF_FAILURES]++;
+    *info = 1;
   }
+  copyStatistics(d, options);
 }
@@ -8,13 +8,16 @@
  * add configuration with mlcp_direct_addConfigFromWSolution to add configuration.
  * mlcp_direct_reset
  *
+ * The state of the solver is kept in options->solverData, from
+ * mlcp_direct_init to mlcp_direct_reset: problems solved with different
+ * options are independent and may be solved concurrently.
  */
 
 
-void mlcp_direct_addConfig(MixedLinearComplementarityProblem* problem, int * zw);
-void mlcp_direct_addConfigFromWSolution(MixedLinearComplementarityProblem* problem, double * wSol);
+void mlcp_direct_addConfig(MixedLinearComplementarityProblem* problem, SolverOptions* options, int * zw);
+void mlcp_direct_addConfigFromWSolution(MixedLinearComplementarityProblem* problem, SolverOptions* options, double * wSol);
 void mlcp_direct_init(MixedLinearComplementarityProblem* problem, SolverOptions* options);
-void mlcp_direct_reset(void);
+void mlcp_direct_reset(MixedLinearComplementarityProblem* problem, SolverOptions* options);
 
 int mlcp_direct_getNbIWork(MixedLinearComplementarityProblem* problem, SolverOptions* options);
 int mlcp_direct_getNbDWork(MixedLinearComplementarityProblem* problem, SolverOptions* options);
@@ -36,14 +36,6 @@ dim(v)=nn
 #include "mlcp_direct.h"
 #include "mlcp_tool.h"
 
-static int sN;
-static int sM;
-
-static int * siWorkFB = 0;
-static int * siWorkDirect = 0;
-static double * sdWorkFB = 0;
-static double * sdWorkDirect = 0;
-
 int mixedLinearComplementarity_directFB_setDefaultSolverOptions(MixedLinearComplementarityProblem* problem, SolverOptions* pSolver)
 {
   mixedLinearComplementarity_default_setDefaultSolverOptions(problem, pSolver);
@@ -75,29 +67,22 @@ int mlcp_direct_FB_getNbDWork(MixedLinearComplementarityProblem* problem, Solver
 
 void mlcp_direct_FB_init(MixedLinearComplementarityProblem* problem, SolverOptions* options)
 {
-  sN = problem->n;
-  sM = problem->m;
-  int iOffset = mlcp_direct_getNbIWork(problem, options);
-  int dOffset = mlcp_direct_getNbDWork(problem, options);
-  siWorkFB = options->iWork + iOffset;
-  siWorkDirect = options->iWork;
-  sdWorkFB = options->dWork + dOffset;
-  sdWorkDirect = options->dWork;
+  /* the working memory of mlcp_direct, followed by the one of mlcp_FB */
+  double * dWorkDirect = options->dWork;
+  int * iWorkDirect = options->iWork;
 
   mlcp_direct_init(problem, options);
-  options->dWork = sdWorkFB;
-  options->iWork = siWorkFB;
+  options->dWork = dWorkDirect + mlcp_direct_getNbDWork(problem, options);
+  options->iWork = iWorkDirect + mlcp_direct_getNbIWork(problem, options);
 
   mlcp_FB_init(problem, options);
-  options->dWork = sdWorkDirect;
-  options->iWork = siWorkDirect;
-
-
+  options->dWork = dWorkDirect;
+  options->iWork = iWorkDirect;
 }
-void mlcp_direct_FB_reset()
+void mlcp_direct_FB_reset(MixedLinearComplementarityProblem* problem, SolverOptions* options)
 {
-  mlcp_direct_reset();
-  mlcp_FB_reset();
+  mlcp_direct_reset(problem, options);
+  mlcp_FB_reset(problem, options);
 }
 
 /*
@@ -120,14 +105,20 @@ void mlcp_direct_FB(MixedLinearComplementarityProblem* problem, double *z, doubl
   mlcp_direct(problem, z, w, info, options);
   if (*info)
   {
+    double * dWorkDirect = options->dWork;
+    int * iWorkDirect = options->iWork;
+    options->dWork = dWorkDirect + mlcp_direct_getNbDWork(problem, options);
+    options->iWork = iWorkDirect + mlcp_direct_getNbIWork(problem, options);
     /*solver direct failed, so run the path solver.*/
     mlcp_FB(problem, z, w, info, options);
+    options->dWork = dWorkDirect;
+    options->iWork = iWorkDirect;
     if (!(*info))
     {
       /*       for (i=0;i<problem->n+problem->m;i++){ */
       /*  printf("w[%d]=%f z[%d]=%f\t",i,w[i],i,z[i]);  */
       /*       } */
-      mlcp_direct_addConfigFromWSolution(problem, w + sN);
+      mlcp_direct_addConfigFromWSolution(problem, options, w + problem->n);
     }
   }
 }
@@ -37,14 +37,6 @@ dim(v)=nn
 #include "mlcp_enum.h"
 #include "mlcp_tool.h"
 
-static int sN;
-static int sM;
-
-static int * siWorkEnum = 0;
-static int * siWorkDirect = 0;
-static double * sdWorkEnum = 0;
-static double * sdWorkDirect = 0;
-
 int mixedLinearComplementarity_directEnum_setDefaultSolverOptions(MixedLinearComplementarityProblem* problem, SolverOptions* pSolver)
 {
   mixedLinearComplementarity_default_setDefaultSolverOptions(problem, pSolver);
@@ -73,24 +65,11 @@ int mlcp_direct_enum_getNbDWork(MixedLinearComplementarityProblem* problem, Solv
 
 void mlcp_direct_enum_init(MixedLinearComplementarityProblem* problem, SolverOptions* options)
 {
-  sN = problem->n;
-  sM = problem->m;
-  int iOffset = mlcp_direct_getNbIWork(problem, options);
-  int dOffset = mlcp_direct_getNbDWork(problem, options);
-  siWorkEnum = options->iWork + iOffset;
-  siWorkDirect = options->iWork;
-  sdWorkEnum = options->dWork + dOffset;
-  sdWorkDirect = options->dWork;
   mlcp_direct_init(problem, options);
-
 }
-void mlcp_direct_enum_reset()
+void mlcp_direct_enum_reset(MixedLinearComplementarityProblem* problem, SolverOptions* options)
 {
-  mlcp_direct_reset();
-  siWorkEnum = 0;
-  siWorkDirect = 0;
-  sdWorkEnum = 0;
-  sdWorkDirect = 0;
+  mlcp_direct_reset(problem, options);
 }
 
 /*
@@ -109,25 +88,29 @@ void mlcp_direct_enum_reset()
  */
 void mlcp_direct_enum(MixedLinearComplementarityProblem* problem, double *z, double *w, int *info, SolverOptions* options)
 {
-  if (!siWorkEnum)
+  if (!options->solverData)
   {
     *info = 1;
     printf("MLCP_DIRECT_ENUM error, call a non initialised method!!!!!!!!!!!!!!!!!!!!!\n");
     return;
   }
+  /* the working memory of mlcp_direct, followed by the one of mlcp_enum */
+  double * dWorkDirect = options->dWork;
+  int * iWorkDirect = options->iWork;
   /*First, try direct solver*/
-  options->dWork = sdWorkDirect;
-  options->iWork = siWorkDirect;
   mlcp_direct(problem, z, w, info, options);
   if (*info)
   {
-    options->dWork = sdWorkEnum;
-    options->iWork = siWorkEnum;
+    options->dWork = dWorkDirect + mlcp_direct_getNbDWork(problem, options);
+    options->iWork = iWorkDirect + mlcp_direct_getNbIWork(problem, options);
     /*solver direct failed, so run the enum solver.*/
     mlcp_enum(problem, z, w, info, options);
+    /* the working memory given by the user */
+    options->dWork = dWorkDirect;
+    options->iWork = iWorkDirect;
     if (!(*info))
     {
-      mlcp_direct_addConfigFromWSolution(problem, w + sN);
+      mlcp_direct_addConfigFromWSolution(problem, options, w + problem->n);
     }
   }
 }
@@ -26,8 +26,6 @@
 #include "mlcp_direct.h"
 #include "mlcp_tool.h"
 
-static int sN;
-static int sM;
 
 int mixedLinearComplementarity_directPath_setDefaultSolverOptions(MixedLinearComplementarityProblem* problem, SolverOptions* pSolver)
 {
@@ -58,15 +56,13 @@ int mlcp_direct_path_getNbDWork(MixedLinearComplementarityProblem* problem, Solv
 
 void mlcp_direct_path_init(MixedLinearComplementarityProblem* problem, SolverOptions* options)
 {
-  sN = problem->n;
-  sM = problem->m;
   mlcp_direct_init(problem, options);
   //mlcp_path_init(problem, options);
 
 }
-void mlcp_direct_path_reset()
+void mlcp_direct_path_reset(MixedLinearComplementarityProblem* problem, SolverOptions* options)
 {
-  mlcp_direct_reset();
+  mlcp_direct_reset(problem, options);
   //mlcp_path_reset();
 }
 
@@ -97,7 +93,7 @@ void mlcp_direct_path(MixedLinearComplementarityProblem* problem, double *z, dou
       /*       for (i=0;i<problem->n+problem->m;i++){ */
       /*  printf("w[%d]=%f z[%d]=%f\t",i,w[i],i,z[i]);  */
       /*       } */
-      mlcp_direct_addConfigFromWSolution(problem, w + sN);
+      mlcp_direct_addConfigFromWSolution(problem, options, w + problem->n);
     }
   }
 }
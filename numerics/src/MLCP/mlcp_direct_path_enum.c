@@ -37,14 +37,6 @@ dim(v)=nn
 #include "mlcp_path_enum.h"
 #include "mlcp_tool.h"
 
-static int sN;
-static int sM;
-
-static int * siWorkPathEnum = 0;
-static int * siWorkDirect = 0;
-static double * sdWorkPathEnum = 0;
-static double * sdWorkDirect = 0;
-
 int mixedLinearComplementarity_directPathEnum_setDefaultSolverOptions(MixedLinearComplementarityProblem* problem, SolverOptions* pSolver)
 {
   mixedLinearComplementarity_default_setDefaultSolverOptions(problem, pSolver);
@@ -74,28 +66,20 @@ int mlcp_direct_path_enum_getNbDWork(MixedLinearComplementarityProblem* problem,
 
 void mlcp_direct_path_enum_init(MixedLinearComplementarityProblem* problem, SolverOptions* options)
 {
-  sN = problem->n;
-  sM = problem->m;
-  int iOffset = mlcp_direct_getNbIWork(problem, options);
-  int dOffset = mlcp_direct_getNbDWork(problem, options);
-  siWorkPathEnum = options->iWork + iOffset;
-  siWorkDirect = options->iWork;
-  sdWorkPathEnum = options->dWork + dOffset;
-  sdWorkDirect = options->dWork;
+  /* the working memory of mlcp_direct, followed by the one of mlcp_path_enum */
+  double * dWorkDirect = options->dWork;
+  int * iWorkDirect = options->iWork;
   mlcp_direct_init(problem, options);
-  options->dWork = sdWorkPathEnum;
-  options->iWork = siWorkPathEnum;
+  options->dWork = dWorkDirect + mlcp_direct_getNbDWork(problem, options);
+  options->iWork = iWorkDirect + mlcp_direct_getNbIWork(problem, options);
   mlcp_path_enum_init(problem, options);
-
+  options->dWork = dWorkDirect;
+  options->iWork = iWorkDirect;
 }
-void mlcp_direct_path_enum_reset()
+void mlcp_direct_path_enum_reset(MixedLinearComplementarityProblem* problem, SolverOptions* options)
 {
-  mlcp_direct_reset();
-  mlcp_path_enum_reset();
-  siWorkPathEnum = 0;
-  siWorkDirect = 0;
-  sdWorkPathEnum = 0;
-  sdWorkDirect = 0;
+  mlcp_direct_reset(problem, options);
+  mlcp_path_enum_reset(problem, options);
 }
 
 /*
@@ -114,25 +98,27 @@ void mlcp_direct_path_enum_reset()
  */
 void mlcp_direct_path_enum(MixedLinearComplementarityProblem* problem, double *z, double *w, int *info, SolverOptions* options)
 {
-  if (!siWorkPathEnum)
+  if (!options->solverData)
   {
     *info = 1;
     printf("MLCP_DIRECT_PATH_ENUM error, call a non initialised method!!!!!!!!!!!!!!!!!!!!!\n");
     return;
   }
+  double * dWorkDirect = options->dWork;
+  int * iWorkDirect = options->iWork;
   /*First, try direct solver*/
-  options->dWork = sdWorkDirect;
-  options->iWork = siWorkDirect;
   mlcp_direct(problem, z, w, info, options);
   if (*info)
   {
-    options->dWork = sdWorkPathEnum;
-    options->iWork = siWorkPathEnum;
+    options->dWork = dWorkDirect + mlcp_direct_getNbDWork(problem, options);
+    options->iWork = iWorkDirect + mlcp_direct_getNbIWork(problem, options);
     /*solver direct failed, so run the enum solver.*/
     mlcp_path_enum(problem, z, w, info, options);
+    options->dWork = dWorkDirect;
+    options->iWork = iWorkDirect;
     if (!(*info))
     {
-      mlcp_direct_addConfigFromWSolution(problem, w + sN);
+      mlcp_direct_addConfigFromWSolution(problem, options, w + problem->n);
     }
   }
 }
@@ -27,8 +27,6 @@
 #include "mlcp_simplex.h"
 #include "mlcp_tool.h"
 
-static int sN;
-static int sM;
 
 
 int mixedLinearComplementarity_directSimplex_setDefaultSolverOptions(MixedLinearComplementarityProblem* problem, SolverOptions* pSolver)
@@ -60,16 +58,14 @@ int mlcp_direct_simplex_getNbDWork(MixedLinearComplementarityProblem* problem, S
 
 void mlcp_direct_simplex_init(MixedLinearComplementarityProblem* problem, SolverOptions* options)
 {
-  sN = problem->n;
-  sM = problem->m;
   mlcp_direct_init(problem, options);
   mlcp_simplex_init(problem, options);
 
 }
-void mlcp_direct_simplex_reset()
+void mlcp_direct_simplex_reset(MixedLinearComplementarityProblem* problem, SolverOptions* options)
 {
-  mlcp_direct_reset();
-  mlcp_simplex_reset();
+  mlcp_direct_reset(problem, options);
+  mlcp_simplex_reset(problem, options);
 }
 
 /*
@@ -99,7 +95,7 @@ void mlcp_direct_simplex(MixedLinearComplementarityProblem* problem, double *z,
       /*       for (i=0;i<problem->n+problem->m;i++){ */
       /*  printf("w[%d]=%f z[%d]=%f\t",i,w[i],i,z[i]);  */
       /*       } */
-      mlcp_direct_addConfigFromWSolution(problem, w + sN);
+      mlcp_direct_addConfigFromWSolution(problem, options, w + problem->n);
     }
   }
 }
@@ -113,28 +113,28 @@ void mlcp_driver_reset(MixedLinearComplementarityProblem* problem, SolverOptions
   switch (options->solverId)
   {
   case SICONOS_MLCP_DIRECT_ENUM :
-    mlcp_direct_enum_reset();
+    mlcp_direct_enum_reset(problem, options);
     break;
   case SICONOS_MLCP_DIRECT_PATH_ENUM :
-    mlcp_direct_path_enum_reset();
+    mlcp_direct_path_enum_reset(problem, options);
     break;
   case SICONOS_MLCP_PATH_ENUM :
-    mlcp_path_enum_reset();
+    mlcp_path_enum_reset(problem, options);
     break;
   case SICONOS_MLCP_DIRECT_SIMPLEX :
-    mlcp_direct_simplex_reset();
+    mlcp_direct_simplex_reset(problem, options);
     break;
   case SICONOS_MLCP_DIRECT_PATH :
-    mlcp_direct_path_reset();
+    mlcp_direct_path_reset(problem, options);
     break;
   case SICONOS_MLCP_DIRECT_FB :
-    mlcp_direct_FB_reset();
+    mlcp_direct_FB_reset(problem, options);
     break;
   case SICONOS_MLCP_SIMPLEX :
-    mlcp_simplex_reset();
+    mlcp_simplex_reset(problem, options);
     break;
   case SICONOS_MLCP_FB :
-    mlcp_FB_reset();
+    mlcp_FB_reset(problem, options);
     break;
 
   default:
@@ -38,85 +38,25 @@ dim(v)=nn
 #include "mlcp_enum_tool.h"
 #include "SiconosLapack.h"
 #include "numerics_verbose.h"
+#include "mlcp_cst.h"
 
-//#ifdef HAVE_DGELS
-//#define ENUM_USE_DGELS
-//#endif
-
-#ifdef MLCP_DEBUG
-static int *sLastIWork;
-static double *sLastDWork;
+#ifdef _OPENMP
+#include <omp.h>
 #endif
 
-static double * sQ = 0;
-static double * sColNul = 0;
-static double * sM = 0;
-static double * sMref = 0;
-static double * sQref = 0;
-/* double working memory for dgels*/
-static double * sDgelsWork = 0;
-static int LWORK = 0;
-
-static int sNn = 0;
-static int sMm = 0;
-static int sMl = 0;
-static int* sW2V = 0;
-
-/*OUTPUT */
-/*sW2 is a pointer on the output w*/
-static double* sW2;
-/*sW1 is a pointer on the output w*/
-static double* sW1;
-/*sV is a pointer on the output v*/
-static double* sV;
-/*sU is a pointer on the output u*/
-static double* sU;
+/* number of patterns given at once to a thread */
+#define MLCP_ENUM_CHUNK 16
 
-static void buildQ(void);
-static void printCurrentSystem(void);
-static void printRefSystem(void);
-
-/*case defined with sCurrentEnum
- *if sW2V[i]==0
+/* The enumeration has no static state: the working memory of the first
+ * thread is options->dWork and options->iWork, the other threads
+ * allocate their own.
+ *
+ * The complementarity pattern zw of a key is:
+ *if zw[i]==0
  *  v[i] not null w2[i] null
  *else
  *  v[i] null and w2[i] not null
  */
-/* void affectW2V(){ */
-/*   unsigned long  int aux = sCurrentEnum; */
-/*   for (unsigned int i =0; i <sMm; i++){ */
-/*     sW2V[i]=aux & 1; */
-/*     aux = aux >> 1; */
-/*   } */
-
-/* } */
-/* void initEnum(){ */
-/*   int cmp; */
-/*   sCmpEnum=0;   */
-/*   sNbCase = 1; */
-/*   for (cmp=0;cmp<sMm;cmp++) */
-/*     sNbCase = sNbCase << 1; */
-/*   sProgress=0; */
-/* } */
-/* int nextEnum(){ */
-/*   if (sCmpEnum == sNbCase) */
-/*     return 0; */
-/*   if (sCurrentEnum >= sNbCase){ */
-/*     sCurrentEnum=0; */
-/*   } */
-/*   if (verbose) */
-/*     printf("try enum :%d\n",(int)sCurrentEnum); */
-/*   affectW2V(); */
-/*   sCurrentEnum++; */
-/*   sCmpEnum++; */
-/*   if (verbose && sCmpEnum > sProgress*sNbCase){ */
-/*     sProgress+=0.001; */
-/*     printf(" progress %f %d \n",sProgress,(int) sCurrentEnum); */
-/*   } */
-
-/*   return 1; */
-/* } */
-
 
 int mixedLinearComplementarity_enum_setDefaultSolverOptions(MixedLinearComplementarityProblem* problem, SolverOptions* pOPtionSolver)
 {
@@ -125,26 +65,19 @@ int mixedLinearComplementarity_enum_setDefaultSolverOptions(MixedLinearComplemen
   return 0;
 }
 
-
-void buildQ()
+static void printCurrentSystem(double * M, double * Q, int n, int m, int NbLines)
 {
-  memcpy(sQ, sQref, sMl * sizeof(double));
-}
-void printCurrentSystem()
-{
-  int npm = sNn + sMm;
   printf("printCurrentSystemM:\n");
-  NM_dense_display(sM, sMl, npm, 0);
+  NM_dense_display(M, NbLines, n + m, 0);
   printf("printCurrentSystemQ (ie -Q from mlcp because of linear system MZ=Q):\n");
-  NM_dense_display(sQ, sMl, 1, 0);
+  NM_dense_display(Q, NbLines, 1, 0);
 }
-void printRefSystem()
+static void printRefSystem(double * Mref, double * Qref, int n, int m, int NbLines)
 {
-  int npm = sNn + sMm;
-  printf("ref M NbLines %d n %d  m %d :\n", sMl, sNn, sMm);
-  NM_dense_display(sMref, sMl, npm, 0);
+  printf("ref M NbLines %d n %d  m %d :\n", NbLines, n, m);
+  NM_dense_display(Mref, NbLines, n + m, 0);
   printf("ref Q (ie -Q from mlcp because of linear system MZ=Q):\n");
-  NM_dense_display(sQref, sMl, 1, 0);
+  NM_dense_display(Qref, NbLines, 1, 0);
 }
 int mlcp_enum_getNbIWork(MixedLinearComplementarityProblem* problem, SolverOptions* options)
 {
@@ -157,367 +90,258 @@ int mlcp_enum_getNbDWork(MixedLinearComplementarityProblem* problem, SolverOptio
   if (!problem)
     return 0;
   assert(problem->M);
-  LWORK = 0;
-  if (options->iparam[4])
-  {
-    LWORK = -1;
-    //int info = 0;
-    double dgelsSize = 0;
-    //DGELS(problem->M->size0, problem->n + problem->m, 1, 0, problem->M->size0, 0, problem->M->size0, &dgelsSize, LWORK, &info);
-    LWORK = (int) dgelsSize;
-  }
-  return LWORK + 3 * (problem->M->size0) + (problem->n + problem->m) * (problem->M->size0); 
+  return 3 * (problem->M->size0) + (problem->n + problem->m) * (problem->M->size0);
 }
 
-/*
- * The are no memory allocation in mlcp_enum, all necessary memory must be allocated by the user.
- *
- *options:
- * dparam[0] : (in) a positive value, tolerane about the sign.
- * dWork : working float zone size : (nn+mm)*(nn+mm) + 3*(nn+mm). MUST BE ALLOCATED BY THE USER.
- * iWork : working int zone size : 2(nn+mm). MUST BE ALLOCATED BY THE USER.
- * double *z : size n+m
- * double *w : size n+m
- */
-void mlcp_enum_Block(MixedLinearComplementarityProblem* problem, double *z, double *w, int *info, SolverOptions* options);
-void mlcp_enum(MixedLinearComplementarityProblem* problem, double *z, double *w, int *info, SolverOptions* options)
+/* solve the linear system of the pattern of key and check that its
+ * solution Q is in the cone. M, Q and ipiv are the working memory of
+ * the thread. indexInBlock is NULL if the problem is not given by blocks.
+ * return 1 if the solution is in the cone, 0 otherwise */
+static int mlcp_enum_solve_pattern(unsigned long long int key, int n, int m, int NbLines,
+                                   double * Mref, double * Qref, double * M, double * Q,
+                                   int * zw, lapack_int * ipiv, int * indexInBlock,
+                                   int useDGELS, double tol)
 {
-  int nbSol = 0;
-  if (problem->blocksRows)
-  {
-    mlcp_enum_Block(problem, z, w, info, options);
-    return;
-  }
-  double tol ;
-  double * workingFloat = options->dWork;
-  int * workingInt = options->iWork;
-  int lin;
-  int npm = (problem->n) + (problem->m);
-  int NRHS = 1;
-  lapack_int * ipiv;
-  int check;
+  int npm = n + m;
   lapack_int LAinfo = 0;
-  *info = 0;
-  sMl = problem->M->size0;
-  sNn = problem->n;
-  sMm = problem->m;
-  int useDGELS = options->iparam[4];
-  /*OUTPUT param*/
-  sW1 = w;
-  sW2 = w + (sMl - problem->m); /*sW2 size :m */
-  sU = z;
-  sV = z + problem->n;
-  tol = options->dparam[0];
-  int itermax = options->iparam[0];
-
-  sMref = problem->M->matrix0;
-  /*  LWORK = 2*npm; LWORK >= max( 1, MN + max( MN, NRHS ) ) where MN = min(M,N)*/
-  //  verbose=1;
   if (verbose)
-    printf("mlcp_enum begin, n %d m %d tol %lf\n", sNn, sMm, tol);
-
-  sM = workingFloat;
-  /*  sQ = sM + npm*npm;*/
-  sQ = sM + (sNn + sMm) * sMl;
-  /*  sColNul = sQ + sMm +sNn;*/
-  sColNul = sQ + sMl;
-  /*  sQref = sColNul + sMm +sNn;*/
-  sQref = sColNul + sMl;
-
-  sDgelsWork = sQref + sMl;
-
-  for (lin = 0; lin < sMl; lin++)
-    sQref[lin] =  - problem->q[lin];
-  for (lin = 0; lin < sMl; lin++)
-    sColNul[lin] = 0;
-  /*  printf("sColNul\n");
-      NM_dense_display(sColNul,npm,1);*/
+    printf("try enum :%llu\n", key);
+  enum_pattern(key, m, zw);
+  if (indexInBlock)
+    mlcp_buildM_Block(zw, M, Mref, n, m, NbLines, indexInBlock);
+  else
+    mlcp_buildM(zw, M, Mref, n, m, NbLines);
+  memcpy(Q, Qref, NbLines * sizeof(double));
   if (verbose)
-    printRefSystem();
-  sW2V = workingInt;
-  ipiv = sW2V + sMm;
-
-  initEnum(problem->m);
-  while (nextEnum(sW2V) && itermax-- > 0)
+    printCurrentSystem(M, Q, n, m, NbLines);
+  if (useDGELS)
   {
-    mlcp_buildM(sW2V, sM, sMref, sNn, sMm, sMl);
-    buildQ();
+    DGELS(LA_NOTRANS, NbLines, npm, 1, M, NbLines, Q, NbLines, &LAinfo);
     if (verbose)
-      printCurrentSystem();
-    if (useDGELS)
     {
-      DGELS(LA_NOTRANS,sMl, npm, NRHS, sM, sMl, sQ, sMl, &LAinfo);
-      if (verbose)
-      {
-        printf("Solution of dgels\n");
-        NM_dense_display(sQ, sMl, 1, 0);
-      }
+      printf("Solution of dgels\n");
+      NM_dense_display(Q, NbLines, 1, 0);
     }
-    else
+  }
+  else
+  {
+    DGESV(npm, 1, M, npm, ipiv, Q, npm, &LAinfo);
+    if (verbose)
     {
-      DGESV(npm, NRHS, sM, npm, ipiv, sQ, npm, &LAinfo);
-      if (verbose)
-      {
-        printf("Solution of dgesv\n");
-        NM_dense_display(sQ, sMl, 1, 0);
-      }
+      printf("Solution of dgesv\n");
+      NM_dense_display(Q, NbLines, 1, 0);
     }
-    if (!LAinfo)
+  }
+  if (LAinfo)
+  {
+    if (verbose)
     {
-      if (useDGELS)
-      {
-        int cc = 0;
-        int ii;
-        double rest = 0;
-        for (ii = 0; ii < npm; ii++)
-        {
-          if (isnan(sQ[ii]) || isinf(sQ[ii]))
-          {
-            printf("DGELS FAILED\n");
-            cc = 1;
-            break;
-          }
-        }
-        if (cc)
-          continue;
-
-        if (sMl > npm)
-        {
-          rest = cblas_dnrm2(sMl - npm, sQ + npm, 1);
-
-          if (rest > tol || isnan(rest) || isinf(rest))
-          {
-            if (verbose)
-              printf("DGELS, optimal point doesn't satisfy AX=b, rest = %e\n", rest);
-            continue;
-          }
-          if (verbose)
-            printf("DGELS, optimal point rest = %e\n", rest);
-        }
-      }
-
-      if (verbose)
-      {
-        printf("Solving linear system success, solution in cone?\n");
-        NM_dense_display(sQ, sMl, 1, 0);
-      }
+      printf("LU factorization failed:\n");
+    }
+    return 0;
+  }
 
-      check = 1;
-      for (lin = 0 ; lin < sMm; lin++)
-      {
-        if (sQ[sNn + lin] < - tol)
-        {
-          check = 0;
-          break;/*out of the cone!*/
-        }
-      }
-      if (!check)
-        continue;
-      else
+  if (useDGELS)
+  {
+    for (int ii = 0; ii < npm; ii++)
+    {
+      if (isnan(Q[ii]) || isinf(Q[ii]))
       {
-        double err;
-        mlcp_fillSolution(sU, sV, sW1, sW2, sNn, sMm, sMl, sW2V, sQ);
-        mlcp_compute_error(problem, z, w, tol, &err);
-        /*because it happens the LU leads to an wrong solution witout raise any error.*/
-        if (err > 10 * tol)
-        {
-          if (verbose)
-            printf("LU no-error, but mlcp_compute_error out of tol: %e!\n", err);
-          continue;
-        }
-        nbSol++;
         if (verbose)
-        {
-          printf("mlcp_enum find a solution, err=%e !\n", err);
-          mlcp_DisplaySolution(sU, sV, sW1, sW2, sNn, sMm, sMl);
-        }
-        // options->iparam[1]=sCurrentEnum-1;
-        return;
+          printf("DGELS FAILED\n");
+        return 0;
       }
     }
-    else
+
+    if (NbLines > npm)
     {
-      if (verbose)
+      double rest = cblas_dnrm2(NbLines - npm, Q + npm, 1);
+
+      if (rest > tol || isnan(rest) || isinf(rest))
       {
-        printf("LU factorization failed:\n");
+        if (verbose)
+          printf("DGELS, optimal point doesn't satisfy AX=b, rest = %e\n", rest);
+        return 0;
       }
+      if (verbose)
+        printf("DGELS, optimal point rest = %e\n", rest);
     }
   }
-  *info = 1;
+
   if (verbose)
-    printf("mlcp_enum failed nbSol=%i!\n", nbSol);
+  {
+    printf("Solving linear system success, solution in cone?\n");
+    NM_dense_display(Q, NbLines, 1, 0);
+  }
+
+  for (int lin = 0 ; lin < m; lin++)
+  {
+    if (Q[indexInBlock ? indexInBlock[lin] : n + lin] < - tol)
+      return 0; /*out of the cone!*/
+  }
+  return 1;
 }
+
 /*
-An adaptation of the previuos algorithm, to manage the case of MLCP-block formalization
+ * The are no memory allocation in mlcp_enum, all necessary memory must be allocated by the user.
+ *
+ *options:
+ * iparam[0] : (in) maximum number of patterns tried.
+ * iparam[1] : (out) key of the pattern of the solution.
+ * iparam[3] : (in/out) key of the first pattern tried, set to the key of the solution
+ *             so that the next call starts from it.
+ * iparam[4] : (in) use DGELS (1) or DGESV (0).
+ * iparam[6] : (in) number of threads (0 : OpenMP default).
+ * dparam[0] : (in) a positive value, tolerane about the sign.
+ * dWork : working float zone size : (nn+mm)*(nn+mm) + 3*(nn+mm). MUST BE ALLOCATED BY THE USER.
+ * iWork : working int zone size : 2(nn+mm). MUST BE ALLOCATED BY THE USER.
+ * double *z : size n+m
+ * double *w : size n+m
  */
-void mlcp_enum_Block(MixedLinearComplementarityProblem* problem, double *z, double *w, int *info, SolverOptions* options)
+void mlcp_enum(MixedLinearComplementarityProblem* problem, double *z, double *w, int *info, SolverOptions* options)
 {
-  double tol ;
-  double * workingFloat = options->dWork;
-  int * workingInt = options->iWork;
-  int lin;
-  int npm = (problem->n) + (problem->m);
-  int NRHS = 1;
-  lapack_int * ipiv;
-  int * indexInBlock;
-  int check;
-  lapack_int LAinfo = 0;
-  int useDGELS = options->iparam[4];
-  *info = 0;
   assert(problem->M);
   assert(problem->M->matrix0);
   assert(problem->q);
+  int * iparam = options->iparam;
+  int NbLines = problem->M->size0;
+  int n = problem->n;
+  int m = problem->m;
+  int npm = n + m;
+  double tol = options->dparam[0];
+  int useDGELS = iparam[SICONOS_MLCP_IPARAM_ENUM_USE_DGELS];
+  int itermax = iparam[0];
+  double * Mref = problem->M->matrix0;
 
-
-
-  sMl = problem->M->size0;
-  sNn = problem->n;
-  sMm = problem->m;
-
-  /*OUTPUT param*/
-  sW1 = w;
-  /*sW2=w+(sMl-problem->m); sW2 size :m */
-  sU = z;
-  tol = options->dparam[0];
-  int itermax = options->iparam[0];
-
-  sMref = problem->M->matrix0;
-  /*  LWORK = 2*npm; LWORK >= max( 1, MN + max( MN, NRHS ) ) where MN = min(M,N)*/
-  //  verbose=1;
   if (verbose)
-    printf("mlcp_enum begin, n %d m %d tol %lf\n", sNn, sMm, tol);
+    printf("mlcp_enum begin, n %d m %d tol %lf\n", n, m, tol);
 
-  sM = workingFloat;
-  /*  sQ = sM + npm*npm;*/
-  sQ = sM + (sNn + sMm) * sMl;
-  /*  sColNul = sQ + sMm +sNn;*/
-  sColNul = sQ + sMl;
-  /*  sQref = sColNul + sMm +sNn;*/
-  sQref = sColNul + sMl;
-
-  sDgelsWork = sQref + sMl;
-
-  for (lin = 0; lin < sMl; lin++)
-    sQref[lin] =  - problem->q[lin];
-  for (lin = 0; lin < sMl; lin++)
-    sColNul[lin] = 0;
-
-  /*  printf("sColNul\n");
-      NM_dense_display(sColNul,npm,1);*/
+  /* working memory of the first thread: M, Q, (unused), Qref */
+  double * Qref = options->dWork + npm * NbLines + 2 * NbLines;
+  for (int lin = 0; lin < NbLines; lin++)
+    Qref[lin] =  - problem->q[lin];
   if (verbose)
-    printRefSystem();
-  sW2V = workingInt;
-  ipiv = sW2V + sMm;
-  indexInBlock = ipiv + sMm + sNn;
-  if (sMm == 0)
-    indexInBlock = 0;
-  *info = 0;
-  mlcp_buildIndexInBlock(problem, indexInBlock);
-  initEnum(problem->m);
-  while (nextEnum(sW2V) && itermax-- > 0)
+    printRefSystem(Mref, Qref, n, m, NbLines);
+
+  /* the index of the complementarity rows: W2V (m), ipiv (n+m), indexInBlock (m) */
+  int * indexInBlock = NULL;
+  if (problem->blocksRows && m > 0)
   {
-    mlcp_buildM_Block(sW2V, sM, sMref, sNn, sMm, sMl, indexInBlock);
-    buildQ();
-    if (verbose)
-      printCurrentSystem();
-    if (useDGELS)
+    indexInBlock = options->iWork + m + npm;
+    mlcp_buildIndexInBlock(problem, indexInBlock);
+  }
+  /* length of z written by the fill of the solution */
+  int zSize = indexInBlock ? NbLines : npm;
+
+  int nthreads = 1;
+  if (options->iSize > SICONOS_MLCP_IPARAM_ENUM_NUMBER_OF_THREADS)
+    nthreads = enum_number_of_threads(iparam[SICONOS_MLCP_IPARAM_ENUM_NUMBER_OF_THREADS]);
+
+  /* the patterns are tried from the one of the seed key, and the solution
+   * is the first one found in this order, whatever the number of threads */
+  unsigned long long int nbCase = enum_nb_patterns(m);
+  unsigned long long int seed = (unsigned long long int) iparam[SICONOS_MLCP_IPARAM_ENUM_SEED];
+  if (seed >= nbCase)
+    seed = 0;
+  long long int nbTries = (long long int) nbCase;
+  if (itermax < nbTries)
+    nbTries = itermax < 0 ? 0 : itermax;
+  /* rank of the first solution found */
+  unsigned long long int found = nbCase;
+
+#pragma omp parallel num_threads(nthreads) if(nthreads > 1)
+  {
+    int tid = 0;
+#ifdef _OPENMP
+    tid = omp_get_thread_num();
+#endif
+    double * M = options->dWork;
+    int * zw = options->iWork;
+    double * zt = z;
+    double * wt = w;
+    if (tid > 0)
     {
-      DGELS(LA_NOTRANS,sMl, npm, NRHS, sM, sMl, sQ, sMl,&LAinfo);
-      if (verbose)
-      {
-        printf("Solution of dgels\n");
-        NM_dense_display(sQ, sMl, 1, 0);
-      }
+      M = (double *) malloc((npm * NbLines + NbLines) * sizeof(double));
+      zw = (int *) malloc((m + npm) * sizeof(int));
     }
-    else
+    if (nthreads > 1)
     {
-      DGESV(npm, NRHS, sM, npm, ipiv, sQ, npm, &LAinfo);
-      if (verbose)
-      {
-        printf("Solution of dgesv\n");
-        NM_dense_display(sQ, sMl, 1, 0);
-      }
+      /* the candidate solutions are checked in private vectors */
+      zt = (double *) malloc(zSize * sizeof(double));
+      wt = (double *) malloc(NbLines * sizeof(double));
     }
-    if (!LAinfo)
-    {
-      if (useDGELS)
-      {
-        int cc = 0;
-        int ii;
-        double rest = 0;
-        for (ii = 0; ii < npm; ii++)
-        {
-          if (isnan(sQ[ii]) || isinf(sQ[ii]))
-          {
-            printf("DGELS FAILED\n");
-            cc = 1;
-            break;
-          }
-        }
-        if (cc)
-          continue;
+    double * Q = M + npm * NbLines;
+    lapack_int * ipiv = zw + m;
 
-        if (sMl > npm)
-        {
-          rest = cblas_dnrm2(sMl - npm, sQ + npm, 1);
-
-          if (rest > tol || isnan(rest) || isinf(rest))
-          {
-            if (verbose)
-              printf("DGELS, optimal point doesn't satisfy AX=b, rest = %e\n", rest);
-            continue;
-          }
-          if (verbose)
-            printf("DGELS, optimal point rest = %e\n", rest);
-        }
-      }
+#pragma omp for schedule(dynamic, MLCP_ENUM_CHUNK)
+    for (long long int r = 0; r < nbTries; r++)
+    {
+      unsigned long long int first;
+#pragma omp atomic read
+      first = found;
+      if ((unsigned long long int) r > first)
+        continue; /* a solution has already been found before this pattern */
+
+      unsigned long long int key = (seed + r) % nbCase;
+      if (!mlcp_enum_solve_pattern(key, n, m, NbLines, Mref, Qref, M, Q, zw, ipiv,
+                                   indexInBlock, useDGELS, tol))
+        continue;
 
-      if (verbose)
+      double err;
+      if (indexInBlock)
+        mlcp_fillSolution_Block(zt, wt, n, m, NbLines, zw, Q, indexInBlock);
+      else
+        mlcp_fillSolution(zt, zt + n, wt, wt + (NbLines - m), n, m, NbLines, zw, Q);
+      mlcp_compute_error(problem, zt, wt, tol, &err);
+      /*because it happens the LU leads to an wrong solution witout raise any error.*/
+      if (err > 10 * tol)
       {
-        printf("Solving linear system success, solution in cone?\n");
-        NM_dense_display(sQ, sMl, 1, 0);
+        if (verbose)
+          printf("LU no-error, but mlcp_compute_error out of tol: %e!\n", err);
+        continue;
       }
 
-      check = 1;
-      for (lin = 0 ; lin < sMm; lin++)
+#pragma omp critical(mlcp_enum_solution)
+      if ((unsigned long long int) r < found)
       {
-        if (sQ[indexInBlock[lin]] < - tol)
+        if (zt != z)
         {
-          check = 0;
-          break;/*out of the cone!*/
-        }
-      }
-      if (!check)
-        continue;
-      else
-      {
-        double err;
-        mlcp_fillSolution_Block(sU, sW1, sNn, sMm, sMl, sW2V, sQ, indexInBlock);
-        mlcp_compute_error(problem, z, w, tol, &err);
-        /*because it happens the LU leads to an wrong solution witout raise any error.*/
-        if (err > 10 * tol)
-        {
-          if (verbose)
-            printf("LU no-error, but mlcp_compute_error out of tol: %e!\n", err);
-          continue;
+          memcpy(z, zt, zSize * sizeof(double));
+          memcpy(w, wt, NbLines * sizeof(double));
         }
+        iparam[SICONOS_MLCP_IPARAM_ENUM_KEY] = (int) key;
+#pragma omp atomic write
+        found = r;
         if (verbose)
         {
-          printf("mlcp_enum find a solution err = %e!\n", err);
-          mlcp_DisplaySolution_Block(sU, sW1, sNn, sMm, sMl, indexInBlock);
+          printf("mlcp_enum find a solution, err=%e !\n", err);
+          if (indexInBlock)
+            mlcp_DisplaySolution_Block(z, w, n, m, NbLines, indexInBlock);
+          else
+            mlcp_DisplaySolution(z, z + n, w, w + (NbLines - m), n, m, NbLines);
         }
-        // options->iparam[1]=sCurrentEnum-1;
-        return;
       }
     }
-    else
+
+    if (tid > 0)
+    {
+      free(M);
+      free(zw);
+    }
+    if (nthreads > 1)
     {
-      if (verbose)
-      {
-        printf("LU factorization failed:\n");
-      }
+      free(zt);
+      free(wt);
     }
   }
+
+  if (found < nbCase)
+  {
+    /* the next call starts from the pattern of this solution */
+    iparam[SICONOS_MLCP_IPARAM_ENUM_SEED] = iparam[SICONOS_MLCP_IPARAM_ENUM_KEY];
+    *info = 0;
+    return;
+  }
   *info = 1;
   if (verbose)
     printf("mlcp_enum failed!\n");
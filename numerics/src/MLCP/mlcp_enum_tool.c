@@ -20,63 +20,31 @@
 #include <stdio.h>
 #include "numerics_verbose.h"
 
-static unsigned long long int sCurrentEnum = 0;
-static unsigned long long int sCmpEnum = 0;
-static unsigned long long int sNbCase = 0;
-static double sProgress = 0;
-static int sMm = 0;
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
-static void affectW2V(int * W2V);
-
-void initEnum(int M)
+unsigned long long int enum_nb_patterns(int m)
 {
-  int cmp;
-  /*  sCurrentEnum = 0;*/
-
-  sCmpEnum = 0;
-  sNbCase = 1;
-  sMm = M;
-
-  for (cmp = 0; cmp < sMm; cmp++)
-    sNbCase = sNbCase << 1;
-  sProgress = 0;
+  return 1ULL << m;
 }
 
-void affectW2V(int * W2V)
+void enum_pattern(unsigned long long int key, int m, int * zw)
 {
-  unsigned long  int aux = sCurrentEnum;
-  for (int i = 0; i < sMm; i++)
+  for (int i = 0; i < m; i++)
   {
-    W2V[i] = aux & 1;
-    aux = aux >> 1;
+    zw[i] = key & 1;
+    key = key >> 1;
   }
-  if (verbose)
-  {
-    for (int i = 0; i < sMm; i++)
-      printf("wv[%d]=%d \t", i, W2V[i]);
-    printf("\n");
-  }
-
 }
 
-int nextEnum(int * W2V)
+int enum_number_of_threads(int nthreads)
 {
-  if (sCmpEnum == sNbCase)
-    return 0;
-  if (sCurrentEnum >= sNbCase)
-  {
-    sCurrentEnum = 0;
-  }
-  if (verbose)
-    printf("try enum :%d\n", (int)sCurrentEnum);
-  affectW2V(W2V);
-  sCurrentEnum++;
-  sCmpEnum++;
-  if (verbose && sCmpEnum > (unsigned long int)sProgress * sNbCase)
-  {
-    sProgress += 0.001;
-    printf(" progress %f %d \n", sProgress, (int) sCurrentEnum);
-  }
-
+#ifdef _OPENMP
+  if (nthreads <= 0)
+    nthreads = omp_get_max_threads();
+  return nthreads;
+#else
   return 1;
+#endif
 }
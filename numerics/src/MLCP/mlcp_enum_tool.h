@@ -1,9 +1,27 @@
-
 #ifndef MLCP_ENUM_TOOL_H
 #define MLCP_ENUM_TOOL_H
 
+/* Enumeration of the complementarity patterns of lcp_enum and mlcp_enum.
+ * A pattern of m complementarity conditions is given by a key in
+ * [0, 2^m[: the bit i of the key selects which one of the variables i
+ * is null. These functions have no state, so that several enumerations
+ * may run concurrently. */
+
+/** \param m number of complementarity conditions
+ * \return the number of patterns, 2^m */
+unsigned long long int enum_nb_patterns(int m);
+
+/** fill the pattern of a key
+ * \param key the key of the pattern
+ * \param m number of complementarity conditions
+ * \param[out] zw zw[i] is the bit i of key
+ */
+void enum_pattern(unsigned long long int key, int m, int * zw);
 
-void initEnum(int M);
-int nextEnum(int * W2V);
+/** \param nthreads the number of threads requested in the solver
+ * options, 0 for the OpenMP default
+ * \return the number of threads used by the enumeration (1 without OpenMP)
+ */
+int enum_number_of_threads(int nthreads);
 
-#endif //MLCP_ENUM_H
+#endif //MLCP_ENUM_TOOL_H
@@ -17,6 +17,6 @@ int mlcp_path_enum_getNbIWork(MixedLinearComplementarityProblem* problem, Solver
 int mlcp_path_enum_getNbDWork(MixedLinearComplementarityProblem* problem, SolverOptions* options);
 
 void mlcp_path_enum_init(MixedLinearComplementarityProblem* problem, SolverOptions* options);
-void mlcp_path_enum_reset(void);
+void mlcp_path_enum_reset(MixedLinearComplementarityProblem* problem, SolverOptions* options);
 void mlcp_path_enum(MixedLinearComplementarityProblem* problem, double *z, double *w, int *info, SolverOptions* options);
 #endif //MLCP_PATH_ENUM_H
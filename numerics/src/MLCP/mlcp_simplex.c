@@ -38,6 +38,8 @@ dim(v)=nn
 /*import external implementation*/
 #include "external_mlcp_simplex.h"
 
+/* the external simplex solver has a single instance: mlcp_simplex is not
+ * reentrant */
 static int sIsInitialize = 0;
 #endif
 
@@ -58,7 +60,7 @@ void mlcp_simplex_init(MixedLinearComplementarityProblem* problem, SolverOptions
   sIsInitialize = 1;
 #endif
 }
-void mlcp_simplex_reset()
+void mlcp_simplex_reset(MixedLinearComplementarityProblem* problem, SolverOptions* options)
 {
 #ifdef HAVE_MLCPSIMPLEX
   extern_mlcp_simplex_stop();
@@ -7,6 +7,6 @@
 
 
 void mlcp_simplex_init(MixedLinearComplementarityProblem* problem, SolverOptions* options);
-void mlcp_simplex_reset(void);
+void mlcp_simplex_reset(MixedLinearComplementarityProblem* problem, SolverOptions* options);
 
 #endif //MLCP_SIMPLEX_H
@@ -0,0 +1,150 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/* mlcp_direct keeps the configurations of the solutions found by mlcp_enum
+ * with their LU factors: a problem solved again must be solved from the
+ * cache, without factorization. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "NumericsMatrix.h"
+#include "MixedLinearComplementarityProblem.h"
+#include "MLCP_Solvers.h"
+#include "mlcp_cst.h"
+#include "SolverOptions.h"
+
+#define NB_PROBLEMS 4
+
+static const char * const filenames[NB_PROBLEMS] =
+{
+  "./data/deudeu_mlcp.dat",
+  "./data/RLCD_mlcp.dat",
+  "./data/BuckConverter_mlcp.dat",
+  "./data/m3n2_mlcp.dat"
+};
+
+static int testProblem(MixedLinearComplementarityProblem* problem)
+{
+  int info = 0;
+  int info_copy = 0;
+  int size = problem->M->size0;
+  double * z = (double *) calloc(size, sizeof(double));
+  double * w = (double *) calloc(size, sizeof(double));
+  double * z0 = (double *) calloc(size, sizeof(double));
+  SolverOptions options;
+  SolverOptions copy = {0};
+  options.solverId = SICONOS_MLCP_DIRECT_ENUM;
+  mixedLinearComplementarity_setDefaultSolverOptions(problem, &options);
+  options.iparam[0] = 1 << 20;
+  options.dparam[0] = 1e-10;
+  options.iWorkSize = mlcp_driver_get_iwork(problem, &options);
+  options.dWorkSize = mlcp_driver_get_dwork(problem, &options);
+  mlcp_driver_init(problem, &options);
+
+  /* the first call is solved by mlcp_enum */
+  mlcp_direct_enum(problem, z0, w, &info, &options);
+  if (info)
+  {
+    printf("no solution found\n");
+    goto exit;
+  }
+
+  /* the configuration of the solution is in the cache, factorized once */
+  for (int k = 0; k < 3; k++)
+  {
+    mlcp_direct_enum(problem, z, w, &info, &options);
+    for (int i = 0; i < size; i++)
+      if (fabs(z[i] - z0[i]) > 1e-8 * (1.0 + fabs(z0[i])))
+        info = 1;
+  }
+  printf("hits = %i, solves = %i, factorizations = %i, failures = %i\n",
+         options.iparam[SICONOS_MLCP_IPARAM_DIRECT_NUMBER_OF_HITS],
+         options.iparam[SICONOS_MLCP_IPARAM_DIRECT_NUMBER_OF_SOLVES],
+         options.iparam[SICONOS_MLCP_IPARAM_DIRECT_NUMBER_OF_FACTORIZATIONS],
+         options.iparam[SICONOS_MLCP_IPARAM_DIRECT_NUMBER_OF_FAILURES]);
+  if (info || options.iparam[SICONOS_MLCP_IPARAM_DIRECT_NUMBER_OF_HITS] != 3
+      || options.iparam[SICONOS_MLCP_IPARAM_DIRECT_NUMBER_OF_FACTORIZATIONS] != 1)
+  {
+    printf("the solution is not found from the cache\n");
+    info = 1;
+    goto exit;
+  }
+
+  /* a changed problem: the configuration is factorized again */
+  options.iparam[SICONOS_MLCP_IPARAM_DIRECT_PROBLEM_CHANGED] = 1;
+  mlcp_direct_enum(problem, z, w, &info, &options);
+  if (info || options.iparam[SICONOS_MLCP_IPARAM_DIRECT_NUMBER_OF_HITS] != 4
+      || options.iparam[SICONOS_MLCP_IPARAM_DIRECT_NUMBER_OF_FACTORIZATIONS] != 2)
+  {
+    printf("the configuration is not factorized again\n");
+    info = 1;
+    goto exit;
+  }
+
+  /* a copy of the options gets its own state: deleting it leaves the cache
+   * of the original options untouched */
+  solver_options_copy(&options, &copy);
+  if (copy.solverData)
+  {
+    printf("the copy shares the state of the solver\n");
+    info = 1;
+  }
+  mlcp_driver_init(problem, &copy);
+  mlcp_direct_enum(problem, z, w, &info_copy, &copy);
+  mlcp_driver_reset(problem, &copy);
+  solver_options_delete(&copy);
+
+  options.iparam[SICONOS_MLCP_IPARAM_DIRECT_PROBLEM_CHANGED] = 0;
+  mlcp_direct_enum(problem, z, w, &info, &options);
+  if (info || info_copy || options.iparam[SICONOS_MLCP_IPARAM_DIRECT_NUMBER_OF_HITS] != 5)
+  {
+    printf("the cache is lost after the deletion of a copy\n");
+    info = 1;
+  }
+
+exit:
+  mlcp_driver_reset(problem, &options);
+  mixedLinearComplementarity_deleteDefaultSolverOptions(problem, &options);
+  free(z);
+  free(w);
+  free(z0);
+  return info;
+}
+
+int main(void)
+{
+  int info = 0;
+  for (int i = 0; i < NB_PROBLEMS; ++i)
+  {
+    FILE * finput = fopen(filenames[i], "r");
+    if (!finput)
+    {
+      printf("Error! Could not read %s\n", filenames[i]);
+      return 1;
+    }
+    MixedLinearComplementarityProblem * problem = (MixedLinearComplementarityProblem *) malloc(sizeof(MixedLinearComplementarityProblem));
+    mixedLinearComplementarity_newFromFile(problem, finput);
+    fclose(finput);
+    printf("%s: ", filenames[i]);
+    if (testProblem(problem))
+      info = 1;
+    freeMixedLinearComplementarityProblem(problem);
+  }
+  return info;
+}
@@ -0,0 +1,133 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/* mlcp_enum with several threads must find the same solution as the
+ * sequential enumeration, and several mlcp_enum must run concurrently. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "NumericsMatrix.h"
+#include "MixedLinearComplementarityProblem.h"
+#include "MLCP_Solvers.h"
+#include "mlcp_cst.h"
+#include "SolverOptions.h"
+
+#define NB_PROBLEMS 5
+
+static const char * const filenames[NB_PROBLEMS] =
+{
+  "./data/deudeu_mlcp.dat",
+  "./data/RLCD_mlcp.dat",
+  "./data/BuckConverter_mlcp.dat",
+  "./data/diodeBridge_mlcp.dat",
+  "./data/m3n2_mlcp.dat"
+};
+
+static int solve(MixedLinearComplementarityProblem* problem, int nthreads, double* z, double* w, int* key)
+{
+  SolverOptions options;
+  int info;
+  options.solverId = SICONOS_MLCP_ENUM;
+  mixedLinearComplementarity_setDefaultSolverOptions(problem, &options);
+  options.iparam[SICONOS_MLCP_IPARAM_ENUM_NUMBER_OF_THREADS] = nthreads;
+  /* all the patterns may be tried */
+  options.iparam[0] = 1 << 20;
+  mlcp_enum(problem, z, w, &info, &options);
+  *key = options.iparam[SICONOS_MLCP_IPARAM_ENUM_KEY];
+  mixedLinearComplementarity_deleteDefaultSolverOptions(problem, &options);
+  return info;
+}
+
+int main(void)
+{
+  int info = 0;
+  MixedLinearComplementarityProblem * problems[NB_PROBLEMS];
+  double * z[NB_PROBLEMS];
+  double * w[NB_PROBLEMS];
+  int key[NB_PROBLEMS];
+  int solved[NB_PROBLEMS];
+
+  for (int i = 0; i < NB_PROBLEMS; ++i)
+  {
+    FILE * finput = fopen(filenames[i], "r");
+    if (!finput)
+    {
+      printf("Error! Could not read %s\n", filenames[i]);
+      return 1;
+    }
+    problems[i] = (MixedLinearComplementarityProblem *) malloc(sizeof(MixedLinearComplementarityProblem));
+    mixedLinearComplementarity_newFromFile(problems[i], finput);
+    fclose(finput);
+    int size = problems[i]->M->size0;
+    z[i] = (double *) calloc(size, sizeof(double));
+    w[i] = (double *) calloc(size, sizeof(double));
+    solved[i] = solve(problems[i], 1, z[i], w[i], &key[i]);
+    printf("%s: n = %i, m = %i, info = %i, key = %i\n", filenames[i],
+           problems[i]->n, problems[i]->m, solved[i], key[i]);
+  }
+
+  /* the same solution with several threads */
+  for (int i = 0; i < NB_PROBLEMS; ++i)
+  {
+    int size = problems[i]->M->size0;
+    double * zt = (double *) calloc(size, sizeof(double));
+    double * wt = (double *) calloc(size, sizeof(double));
+    int keyt;
+    int infot = solve(problems[i], 4, zt, wt, &keyt);
+    if (infot != solved[i] || (!infot && (keyt != key[i]
+                                          || memcmp(zt, z[i], size * sizeof(double))
+                                          || memcmp(wt, w[i], size * sizeof(double)))))
+    {
+      printf("%s: 4 threads, info = %i, key = %i, not the sequential solution\n", filenames[i], infot, keyt);
+      info = 1;
+    }
+    free(zt);
+    free(wt);
+  }
+
+  /* concurrent calls */
+  int failed = 0;
+#pragma omp parallel for reduction(+:failed)
+  for (int i = 0; i < NB_PROBLEMS; ++i)
+  {
+    int size = problems[i]->M->size0;
+    double * zt = (double *) calloc(size, sizeof(double));
+    double * wt = (double *) calloc(size, sizeof(double));
+    int keyt;
+    int infot = solve(problems[i], 1, zt, wt, &keyt);
+    if (infot != solved[i] || (!infot && (keyt != key[i]
+                                          || memcmp(zt, z[i], size * sizeof(double)))))
+      failed++;
+    free(zt);
+    free(wt);
+  }
+  if (failed)
+  {
+    printf("concurrent calls of mlcp_enum: %i wrong solutions\n", failed);
+    info = 1;
+  }
+
+  for (int i = 0; i < NB_PROBLEMS; ++i)
+  {
+    free(z[i]);
+    free(w[i]);
+    freeMixedLinearComplementarityProblem(problems[i]);
+  }
+  return info;
+}
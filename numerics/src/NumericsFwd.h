@@ -32,6 +32,7 @@ TYPEDEF_STRUCT(NSM_linear_solver_params)
 TYPEDEF_STRUCT(SparseBlockStructuredMatrix)
 TYPEDEF_STRUCT(SparseBlockStructuredMatrixPred)
 TYPEDEF_STRUCT(SparseBlockCoordinateMatrix)
+TYPEDEF_STRUCT(NumericsMatrixOperator)
 
 // Nonsmooth solvers
 TYPEDEF_STRUCT(SolverOptions)
@@ -199,6 +199,10 @@ void convexQP_ADMM(ConvexQP* problem,
     Atrans = NM_transpose(A);
     NM_gemm(rho, Atrans, A, 1.0, W);
   }
+  /* W is symmetric positive definite if M is symmetric: Cholesky factorization */
+  int symmetry = options->iparam[SICONOS_CONVEXQP_ADMM_IPARAM_SYMMETRY];
+  NM_set_symmetric(W, symmetry == SICONOS_CONVEXQP_ADMM_ASSUME_SYMMETRY
+                   || (symmetry == SICONOS_CONVEXQP_ADMM_CHECK_SYMMETRY && NM_is_symmetric(M)));
 
 
   if (accelerated == SICONOS_CONVEXQP_ADMM_NO_ACCELERATION)
@@ -534,6 +538,7 @@ int convexQP_ADMM_setDefaultSolverOptions(SolverOptions* options)
 
   options->iparam[SICONOS_IPARAM_MAX_ITER] = 20000;
   options->iparam[SICONOS_CONVEXQP_ADMM_IPARAM_ACCELERATION] = SICONOS_CONVEXQP_ADMM_ACCELERATION_AND_RESTART; /* 0 Acceleration */
+  options->iparam[SICONOS_CONVEXQP_ADMM_IPARAM_SYMMETRY] = SICONOS_CONVEXQP_ADMM_ASSUME_SYMMETRY;
 
 
   options->dparam[SICONOS_DPARAM_TOL] = 1e-6;
@@ -30,6 +30,7 @@
 #include <math.h>
 #include <string.h>
 #include "ConvexQP_cst.h"
+#include "fixed_point_acceleration.h"
 #include "numerics_verbose.h"
 
 #include "debug.h"
@@ -111,6 +112,9 @@ void convexQP_ProjectedGradient(ConvexQP* problem, double *z, double *w, int* in
   double alpha = 1.0;
   double beta = 1.0;
 
+  FixedPointAcceleration* acc = fixed_point_acceleration_new(n, options, z,
+                                                             problem->ProjectionOnC, problem);
+
   if (!isVariable)
   {
     double minusrho  = -1.0*rho;
@@ -139,6 +143,9 @@ void convexQP_ProjectedGradient(ConvexQP* problem, double *z, double *w, int* in
 
       if (error < tolerance) hasNotConverged = 0;
       *info = hasNotConverged;
+
+      if (acc && hasNotConverged && iter < itermax)
+        fixed_point_acceleration_update(acc, z, error);
     }
   }
   else
@@ -255,6 +262,18 @@ void convexQP_ProjectedGradient(ConvexQP* problem, double *z, double *w, int* in
       }
       if (error < tolerance) hasNotConverged = 0;
       *info = hasNotConverged;
+
+      if (acc && hasNotConverged && iter < itermax)
+      {
+        fixed_point_acceleration_update(acc, z, error);
+        /* the next line search starts from the accelerated point */
+        cblas_dcopy(n , z , 1 , z_k , 1);
+        cblas_dcopy(n , q , 1 , w_k, 1);
+        NM_gemv(1.0, M, z, 1.0, w_k);
+        cblas_dcopy(n , w_k , 1 , w, 1);
+        cblas_daxpy(n, 1.0, q, 1, w, 1);
+        theta_k = 0.5*cblas_ddot(n, z, 1, w, 1);
+      }
     }
   }
 
@@ -267,6 +286,7 @@ void convexQP_ProjectedGradient(ConvexQP* problem, double *z, double *w, int* in
   iparam[SICONOS_IPARAM_ITER_DONE] = iter;
 
   free(z_tmp);
+  fixed_point_acceleration_free(acc);
   if (isVariable)
   {
     free(z_k);
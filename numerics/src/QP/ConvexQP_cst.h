@@ -41,8 +41,9 @@ enum SICONOS_CONVEXQP_ADMM_IPARAM_ENUM
   /** index in iparam to store the strategy for computing rho */
   SICONOS_CONVEXQP_ADMM_IPARAM_RHO_STRATEGY = 9,
   /** index in iparam to store the acceleration paramter */
-  SICONOS_CONVEXQP_ADMM_IPARAM_ACCELERATION= 10
-
+  SICONOS_CONVEXQP_ADMM_IPARAM_ACCELERATION= 10,
+  /** index in iparam to store the symmetry assumption on M */
+  SICONOS_CONVEXQP_ADMM_IPARAM_SYMMETRY= 11
 };
 
 enum SICONOS_CONVEXQP_ADMM_DPARAM_ENUM
@@ -60,6 +61,18 @@ enum SICONOS_CONVEXQP_ADMM_ACCELERATION_ENUM
   SICONOS_CONVEXQP_ADMM_ACCELERATION_AND_RESTART= 2
 };
 
+enum SICONOS_CONVEXQP_ADMM_SYMMETRY_ENUM
+{
+  /** the symmetry of M is checked: Cholesky factorization if M is
+   * symmetric, LU factorization otherwise */
+  SICONOS_CONVEXQP_ADMM_CHECK_SYMMETRY= 0,
+  /** M is assumed to be symmetric: Cholesky factorization, with a
+   * fallback to LU if it fails */
+  SICONOS_CONVEXQP_ADMM_ASSUME_SYMMETRY= 1,
+  /** M may be unsymmetric: LU factorization */
+  SICONOS_CONVEXQP_ADMM_ASSUME_NO_SYMMETRY= 2
+};
+
 enum SICONOS_CONVEXQP_RHO_STRATEGY_ENUM
 {
   /** A constant value given in dparam[CONVEXQP_RHO_RHO] is used */
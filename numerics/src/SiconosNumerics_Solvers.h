@@ -96,6 +96,8 @@ SICONOS_SOLVER_MACRO(SICONOS_FRICTION_2D_ENUM);\
 SICONOS_SOLVER_MACRO(SICONOS_FRICTION_2D_LEMKE);\
 SICONOS_SOLVER_MACRO(SICONOS_FRICTION_3D_NSGS);\
 SICONOS_SOLVER_MACRO(SICONOS_FRICTION_3D_NSGSV);\
+SICONOS_SOLVER_MACRO(SICONOS_FRICTION_3D_NSGS_OPENMP);\
+SICONOS_SOLVER_MACRO(SICONOS_FRICTION_3D_BLOCK_JACOBI);\
 SICONOS_SOLVER_MACRO(SICONOS_FRICTION_3D_PROX);\
 SICONOS_SOLVER_MACRO(SICONOS_FRICTION_3D_TFP);\
 SICONOS_SOLVER_MACRO(SICONOS_FRICTION_3D_PFP);\
@@ -128,6 +130,7 @@ SICONOS_SOLVER_MACRO(SICONOS_FRICTION_3D_GAMS_LCP_PATH);\
 SICONOS_SOLVER_MACRO(SICONOS_FRICTION_3D_GAMS_LCP_PATHVI);\
 SICONOS_SOLVER_MACRO(SICONOS_FRICTION_3D_SOCLCP);\
 SICONOS_SOLVER_MACRO(SICONOS_FRICTION_3D_ACLMFP);\
+SICONOS_SOLVER_MACRO(SICONOS_FRICTION_3D_ADMM);\
 SICONOS_SOLVER_MACRO(SICONOS_FRICTION_3D_ONECONTACT_QUARTIC);\
 SICONOS_SOLVER_MACRO(SICONOS_FRICTION_3D_ONECONTACT_QUARTIC_NU);\
 SICONOS_SOLVER_MACRO(SICONOS_GLOBAL_FRICTION_3D_NSGS_WR);\
@@ -19,6 +19,7 @@
 #include "VariationalInequality_Solvers.h"
 #include "VariationalInequality_computeError.h"
 #include "SiconosBlas.h"
+#include "fixed_point_acceleration.h"
 
 #include <float.h>
 #include <stdio.h>
@@ -182,6 +183,9 @@ void variationalInequality_ExtraGradient(VariationalInequality* problem, double
   }
   /* memcpy(x,x_k,n * sizeof(double)); */
   /* memcpy(w,w_k,n * sizeof(double)); */
+  FixedPointAcceleration* acc = fixed_point_acceleration_new(n, options, x,
+                                                             problem->ProjectionOnX, problem);
+
   //isVariable=0;
   if (!isVariable)
   {
@@ -237,6 +241,9 @@ void variationalInequality_ExtraGradient(VariationalInequality* problem, double
                                         error, NULL);
       }
 
+      if (acc && hasNotConverged && iter < itermax)
+        fixed_point_acceleration_update(acc, x, error);
+
 
 
 
@@ -334,6 +341,9 @@ void variationalInequality_ExtraGradient(VariationalInequality* problem, double
         hasNotConverged = determine_convergence(error, &tolerance, iter, options,
                                                 problem, x, w, rho);
 
+        if (acc && hasNotConverged && iter < itermax)
+          fixed_point_acceleration_update(acc, x, error);
+
         DEBUG_PRINTF("error = %12.8e\t error_k = %12.8e\n",error,error_k);
         /*Update rho*/
         if ((rho_k*a1 < Lmin * a2))
@@ -438,6 +448,9 @@ void variationalInequality_ExtraGradient(VariationalInequality* problem, double
         hasNotConverged = determine_convergence(error, &tolerance, iter, options,
                                                 problem, x, w, rho);
 
+        if (acc && hasNotConverged && iter < itermax)
+          fixed_point_acceleration_update(acc, x, error);
+
 
 
 
@@ -471,6 +484,7 @@ void variationalInequality_ExtraGradient(VariationalInequality* problem, double
   iparam[SICONOS_IPARAM_ITER_DONE] = iter;
   free(xtmp);
   free(wtmp);
+  fixed_point_acceleration_free(acc);
   DEBUG_END("variationalInequality_ExtraGradient(VariationalInequality* problem, ...)\n")
 
 }
@@ -488,8 +502,8 @@ int variationalInequality_ExtraGradient_setDefaultSolverOptions(SolverOptions* o
   options->numberOfInternalSolvers = 0;
   options->isSet = 1;
   options->filterOn = 1;
-  options->iSize = 10;
-  options->dSize = 10;
+  options->iSize = 14;
+  options->dSize = 14;
   options->iparam = (int *)calloc(options->iSize,sizeof(int));
   options->dparam = (double *)calloc(options->dSize,sizeof(double));
   options->dWork = NULL;
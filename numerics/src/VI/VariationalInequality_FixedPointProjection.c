@@ -19,6 +19,7 @@
 #include "VariationalInequality_Solvers.h"
 #include "VariationalInequality_computeError.h"
 #include "SiconosBlas.h"
+#include "fixed_point_acceleration.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -174,6 +175,9 @@ void variationalInequality_FixedPointProjection(VariationalInequality* problem,
     w_k = (double *)malloc(n * sizeof(double));
   }
 
+  FixedPointAcceleration* acc = fixed_point_acceleration_new(n, options, x,
+                                                             problem->ProjectionOnX, problem);
+
   //isVariable=0;
   if (!isVariable)
   {
@@ -201,6 +205,9 @@ void variationalInequality_FixedPointProjection(VariationalInequality* problem,
                                         error, NULL);
       }
 
+      if (acc && hasNotConverged && iter < itermax)
+        fixed_point_acceleration_update(acc, x, error);
+
     }
   }
   else if (isVariable)
@@ -285,6 +292,9 @@ void variationalInequality_FixedPointProjection(VariationalInequality* problem,
         hasNotConverged = determine_convergence(error, &tolerance, iter, options,
                                                 problem, x, w, rho);
 
+        if (acc && hasNotConverged && iter < itermax)
+          fixed_point_acceleration_update(acc, x, error);
+
         DEBUG_EXPR_WE(
           if ((error < error_k))
           {
@@ -385,6 +395,9 @@ void variationalInequality_FixedPointProjection(VariationalInequality* problem,
 
         hasNotConverged = determine_convergence(error, &tolerance, iter, options,
                                                 problem, x, w, rho);
+
+        if (acc && hasNotConverged && iter < itermax)
+          fixed_point_acceleration_update(acc, x, error);
         DEBUG_EXPR_WE(
           if ((error < error_k))
           {
@@ -484,6 +497,9 @@ void variationalInequality_FixedPointProjection(VariationalInequality* problem,
         hasNotConverged = determine_convergence(error, &tolerance, iter, options,
                                                 problem, x, w, rho);
 
+        if (acc && hasNotConverged && iter < itermax)
+          fixed_point_acceleration_update(acc, x, error);
+
         DEBUG_EXPR_WE(
           if ((error < error_k))
           {
@@ -527,6 +543,7 @@ void variationalInequality_FixedPointProjection(VariationalInequality* problem,
   iparam[SICONOS_IPARAM_ITER_DONE] = iter;
   free(xtmp);
   free(wtmp);
+  fixed_point_acceleration_free(acc);
 
 }
 
@@ -542,8 +559,8 @@ int variationalInequality_FixedPointProjection_setDefaultSolverOptions(SolverOpt
   options->numberOfInternalSolvers = 0;
   options->isSet = 1;
   options->filterOn = 1;
-  options->iSize = 10;
-  options->dSize = 10;
+  options->iSize = 14;
+  options->dSize = 14;
   options->iparam = (int *)calloc(options->iSize, sizeof(int));
   options->dparam = (double *)calloc(options->dSize, sizeof(double));
   solver_options_nullify(options);
@@ -34,6 +34,10 @@
 #include "CSparseMatrix_internal.h"
 #include "SiconosCompat.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #if defined(__cplusplus)
 #undef restrict
 #define restrict __restrict
@@ -74,6 +78,110 @@ int CSparseMatrix_aaxpy(const double alpha, const CSparseMatrix *A,
 }
 
 
+/* below this number of nonzeros, products are computed by one thread */
+#define CSPARSEMATRIX_PARALLEL_MIN_NNZ 10000
+
+/* y = alpha*A^T*x+beta*y */
+int CSparseMatrix_aaxpy_trans(const double alpha, const CSparseMatrix *A,
+                              const double * restrict x,
+                              const double beta, double * restrict y)
+{
+  if(!A || !x || !y) return (0) ;	     /* check inputs */
+  assert(A->nz < 0);
+
+  CS_INT n = A->n;
+  const CS_INT* restrict Ap = A->p;
+  const CS_INT* restrict Ai = A->i;
+  const double* restrict Ax = A->x;
+  int beta_zero = (beta == 0.);
+
+  /* the column j of A gives y[j]: the columns are shared by the threads
+   * without any concurrent write */
+#pragma omp parallel for schedule(dynamic, 512) if(Ap[n] > CSPARSEMATRIX_PARALLEL_MIN_NNZ)
+  for(CS_INT j = 0 ; j < n ; j++)
+  {
+    double s = 0.;
+    for(CS_INT p = Ap [j] ; p < Ap [j+1] ; p++)
+    {
+      s += Ax [p] * x [Ai [p]] ;
+    }
+    y [j] = beta_zero ? alpha * s : alpha * s + beta * y [j];
+  }
+  return 1;
+}
+
+/* y = alpha*A*x+beta*y */
+int CSparseMatrix_aaxpy_columns(const double alpha, const CSparseMatrix *A,
+                                const double * restrict x,
+                                const double beta, double * restrict y,
+                                int nthreads, double * restrict work)
+{
+  if(!A || !x || !y || !work) return (0) ;	     /* check inputs */
+  assert(A->nz < 0);
+  assert(nthreads > 0);
+
+  CS_INT m = A->m;
+  CS_INT n = A->n;
+  const CS_INT* restrict Ap = A->p;
+  const CS_INT* restrict Ai = A->i;
+  const double* restrict Ax = A->x;
+  int beta_zero = (beta == 0.);
+
+  /* rows written by each thread, [first[t], last[t]] */
+  CS_INT* first = (CS_INT*)malloc(2 * nthreads * sizeof(CS_INT));
+  CS_INT* last = first + nthreads;
+  for(int t = 0 ; t < nthreads ; t++)
+  {
+    first[t] = m;
+    last[t] = -1;
+  }
+
+  /* the columns of A are shared by the threads, each one accumulates its
+   * contributions in its own part of work. The rows it wrote are summed
+   * row by row at the end and set back to zero */
+#pragma omp parallel num_threads(nthreads)
+  {
+#ifdef _OPENMP
+    int t = omp_get_thread_num();
+#else
+    int t = 0;
+#endif
+    double* restrict w = work + (size_t)t * m;
+    CS_INT lo = m, hi = -1;
+#pragma omp for schedule(static)
+    for(CS_INT j = 0 ; j < n ; j++)
+    {
+      for(CS_INT p = Ap [j] ; p < Ap [j+1] ; p++)
+      {
+        CS_INT i = Ai [p];
+        w [i] += Ax [p] * x [j] ;
+        if (i < lo) lo = i;
+        if (i > hi) hi = i;
+      }
+    }
+    first[t] = lo;
+    last[t] = hi;
+#pragma omp barrier
+#pragma omp for schedule(static)
+    for(CS_INT i = 0 ; i < m ; i++)
+    {
+      double s = 0.;
+      for(int k = 0 ; k < nthreads ; k++)
+      {
+        if (first[k] <= i && i <= last[k])
+        {
+          double* restrict wk = work + (size_t)k * m;
+          s += wk [i] ;
+          wk [i] = 0. ;
+        }
+      }
+      y [i] = beta_zero ? alpha * s : alpha * s + beta * y [i];
+    }
+  }
+  free(first);
+  return 1;
+}
+
 int CSparseMatrix_check_triplet(CSparseMatrix *T)
 {
   if (T->nz < 0)
@@ -180,6 +288,17 @@ CSparseMatrix* CSparseMatrix_spfree_on_stack(CSparseMatrix* A)
   return NULL;
 }
 
+/* keep a copy of the pattern of the analysed matrix, to check that a
+ * matrix given for a refactorization has the same one */
+static void lu_factors_set_pattern(CSparseMatrix_lu_factors * cs_lu_A, const cs *A)
+{
+  CS_INT nnz = A->p[A->n];
+  cs_lu_A->Ap = (CS_INT*) realloc(cs_lu_A->Ap, (A->n + 1) * sizeof(CS_INT));
+  cs_lu_A->Ai = (CS_INT*) realloc(cs_lu_A->Ai, (nnz > 0 ? nnz : 1) * sizeof(CS_INT));
+  memcpy(cs_lu_A->Ap, A->p, (A->n + 1) * sizeof(CS_INT));
+  memcpy(cs_lu_A->Ai, A->i, nnz * sizeof(CS_INT));
+}
+
 int CSparsematrix_lu_factorization(CS_INT order, const cs *A, double tol, CSparseMatrix_lu_factors * cs_lu_A )
 {
   assert(A);
@@ -187,10 +306,79 @@ int CSparsematrix_lu_factorization(CS_INT order, const cs *A, double tol, CSpars
   css* S = cs_sqr (order, A, 0);
   cs_lu_A->S = S;
   cs_lu_A->N = cs_lu(A, S, tol);
+  lu_factors_set_pattern(cs_lu_A, A);
+  cs_lu_A->is_cholesky = 0;
 
   return (S && cs_lu_A->N);
 }
 
+int CSparseMatrix_lu_refactorization(const cs *A, double tol, CSparseMatrix_lu_factors * cs_lu_A)
+{
+  assert(A);
+  assert(cs_lu_A->S);
+  assert(cs_lu_A->n == A->n);
+  cs_nfree(cs_lu_A->N);
+  cs_lu_A->N = cs_lu(A, cs_lu_A->S, tol);
+
+  return (cs_lu_A->N != NULL);
+}
+
+int CSparseMatrix_chol_factorization(CS_INT order, const cs *A, CSparseMatrix_lu_factors * cs_chol_A)
+{
+  assert(A);
+  cs_chol_A->n = A->n;
+  css* S = cs_schol(order, A);
+  cs_chol_A->S = S;
+  cs_chol_A->N = S ? cs_chol(A, S) : NULL;
+  lu_factors_set_pattern(cs_chol_A, A);
+  cs_chol_A->is_cholesky = 1;
+
+  return (S && cs_chol_A->N);
+}
+
+int CSparseMatrix_chol_refactorization(const cs *A, CSparseMatrix_lu_factors * cs_chol_A)
+{
+  assert(A);
+  assert(cs_chol_A->S);
+  assert(cs_chol_A->is_cholesky);
+  assert(cs_chol_A->n == A->n);
+  cs_nfree(cs_chol_A->N);
+  cs_chol_A->N = cs_chol(A, cs_chol_A->S);
+
+  return (cs_chol_A->N != NULL);
+}
+
+/* Solve Ax = b with the Cholesky factor of A stored in the cs_chol_A
+ * This is extracted from cs_cholsol, you need to synchronize any changes! */
+CS_INT CSparseMatrix_chol_solve(CSparseMatrix_lu_factors* cs_chol_A, double* x, double *b)
+{
+  assert(cs_chol_A);
+
+  CS_INT ok;
+  CS_INT n = cs_chol_A->n;
+  css* S = cs_chol_A->S;
+  csn* N = cs_chol_A->N;
+  ok = (S && N && x) ;
+  if (ok)
+  {
+    cs_ipvec (S->pinv, b, x, n) ;       /* x = P*b */
+    cs_lsolve (N->L, x) ;               /* x = L\x */
+    cs_ltsolve (N->L, x) ;              /* x = L'\x */
+    cs_pvec (S->pinv, x, b, n) ;        /* b = P'*x */
+  }
+  return (ok);
+}
+
+int CSparseMatrix_lu_factors_same_pattern(const CSparseMatrix_lu_factors* cs_lu_A, const cs *A)
+{
+  assert(A);
+  assert(A->nz == -1);
+  if (!cs_lu_A->Ap || cs_lu_A->n != A->n || cs_lu_A->Ap[A->n] != A->p[A->n])
+    return 0;
+  return !memcmp(cs_lu_A->Ap, A->p, (A->n + 1) * sizeof(CS_INT))
+    && !memcmp(cs_lu_A->Ai, A->i, A->p[A->n] * sizeof(CS_INT));
+}
+
 void CSparseMatrix_free_lu_factors(CSparseMatrix_lu_factors* cs_lu_A)
 {
   assert(cs_lu_A);
@@ -204,6 +392,9 @@ void CSparseMatrix_free_lu_factors(CSparseMatrix_lu_factors* cs_lu_A)
     cs_nfree(cs_lu_A->N);
     cs_lu_A->N = NULL;
 
+    free(cs_lu_A->Ap);
+    free(cs_lu_A->Ai);
+
     free(cs_lu_A);
   }
 }
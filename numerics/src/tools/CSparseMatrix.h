@@ -126,11 +126,16 @@ extern "C"
 #endif
 
   /** \struct CSparseMatrix_lu_factors
-   * Information used and produced by CSparse for an LU factorization*/
+   * Information used and produced by CSparse for an LU factorization,
+   * or for a Cholesky factorization of a symmetric positive definite matrix.
+   * Ap and Ai are NULL before the first factorization. */
   typedef struct {
     CS_INT n;       /**< size of linear system */
     css* S;      /**< symbolic analysis */
     csn* N;      /**< numerics factorization */
+    CS_INT* Ap;  /**< copy of the column pointers of the matrix analysed in S */
+    CS_INT* Ai;  /**< copy of the row indices of the matrix analysed in S */
+    int is_cholesky; /**< 1 if N holds the Cholesky factor L (A = L L^T), 0 for the LU factors */
   } CSparseMatrix_lu_factors;
 
  /** compute a LU factorization of A and store it in a workspace
@@ -142,6 +147,55 @@ extern "C"
    */
   int CSparsematrix_lu_factorization(CS_INT order, const CSparseMatrix *A, double tol, CSparseMatrix_lu_factors * cs_lu_A);
 
+  /** compute the LU factors of A with the symbolic analysis (the
+   * ordering) already stored in cs_lu_A. A must have the sparsity
+   * pattern of the matrix used for the analysis, see
+   * CSparseMatrix_lu_factors_same_pattern.
+   * \param A the sparse matrix
+   * \param tol the tolerance
+   * \param cs_lu_A the structure holding the symbolic analysis, the
+   * previous numerical factors are replaced
+   * \return 1 if the factorization was successful, 0 otherwise
+   */
+  int CSparseMatrix_lu_refactorization(const CSparseMatrix *A, double tol, CSparseMatrix_lu_factors * cs_lu_A);
+
+  /** compute a Cholesky factorization of a symmetric positive definite
+   * matrix A and store it in a workspace. Only the upper triangular part
+   * of A is used.
+   * \param order control if ordering is used
+   * \param A the sparse matrix
+   * \param cs_chol_A the parameter structure that eventually holds the factors
+   * \return 1 if the factorization was successful, 0 otherwise (A is not
+   * positive definite)
+   */
+  int CSparseMatrix_chol_factorization(CS_INT order, const CSparseMatrix *A, CSparseMatrix_lu_factors * cs_chol_A);
+
+  /** compute the Cholesky factor of A with the symbolic analysis (the
+   * ordering and the elimination tree) already stored in cs_chol_A. A
+   * must have the sparsity pattern of the matrix used for the analysis.
+   * \param A the sparse matrix
+   * \param cs_chol_A the structure holding the symbolic analysis, the
+   * previous numerical factor is replaced
+   * \return 1 if the factorization was successful, 0 otherwise
+   */
+  int CSparseMatrix_chol_refactorization(const CSparseMatrix *A, CSparseMatrix_lu_factors * cs_chol_A);
+
+  /** reuse a Cholesky factorization (stored in the cs_chol_A) to solve a
+   * linear system Ax = b
+   * \param cs_chol_A contains the Cholesky factor of A, permutation information
+   * \param x workspace
+   * \param[in,out] b on input RHS of the linear system; on output the solution
+   * \return 0 if failed, 1 otherwise*/
+  CS_INT CSparseMatrix_chol_solve(CSparseMatrix_lu_factors* cs_chol_A, double* x, double *b);
+
+  /** check that a matrix has the sparsity pattern (sizes and indices,
+   * not the values) of the matrix analysed in cs_lu_A
+   * \param cs_lu_A the structure holding the symbolic analysis
+   * \param A the sparse matrix in compressed column format
+   * \return 1 if the patterns are the same, 0 otherwise
+   */
+  int CSparseMatrix_lu_factors_same_pattern(const CSparseMatrix_lu_factors* cs_lu_A, const CSparseMatrix *A);
+
   /** reuse a LU factorization (stored in the cs_lu_A) to solve a linear system Ax = b
    * \param cs_lu_A contains the LU factors of A, permutation information
    * \param x workspace
@@ -165,6 +219,40 @@ extern "C"
   int CSparseMatrix_aaxpy(const double alpha, const CSparseMatrix *A, const double *x,
                const double beta, double *y);
 
+  /** Matrix vector multiplication : y = alpha*A*x+beta*y, with any beta.
+   * With OpenMP, the columns of A are shared by the threads, each one
+   * accumulating its part of the product in its own vector of size A->m
+   * in work. Only the rows written by a thread are read and set back
+   * to zero at the end.
+   * \param[in] alpha matrix coefficient
+   * \param[in] A the sparse matrix, in compressed column form
+   * \param[in] x pointer on a dense vector of size A->n
+   * \param[in] beta vector coefficient, y is not read if beta is zero
+   * \param[in, out] y pointer on a dense vector of size A->m
+   * \param[in] nthreads the number of threads
+   * \param[in, out] work workspace of size nthreads * A->m, zero on
+   * input, and zero on output
+   * \return 0 if A x y or work is NULL else 1
+   */
+  int CSparseMatrix_aaxpy_columns(const double alpha, const CSparseMatrix *A, const double *x,
+                                  const double beta, double *y,
+                                  int nthreads, double *work);
+
+  /** Transposed matrix vector multiplication : y = alpha*A^T*x+beta*y.
+   * Each entry of y is the dot product of a column of A with x, so that the
+   * columns are computed in parallel when OpenMP is enabled. Given the
+   * compressed rows of a matrix B (csr, or csc of B^T), this computes
+   * y = alpha*B*x+beta*y.
+   * \param[in] alpha matrix coefficient
+   * \param[in] A the sparse matrix, in compressed column form
+   * \param[in] x pointer on a dense vector of size A->m
+   * \param[in] beta vector coefficient, y is not read if beta is zero
+   * \param[in, out] y pointer on a dense vector of size A->n
+   * \return 0 if A x or y is NULL else 1
+   */
+  int CSparseMatrix_aaxpy_trans(const double alpha, const CSparseMatrix *A, const double *x,
+                                const double beta, double *y);
+
 
     /** Allocate a CSparse matrix for future copy (as in NSM_copy)
    * \param m the matrix used as model
@@ -37,6 +37,10 @@
 /* #define DEBUG_MESSAGES */
 #include "debug.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #ifdef WITH_MKL_SPBLAS
 #include "MKL_common.h"
 #include "NM_MKL_spblas.h"
@@ -71,6 +75,10 @@ void NM_prod_mv_3x3(int sizeX, int sizeY, NumericsMatrix* A,
     case NM_SPARSE:
       CSparseMatrix_aaxpy(alpha, NM_csc(A), x, beta, y);
     break;
+  /* matrix-free */
+    case NM_OPERATOR:
+      A->matrix3->gemv(A->matrix3->env, alpha, x, beta, y);
+    break;
 
     default:
     fprintf(stderr, "Numerics, NumericsMatrix, product matrix - vector prod(A,x,y) failed, unknown storage type for A.\n");
@@ -485,6 +493,8 @@ void NM_internalData_copy(const NumericsMatrix* const A, NumericsMatrix* B )
       }
       B->internalData->isLUfactorized = A->internalData->isLUfactorized;
       B->internalData->isInversed = A->internalData->isInversed;
+      B->internalData->isSymmetric = A->internalData->isSymmetric;
+      B->internalData->isCholeskyFactorized = A->internalData->isCholeskyFactorized;
     }
   }
 void NM_free(NumericsMatrix* m)
@@ -494,6 +504,7 @@ void NM_free(NumericsMatrix* m)
   NM_clearDense(m);
   NM_clearSparseBlock(m);
   NM_clearSparse(m);
+  NM_clearOperator(m);
 
   NM_internalData_free(m);
 }
@@ -828,6 +839,12 @@ void NM_display(const NumericsMatrix* const m)
 
     break;
   }
+  case NM_OPERATOR:
+  {
+    assert(m->matrix3);
+    printf("========== storageType = NM_OPERATOR\n");
+    break;
+  }
   default:
   {
     fprintf(stderr, "display for NumericsMatrix: matrix type %d not supported!\n", m->storageType);
@@ -1147,6 +1164,13 @@ void NM_extract_diag_block(NumericsMatrix* M, int block_row_nb, size_t start_row
     NSM_extract_block(M, *Block, start_row, start_row, size, size);
     break;
   }
+  case NM_OPERATOR:
+  {
+    if (!M->matrix3->diag_block)
+      numerics_error("NM_extract_diag_block", "the diagonal blocks of this operator are not available.");
+    M->matrix3->diag_block(M->matrix3->env, (int)start_row, size, *Block);
+    break;
+  }
   default:
   {
     printf("NM_extract_diag_block :: unknown matrix storage");
@@ -1190,6 +1214,13 @@ void NM_extract_diag_block3(NumericsMatrix* M, int block_row_nb, double ** Block
     NSM_extract_block(M, *Block, start_row, start_row, 3, 3);
     break;
   }
+  case NM_OPERATOR:
+  {
+    if (!M->matrix3->diag_block)
+      numerics_error("NM_extract_diag_block3", "the diagonal blocks of this operator are not available.");
+    M->matrix3->diag_block(M->matrix3->env, 3 * block_row_nb, 3, *Block);
+    break;
+  }
   default:
   {
     printf("NM_extract_diag_block :: unknown matrix storage");
@@ -1279,6 +1310,12 @@ void NM_add_to_diag3(NumericsMatrix* M, double alpha)
     double* Mx = NSM_data(M->matrix2);
     for (size_t i = 0; i < n; ++i) Mx[diag_indices[i]] += alpha;
 
+    /* invalidations: the origin (csc or csr) is the only one up to date */
+    NM_clearTriplet(M);
+    NM_clearCSCTranspose(M);
+    if (M->matrix2->origin == NSM_CSC) { NM_clearCSR(M); }
+    else { NM_clearCSC(M); }
+
     break;
   }
   default:
@@ -1296,6 +1333,20 @@ NumericsMatrix* NM_create_from_data(int storageType, int size0, int size1, void*
   return M;
 }
 
+NumericsMatrix* NM_create_operator(int size0, int size1, void* env,
+                                   void (*gemv)(void* env, double alpha, const double* x, double beta, double* y),
+                                   void (*diag_block)(void* env, int start, int size, double* block),
+                                   void (*free_env)(void* env))
+{
+  assert(gemv);
+  NumericsMatrixOperator* op = (NumericsMatrixOperator*) malloc(sizeof(NumericsMatrixOperator));
+  op->env = env;
+  op->gemv = gemv;
+  op->diag_block = diag_block;
+  op->free_env = free_env;
+  return NM_create_from_data(NM_OPERATOR, size0, size1, op);
+}
+
 NumericsMatrix* NM_duplicate(NumericsMatrix* mat)
 {
   NumericsMatrix* M = NM_new();
@@ -1407,6 +1458,9 @@ void NM_fill(NumericsMatrix* M, int storageType, int size0, int size1, void* dat
           }
         }
         break;
+      case NM_OPERATOR:
+        M->matrix3 = (NumericsMatrixOperator*) data;
+        break;
 
       default:
         printf("NM_fill :: storageType value %d not implemented yet !", storageType);
@@ -1492,6 +1546,17 @@ void NM_clearSparse(NumericsMatrix* A)
   }
 }
 
+void NM_clearOperator(NumericsMatrix* A)
+{
+  if (A->matrix3)
+  {
+    if (A->matrix3->free_env)
+      A->matrix3->free_env(A->matrix3->env);
+    free(A->matrix3);
+    A->matrix3 = NULL;
+  }
+}
+
 void NM_clearTriplet(NumericsMatrix* A)
 {
   if (A->matrix2)
@@ -1554,6 +1619,45 @@ void NM_clearSparseStorage(NumericsMatrix *A)
  
 }
 
+/* free the numerical factors of the sparse linear solver of A, but keep
+ * the symbolic analysis of the CSparse factors */
+static void NSM_clearNumericalFactors(NumericsSparseMatrix* A)
+{
+  NSM_linear_solver_params* p = A->linearSolverParams;
+  if (!p) return;
+  if (p->solver == NSM_CS_LUSOL)
+  {
+    CSparseMatrix_lu_factors* cs_lu_A = (CSparseMatrix_lu_factors *)NSM_solver_data(p);
+    if (cs_lu_A)
+    {
+      cs_nfree(cs_lu_A->N);
+      cs_lu_A->N = NULL;
+    }
+  }
+  else
+    A->linearSolverParams = NSM_linearSolverParams_free(p);
+}
+
+void NM_clearSparseStorageKeepSymbolic(NumericsMatrix *A)
+{
+  NSM_linear_solver_params* p = NULL;
+  if (A->matrix2)
+  {
+    /* only the numerical factors depend on the values */
+    NSM_clearNumericalFactors(A->matrix2);
+    p = A->matrix2->linearSolverParams;
+    A->matrix2->linearSolverParams = NULL;
+    if (A->matrix2->diag_indx)
+    {
+      free(A->matrix2->diag_indx);
+      A->matrix2->diag_indx = NULL;
+    }
+  }
+  NM_clearSparseStorage(A);
+  if (p)
+    A->matrix2->linearSolverParams = p;
+}
+
 
 void NM_dense_to_sparse(const NumericsMatrix* const A, NumericsMatrix* B)
 {
@@ -1859,7 +1963,7 @@ void NM_copy(const NumericsMatrix* const A, NumericsMatrix* B)
 
     /* invalidations */
     NM_clearDense(B);
-    NM_clearSparseStorage(B);
+    NM_clearSparseStorageKeepSymbolic(B);
 
     break;
   }
@@ -1925,8 +2029,9 @@ void NM_copy(const NumericsMatrix* const A, NumericsMatrix* B)
     }
 
     NM_copy_sparse(A_, B_);
-    
-    numericsSparseMatrix(B)->linearSolverParams = NSM_linearSolverParams_free(numericsSparseMatrix(B)->linearSolverParams);
+
+    /* the symbolic analysis is kept for a factorization of the new values */
+    NSM_clearNumericalFactors(numericsSparseMatrix(B));
 
     /* invalidations */
     NM_clearDense(B);
@@ -1941,6 +2046,7 @@ void NM_copy(const NumericsMatrix* const A, NumericsMatrix* B)
     else
     {
       NM_clearTriplet(B);
+      NM_clearCSCTranspose(B);
       if (A->matrix2->origin == NSM_CSC) { NM_clearCSR(B); }
       else { NM_clearCSC(B); }
     }
@@ -2145,6 +2251,10 @@ CSparseMatrix* NM_csr(NumericsMatrix *A)
   return A->matrix2->csr;
 }
 
+/* below this number of nonzeros, NM_gemv does not build the compressed rows
+ * of a sparse matrix to compute the product in parallel */
+#define NM_GEMV_PARALLEL_MIN_NNZ 10000
+
 /* Numerics Matrix wrapper  for y <- alpha A x + beta y */
 void NM_gemv(const double alpha, NumericsMatrix* A, const double *x,
              const double beta, double *y)
@@ -2173,6 +2283,31 @@ void NM_gemv(const double alpha, NumericsMatrix* A, const double *x,
   case NM_SPARSE:
   {
     assert(A->storageType == NM_SPARSE);
+#ifdef _OPENMP
+    /* with several threads, the product is computed row by row on the
+     * csr storage when it is the origin of A, otherwise the columns of the
+     * csc storage are shared by the threads. No other copy of A is built:
+     * a cached one would not follow the changes of the values of A. The
+     * partial products are accumulated in the workspace of A, which is
+     * kept to zero between the products (it is not used otherwise for a
+     * sparse matrix). */
+    int nthreads = omp_get_max_threads();
+    if (nthreads > 1 && NM_nnz(A) > NM_GEMV_PARALLEL_MIN_NNZ)
+    {
+      if (A->matrix2->origin == NSM_CSR)
+        CHECK_RETURN(CSparseMatrix_aaxpy_trans(alpha, NM_csr(A), x, beta, y));
+      else
+      {
+        size_t size = (size_t)nthreads * A->size0;
+        bool zero = NM_internalData(A)->dWorkSize < size;
+        double* work = NM_dWork(A, (int)size);
+        if (zero)
+          memset(work, 0, size * sizeof(double));
+        CHECK_RETURN(CSparseMatrix_aaxpy_columns(alpha, NM_csc(A), x, beta, y, nthreads, work));
+      }
+      break;
+    }
+#endif
     // if possible use the much simpler version provided by CSparse
     // Also at the time of writing, CSparseMatrix_aaxpy is bugged --xhub
     bool beta_check = false;
@@ -2187,10 +2322,17 @@ void NM_gemv(const double alpha, NumericsMatrix* A, const double *x,
     }
     else
     {
-      CHECK_RETURN(CSparseMatrix_aaxpy(alpha, NM_csc(A), x, beta, y));
+      /* CSparseMatrix_aaxpy only supports beta = 1 */
+      if (!beta_check) cblas_dscal(A->size0, beta, y, 1);
+      CHECK_RETURN(CSparseMatrix_aaxpy(alpha, NM_csc(A), x, 1.0, y));
     }
     break;
   }
+  case NM_OPERATOR:
+  {
+    A->matrix3->gemv(A->matrix3->env, alpha, x, beta, y);
+    break;
+  }
   default:
     {
       assert(0 && "NM_gemv unknown storageType");
@@ -2213,22 +2355,10 @@ void NM_tgemv(const double alpha, NumericsMatrix* A, const double *x,
   case NM_SPARSE_BLOCK:
   case NM_SPARSE:
     {
-      /* if possible use the much simpler version provided by CSparse
-       Also at the time of writing, CSparseMatrix_aaxpy is bugged --xhub */
-      bool beta_check = false;
-      if (fabs(beta) < 100*DBL_EPSILON)
-      {
-        memset(y, 0, A->size0*sizeof(double));
-        beta_check = true;
-      }
-      if (fabs(alpha - 1.) < 100*DBL_EPSILON && (fabs(beta - 1.) < 100*DBL_EPSILON || beta_check))
-      {
-        CHECK_RETURN(cs_gaxpy(NM_csc_trans(A), x, y));
-      }
-      else
-      {
-        CHECK_RETURN(CSparseMatrix_aaxpy(alpha, NM_csc_trans(A), x, beta, y));
-      }
+      /* the entry j of trans(A) x is the dot product of the column j of A
+       * with x: no transposition is needed and the columns are computed in
+       * parallel */
+      CHECK_RETURN(CSparseMatrix_aaxpy_trans(alpha, NM_csc(A), x, beta, y));
       break;
     }
   default:
@@ -2402,6 +2532,49 @@ double* NM_dWork(NumericsMatrix* A, int size)
   return A->internalData->dWork;
 }
 
+/* (re)factorization of a sparse matrix with CSparse: Cholesky if A is
+ * flagged symmetric, LU otherwise or if the Cholesky factorization
+ * fails. The symbolic analysis already in cs_lu_A is reused if A has
+ * the pattern of the analysed matrix. */
+static int NM_csparse_factorize(NumericsMatrix* A, CSparseMatrix_lu_factors* cs_lu_A)
+{
+  CSparseMatrix* C = NM_csc(A);
+  bool symmetric = NM_internalData(A)->isSymmetric;
+
+  if (cs_lu_A->S && CSparseMatrix_lu_factors_same_pattern(cs_lu_A, C)
+      && (!cs_lu_A->is_cholesky || symmetric))
+  {
+    numerics_printf_verbose(2,"NM_gesv_expert, we compute factors with the previous symbolic analysis" );
+    if (!cs_lu_A->is_cholesky)
+      return CSparseMatrix_lu_refactorization(C, DBL_EPSILON, cs_lu_A);
+    if (CSparseMatrix_chol_refactorization(C, cs_lu_A))
+      return 1;
+    symmetric = false;
+  }
+
+  cs_sfree(cs_lu_A->S);
+  cs_lu_A->S = NULL;
+  cs_nfree(cs_lu_A->N);
+  cs_lu_A->N = NULL;
+  if (symmetric)
+  {
+    if (CSparseMatrix_chol_factorization(1, C, cs_lu_A))
+      return 1;
+    numerics_printf_verbose(2,"NM_gesv_expert, the Cholesky factorization failed, we use a LU factorization" );
+    cs_sfree(cs_lu_A->S);
+    cs_lu_A->S = NULL;
+    cs_nfree(cs_lu_A->N);
+    cs_lu_A->N = NULL;
+  }
+  return CSparsematrix_lu_factorization(1, C, DBL_EPSILON, cs_lu_A);
+}
+
+void NM_set_symmetric(NumericsMatrix* A, bool symmetric)
+{
+  assert(A->size0 == A->size1);
+  NM_internalData(A)->isSymmetric = symmetric;
+}
+
 int NM_gesv_expert(NumericsMatrix* A, double *b, unsigned keep)
 {
 
@@ -2423,6 +2596,29 @@ int NM_gesv_expert(NumericsMatrix* A, double *b, unsigned keep)
       lapack_int* ipiv = (lapack_int*)NM_iWork(A, A->size0, sizeof(lapack_int));
       DEBUG_PRINTF("iwork and dwork are initialized with size %i and %i\n",A->size0*A->size1,A->size0 );
 
+      if (!NM_internalData(A)->isLUfactorized && NM_internalData(A)->isSymmetric)
+      {
+        numerics_printf_verbose(2,"NM_gesv_expert, we compute the Cholesky factors and keep them" );
+        /* DPOTRF overwrites the upper triangle, which is restored from the
+         * lower one and from the diagonal if A is not positive definite */
+        int n = A->size0;
+        double* diag = NM_dWork(A, n);
+        cblas_dcopy(n, A->matrix0, n + 1, diag, 1);
+        DPOTRF(LA_UP, n, A->matrix0, n, &info);
+        if (info)
+        {
+          numerics_printf_verbose(2,"NM_gesv_expert, the Cholesky factorization failed (info = %d), we use a LU factorization", info);
+          cblas_dcopy(n, diag, 1, A->matrix0, n + 1);
+          for (int j = 1; j < n; ++j)
+            cblas_dcopy(j, &A->matrix0[j], n, &A->matrix0[j * n], 1);
+        }
+        else
+        {
+          NM_internalData(A)->isLUfactorized = true;
+          NM_internalData(A)->isCholeskyFactorized = true;
+        }
+      }
+
       if (!NM_internalData(A)->isLUfactorized)
       {
         numerics_printf_verbose(2,"NM_gesv_expert, we compute factors and keep it" );
@@ -2445,16 +2641,28 @@ int NM_gesv_expert(NumericsMatrix* A, double *b, unsigned keep)
         if (info) { NM_internalData_free(A); return info; }
 
         NM_internalData(A)->isLUfactorized = true;
+        NM_internalData(A)->isCholeskyFactorized = false;
       }
-      DEBUG_PRINT("Start to call DGETRS for NM_DENSE storage\n");
-      numerics_printf_verbose(2,"NM_gesv_expert, we solve with given factors" );
-      DGETRS(LA_NOTRANS, A->size0, 1, A->matrix0, A->size0, ipiv, b, A->size0, &info);
-      DEBUG_PRINT("End of call DGETRS for NM_DENSE storage\n");
-      if (info < 0)
+      if (NM_internalData(A)->isCholeskyFactorized)
+      {
+        numerics_printf_verbose(2,"NM_gesv_expert, we solve with given Cholesky factors" );
+        /* A = U^T U */
+        cblas_dtrsv(CblasColMajor, CblasUpper, CblasTrans, CblasNonUnit, A->size0, A->matrix0, A->size0, b, 1);
+        cblas_dtrsv(CblasColMajor, CblasUpper, CblasNoTrans, CblasNonUnit, A->size0, A->matrix0, A->size0, b, 1);
+        info = 0;
+      }
+      else
       {
-        if (verbose >= 2)
+        DEBUG_PRINT("Start to call DGETRS for NM_DENSE storage\n");
+        numerics_printf_verbose(2,"NM_gesv_expert, we solve with given factors" );
+        DGETRS(LA_NOTRANS, A->size0, 1, A->matrix0, A->size0, ipiv, b, A->size0, &info);
+        DEBUG_PRINT("End of call DGETRS for NM_DENSE storage\n");
+        if (info < 0)
         {
-          printf("NM_gesv: dense LU solve DGETRS failed. The %d-th argument has an illegal value, stopping\n", -info);
+          if (verbose >= 2)
+          {
+            printf("NM_gesv: dense LU solve DGETRS failed. The %d-th argument has an illegal value, stopping\n", -info);
+          }
         }
       }
     }
@@ -2497,13 +2705,32 @@ int NM_gesv_expert(NumericsMatrix* A, double *b, unsigned keep)
           p->dWork = (double*) malloc(A->size1 * sizeof(double));
           p->dWorkSize = A->size1;
           CSparseMatrix_lu_factors* cs_lu_A = (CSparseMatrix_lu_factors*) malloc(sizeof(CSparseMatrix_lu_factors));
-          numerics_printf_verbose(2,"NM_gesv_expert, we compute factors and keep it" );
-          CHECK_RETURN(CSparsematrix_lu_factorization(1, NM_csc(A), DBL_EPSILON, cs_lu_A));
+          cs_lu_A->S = NULL;
+          cs_lu_A->N = NULL;
+          cs_lu_A->Ap = NULL;
+          cs_lu_A->Ai = NULL;
           p->solver_data = cs_lu_A;
+          numerics_printf_verbose(2,"NM_gesv_expert, we compute factors and keep it" );
+          CHECK_RETURN(NM_csparse_factorize(A, cs_lu_A));
+        }
+        else if (!((CSparseMatrix_lu_factors *)NSM_solver_data(p))->N)
+        {
+          /* the values have been cleared by NM_clearSparseStorageKeepSymbolic
+           * or NM_copy: the symbolic analysis is reused if the pattern is the same */
+          if (p->dWorkSize < A->size1)
+          {
+            p->dWork = (double*) realloc(p->dWork, A->size1 * sizeof(double));
+            p->dWorkSize = A->size1;
+          }
+          CHECK_RETURN(NM_csparse_factorize(A, (CSparseMatrix_lu_factors *)NSM_solver_data(p)));
         }
 
         numerics_printf_verbose(2,"NM_gesv, we solve with given factors" );
-        info = !CSparseMatrix_solve((CSparseMatrix_lu_factors *)NSM_solver_data(p), NSM_workspace(p), b);
+        CSparseMatrix_lu_factors* cs_lu_A = (CSparseMatrix_lu_factors *)NSM_solver_data(p);
+        if (cs_lu_A->is_cholesky)
+          info = !CSparseMatrix_chol_solve(cs_lu_A, NSM_workspace(p), b);
+        else
+          info = !CSparseMatrix_solve(cs_lu_A, NSM_workspace(p), b);
       }
       else
       {
@@ -2956,6 +3183,23 @@ size_t NM_nnz(const NumericsMatrix* M)
     assert(M->matrix2);
     return NSM_nnz(NSM_get_origin(M->matrix2));
   }
+  case NM_SPARSE_BLOCK:
+  {
+    assert(M->matrix1);
+    SparseBlockStructuredMatrix* A = M->matrix1;
+    size_t nnz = 0;
+    size_t nbfilled = A->filled1 > 0 ? A->filled1 - 1 : 0;
+    for (size_t row = 0; row < nbfilled; ++row)
+    {
+      size_t nbrows = A->blocksize0[row] - (row > 0 ? A->blocksize0[row - 1] : 0);
+      for (size_t blockNum = A->index1_data[row]; blockNum < A->index1_data[row + 1]; ++blockNum)
+      {
+        size_t col = A->index2_data[blockNum];
+        nnz += nbrows * (A->blocksize1[col] - (col > 0 ? A->blocksize1[col - 1] : 0));
+      }
+    }
+    return nnz;
+  }
   default:
     numerics_error("NM_nnz", "Unsupported matrix type %d in %s", M->storageType);
     return SIZE_MAX;
@@ -43,8 +43,26 @@ typedef struct
   double *dWork; /**< double workspace */
   bool isLUfactorized; /**<  true if the matrix has already been LU-factorized */
   bool isInversed; /**<  true if the matrix containes its inverse (in place inversion) */
+  bool isSymmetric; /**< true if the matrix is flagged as symmetric, see NM_set_symmetric */
+  bool isCholeskyFactorized; /**< true if the factors kept for a dense matrix are the Cholesky ones */
 } NumericsMatrixInternalData;
 
+/** \struct NumericsMatrixOperator NumericsMatrix.h
+    A matrix-free linear operator: the matrix is known only through its
+    product with a vector and, optionally, its diagonal blocks.
+*/
+struct NumericsMatrixOperator
+{
+  void* env; /**< data of the operator, given to the functions below */
+  /** y = alpha A x + beta y */
+  void (*gemv)(void* env, double alpha, const double* x, double beta, double* y);
+  /** copy into block (column-major) the diagonal block of A of size
+   * size whose first row and column is start, may be NULL */
+  void (*diag_block)(void* env, int start, int size, double* block);
+  /** free env with the operator, may be NULL */
+  void (*free_env)(void* env);
+};
+
 /** \struct NumericsMatrix NumericsMatrix.h
     Interface to different type of matrices in numerics component.
 
@@ -55,12 +73,14 @@ struct NumericsMatrix
   int storageType; /**< the type of storage:
                       0: dense (double*),
                       1: SparseBlockStructuredMatrix,
-                      2: classical sparse (csc, csr or triplet) via CSparse (from T. Davis)*/
+                      2: classical sparse (csc, csr or triplet) via CSparse (from T. Davis),
+                      3: matrix-free operator*/
   int size0; /**< number of rows */
   int size1; /**< number of columns */
   double* matrix0; /**< dense storage */
   SparseBlockStructuredMatrix* matrix1; /**< sparse block storage */
   NumericsSparseMatrix* matrix2; /**< csc, csr or triplet storage */
+  NumericsMatrixOperator* matrix3; /**< matrix-free operator */
 
   NumericsMatrixInternalData* internalData; /**< internal storage, used for workspace among other things */
 
@@ -71,6 +91,7 @@ typedef enum NumericsMatrix_types {
   NM_DENSE,        /**< dense format */
   NM_SPARSE_BLOCK, /**< sparse block format */
   NM_SPARSE,          /**< compressed column format */
+  NM_OPERATOR,     /**< matrix-free operator, see NM_create_operator */
 } NM_types;
 
 /*! option for gesv factorization */
@@ -113,6 +134,24 @@ extern "C"
   NumericsMatrix* NM_create_from_filename(char *filename);
   NumericsMatrix* NM_create_from_file(FILE *file);
 
+  /** create a matrix-free NumericsMatrix (storage NM_OPERATOR), known
+   * only through its product with a vector.
+   * Most of the functions of this file require an explicit storage; the
+   * ones supporting NM_OPERATOR are NM_gemv, NM_prod_mv_3x3,
+   * NM_extract_diag_block, NM_extract_diag_block3, NM_display and NM_free.
+   * \param size0 number of rows
+   * \param size1 number of columns
+   * \param env data of the operator, freed by NM_free with free_env
+   * \param gemv computes y = alpha A x + beta y
+   * \param diag_block copies a diagonal block of A (may be NULL)
+   * \param free_env frees env (may be NULL)
+   * \return a pointer to a NumericsMatrix
+   */
+  NumericsMatrix* NM_create_operator(int size0, int size1, void* env,
+                                     void (*gemv)(void* env, double alpha, const double* x, double beta, double* y),
+                                     void (*diag_block)(void* env, int start, int size, double* block),
+                                     void (*free_env)(void* env));
+
 
  /** Copy a CSparseMatrix inside another CSparseMatrix.
    *  Reallocations are performed if B cannot hold a copy of A
@@ -210,6 +249,7 @@ extern "C"
     A->matrix0 = NULL;
     A->matrix1 = NULL;
     A->matrix2 = NULL;
+    A->matrix3 = NULL;
     A->internalData = NULL;
   }
 
@@ -282,7 +322,8 @@ extern "C"
 
 
   /** return the number of non-zero element. For a dense matrix, it is the
-   * product of the dimensions (e.g. an upper bound). For a sparse matrix, it is the true number
+   * product of the dimensions (e.g. an upper bound). For a sparse matrix, it is the true number.
+   * For a SBM, it is the number of entries of the non null blocks
    * \param M the matrix
    * \return the number (or an upper bound) of non-zero elements in the matrix
    */
@@ -366,7 +407,12 @@ extern "C"
   void NM_row_prod_no_diag3(size_t sizeX, int block_start, size_t row_start, NumericsMatrix* A, double* x, double* y, bool init);
   void NM_row_prod_no_diag1x1(size_t sizeX, int block_start, size_t row_start, NumericsMatrix* A, double* x, double* y, bool init);
 
-  /** Matrix vector multiplication : y = alpha A x + beta y
+  /** Matrix vector multiplication : y = alpha A x + beta y.
+   * With OpenMP and more than one thread, the product with a large sparse
+   * matrix is computed in parallel, on its csr storage if it is its origin,
+   * otherwise on the columns of its csc storage, each thread accumulating
+   * its part of the product in the workspace of A (see
+   * CSparseMatrix_aaxpy_columns).
    * \param[in] alpha scalar
    * \param[in] A a NumericsMatrix
    * \param[in] x pointer on a dense vector of size A->size1
@@ -387,7 +433,9 @@ extern "C"
   void NM_gemm(const double alpha, NumericsMatrix* A, NumericsMatrix* B,
                const double beta, NumericsMatrix *C);
 
-  /** Transposed matrix multiplication : y += alpha transpose(A) x + y
+  /** Transposed matrix multiplication : y = alpha transpose(A) x + beta y.
+   * For sparse matrices, the entries of y are computed in parallel from the
+   * columns of A with OpenMP.
    * \param[in] alpha scalar
    * \param[in] A a NumericsMatrix
    * \param[in] x pointer on a dense vector of size A->size1
@@ -524,6 +572,11 @@ extern "C"
    */
   void NM_clearSparse(NumericsMatrix* A);
 
+  /** Clear the matrix-free operator, if it is existent.
+   * \param[in,out] A a Numericsmatrix
+   */
+  void NM_clearOperator(NumericsMatrix* A);
+
   /** Clear triplet storage, if it is existent.
    * \param[in,out] A a Numericsmatrix
    */
@@ -550,6 +603,15 @@ extern "C"
     */
   void NM_clearSparseStorage(NumericsMatrix *A);
 
+  /** Clear triplet, csc, csc transposed storage, if they are existent,
+    * before new values are set in the matrix. The symbolic analysis of
+    * the factors kept by NM_gesv_expert (NM_KEEP_FACTORS) is preserved:
+    * if the new values have the same sparsity pattern, the next solve
+    * only computes the numerical factorization.
+    * \param[in,out] A a Numericsmatrix
+    */
+  void NM_clearSparseStorageKeepSymbolic(NumericsMatrix *A);
+
 
 
   /** Direct computation of the solution of a real system of linear
@@ -563,11 +625,24 @@ extern "C"
    * allow for future solves. If A is already factorized, just solve the linear
    * system. If set to NM_PRESERVE, preserve the original matrix (just used in
    * the dense case). if NM_NONE, discard everything.
+   * With NM_KEEP_FACTORS, the factors of a matrix flagged with
+   * NM_set_symmetric are the Cholesky ones (LAPACK or CSparse solver).
    * \return 0 if successful, else the error is specific to the backend solver
    * used
    */
   int NM_gesv_expert(NumericsMatrix* A, double *b, unsigned keep);
 
+  /** Flag a matrix as symmetric, and expected to be positive definite:
+   * the factors kept by NM_gesv_expert are the Cholesky ones, which
+   * take half the time and the memory of the LU ones. If the Cholesky
+   * factorization fails, a LU factorization is used.
+   * The flag is in the internal data of the matrix, and is lost when
+   * the matrix is overwritten by NM_copy.
+   * \param[in,out] A a square NumericsMatrix
+   * \param symmetric the value of the flag
+   */
+  void NM_set_symmetric(NumericsMatrix* A, bool symmetric);
+
   int NM_gesv_expert_multiple_rhs(NumericsMatrix* A, double *b, unsigned int n_rhs, unsigned keep);
 
   /**  Computation of the inverse of a NumericsMatrix A usinf NM_gesv_expert
@@ -617,6 +692,8 @@ extern "C"
     M->internalData->dWork = NULL;
     M->internalData->dWorkSize = 0;
     M->internalData->isLUfactorized = 0;
+    M->internalData->isSymmetric = 0;
+    M->internalData->isCholeskyFactorized = 0;
   }
   /** Copy the internalData structure 
    * \param M the matrix to modify
@@ -37,6 +37,8 @@
 #include "VariationalInequality_Solvers.h"
 
 #include "GAMSlink.h"
+#include "MixedLinearComplementarityProblem.h"
+#include "mlcp_direct.h"
 
 #include "SiconosNumerics_Solvers.h"
 
@@ -186,6 +188,21 @@ void solver_options_free_solver_specific_data(SolverOptions* options)
   int id = options->solverId;
   switch (id)
   {
+    case SICONOS_MLCP_DIRECT_ENUM:
+    case SICONOS_MLCP_DIRECT_SIMPLEX:
+    case SICONOS_MLCP_DIRECT_PATH:
+    case SICONOS_MLCP_DIRECT_PATH_ENUM:
+    case SICONOS_MLCP_DIRECT_FB:
+    {
+      /* cache of configurations, if mlcp_direct_reset was not called */
+      mlcp_direct_reset(NULL, options);
+      if (options->solverParameters)
+      {
+        free(options->solverParameters);
+        options->solverParameters = NULL;
+      }
+      break;
+    }
     case SICONOS_NCP_PATHSEARCH:
       assert(options->solverData);
       free_solverData_PathSearch(options->solverData);
@@ -311,7 +328,7 @@ void solver_options_copy(SolverOptions* options_ori, SolverOptions* options)
 
   if (options_ori->iWork)
   {
-    assert(options->iWorkSize > 0);
+    assert(options_ori->iWorkSize > 0);
     options->iWorkSize = options_ori->iWorkSize;
     options->iWork = (int *)calloc(options->iWorkSize, sizeof(int));
     for (int i = 0  ; i < options->iWorkSize; i++ )
@@ -322,7 +339,7 @@ void solver_options_copy(SolverOptions* options_ori, SolverOptions* options)
 
   if (options_ori->dWork)
   {
-    assert(options->dWorkSize > 0);
+    assert(options_ori->dWorkSize > 0);
     options->dWorkSize = options_ori->dWorkSize;
     options->dWork = (double *)calloc(options->dWorkSize, sizeof(double));
     for (int i = 0  ; i < options->dWorkSize; i++ )
@@ -350,6 +367,21 @@ void solver_options_copy(SolverOptions* options_ori, SolverOptions* options)
    if (options_ori->solverData)
     options->solverData =options_ori->solverData;
 
+  switch (options->solverId)
+  {
+    case SICONOS_MLCP_DIRECT_ENUM:
+    case SICONOS_MLCP_DIRECT_SIMPLEX:
+    case SICONOS_MLCP_DIRECT_PATH:
+    case SICONOS_MLCP_DIRECT_PATH_ENUM:
+    case SICONOS_MLCP_DIRECT_FB:
+      /* the state of the direct solvers points into the dWork of options_ori
+       * and is freed with it: the copy gets its own one from mlcp_direct_init */
+      options->solverData = NULL;
+      break;
+    default:
+      break;
+  }
+
 
 
 
@@ -114,6 +114,11 @@ enum SICONOS_IPARAM
 #define SICONOS_IPARAM_NMS_PROJECTED_GRADIENT_TYPE 8
 #define SICONOS_IPARAM_NMS_N_MAX 9
 
+/** acceleration of the fixed-point iterations (see fixed_point_acceleration.h),
+ * available for the solvers whose iparam and dparam are large enough */
+#define SICONOS_IPARAM_ACCELERATION 12
+#define SICONOS_IPARAM_ACCELERATION_MEMORY 13
+
 /** Some values for dparam index */
 enum SICONOS_DPARAM
 {
@@ -133,6 +138,20 @@ enum SICONOS_DPARAM
 #define SICONOS_DPARAM_NMS_ALPHA_MIN_PGRAD 6
 #define SICONOS_DPARAM_NMS_MERIT_INCR 7
 
+/** acceleration of the fixed-point iterations */
+#define SICONOS_DPARAM_ACCELERATION_RESTART_ETA 12
+
+/** values of iparam[SICONOS_IPARAM_ACCELERATION] */
+enum SICONOS_ACCELERATION_ENUM
+{
+  /** plain fixed-point iterations */
+  SICONOS_ACCELERATION_NONE = 0,
+  /** Anderson acceleration, with the last iparam[SICONOS_IPARAM_ACCELERATION_MEMORY] iterates */
+  SICONOS_ACCELERATION_ANDERSON = 1,
+  /** Nesterov momentum, restarted when the residual increases */
+  SICONOS_ACCELERATION_NESTEROV = 2
+};
+
 
 extern const char* const SICONOS_NUMERICS_PROBLEM_LCP_STR;
 extern const char* const SICONOS_NUMERICS_PROBLEM_MLCP_STR;
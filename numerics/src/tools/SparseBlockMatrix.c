@@ -76,6 +76,9 @@ typedef struct sparse_matrix_iterator
   const CSparseMatrix* mat;
 } sparse_matrix_iterator;
 
+/* below this number of rows of blocks, products are computed by one thread */
+#define SBM_PARALLEL_MIN_ROWS 256
+
 static sparse_matrix_iterator sparseMatrixBegin(const CSparseMatrix* const sparseMat);
 static int sparseMatrixNext(sparse_matrix_iterator* it);
 
@@ -110,6 +113,10 @@ void SBM_gemv(unsigned int sizeX, unsigned int sizeY, double alpha, const Sparse
   */
   cblas_dscal(sizeY, beta, y, 1);
 
+  /* each row of blocks gives its own part of y: the rows are shared by the
+     threads */
+#pragma omp parallel for schedule(dynamic, 64) if(A->filled1 > SBM_PARALLEL_MIN_ROWS) \
+  private(colNumber, nbRows, nbColumns, posInX, posInY)
   for (unsigned int currentRowNumber = 0 ; currentRowNumber < A->filled1 - 1; ++currentRowNumber)
   {
     for (size_t blockNum = A->index1_data[currentRowNumber];
@@ -186,6 +193,10 @@ void SBM_gemv_3x3(unsigned int sizeX, unsigned int sizeY, const SparseBlockStruc
      Works whatever the ordering order of the block is, in A->block
   */
 
+  /* each row of blocks gives its own part of y: the rows are shared by the
+     threads */
+#pragma omp parallel for schedule(dynamic, 64) if(A->filled1 > SBM_PARALLEL_MIN_ROWS) \
+  private(colNumber, nbRows, nbColumns, posInX, posInY)
   for (unsigned int currentRowNumber = 0 ; currentRowNumber < A->filled1 - 1; ++currentRowNumber)
   {
     for (size_t blockNum = A->index1_data[currentRowNumber];
@@ -2671,3 +2682,161 @@ void SBM_column_permutation(unsigned int *colIndex, SparseBlockStructuredMatrix*
   fclose(titi);
 #endif
 }
+
+/* Transposed block pattern of a SBM square in blocks: the rows having a
+ * block in column j are tindex2[tindex1[j]] ... tindex2[tindex1[j+1]-1]. */
+static void SBM_transposed_pattern(const SparseBlockStructuredMatrix* const M,
+                                   size_t nbfilled,
+                                   size_t ** tindex1_ptr, size_t ** tindex2_ptr)
+{
+  unsigned int nbrow = M->blocknumber0;
+  size_t * tindex1 = (size_t *)calloc(nbrow + 1, sizeof(size_t));
+  size_t * tindex2 = (size_t *)malloc((M->filled2 + 1) * sizeof(size_t));
+  for (size_t row = 0; row < nbfilled; ++row)
+  {
+    for (size_t blockNum = M->index1_data[row]; blockNum < M->index1_data[row + 1]; ++blockNum)
+    {
+      assert(M->index2_data[blockNum] < nbrow);
+      tindex1[M->index2_data[blockNum] + 1]++;
+    }
+  }
+  for (unsigned int i = 0; i < nbrow; ++i)
+    tindex1[i + 1] += tindex1[i];
+  size_t * tpos = (size_t *)malloc(nbrow * sizeof(size_t));
+  memcpy(tpos, tindex1, nbrow * sizeof(size_t));
+  for (size_t row = 0; row < nbfilled; ++row)
+  {
+    for (size_t blockNum = M->index1_data[row]; blockNum < M->index1_data[row + 1]; ++blockNum)
+    {
+      tindex2[tpos[M->index2_data[blockNum]]++] = row;
+    }
+  }
+  free(tpos);
+  *tindex1_ptr = tindex1;
+  *tindex2_ptr = tindex2;
+}
+
+unsigned int SBM_row_blocks_coloring(const SparseBlockStructuredMatrix* const M, unsigned int* color)
+{
+  assert(M);
+  assert(color);
+  unsigned int nbrow = M->blocknumber0;
+  if (nbrow == 0)
+    return 0;
+
+  /* number of rows of blocks that effectively contain blocks */
+  size_t nbfilled = M->filled1 > 0 ? M->filled1 - 1 : 0;
+
+  /* The block pattern is symmetrized: the neighbours of row i are the
+   * columns of the blocks of row i (scanned through index1_data/index2_data)
+   * and the rows having a block in column i (scanned through the transposed
+   * pattern) */
+  size_t * tindex1;
+  size_t * tindex2;
+  SBM_transposed_pattern(M, nbfilled, &tindex1, &tindex2);
+
+  /* mark[c] == i + 1 if color c is already used by a neighbour of row i */
+  unsigned int * mark = (unsigned int *)calloc(nbrow + 1, sizeof(unsigned int));
+  unsigned int nbcolors = 0;
+  for (unsigned int i = 0; i < nbrow; ++i)
+    color[i] = nbrow;
+
+  for (unsigned int i = 0; i < nbrow; ++i)
+  {
+    if (i < nbfilled)
+    {
+      for (size_t blockNum = M->index1_data[i]; blockNum < M->index1_data[i + 1]; ++blockNum)
+      {
+        size_t j = M->index2_data[blockNum];
+        if (j != i && color[j] < nbrow)
+          mark[color[j]] = i + 1;
+      }
+    }
+    for (size_t k = tindex1[i]; k < tindex1[i + 1]; ++k)
+    {
+      size_t j = tindex2[k];
+      if (j != i && color[j] < nbrow)
+        mark[color[j]] = i + 1;
+    }
+    unsigned int c = 0;
+    while (mark[c] == i + 1)
+      c++;
+    color[i] = c;
+    if (c + 1 > nbcolors)
+      nbcolors = c + 1;
+  }
+  DEBUG_PRINTF("SBM_row_blocks_coloring: %u rows of blocks, %u colors\n", nbrow, nbcolors);
+
+  free(mark);
+  free(tindex1);
+  free(tindex2);
+  return nbcolors;
+}
+
+unsigned int SBM_row_blocks_partition(const SparseBlockStructuredMatrix* const M,
+                                      unsigned int nbparts, unsigned int* part)
+{
+  assert(M);
+  assert(part);
+  unsigned int nbrow = M->blocknumber0;
+  if (nbrow == 0 || nbparts == 0)
+    return 0;
+  if (nbparts > nbrow)
+    nbparts = nbrow;
+
+  size_t nbfilled = M->filled1 > 0 ? M->filled1 - 1 : 0;
+  size_t * tindex1;
+  size_t * tindex2;
+  SBM_transposed_pattern(M, nbfilled, &tindex1, &tindex2);
+
+  /* Breadth-first ordering of the rows on the symmetrized pattern: coupled
+   * rows are close in the ordering, which is then cut in nbparts slices of
+   * (almost) the same size. */
+  unsigned int * order = (unsigned int *)malloc(nbrow * sizeof(unsigned int));
+  char * visited = (char *)calloc(nbrow, sizeof(char));
+  unsigned int head = 0, tail = 0;
+  for (unsigned int root = 0; root < nbrow; ++root)
+  {
+    if (visited[root])
+      continue;
+    visited[root] = 1;
+    order[tail++] = root;
+    while (head < tail)
+    {
+      unsigned int i = order[head++];
+      if (i < nbfilled)
+      {
+        for (size_t blockNum = M->index1_data[i]; blockNum < M->index1_data[i + 1]; ++blockNum)
+        {
+          size_t j = M->index2_data[blockNum];
+          if (!visited[j])
+          {
+            visited[j] = 1;
+            order[tail++] = (unsigned int)j;
+          }
+        }
+      }
+      for (size_t k = tindex1[i]; k < tindex1[i + 1]; ++k)
+      {
+        size_t j = tindex2[k];
+        if (!visited[j])
+        {
+          visited[j] = 1;
+          order[tail++] = (unsigned int)j;
+        }
+      }
+    }
+  }
+  assert(tail == nbrow);
+
+  for (unsigned int k = 0; k < nbrow; ++k)
+    part[order[k]] = (unsigned int)(((size_t)k * nbparts) / nbrow);
+
+  DEBUG_PRINTF("SBM_row_blocks_partition: %u rows of blocks, %u parts\n", nbrow, nbparts);
+
+  free(order);
+  free(visited);
+  free(tindex1);
+  free(tindex2);
+  return nbparts;
+}
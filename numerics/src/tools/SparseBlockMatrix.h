@@ -456,6 +456,28 @@ extern "C"
   */
   int SBM_from_csparse(int blocksize, const CSparseMatrix* const sparseMat, SparseBlockStructuredMatrix* outSBM);
 
+  /** Greedy coloring of the rows of blocks of a SBM. Two rows of blocks i
+      and j get different colors as soon as the block (i,j) or the block (j,i)
+      is not null. Rows of the same color are then uncoupled, which is what
+      a parallel Gauss-Seidel sweep requires.
+      \param[in] M the SparseBlockStructuredMatrix matrix (square in blocks)
+      \param[out] color array of size M->blocknumber0, color[i] is the color of row i
+      \return the number of colors
+  */
+  unsigned int SBM_row_blocks_coloring(const SparseBlockStructuredMatrix* const M, unsigned int* color);
+
+  /** Partition of the rows of blocks of a SBM in parts of (almost) the same
+      size, such that coupled rows (the block (i,j) or (j,i) is not null) tend
+      to be in the same part. The rows are ordered by a breadth-first
+      traversal of the block pattern and this ordering is cut in slices.
+      \param[in] M the SparseBlockStructuredMatrix matrix (square in blocks)
+      \param[in] nbparts the requested number of parts
+      \param[out] part array of size M->blocknumber0, part[i] is the part of row i
+      \return the number of parts, min(nbparts, M->blocknumber0)
+  */
+  unsigned int SBM_row_blocks_partition(const SparseBlockStructuredMatrix* const M,
+                                        unsigned int nbparts, unsigned int* part);
+
   
 #if defined(__cplusplus) && !defined(BUILD_AS_CPP)
 }
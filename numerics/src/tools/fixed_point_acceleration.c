@@ -0,0 +1,252 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include <stdlib.h>
+#include <math.h>
+#include <float.h>
+
+#include "fixed_point_acceleration.h"
+#include "SolverOptions.h"
+#include "SiconosBlas.h"
+#include "SiconosLapack.h"
+#include "numerics_verbose.h"
+
+/* #define DEBUG_MESSAGES */
+/* #define DEBUG_STDOUT */
+#include "debug.h"
+
+/* relative Tikhonov regularization of the least-squares problem of the
+ * Anderson acceleration */
+#define ANDERSON_REGULARIZATION 1e-10
+
+struct FixedPointAcceleration
+{
+  int method;       /* SICONOS_ACCELERATION_ANDERSON or SICONOS_ACCELERATION_NESTEROV */
+  int n;            /* size of the iterates */
+  int memory;       /* number of differences kept by the Anderson acceleration */
+  double eta;       /* restart when error > eta * previous error */
+  fixed_point_projection_ptr projection;
+  void* env;
+
+  int k;            /* number of updates since the last restart */
+  double error;     /* error of the solver at the last update */
+  double* y;        /* last point returned, G is evaluated at y */
+  double* g;        /* last image G(y) */
+  double* f;        /* last residual G(y) - y (Anderson) */
+  double* tmp;      /* input of the projection */
+
+  /* Nesterov */
+  double t;
+
+  /* Anderson */
+  int columns;      /* number of differences stored */
+  int next;         /* next column to overwrite */
+  double* dF;       /* n x memory differences of residuals */
+  double* dG;       /* n x memory differences of images */
+  double* A;        /* memory x memory normal matrix */
+  double* gamma;    /* memory coefficients */
+  lapack_int* ipiv;
+};
+
+FixedPointAcceleration* fixed_point_acceleration_new(int n, SolverOptions* options, double* x,
+                                                     fixed_point_projection_ptr projection,
+                                                     void* env)
+{
+  if (options->iSize <= SICONOS_IPARAM_ACCELERATION_MEMORY)
+    return NULL;
+
+  int method = options->iparam[SICONOS_IPARAM_ACCELERATION];
+  if (method == SICONOS_ACCELERATION_NONE)
+    return NULL;
+  if (method != SICONOS_ACCELERATION_ANDERSON && method != SICONOS_ACCELERATION_NESTEROV)
+    numerics_error("fixed_point_acceleration_new", "unknown acceleration %i", method);
+
+  FixedPointAcceleration* acc = (FixedPointAcceleration*)calloc(1, sizeof(FixedPointAcceleration));
+  acc->method = method;
+  acc->n = n;
+  acc->memory = options->iparam[SICONOS_IPARAM_ACCELERATION_MEMORY] > 0 ?
+    options->iparam[SICONOS_IPARAM_ACCELERATION_MEMORY] : 5;
+  /* the residuals of the Anderson iterates are not monotone */
+  acc->eta = (method == SICONOS_ACCELERATION_ANDERSON) ? 2.0 : 1.0;
+  if (options->dSize > SICONOS_DPARAM_ACCELERATION_RESTART_ETA &&
+      options->dparam[SICONOS_DPARAM_ACCELERATION_RESTART_ETA] > 0.0)
+    acc->eta = options->dparam[SICONOS_DPARAM_ACCELERATION_RESTART_ETA];
+  acc->projection = projection;
+  acc->env = env;
+
+  acc->y = (double*)malloc(n * sizeof(double));
+  acc->g = (double*)malloc(n * sizeof(double));
+  acc->tmp = (double*)malloc(n * sizeof(double));
+  cblas_dcopy(n, x, 1, acc->y, 1);
+  acc->t = 1.0;
+
+  if (method == SICONOS_ACCELERATION_ANDERSON)
+  {
+    int m = acc->memory;
+    acc->f = (double*)malloc(n * sizeof(double));
+    acc->dF = (double*)malloc(n * m * sizeof(double));
+    acc->dG = (double*)malloc(n * m * sizeof(double));
+    acc->A = (double*)malloc(m * m * sizeof(double));
+    acc->gamma = (double*)malloc(m * sizeof(double));
+    acc->ipiv = (lapack_int*)malloc(m * sizeof(lapack_int));
+  }
+  numerics_printf_verbose(1, "---- Fixed-point acceleration: %s, memory = %i, restart eta = %e",
+                          method == SICONOS_ACCELERATION_ANDERSON ? "Anderson" : "Nesterov",
+                          acc->memory, acc->eta);
+  return acc;
+}
+
+/* x <- P(x) */
+static void fixed_point_acceleration_project(FixedPointAcceleration* acc, double* x)
+{
+  if (acc->projection)
+  {
+    cblas_dcopy(acc->n, x, 1, acc->tmp, 1);
+    acc->projection(acc->env, acc->tmp, x);
+  }
+}
+
+static void fixed_point_acceleration_nesterov(FixedPointAcceleration* acc, double* x)
+{
+  int n = acc->n;
+  /* x = g_k, acc->g = g_{k-1} */
+  double t = 0.5 * (1.0 + sqrt(1.0 + 4.0 * acc->t * acc->t));
+  double beta = (acc->t - 1.0) / t;
+  acc->t = t;
+  DEBUG_PRINTF("fixed_point_acceleration_nesterov: beta = %e\n", beta);
+
+  /* tmp <- g_k - g_{k-1}, g <- g_k */
+  cblas_dcopy(n, x, 1, acc->tmp, 1);
+  cblas_daxpy(n, -1.0, acc->g, 1, acc->tmp, 1);
+  cblas_dcopy(n, x, 1, acc->g, 1);
+
+  /* x <- g_k + beta (g_k - g_{k-1}) */
+  cblas_daxpy(n, beta, acc->tmp, 1, x, 1);
+  fixed_point_acceleration_project(acc, x);
+}
+
+static void fixed_point_acceleration_anderson(FixedPointAcceleration* acc, double* x)
+{
+  int n = acc->n;
+  int m = acc->memory;
+  double* f = acc->tmp;
+
+  /* f <- g_k - y_k */
+  cblas_dcopy(n, x, 1, f, 1);
+  cblas_daxpy(n, -1.0, acc->y, 1, f, 1);
+
+  /* new differences f_k - f_{k-1} and g_k - g_{k-1} */
+  double* dF = &acc->dF[acc->next * n];
+  double* dG = &acc->dG[acc->next * n];
+  cblas_dcopy(n, f, 1, dF, 1);
+  cblas_daxpy(n, -1.0, acc->f, 1, dF, 1);
+  cblas_dcopy(n, x, 1, dG, 1);
+  cblas_daxpy(n, -1.0, acc->g, 1, dG, 1);
+  acc->next = (acc->next + 1) % m;
+  if (acc->columns < m)
+    acc->columns++;
+
+  cblas_dcopy(n, f, 1, acc->f, 1);
+  cblas_dcopy(n, x, 1, acc->g, 1);
+
+  /* gamma = argmin || f_k - dF gamma ||, from the regularized normal equations */
+  int c = acc->columns;
+  cblas_dgemm(CblasColMajor, CblasTrans, CblasNoTrans, c, c, n, 1.0,
+              acc->dF, n, acc->dF, n, 0.0, acc->A, c);
+  cblas_dgemv(CblasColMajor, CblasTrans, n, c, 1.0, acc->dF, n, acc->f, 1, 0.0, acc->gamma, 1);
+  double max_diag = 0.0;
+  for (int i = 0; i < c; ++i)
+    max_diag = fmax(max_diag, acc->A[i + i * c]);
+  if (max_diag <= DBL_MIN)
+  {
+    /* stagnation: no information in the differences */
+    DEBUG_PRINT("fixed_point_acceleration_anderson: zero differences\n");
+    return;
+  }
+  for (int i = 0; i < c; ++i)
+    acc->A[i + i * c] += ANDERSON_REGULARIZATION * max_diag;
+
+  lapack_int info = 0;
+  DGESV(c, 1, acc->A, c, acc->ipiv, acc->gamma, c, &info);
+  if (info)
+  {
+    DEBUG_PRINTF("fixed_point_acceleration_anderson: DGESV failed, info = %i\n", info);
+    return;
+  }
+  DEBUG_EXPR(for (int i = 0; i < c; ++i) printf("gamma[%i] = %e\n", i, acc->gamma[i]););
+
+  /* x <- g_k - dG gamma */
+  cblas_dgemv(CblasColMajor, CblasNoTrans, n, c, -1.0, acc->dG, n, acc->gamma, 1, 1.0, x, 1);
+  fixed_point_acceleration_project(acc, x);
+}
+
+int fixed_point_acceleration_update(FixedPointAcceleration* acc, double* x, double error)
+{
+  int n = acc->n;
+  int restart = (acc->k > 0 && error > acc->eta * acc->error);
+
+  if (restart)
+  {
+    /* x is a plain fixed-point iterate, the history starts again at the
+     * next update */
+    DEBUG_PRINTF("fixed_point_acceleration_update: restart, error = %e > %e\n", error, acc->error);
+    acc->k = 0;
+    acc->t = 1.0;
+    acc->columns = 0;
+    acc->next = 0;
+  }
+  else if (acc->k == 0)
+  {
+    /* plain fixed-point step, the history starts from G(y_k) */
+    acc->k = 1;
+    cblas_dcopy(n, x, 1, acc->g, 1);
+    if (acc->method == SICONOS_ACCELERATION_ANDERSON)
+    {
+      cblas_dcopy(n, x, 1, acc->f, 1);
+      cblas_daxpy(n, -1.0, acc->y, 1, acc->f, 1);
+    }
+  }
+  else
+  {
+    acc->k++;
+    if (acc->method == SICONOS_ACCELERATION_NESTEROV)
+      fixed_point_acceleration_nesterov(acc, x);
+    else
+      fixed_point_acceleration_anderson(acc, x);
+  }
+  acc->error = error;
+
+  cblas_dcopy(n, x, 1, acc->y, 1);
+  return restart;
+}
+
+void fixed_point_acceleration_free(FixedPointAcceleration* acc)
+{
+  if (!acc)
+    return;
+  free(acc->y);
+  free(acc->g);
+  free(acc->f);
+  free(acc->tmp);
+  free(acc->dF);
+  free(acc->dG);
+  free(acc->A);
+  free(acc->gamma);
+  free(acc->ipiv);
+  free(acc);
+}
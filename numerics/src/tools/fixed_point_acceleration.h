@@ -0,0 +1,100 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#ifndef FIXED_POINT_ACCELERATION_H
+#define FIXED_POINT_ACCELERATION_H
+
+/*!\file fixed_point_acceleration.h
+ * \brief acceleration of the fixed-point iterations \f$ x_{k+1} = G(x_k) \f$
+ * of the projection solvers.
+ *
+ * The method is selected by options->iparam[SICONOS_IPARAM_ACCELERATION]:
+ *  - SICONOS_ACCELERATION_ANDERSON: the next iterate is the combination of
+ *    the last iparam[SICONOS_IPARAM_ACCELERATION_MEMORY] (default 5) images
+ *    \f$ G(x_i) \f$ minimizing the norm of the combined residual
+ *    \f$ G(x_i) - x_i \f$,
+ *  - SICONOS_ACCELERATION_NESTEROV: \f$ x_{k+1} = G(x_k) + \beta_k (G(x_k) - G(x_{k-1})) \f$
+ *    with the momentum of Nesterov.
+ *
+ * The history (or the momentum) is dropped when the error of the solver
+ * is larger than dparam[SICONOS_DPARAM_ACCELERATION_RESTART_ETA] times
+ * the one of the previous iteration (default 2.0 for Anderson, whose
+ * errors are not monotone, and 1.0 for Nesterov). The extrapolated
+ * iterates are projected on the feasible set.
+ *
+ * Both methods are most efficient with a fixed step size: the line
+ * searches change the map G from one iteration to the next.
+ *
+ * Usage in a solver:
+ * \code
+ * FixedPointAcceleration* acc = fixed_point_acceleration_new(n, options, x, projection, problem);
+ * while (...)
+ * {
+ *   x <- G(x); error, convergence ...
+ *   if (acc && hasNotConverged && iter < itermax)
+ *     fixed_point_acceleration_update(acc, x, error);
+ * }
+ * fixed_point_acceleration_free(acc);
+ * \endcode
+ */
+
+#include "NumericsFwd.h"
+#include "SiconosConfig.h"
+
+/** projection on the feasible set, px = P(x), with the signature of the
+ * projections of VariationalInequality and ConvexQP */
+typedef void (*fixed_point_projection_ptr)(void* env, double* x, double* px);
+
+typedef struct FixedPointAcceleration FixedPointAcceleration;
+
+#if defined(__cplusplus) && !defined(BUILD_AS_CPP)
+extern "C"
+{
+#endif
+
+  /** create the workspace of the acceleration selected in the options
+   * \param n size of the iterates
+   * \param options the options of the solver
+   * \param x the starting point of the iterations
+   * \param projection projection on the feasible set (may be NULL)
+   * \param env first argument of projection
+   * \return the workspace, or NULL if no acceleration is selected
+   */
+  FixedPointAcceleration* fixed_point_acceleration_new(int n, SolverOptions* options, double* x,
+                                                       fixed_point_projection_ptr projection,
+                                                       void* env);
+
+  /** compute the starting point of the next iteration
+   * \param acc the workspace
+   * \param[in,out] x in: \f$ G(x_k) \f$ computed from the last point returned
+   * (or the starting point), out: the accelerated point \f$ x_{k+1} \f$
+   * \param error the error of the solver at \f$ G(x_k) \f$
+   * \return 1 if the acceleration has been restarted, 0 otherwise
+   */
+  int fixed_point_acceleration_update(FixedPointAcceleration* acc, double* x, double error);
+
+  /** free the workspace
+   * \param acc the workspace (may be NULL)
+   */
+  void fixed_point_acceleration_free(FixedPointAcceleration* acc);
+
+#if defined(__cplusplus) && !defined(BUILD_AS_CPP)
+}
+#endif
+
+#endif
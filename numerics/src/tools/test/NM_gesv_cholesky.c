@@ -0,0 +1,150 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/* NM_gesv_expert with NM_KEEP_FACTORS on matrices flagged with
+ * NM_set_symmetric: the Cholesky factors must be used for a positive
+ * definite matrix, and the LU factors for an indefinite one, with the
+ * dense and with the sparse storages. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "CSparseMatrix_internal.h"
+#include "NumericsMatrix.h"
+#include "NumericsSparseMatrix.h"
+#include "SiconosBlas.h"
+
+#define SIZE 40
+
+/* a symmetric matrix, positive definite if shift > -2 */
+static double entry(int i, int j, double shift)
+{
+  if (i == j) return 2.0 + shift + 0.01 * i;
+  if (abs(i - j) == 1) return -1.0;
+  if ((i == 0 && j == SIZE - 1) || (i == SIZE - 1 && j == 0)) return -0.5;
+  return 0.0;
+}
+
+static void fill_sparse(NumericsMatrix* A, double shift)
+{
+  NM_clearSparseStorageKeepSymbolic(A);
+  NM_triplet_alloc(A, 3 * SIZE + 2);
+  A->matrix2->origin = NSM_TRIPLET;
+  CSparseMatrix* T = NM_triplet(A);
+  for (int i = 0; i < SIZE; ++i)
+    for (int j = 0; j < SIZE; ++j)
+      if (entry(i, j, 0.0) != 0.0)
+        cs_entry(T, i, j, entry(i, j, shift));
+}
+
+static void fill_dense(NumericsMatrix* A, double shift)
+{
+  for (int i = 0; i < SIZE; ++i)
+    for (int j = 0; j < SIZE; ++j)
+      A->matrix0[i + j * SIZE] = entry(i, j, shift);
+}
+
+/* solve with A and check the residual with Aref, a copy of A */
+static int solve(NumericsMatrix* A, NumericsMatrix* Aref, double* b)
+{
+  double x[SIZE], r[SIZE];
+  cblas_dcopy(SIZE, b, 1, x, 1);
+  int info = NM_gesv_expert(A, x, NM_KEEP_FACTORS);
+  cblas_dcopy(SIZE, b, 1, r, 1);
+  NM_gemv(1.0, Aref, x, -1.0, r);
+  double res = cblas_dnrm2(SIZE, r, 1);
+  printf("info = %i, residual = %e\n", info, res);
+  return info || !(res < 1e-12);
+}
+
+static int check(int test, const char* msg)
+{
+  if (!test)
+  {
+    printf("%s\n", msg);
+    return 1;
+  }
+  return 0;
+}
+
+static int test_sparse(double* b)
+{
+  int info = 0;
+  NumericsMatrix* A = NM_create(NM_SPARSE, SIZE, SIZE);
+  NM_setSparseSolver(A, NSM_CS_LUSOL);
+  NM_set_symmetric(A, true);
+
+  fill_sparse(A, 0.0);
+  info += solve(A, A, b);
+  CSparseMatrix_lu_factors* factors = (CSparseMatrix_lu_factors*) NSM_linearSolverParams(A)->solver_data;
+  info += check(factors->is_cholesky, "sparse: the Cholesky factorization has not been used");
+  css* S = factors->S;
+
+  /* new values, same pattern: the analysis is kept */
+  fill_sparse(A, 0.5);
+  info += solve(A, A, b);
+  info += check(factors->is_cholesky && factors->S == S,
+                "sparse: the symbolic analysis of the Cholesky factorization has not been reused");
+
+  /* indefinite: LU factorization */
+  fill_sparse(A, -3.0);
+  info += solve(A, A, b);
+  info += check(!factors->is_cholesky, "sparse: the LU factorization has not been used");
+
+  NM_free(A);
+  free(A);
+  return info;
+}
+
+/* positive definite if shift > -2, the dense matrix is then restored
+ * and factorized with LU */
+static int test_dense(double* b, double shift)
+{
+  int info = 0;
+  NumericsMatrix* A = NM_create(NM_DENSE, SIZE, SIZE);
+  NumericsMatrix* Aref = NM_create(NM_DENSE, SIZE, SIZE);
+
+  fill_dense(A, shift);
+  NM_copy(A, Aref);
+  NM_set_symmetric(A, true);
+  info += solve(A, Aref, b);
+  if (shift > -2.0)
+    info += check(NM_internalData(A)->isCholeskyFactorized, "dense: the Cholesky factorization has not been used");
+  else
+    info += check(!NM_internalData(A)->isCholeskyFactorized, "dense: the LU factorization has not been used");
+  /* a second solve with the same factors */
+  info += solve(A, Aref, b);
+
+  NM_free(A);
+  free(A);
+  NM_free(Aref);
+  free(Aref);
+  return info;
+}
+
+int main(void)
+{
+  double b[SIZE];
+  for (int i = 0; i < SIZE; ++i)
+    b[i] = 1.0 + sin((double)i);
+
+  int info = test_sparse(b);
+  info += test_dense(b, 0.0);
+  info += test_dense(b, -3.0);
+  return info;
+}
@@ -0,0 +1,159 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "NumericsMatrix.h"
+#include "NumericsSparseMatrix.h"
+#include "CSparseMatrix_internal.h"
+
+/* NM_gemv and NM_tgemv on a sparse matrix large enough to be handled by
+ * several threads when OpenMP is enabled, compared with a product computed
+ * directly from the triplet entries */
+
+static int check(const char* name, int n, double* y, double* yref)
+{
+  double err = 0.;
+  for (int k = 0; k < n; k++)
+    err = fmax(err, fabs(y[k] - yref[k]) / (1. + fabs(yref[k])));
+  printf("%s: error = %e\n", name, err);
+  return !(err < 1e-12);
+}
+
+int main(void)
+{
+  int size0 = 2000;
+  int size1 = 1500;
+  int nnz = 40000;
+  double alpha = 2.0;
+  double beta = 0.5;
+  int info = 0;
+
+  NumericsMatrix * A  = NM_create(NM_SPARSE, size0, size1);
+  NM_triplet_alloc(A, nnz);
+  A->matrix2->origin = NSM_TRIPLET;
+  srand(1);
+  for (int k = 0; k < nnz; k++)
+  {
+    NM_zentry(A, rand() % size0, rand() % size1, 1. + (double) rand() / RAND_MAX);
+  }
+  CSparseMatrix* T = NM_triplet(A);
+
+  double* x = (double*)malloc(size0 * sizeof(double));
+  double* y = (double*)malloc(size0 * sizeof(double));
+  double* y0 = (double*)malloc(size0 * sizeof(double));
+  double* yref = (double*)malloc(size0 * sizeof(double));
+  for (int k = 0; k < size0; k++)
+  {
+    x[k] = (double) rand() / RAND_MAX - 0.5;
+    y0[k] = (double) rand() / RAND_MAX - 0.5;
+  }
+
+  /* y = alpha A x + beta y */
+  for (int k = 0; k < size0; k++)
+  {
+    y[k] = y0[k];
+    yref[k] = beta * y0[k];
+  }
+  for (CS_INT e = 0; e < T->nz; e++)
+    yref[T->i[e]] += alpha * T->x[e] * x[T->p[e]];
+  NM_gemv(alpha, A, x, beta, y);
+  info += check("NM_gemv", size0, y, yref);
+
+  /* y = A x, y is not read */
+  for (int k = 0; k < size0; k++)
+  {
+    y[k] = NAN;
+    yref[k] = 0.;
+  }
+  for (CS_INT e = 0; e < T->nz; e++)
+    yref[T->i[e]] += T->x[e] * x[T->p[e]];
+  NM_gemv(1.0, A, x, 0.0, y);
+  info += check("NM_gemv, beta = 0", size0, y, yref);
+
+  /* y = alpha trans(A) x + beta y */
+  for (int k = 0; k < size1; k++)
+  {
+    y[k] = y0[k];
+    yref[k] = beta * y0[k];
+  }
+  for (CS_INT e = 0; e < T->nz; e++)
+    yref[T->p[e]] += alpha * T->x[e] * x[T->i[e]];
+  NM_tgemv(alpha, A, x, beta, y);
+  info += check("NM_tgemv", size1, y, yref);
+
+  /* the products follow the changes of the values of A: copy into A the
+   * matrix 3 A in csc form, then change in place the values of A. The
+   * triplets of A are cleared by the copy, keep the product A x */
+  double* Ax0 = (double*)calloc(size0, sizeof(double));
+  for (CS_INT e = 0; e < T->nz; e++)
+    Ax0[T->i[e]] += T->x[e] * x[T->p[e]];
+  NumericsMatrix * B  = NM_create(NM_SPARSE, size0, size1);
+  B->matrix2->csc = cs_spalloc(size0, size1, NM_csc(A)->nzmax, 1, 0);
+  B->matrix2->origin = NSM_CSC;
+  NM_copy_sparse(NM_csc(A), B->matrix2->csc);
+  CSparseMatrix* Bcsc = B->matrix2->csc;
+  for (CS_INT e = 0; e < Bcsc->p[size1]; e++)
+    Bcsc->x[e] *= 3.;
+  for (int pass = 0; pass < 2; pass++)
+  {
+    if (pass == 0)
+      NM_copy(B, A);
+    else
+    {
+      double* Ax = NSM_data(A->matrix2);
+      for (CS_INT e = 0; e < Bcsc->p[size1]; e++)
+        Ax[e] *= 2.;
+    }
+    double scal = (pass == 0) ? 3. : 6.;
+    for (int k = 0; k < size0; k++)
+    {
+      y[k] = y0[k];
+      yref[k] = beta * y0[k] + scal * alpha * Ax0[k];
+    }
+    NM_gemv(alpha, A, x, beta, y);
+    info += check("NM_gemv after a change of the values", size0, y, yref);
+  }
+  NM_free(B);
+  free(B);
+  free(Ax0);
+
+  /* a banded matrix: each thread writes only some rows of its part of the
+   * workspace, the products are computed twice with the same workspace */
+  int n = 20000;
+  NumericsMatrix * C  = NM_create(NM_SPARSE, n, n);
+  NM_triplet_alloc(C, 3 * n);
+  C->matrix2->origin = NSM_TRIPLET;
+  double* xb = (double*)malloc(n * sizeof(double));
+  double* yb = (double*)malloc(n * sizeof(double));
+  double* ybref = (double*)calloc(n, sizeof(double));
+  for (int k = 0; k < n; k++)
+    xb[k] = sin((double) k);
+  for (int k = 0; k < n; k++)
+  {
+    for (int l = k - 1; l <= k + 1; l++)
+    {
+      if (l < 0 || l >= n) continue;
+      double v = (l == k) ? 4. : -1. - 0.001 * k;
+      NM_zentry(C, k, l, v);
+      ybref[k] += v * xb[l];
+    }
+  }
+  for (int pass = 0; pass < 2; pass++)
+  {
+    NM_gemv(1.0, C, xb, 0.0, yb);
+    info += check("NM_gemv on a banded matrix", n, yb, ybref);
+  }
+  NM_free(C);
+  free(C);
+  free(xb);
+  free(yb);
+  free(ybref);
+
+  free(x);
+  free(y);
+  free(y0);
+  free(yref);
+  NM_free(A);
+  free(A);
+
+  return info;
+}
@@ -0,0 +1,128 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/* NM_gesv_expert with NM_KEEP_FACTORS on a sparse matrix whose values
+ * are changed with NM_clearSparseStorageKeepSymbolic: the symbolic
+ * analysis must be reused when the pattern is the same, and redone
+ * otherwise. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "CSparseMatrix_internal.h"
+#include "NumericsMatrix.h"
+#include "NumericsSparseMatrix.h"
+#include "SiconosBlas.h"
+
+#define SIZE 50
+
+/* a tridiagonal matrix with a coupling of the first and the last
+ * unknowns, and with an extra entry in the column 1 + 2 * extra if
+ * extra */
+static void fill(NumericsMatrix* A, double shift, int extra)
+{
+  NM_clearSparseStorageKeepSymbolic(A);
+  NM_triplet_alloc(A, 3 * SIZE + 3);
+  A->matrix2->origin = NSM_TRIPLET;
+  CSparseMatrix* T = NM_triplet(A);
+  for (int i = 0; i < SIZE; ++i)
+  {
+    cs_entry(T, i, i, 4.0 + shift + 0.01 * i);
+    if (i > 0) cs_entry(T, i, i - 1, -1.0 - shift);
+    if (i < SIZE - 1) cs_entry(T, i, i + 1, -1.0 + 0.5 * shift);
+  }
+  cs_entry(T, 0, SIZE - 1, 0.5);
+  cs_entry(T, SIZE - 1, 0, 0.5 + shift);
+  if (extra)
+    cs_entry(T, SIZE / 2, 1 + 2 * extra, 1.5);
+}
+
+/* || A x - b || */
+static double residual(NumericsMatrix* A, double* x, double* b)
+{
+  double r[SIZE];
+  cblas_dcopy(SIZE, b, 1, r, 1);
+  NM_gemv(1.0, A, x, -1.0, r);
+  return cblas_dnrm2(SIZE, r, 1);
+}
+
+static int solve(NumericsMatrix* A, double* b)
+{
+  double x[SIZE];
+  cblas_dcopy(SIZE, b, 1, x, 1);
+  int info = NM_gesv_expert(A, x, NM_KEEP_FACTORS);
+  double res = residual(A, x, b);
+  printf("info = %i, residual = %e\n", info, res);
+  return info || !(res < 1e-12);
+}
+
+int main(void)
+{
+  int info = 0;
+  double b[SIZE];
+  for (int i = 0; i < SIZE; ++i)
+    b[i] = 1.0 + sin((double)i);
+
+  NumericsMatrix* A = NM_create(NM_SPARSE, SIZE, SIZE);
+  NM_setSparseSolver(A, NSM_CS_LUSOL);
+  fill(A, 0.0, 0);
+  info += solve(A, b);
+  CSparseMatrix_lu_factors* factors = (CSparseMatrix_lu_factors*) NSM_linearSolverParams(A)->solver_data;
+  css* S = factors->S;
+
+  /* new values, same pattern: only the numerical factorization */
+  fill(A, 0.3, 0);
+  if (NSM_linearSolverParams(A)->solver_data != factors || factors->N)
+  {
+    printf("the symbolic analysis has not been kept\n");
+    info++;
+  }
+  info += solve(A, b);
+  if (factors->S != S || !CSparseMatrix_lu_factors_same_pattern(factors, NM_csc(A)))
+  {
+    printf("the symbolic analysis has not been reused\n");
+    info++;
+  }
+
+  /* a new pattern: a new analysis */
+  fill(A, 0.1, 1);
+  if (CSparseMatrix_lu_factors_same_pattern(factors, NM_csc(A)))
+  {
+    printf("the new pattern is not detected\n");
+    info++;
+  }
+  info += solve(A, b);
+  if (!CSparseMatrix_lu_factors_same_pattern(factors, NM_csc(A)))
+  {
+    printf("the symbolic analysis has not been updated\n");
+    info++;
+  }
+
+  /* the same number of entries with another pattern: a new analysis */
+  fill(A, 0.2, 2);
+  if (CSparseMatrix_lu_factors_same_pattern(factors, NM_csc(A)))
+  {
+    printf("the new pattern with the same number of entries is not detected\n");
+    info++;
+  }
+  info += solve(A, b);
+
+  NM_free(A);
+  free(A);
+  return info;
+}
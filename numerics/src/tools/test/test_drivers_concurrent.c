@@ -0,0 +1,216 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/* Independent problems solved concurrently by the drivers must have the
+ * same solutions as when they are solved sequentially. The solvers keep
+ * their state in their options or in thread local variables: run this test
+ * built with USE_SANITIZER=tsan to detect the data races (with a libgomp
+ * built without tsan, the end of the parallel region is not seen as a
+ * synchronization and the reads of the results by main are reported). */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "NonSmoothDrivers.h"
+#include "NumericsMatrix.h"
+#include "SolverOptions.h"
+#include "LinearComplementarityProblem.h"
+#include "LCP_Solvers.h"
+#include "lcp_cst.h"
+#include "MixedLinearComplementarityProblem.h"
+#include "MLCP_Solvers.h"
+#include "mlcp_cst.h"
+#include "FrictionContactProblem.h"
+#include "fc3d_Solvers.h"
+#include "Friction_cst.h"
+
+#define NB_TASKS 8
+#define LCP_SIZE 8
+#define MLCP_N 2
+#define MLCP_M 4
+#define NB_CONTACTS 4
+
+#define NB_LCP_SOLVERS 3
+static const int lcp_solvers[NB_LCP_SOLVERS] =
+{
+  SICONOS_LCP_LEMKE, SICONOS_LCP_ENUM, SICONOS_LCP_PGS
+};
+
+/* pseudo-random values in [-1, 1], reproducible for a given seed */
+static double rand_value(unsigned int * seed)
+{
+  *seed = *seed * 1103515245u + 12345u;
+  return ((*seed >> 8) & 0xFFFF) / 32767.5 - 1.0;
+}
+
+/* dense symmetric positive definite matrix R^T R + I */
+static NumericsMatrix * spd_matrix(int n, unsigned int seed)
+{
+  NumericsMatrix * M = NM_create(NM_DENSE, n, n);
+  double * R = (double *) malloc(n * n * sizeof(double));
+  for (int i = 0; i < n * n; i++)
+    R[i] = rand_value(&seed);
+  for (int i = 0; i < n; i++)
+    for (int j = 0; j < n; j++)
+    {
+      double s = (i == j) ? 1.0 : 0.0;
+      for (int k = 0; k < n; k++)
+        s += R[k + i * n] * R[k + j * n];
+      M->matrix0[i + j * n] = s;
+    }
+  free(R);
+  return M;
+}
+
+/* the problems of a task, and their solutions */
+typedef struct
+{
+  LinearComplementarityProblem lcp;
+  MixedLinearComplementarityProblem mlcp;
+  int blocksRows[3];
+  int blocksIsComp[2];
+  FrictionContactProblem * fc3d;
+  double z_lcp[NB_LCP_SOLVERS][LCP_SIZE];
+  double z_mlcp[2][MLCP_N + MLCP_M];
+  double r_fc3d[3 * NB_CONTACTS];
+  int info;
+} Task;
+
+static void task_init(Task * task, unsigned int seed)
+{
+  memset(task, 0, sizeof(Task));
+  task->lcp.size = LCP_SIZE;
+  task->lcp.M = spd_matrix(LCP_SIZE, seed);
+  task->lcp.q = (double *) malloc(LCP_SIZE * sizeof(double));
+  for (int i = 0; i < LCP_SIZE; i++)
+    task->lcp.q[i] = rand_value(&seed);
+
+  task->mlcp.isStorageType1 = 1;
+  task->mlcp.n = MLCP_N;
+  task->mlcp.m = MLCP_M;
+  task->blocksRows[1] = MLCP_N;
+  task->blocksRows[2] = MLCP_N + MLCP_M;
+  task->blocksIsComp[1] = 1;
+  task->mlcp.blocksRows = task->blocksRows;
+  task->mlcp.blocksIsComp = task->blocksIsComp;
+  task->mlcp.M = spd_matrix(MLCP_N + MLCP_M, seed);
+  task->mlcp.q = (double *) malloc((MLCP_N + MLCP_M) * sizeof(double));
+  for (int i = 0; i < MLCP_N + MLCP_M; i++)
+    task->mlcp.q[i] = rand_value(&seed);
+
+  /* independent contacts with a 3x3 block diagonal Delassus matrix */
+  NumericsMatrix * W = NM_create(NM_DENSE, 3 * NB_CONTACTS, 3 * NB_CONTACTS);
+  memset(W->matrix0, 0, 9 * NB_CONTACTS * NB_CONTACTS * sizeof(double));
+  double * q = (double *) malloc(3 * NB_CONTACTS * sizeof(double));
+  double * mu = (double *) malloc(NB_CONTACTS * sizeof(double));
+  for (int c = 0; c < NB_CONTACTS; c++)
+  {
+    NumericsMatrix * block = spd_matrix(3, seed + c);
+    for (int i = 0; i < 3; i++)
+      for (int j = 0; j < 3; j++)
+        W->matrix0[3 * c + i + (3 * c + j) * 3 * NB_CONTACTS] = block->matrix0[i + 3 * j];
+    NM_free(block);
+    free(block);
+    q[3 * c] = -1.0 - 0.5 * rand_value(&seed);
+    q[3 * c + 1] = rand_value(&seed);
+    q[3 * c + 2] = rand_value(&seed);
+    mu[c] = 0.5;
+  }
+  task->fc3d = frictionContactProblem_new(3, NB_CONTACTS, W, q, mu);
+}
+
+static void task_free(Task * task)
+{
+  NM_free(task->lcp.M);
+  free(task->lcp.M);
+  free(task->lcp.q);
+  NM_free(task->mlcp.M);
+  free(task->mlcp.M);
+  free(task->mlcp.q);
+  freeFrictionContactProblem(task->fc3d);
+}
+
+static void task_solve(Task * task)
+{
+  double w[LCP_SIZE + MLCP_N + MLCP_M + 3 * NB_CONTACTS];
+  SolverOptions options;
+
+  for (int s = 0; s < NB_LCP_SOLVERS; s++)
+  {
+    linearComplementarity_setDefaultSolverOptions(&task->lcp, &options, lcp_solvers[s]);
+    task->info += lcp_driver_DenseMatrix(&task->lcp, task->z_lcp[s], w, &options);
+    solver_options_delete(&options);
+  }
+
+  /* the second call of the direct solver is solved from its configurations */
+  options.solverId = SICONOS_MLCP_DIRECT_ENUM;
+  mixedLinearComplementarity_setDefaultSolverOptions(&task->mlcp, &options);
+  options.iparam[0] = 1 << 10;
+  options.dparam[0] = 1e-10;
+  mlcp_driver_init(&task->mlcp, &options);
+  for (int k = 0; k < 2; k++)
+    task->info += mlcp_driver(&task->mlcp, task->z_mlcp[k], w, &options);
+  if (options.iparam[SICONOS_MLCP_IPARAM_DIRECT_NUMBER_OF_HITS] != 1)
+    task->info++;
+  mlcp_driver_reset(&task->mlcp, &options);
+  mixedLinearComplementarity_deleteDefaultSolverOptions(&task->mlcp, &options);
+
+  fc3d_setDefaultSolverOptions(&options, SICONOS_FRICTION_3D_NSGS);
+  task->info += fc3d_driver(task->fc3d, task->r_fc3d, w, &options);
+  solver_options_delete(&options);
+}
+
+int main(void)
+{
+  int info = 0;
+  Task * reference = (Task *) malloc(NB_TASKS * sizeof(Task));
+  Task * concurrent = (Task *) malloc(NB_TASKS * sizeof(Task));
+
+  for (int t = 0; t < NB_TASKS; t++)
+  {
+    task_init(&reference[t], 17 * t + 1);
+    task_solve(&reference[t]);
+    if (reference[t].info)
+    {
+      printf("task %i: a problem is not solved\n", t);
+      info = 1;
+    }
+    task_init(&concurrent[t], 17 * t + 1);
+  }
+
+#pragma omp parallel for schedule(static, 1)
+  for (int t = 0; t < NB_TASKS; t++)
+    task_solve(&concurrent[t]);
+
+  for (int t = 0; t < NB_TASKS; t++)
+  {
+    if (concurrent[t].info != reference[t].info
+        || memcmp(concurrent[t].z_lcp, reference[t].z_lcp, sizeof(reference[t].z_lcp))
+        || memcmp(concurrent[t].z_mlcp, reference[t].z_mlcp, sizeof(reference[t].z_mlcp))
+        || memcmp(concurrent[t].r_fc3d, reference[t].r_fc3d, sizeof(reference[t].r_fc3d)))
+    {
+      printf("task %i: the concurrent solutions differ from the sequential ones\n", t);
+      info = 1;
+    }
+    task_free(&reference[t]);
+    task_free(&concurrent[t]);
+  }
+  free(reference);
+  free(concurrent);
+  return info;
+}